@@ -0,0 +1,127 @@
+#include <hmm/clock-cache.hpp>
+#include <hmm/lru-cache.hpp>
+
+// Std
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// @brief The usual LRU: a recency list plus a map of list iterators, with
+/// two node allocations per cached entry.
+class ListLru {
+  public:
+    explicit ListLru(std::size_t capacity) : capacity_(capacity) {
+        map_.reserve(capacity);
+    }
+
+    std::uint64_t* get(std::uint64_t key) {
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            return nullptr;
+        }
+        order_.splice(order_.begin(), order_, it->second);
+        return &it->second->second;
+    }
+
+    void put(std::uint64_t key, std::uint64_t value) {
+        auto it = map_.find(key);
+        if (it != map_.end()) {
+            it->second->second = value;
+            order_.splice(order_.begin(), order_, it->second);
+            return;
+        }
+        if (map_.size() == capacity_) {
+            map_.erase(order_.back().first);
+            order_.pop_back();
+        }
+        order_.emplace_front(key, value);
+        map_.emplace(key, order_.begin());
+    }
+
+  private:
+    using Order = std::list<std::pair<std::uint64_t, std::uint64_t>>;
+
+    std::size_t capacity_;
+    Order order_;
+    std::unordered_map<std::uint64_t, Order::iterator> map_;
+};
+
+/// @brief Draws keys from a Zipf distribution over `n` keys, by inverting a
+/// precomputed CDF.
+std::vector<std::uint64_t> ZipfKeys(std::size_t n, double skew,
+                                    std::size_t count) {
+    std::vector<double> cdf(n);
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+        cdf[i] = sum;
+    }
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> uniform(0, sum);
+    std::vector<std::uint64_t> keys(count);
+    for (auto& key : keys) {
+        const auto rank = static_cast<std::uint64_t>(
+            std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) -
+            cdf.begin());
+        // Scatter the ranks so that hot keys are not clustered.
+        key = rank * 0x9E3779B97F4A7C15ULL;
+    }
+    return keys;
+}
+
+/// @brief Replays a read-through workload: every miss is followed by a put.
+template <class Cache>
+void Run(const char* name, Cache& cache,
+         const std::vector<std::uint64_t>& keys) {
+    std::size_t hits = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (auto key : keys) {
+        if (cache.get(key)) {
+            ++hits;
+        } else {
+            cache.put(key, key);
+        }
+    }
+    const auto elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+    std::printf("  %-14s hit rate %6.2f%%  %8.2f Mops/s\n", name,
+                100.0 * static_cast<double>(hits) /
+                    static_cast<double>(keys.size()),
+                static_cast<double>(keys.size()) / elapsed / 1e6);
+}
+
+} // namespace
+
+int main() {
+    const std::size_t universe = 1000000;
+    const std::size_t operations = 10000000;
+
+    for (double skew : {0.8, 0.99, 1.2}) {
+        const auto keys = ZipfKeys(universe, skew, operations);
+        for (std::size_t capacity : {1000, 100000}) {
+            std::printf("zipf %.2f, capacity %zu\n", skew, capacity);
+
+            ListLru list(capacity);
+            Run("list + map", list, keys);
+
+            hmm::lru_cache<std::uint64_t, std::uint64_t> lru(capacity);
+            Run("hmm::lru", lru, keys);
+
+            hmm::clock_cache<std::uint64_t, std::uint64_t> clock(capacity);
+            Run("hmm::clock", clock, keys);
+        }
+    }
+}
@@ -0,0 +1,168 @@
+#include <hmm/flat-hash-map.hpp>
+#include <hmm/flat-hash-multimap.hpp>
+#include <hmm/hash-join.hpp>
+
+// Std
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Row {
+    std::uint64_t key;
+    std::uint64_t payload;
+};
+
+struct KeyOf {
+    std::uint64_t operator()(const Row& row) const {
+        return row.key;
+    }
+};
+
+/// @brief Builds `n` rows in random order over the keys of ranks
+/// `[0, distinct)`, each rank repeated `n / distinct` times.
+std::vector<Row> MakeBuildRows(std::size_t n, std::size_t distinct) {
+    std::vector<Row> rows(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        rows[i].key = i % distinct;
+        rows[i].payload = i;
+    }
+    std::shuffle(rows.begin(), rows.end(), std::mt19937_64(1));
+    return rows;
+}
+
+/// @brief Builds `n` rows over random ranks in `[0, range)`.
+std::vector<Row> MakeProbeRows(std::size_t n, std::size_t range) {
+    std::mt19937_64 rng(2);
+    std::vector<Row> rows(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        rows[i].key = rng() % range;
+        rows[i].payload = i;
+    }
+    return rows;
+}
+
+/// @brief Scatters the ranks so that keys are not clustered.
+void Scatter(std::vector<Row>& rows) {
+    for (auto& row : rows) {
+        row.key *= 0x9E3779B97F4A7C15ULL;
+    }
+}
+
+template <class F> void Run(const char* name, std::size_t rows, F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t checksum = f();
+    const auto elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    std::printf("  %-30s %8.2f Mrows/s  (checksum %llu)\n", name,
+                static_cast<double>(rows) / elapsed / 1e6,
+                static_cast<unsigned long long>(checksum));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t build_rows =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8000000;
+    const std::size_t probe_rows =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4 * build_rows;
+    const std::size_t total = build_rows + probe_rows;
+
+    hmm::join_options single;
+    hmm::join_options partitioned;
+    partitioned.partition_bits = hmm::join_options::kAutoPartitions;
+
+    for (std::size_t repeat : {1, 4}) {
+        const std::size_t distinct = build_rows / repeat;
+        auto build = MakeBuildRows(build_rows, distinct);
+        // Half of the probe keys find a match.
+        auto probe = MakeProbeRows(probe_rows, 2 * distinct);
+        Scatter(build);
+        Scatter(probe);
+        std::printf("%zu build rows, %zu per key, %zu probe rows\n",
+                    build_rows, repeat, probe_rows);
+
+        if (repeat == 1) {
+            Run("inner: map + find loop", total, [&] {
+                hmm::flat_hash_map<std::uint64_t, std::uint32_t> map;
+                map.reserve(build.size());
+                for (std::size_t i = 0; i < build.size(); ++i) {
+                    map.emplace(build[i].key, static_cast<std::uint32_t>(i));
+                }
+                std::uint64_t sum = 0;
+                for (const auto& row : probe) {
+                    const auto it = map.find(row.key);
+                    if (it != map.end()) {
+                        sum += build[it->second].payload ^ row.payload;
+                    }
+                }
+                return sum;
+            });
+        } else {
+            Run("inner: multimap loop", total, [&] {
+                hmm::flat_hash_multimap<std::uint64_t, std::uint32_t> map;
+                map.reserve(build.size());
+                for (std::size_t i = 0; i < build.size(); ++i) {
+                    map.emplace(build[i].key, static_cast<std::uint32_t>(i));
+                }
+                std::uint64_t sum = 0;
+                for (const auto& row : probe) {
+                    auto range = map.equal_range(row.key);
+                    for (; range.first != range.second; ++range.first) {
+                        sum += build[range.first->second].payload ^
+                               row.payload;
+                    }
+                }
+                return sum;
+            });
+        }
+
+        const auto inner = [&](const hmm::join_options& options) {
+            std::uint64_t sum = 0;
+            hmm::hash_join(
+                build, probe, KeyOf(),
+                [&](const Row& b, const Row& p) {
+                    sum += b.payload ^ p.payload;
+                },
+                options);
+            return sum;
+        };
+        Run("inner: hash_join", total, [&] { return inner(single); });
+        Run("inner: hash_join, partitioned", total,
+            [&] { return inner(partitioned); });
+
+        Run("semi: map + find loop", total, [&] {
+            hmm::flat_hash_map<std::uint64_t, std::uint32_t> map;
+            map.reserve(build.size());
+            for (const auto& row : build) {
+                map.emplace(row.key, 0);
+            }
+            std::uint64_t sum = 0;
+            for (const auto& row : probe) {
+                if (map.contains(row.key)) {
+                    sum += row.payload;
+                }
+            }
+            return sum;
+        });
+        Run("semi: hash_semi_join", total, [&] {
+            std::uint64_t sum = 0;
+            hmm::hash_semi_join(build, probe, KeyOf(),
+                                [&](const Row& p) { sum += p.payload; });
+            return sum;
+        });
+        Run("anti: hash_anti_join", total, [&] {
+            std::uint64_t sum = 0;
+            hmm::hash_anti_join(build, probe, KeyOf(),
+                                [&](const Row& p) { sum += p.payload; });
+            return sum;
+        });
+    }
+}
@@ -0,0 +1,199 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_ALGORITHM_HPP
+#define HMM_HMM_ALGORITHM_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hmm/executor.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Grants the table algorithms access to the table under a container.
+struct TableAccess {
+    /// @brief The raw table type under a container.
+    template <class Container>
+    using Raw = typename Container::raw_table_type;
+
+    template <class Container>
+    static typename Container::raw_table_type& raw(Container& c) noexcept {
+        return c;
+    }
+
+    template <class Container>
+    static const typename Container::raw_table_type&
+    raw(const Container& c) noexcept {
+        return c;
+    }
+};
+
+/// @brief Passes executors through unchanged.
+template <class Executor> Executor& make_executor(Executor& executor) {
+    return executor;
+}
+
+inline inline_executor make_executor(const execution::sequenced_policy&) {
+    return inline_executor();
+}
+
+inline thread_executor make_executor(const execution::parallel_policy&) {
+    return thread_executor();
+}
+
+/// @brief The element of a table an algorithm hands to user code: a const
+/// reference for sets and const tables, a mutable one for maps.
+template <class Container>
+using ElementRef = typename std::conditional<
+    std::is_const<Container>::value,
+    typename Container::const_iterator::reference,
+    typename Container::iterator::reference>::type;
+
+template <class Value>
+const Value& MappedOf(const Value& value, std::true_type) noexcept {
+    return value;
+}
+
+template <class Value>
+auto MappedOf(const Value& value, std::false_type) noexcept
+    -> decltype((value.second)) {
+    return value.second;
+}
+
+} // namespace internal
+
+/// @name Table Algorithms
+/// Whole-table algorithms that split the control bytes into group-aligned
+/// ranges, one task per range, instead of walking a single iterator.
+///
+/// Each takes an execution policy (`hmm::execution::seq` or
+/// `hmm::execution::par`) or an executor such as `hmm::thread_executor`.
+/// With a parallel policy the callbacks run concurrently and must be safe to
+/// do so. They must not insert into or erase from the table.
+///@{
+
+/// @brief Invokes `f` on every element of the table.
+/// @details For maps, `f` receives a mutable `std::pair<const K, V>&`, so the
+/// mapped values may be updated in place.
+template <class Exec, class Container, class F>
+void for_each(Exec&& exec, Container& container, F&& f) {
+    auto&& executor = internal::make_executor(exec);
+    const auto& table = internal::TableAccess::raw(container);
+    table.parallel_scan(executor, [&](std::size_t, std::size_t index) {
+        f(static_cast<internal::ElementRef<Container>>(
+            Container::policy_type::value_from_slot(table.slots_ptr()[index])));
+    });
+}
+
+/// @brief Counts the elements satisfying `pred`.
+template <class Exec, class Container, class Pred>
+HMM_NODISCARD typename Container::size_type
+count_if(Exec&& exec, const Container& container, Pred&& pred) {
+    auto&& executor = internal::make_executor(exec);
+    const auto& table = internal::TableAccess::raw(container);
+
+    std::vector<std::size_t> counts(table.scan_chunks(executor), 0);
+    table.parallel_scan(executor, [&](std::size_t chunk, std::size_t index) {
+        if (pred(*table.iterator_at(index))) {
+            ++counts[chunk];
+        }
+    });
+
+    typename Container::size_type total = 0;
+    for (std::size_t count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+/// @brief Erases every element satisfying `pred`.
+/// @details Elements are destroyed on the tasks that test them, so the
+/// allocator must support concurrent use with a parallel policy.
+/// @return The number of erased elements.
+template <class Exec, class Container, class Pred>
+typename Container::size_type erase_if(Exec&& exec, Container& container,
+                                       Pred&& pred) {
+    auto&& executor = internal::make_executor(exec);
+    auto& table = internal::TableAccess::raw(container);
+
+    std::vector<std::size_t> counts(table.scan_chunks(executor), 0);
+    const auto settle = [&] {
+        typename Container::size_type total = 0;
+        for (std::size_t count : counts) {
+            total += count;
+        }
+        table.account_erased(total);
+        return total;
+    };
+    const auto& view = table;
+    try {
+        view.parallel_scan(executor, [&](std::size_t chunk, std::size_t index) {
+            if (pred(*view.iterator_at(index))) {
+                table.tombstone_at(index);
+                ++counts[chunk];
+            }
+        });
+    } catch (...) {
+        settle();
+        throw;
+    }
+    return settle();
+}
+
+/// @brief Combines the mapped values of a map, or the elements of a set,
+/// with `op`, starting from `init`.
+/// @details As with `std::reduce`, the grouping and order of the operands is
+/// unspecified, so `op` must be associative and commutative.
+template <class Exec, class Container, class T, class BinaryOp>
+HMM_NODISCARD T reduce(Exec&& exec, const Container& container, T init,
+                       BinaryOp&& op) {
+    auto&& executor = internal::make_executor(exec);
+    const auto& table = internal::TableAccess::raw(container);
+    using IsSet =
+        std::is_void<typename Container::policy_type::mapped_type>;
+
+    // One partial result per range, seeded by its first element.
+    std::vector<std::unique_ptr<T>> partials(table.scan_chunks(executor));
+    table.parallel_scan(executor, [&](std::size_t chunk, std::size_t index) {
+        const auto& value =
+            internal::MappedOf(*table.iterator_at(index), IsSet());
+        if (partials[chunk]) {
+            *partials[chunk] = op(std::move(*partials[chunk]), value);
+        } else {
+            partials[chunk].reset(new T(value));
+        }
+    });
+
+    for (auto& partial : partials) {
+        if (partial) {
+            init = op(std::move(init), std::move(*partial));
+        }
+    }
+    return init;
+}
+
+///@}
+
+} // namespace hmm
+
+#endif // HMM_HMM_ALGORITHM_HPP
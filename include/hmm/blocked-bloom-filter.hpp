@@ -0,0 +1,360 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_BLOCKED_BLOOM_FILTER_HPP
+#define HMM_HMM_BLOCKED_BLOOM_FILTER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "hmm/city-hash.hpp"
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/hash-mix.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief The geometry of a split block Bloom filter: one 512-bit cache line
+/// per block, as eight 64-bit words with one bit set in each.
+struct BloomBlock {
+    static constexpr std::size_t kWords = 8;
+    static constexpr std::size_t kBytes = kWords * sizeof(std::uint64_t);
+};
+
+/// @brief Odd 32-bit multipliers that pick the bit in each word of a block.
+HMM_NODISCARD inline const std::uint32_t* BloomSalts() noexcept {
+    alignas(32) static const std::uint32_t kSalts[BloomBlock::kWords] = {
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+    return kSalts;
+}
+
+/// @brief Estimates the false positive rate of a split block filter holding
+/// `load` keys per block on average.
+/// @details The keys per block follow a Poisson distribution, and a block
+/// holding `i` keys answers yes with probability `(1 - (63/64)^i)^8`.
+HMM_NODISCARD inline double BloomFalsePositiveRate(double load) {
+    const double last = load + 12 * std::sqrt(load) + 16;
+    double poisson = std::exp(-load);
+    double rate = 0;
+    for (double i = 0; i <= last; ++i) {
+        if (i > 0) {
+            poisson *= load / i;
+        }
+        const double word = 1 - std::pow(63.0 / 64.0, i);
+        rate += poisson * std::pow(word, 8);
+    }
+    return rate;
+}
+
+/// @brief Finds the largest average number of keys per block that keeps the
+/// false positive rate at or below `fpp`.
+HMM_NODISCARD inline double BloomKeysPerBlock(double fpp) {
+    double lo = 1.0 / 64;
+    double hi = 512;
+    if (BloomFalsePositiveRate(hi) <= fpp) {
+        return hi;
+    }
+    for (int i = 0; i < 48; ++i) {
+        const double mid = (lo + hi) / 2;
+        if (BloomFalsePositiveRate(mid) <= fpp) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+} // namespace internal
+
+/// @brief A split block Bloom filter: a probabilistic set that answers "maybe
+/// present" or "definitely absent" while touching one cache line.
+///
+/// The filter is an array of 64-byte blocks, each eight 64-bit words. A key's
+/// hash is remixed, its high half picks the block and its low half, times
+/// eight fixed odd salts, picks one bit in each word. Insertion ORs the eight
+/// bits in and a lookup tests them all at once, with one 256-bit test per
+/// half block under AVX2, a 128-bit compare under SSE2 and a word loop
+/// elsewhere.
+///
+/// Keys are hashed with the same functors as the tables, so a key hashed once
+/// can be checked against a filter and then probed for in a table through
+/// `contains_hash` and the table's `find_hashed`. See `filtered_table`.
+///
+/// Elements cannot be removed. Use `cuckoo_filter` for that.
+///
+/// @tparam T The type of the keys.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<T>`)
+///               2. Allocator (Defaults to `std::allocator<T>`)
+template <class T, class... TArgs> class blocked_bloom_filter {
+  public:
+    using key_type = T;
+    using hasher_type =
+        typename internal::detail::TypeAtIndexOrDefault<0, CityHash<T>,
+                                                        TArgs...>::type;
+    using allocator_type =
+        typename internal::detail::TypeAtIndexOrDefault<1, std::allocator<T>,
+                                                        TArgs...>::type;
+    using size_type = std::size_t;
+
+    /// @brief The filter cannot forget keys.
+    static constexpr bool supports_erase = false;
+
+  private:
+    using Block = internal::BloomBlock;
+    using WordAlloc = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<std::uint64_t>;
+
+  public:
+    /// @brief Builds an empty filter sized for `expected` keys at a false
+    /// positive rate of about `fpp`.
+    /// @throws std::invalid_argument If `fpp` is not within (0, 1).
+    /// @throws std::length_error If more than 2^32 blocks would be needed.
+    explicit blocked_bloom_filter(size_type expected = 0, double fpp = 0.01,
+                                  const hasher_type& hash = hasher_type(),
+                                  const allocator_type& alloc =
+                                      allocator_type())
+        : hash_(hash), fpp_(fpp), words_(WordAlloc(alloc)) {
+        if (!(fpp > 0 && fpp < 1)) {
+            throw std::invalid_argument(
+                "blocked_bloom_filter needs a rate within (0, 1)");
+        }
+        reset(expected);
+    }
+
+    /// @brief Copies the bits. The copy's blocks are realigned to its own
+    /// allocation.
+    blocked_bloom_filter(const blocked_bloom_filter& other)
+        : hash_(other.hash_), fpp_(other.fpp_), capacity_(other.capacity_),
+          block_count_(other.block_count_),
+          words_(std::allocator_traits<WordAlloc>::
+                     select_on_container_copy_construction(
+                         other.words_.get_allocator())) {
+        words_.assign(other.words_.size(), 0);
+        std::memcpy(blocks(), other.blocks(), block_count_ * Block::kBytes);
+    }
+
+    blocked_bloom_filter(blocked_bloom_filter&&) = default;
+
+    blocked_bloom_filter& operator=(const blocked_bloom_filter& other) {
+        if (this != &other) {
+            blocked_bloom_filter tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    blocked_bloom_filter& operator=(blocked_bloom_filter&&) = default;
+
+    /// @brief Adds a key.
+    void insert(const key_type& key) {
+        insert_hash(hash_(key));
+    }
+
+    /// @brief Adds a key that was already hashed with `hasher_type`.
+    /// @return Always `true`; a Bloom filter never runs out of room, it only
+    /// gets less precise.
+    bool insert_hash(std::size_t hash) noexcept {
+        const std::uint64_t mixed = internal::Mix64(hash);
+        std::uint64_t* block = block_at(mixed);
+#if defined(HMM_AVX2)
+        __m256i lo;
+        __m256i hi;
+        masks(static_cast<std::uint32_t>(mixed), lo, hi);
+        auto* words = reinterpret_cast<__m256i*>(block);
+        _mm256_storeu_si256(
+            words, _mm256_or_si256(_mm256_loadu_si256(words), lo));
+        _mm256_storeu_si256(
+            words + 1, _mm256_or_si256(_mm256_loadu_si256(words + 1), hi));
+#else
+        std::uint64_t mask[Block::kWords];
+        masks(static_cast<std::uint32_t>(mixed), mask);
+        for (std::size_t i = 0; i < Block::kWords; ++i) {
+            block[i] |= mask[i];
+        }
+#endif
+        return true;
+    }
+
+    /// @brief Checks for a key.
+    /// @return `false` if the key was never inserted. `true` if it was, or,
+    /// with a probability of about the configured rate, if it was not.
+    HMM_NODISCARD bool contains(const key_type& key) const {
+        return contains_hash(hash_(key));
+    }
+
+    /// @brief Checks for a key that was already hashed with `hasher_type`.
+    HMM_NODISCARD bool contains_hash(std::size_t hash) const noexcept {
+        const std::uint64_t mixed = internal::Mix64(hash);
+        const std::uint64_t* block = block_at(mixed);
+#if defined(HMM_AVX2)
+        __m256i lo;
+        __m256i hi;
+        masks(static_cast<std::uint32_t>(mixed), lo, hi);
+        const auto* words = reinterpret_cast<const __m256i*>(block);
+        // testc is 1 when every bit of the mask is set in the block.
+        return _mm256_testc_si256(_mm256_loadu_si256(words), lo) &
+               _mm256_testc_si256(_mm256_loadu_si256(words + 1), hi);
+#elif defined(HMM_SSE2)
+        alignas(16) std::uint64_t mask[Block::kWords];
+        masks(static_cast<std::uint32_t>(mixed), mask);
+        __m128i missing = _mm_setzero_si128();
+        for (std::size_t i = 0; i < Block::kWords; i += 2) {
+            const __m128i m =
+                _mm_load_si128(reinterpret_cast<const __m128i*>(mask + i));
+            const __m128i b =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            missing = _mm_or_si128(missing, _mm_andnot_si128(b, m));
+        }
+        return _mm_movemask_epi8(
+                   _mm_cmpeq_epi8(missing, _mm_setzero_si128())) == 0xFFFF;
+#else
+        std::uint64_t mask[Block::kWords];
+        masks(static_cast<std::uint32_t>(mixed), mask);
+        for (std::size_t i = 0; i < Block::kWords; ++i) {
+            if ((block[i] & mask[i]) != mask[i]) {
+                return false;
+            }
+        }
+        return true;
+#endif
+    }
+
+    /// @brief Forgets every key, keeping the size.
+    void clear() noexcept {
+        std::uint64_t* first = blocks();
+        std::memset(first, 0, block_count_ * Block::kBytes);
+    }
+
+    /// @brief Forgets every key and resizes for `expected` keys at the
+    /// configured rate.
+    void reset(size_type expected) {
+        const double per_block = internal::BloomKeysPerBlock(fpp_);
+        const double wanted =
+            std::ceil(static_cast<double>(expected) / per_block);
+        if (wanted > 4294967296.0) {
+            throw std::length_error(
+                "blocked_bloom_filter exceeds 2^32 blocks");
+        }
+        block_count_ = wanted < 1 ? 1 : static_cast<size_type>(wanted);
+        capacity_ = expected;
+
+        // Seven spare words let the blocks start on a cache line boundary
+        // whatever the allocator's alignment.
+        words_.assign(block_count_ * Block::kWords + Block::kWords - 1, 0);
+    }
+
+    /// @brief The number of keys the filter was sized for.
+    HMM_NODISCARD size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    /// @brief The configured false positive rate.
+    HMM_NODISCARD double rate() const noexcept {
+        return fpp_;
+    }
+
+    /// @brief The number of 64-byte blocks.
+    HMM_NODISCARD size_type block_count() const noexcept {
+        return block_count_;
+    }
+
+    /// @brief The bytes allocated for the bit array.
+    HMM_NODISCARD size_type memory_usage() const noexcept {
+        return words_.capacity() * sizeof(std::uint64_t);
+    }
+
+    HMM_NODISCARD const hasher_type& hash_function() const noexcept {
+        return hash_;
+    }
+
+    HMM_NODISCARD allocator_type get_allocator() const {
+        return allocator_type(words_.get_allocator());
+    }
+
+  private:
+    /// @brief The first word of the cache-line aligned block array.
+    HMM_NODISCARD std::uint64_t* blocks() noexcept {
+        return const_cast<std::uint64_t*>(
+            static_cast<const blocked_bloom_filter*>(this)->blocks());
+    }
+
+    HMM_NODISCARD const std::uint64_t* blocks() const noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(words_.data());
+        const std::size_t skip =
+            ((Block::kBytes - address % Block::kBytes) % Block::kBytes) /
+            sizeof(std::uint64_t);
+        return words_.data() + skip;
+    }
+
+    HMM_NODISCARD std::uint64_t* block_at(std::uint64_t mixed) noexcept {
+        return blocks() + block_index(mixed) * Block::kWords;
+    }
+
+    HMM_NODISCARD const std::uint64_t*
+    block_at(std::uint64_t mixed) const noexcept {
+        return blocks() + block_index(mixed) * Block::kWords;
+    }
+
+    HMM_NODISCARD std::size_t block_index(std::uint64_t mixed) const noexcept {
+        return static_cast<std::size_t>(((mixed >> 32) * block_count_) >> 32);
+    }
+
+#if defined(HMM_AVX2)
+    /// @brief The bit to set in each word of the block, as two halves.
+    static void masks(std::uint32_t bits, __m256i& lo, __m256i& hi) noexcept {
+        const __m256i salts = _mm256_load_si256(
+            reinterpret_cast<const __m256i*>(internal::BloomSalts()));
+        const __m256i shifts = _mm256_srli_epi32(
+            _mm256_mullo_epi32(
+                _mm256_set1_epi32(static_cast<int>(bits)), salts),
+            26);
+        const __m256i one = _mm256_set1_epi64x(1);
+        lo = _mm256_sllv_epi64(
+            one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts)));
+        hi = _mm256_sllv_epi64(
+            one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1)));
+    }
+#else
+    /// @brief The bit to set in each word of the block.
+    static void masks(std::uint32_t bits, std::uint64_t* mask) noexcept {
+        const std::uint32_t* salts = internal::BloomSalts();
+        for (std::size_t i = 0; i < Block::kWords; ++i) {
+            mask[i] = std::uint64_t{1} << ((bits * salts[i]) >> 26);
+        }
+    }
+#endif
+
+    hasher_type hash_;
+    double fpp_;
+    size_type capacity_ = 0;
+    size_type block_count_ = 0;
+    std::vector<std::uint64_t, WordAlloc> words_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_BLOCKED_BLOOM_FILTER_HPP
@@ -17,9 +17,17 @@
 #ifndef HMM_CITY_HASH_HPP
 #define HMM_CITY_HASH_HPP
 
+#include <cstdint>
+#include <type_traits>
+
+#include "hmm/internal/city-hash-core.hpp"
 #include "hmm/internal/city-hash-mixers.hpp"
 #include "hmm/internal/macros.hpp"
 
+#if HMM_HAS_CXX_17
+#include <string_view>
+#endif
+
 namespace hmm {
 
 template <typename T> struct CityHash {
@@ -40,6 +48,39 @@ template <> struct CityHash<void> {
     }
 };
 
+/// @brief A CityHash functor usable in constant expressions, for tables built
+/// at compile time.
+///
+/// Supports integers, enums and, from C++17, `std::string_view`. On
+/// little-endian targets it returns the same values as `CityHash<T>`, and a
+/// `std::string_view` hashes like a `std::string` with the same contents.
+template <typename T, typename = void> struct ConstexprCityHash;
+
+template <typename T>
+struct ConstexprCityHash<
+    T, typename std::enable_if<std::is_integral<T>::value ||
+                               std::is_enum<T>::value>::type> {
+    HMM_CONSTEXPR_14 std::size_t operator()(const T& value) const {
+        // Lay the value out as the little-endian bytes CityHash<T> reads.
+        const auto bits = static_cast<std::uint64_t>(value);
+        char bytes[sizeof(T)] = {};
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+        }
+        return internal::CityHash64WithSeedCore(bytes, sizeof(T),
+                                                internal::k2);
+    }
+};
+
+#if HMM_HAS_CXX_17
+template <> struct ConstexprCityHash<std::string_view> {
+    constexpr std::size_t operator()(std::string_view value) const {
+        return internal::CityHash64WithSeedCore(value.data(), value.size(),
+                                                internal::k2);
+    }
+};
+#endif
+
 } // namespace hmm
 
 // ============================================================================
@@ -0,0 +1,193 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_CLOCK_CACHE_HPP
+#define HMM_HMM_CLOCK_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/cache-storage.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A fixed-capacity cache with CLOCK (second chance) eviction.
+///
+/// `clock_cache` approximates LRU with one reference bit per entry. A hit only
+/// sets the bit, so lookups write no list pointers. To evict, a hand sweeps
+/// the entry array: referenced entries lose their bit and are skipped, and the
+/// first unreferenced entry is replaced. New entries take the position just
+/// evicted, behind the hand, so they survive at least one full sweep.
+///
+/// Storage is the same as `lru_cache`: one entry array indexed by a SwissTable
+/// of 32-bit positions, with no allocation after construction.
+///
+/// @tparam Key The type of keys stored in the cache.
+/// @tparam Value The type of cached values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs> class clock_cache {
+    using Policy = MapPolicy<Key, Value>;
+
+  public:
+    using hasher_type = typename internal::detail::TypeAtIndexOrDefault<
+        0, typename Policy::default_hasher_type, TArgs...>::type;
+    using key_equal = typename internal::detail::TypeAtIndexOrDefault<
+        1, typename Policy::default_eq_type, TArgs...>::type;
+    using allocator_type = typename internal::detail::TypeAtIndexOrDefault<
+        2, typename Policy::default_allocator_type, TArgs...>::type;
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+
+  private:
+    /// @brief Each entry's bookkeeping is its reference bit.
+    using Storage = internal::CacheStorage<Key, Value, bool, hasher_type,
+                                           key_equal, allocator_type>;
+
+  public:
+    /// @brief Constructs an empty cache holding up to `capacity` entries.
+    /// @throws std::length_error If `capacity` exceeds 2^32 - 2 entries.
+    explicit clock_cache(size_type capacity,
+                         const hasher_type& hash = hasher_type(),
+                         const key_equal& eq = key_equal(),
+                         const allocator_type& alloc = allocator_type())
+        : storage_(capacity, hash, eq, alloc) {}
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return storage_.size();
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// @brief The maximum number of entries held at once.
+    HMM_NODISCARD size_type capacity() const noexcept {
+        return storage_.capacity();
+    }
+
+    /// @brief Looks up `key`, setting its reference bit.
+    /// @return A pointer to the cached value, or `nullptr` on a miss. It
+    /// stays valid until the entry is evicted or erased.
+    template <class K> HMM_NODISCARD mapped_type* get(const K& key) {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return nullptr;
+        }
+        auto& entry = storage_.entry(position);
+        entry.meta = true;
+        return &entry.value.second;
+    }
+
+    /// @brief Looks up `key` without setting its reference bit.
+    template <class K>
+    HMM_NODISCARD const mapped_type* peek(const K& key) const {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return nullptr;
+        }
+        return &storage_.entry(position).value.second;
+    }
+
+    /// @brief Checks if `key` is cached, without setting its reference bit.
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return storage_.find(key) != Storage::kNone;
+    }
+
+    /// @brief Caches `value` under `key`, or assigns it and sets the
+    /// reference bit if `key` is present. When the cache is full, the hand
+    /// first evicts an unreferenced entry.
+    /// @return `true` if a new entry was inserted.
+    template <class K, class V> bool put(K&& key, V&& value) {
+        if (capacity() == 0) {
+            return false;
+        }
+        auto info = storage_.prepare(key);
+        if (info.found) {
+            auto& entry = storage_.entry(storage_.position(info));
+            entry.value.second = std::forward<V>(value);
+            entry.meta = true;
+            return false;
+        }
+        if (size() == capacity()) {
+            storage_.erase(sweep());
+        }
+        storage_.emplace_prepared(info, std::forward<K>(key),
+                                  std::forward<V>(value));
+        return true;
+    }
+
+    /// @brief Removes `key` from the cache.
+    /// @return `true` if an entry was removed.
+    template <class K> bool erase(const K& key) {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return false;
+        }
+        storage_.erase(position);
+        return true;
+    }
+
+    /// @brief Removes every entry, keeping all buffers.
+    void clear() {
+        storage_.clear();
+        hand_ = 0;
+    }
+
+    /// @brief Invokes `f(const value_type&)` on every entry, in storage
+    /// order.
+    template <class F> void for_each(F&& f) const {
+        for (size_type i = 0; i < capacity(); ++i) {
+            const auto& entry = storage_.entry(static_cast<std::uint32_t>(i));
+            if (entry.live) {
+                f(static_cast<const value_type&>(entry.value));
+            }
+        }
+    }
+
+  private:
+    /// @brief Advances the hand to the first unreferenced entry, clearing
+    /// the bits it passes, and returns its position. The cache must be full.
+    std::uint32_t sweep() {
+        while (true) {
+            const auto position = hand_;
+            hand_ = hand_ + 1 == capacity() ? 0 : hand_ + 1;
+            auto& entry = storage_.entry(position);
+            if (!entry.meta) {
+                return position;
+            }
+            entry.meta = false;
+        }
+    }
+
+    Storage storage_;
+    std::uint32_t hand_ = 0;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_CLOCK_CACHE_HPP
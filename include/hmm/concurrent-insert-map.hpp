@@ -0,0 +1,124 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_CONCURRENT_INSERT_MAP_HPP
+#define HMM_HMM_CONCURRENT_INSERT_MAP_HPP
+
+#include <tuple>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/concurrent-insert-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A flat hash map that many threads may insert into at once.
+///
+/// `concurrent_insert_map` is the map counterpart of `concurrent_insert_set`.
+/// Insertions never lock, and exactly one of several concurrent insertions
+/// under equal keys succeeds. Elements never move while threads insert, so
+/// the returned pointers to mapped values stay valid until `reserve` or
+/// `clear`. Synchronizing writes to mapped values themselves (e.g. by
+/// mapping to atomics) is left to the caller.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs>
+class concurrent_insert_map
+    : protected internal::concurrent_insert_table<MapPolicy<Key, Value>,
+                                                  TArgs...> {
+    using Base =
+        internal::concurrent_insert_table<MapPolicy<Key, Value>, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using mapped_type = Value;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using slot_type = typename Base::slot_type;
+    using allocator_type = typename Base::allocator_type;
+
+    /// @brief Constructs a map with room for `count` elements.
+    explicit concurrent_insert_map(
+        size_type count = 0, const hasher_type& hash = hasher_type(),
+        const key_equal& eq = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : Base(count, hash, eq, alloc) {}
+
+    /// @name Thread-Safe Operations
+    ///@{
+    using Base::capacity;
+    using Base::empty;
+    using Base::size;
+
+    /// @brief Inserts a copy of `value` if its key is not present.
+    /// @return `true` if this call inserted the element.
+    /// @throws std::length_error If the map has run out of room.
+    bool insert(const value_type& value) {
+        return try_emplace(value.first, value.second).second;
+    }
+
+    /// @brief Constructs the mapped value from `args` if `key` is not
+    /// present.
+    /// @return A pointer to the mapped value under `key`, and whether this
+    /// call inserted it.
+    template <class K, class... Args>
+    std::pair<mapped_type*, bool> try_emplace(K&& key, Args&&... args) {
+        const key_type& k = key;
+        auto result = Base::emplace_key(
+            k, std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        return {&result.first->second, result.second};
+    }
+
+    /// @brief Locates the mapped value under `key`.
+    /// @return A pointer to the value, or `nullptr` if `key` is absent.
+    template <class K>
+    HMM_NODISCARD const mapped_type* find(const K& key) const {
+        const slot_type* slot = Base::find_slot(key);
+        return slot ? &slot->second : nullptr;
+    }
+
+    /// @brief Checks if an element with `key` is present.
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return Base::find_slot(key) != nullptr;
+    }
+
+    /// @brief Invokes `f(const value_type&)` on every inserted element.
+    using Base::for_each;
+    ///@}
+
+    /// @name Exclusive Operations
+    /// These must not run concurrently with any other operation.
+    ///@{
+    using Base::clear;
+    using Base::reserve;
+    ///@}
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_CONCURRENT_INSERT_MAP_HPP
@@ -0,0 +1,122 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_CONCURRENT_INSERT_SET_HPP
+#define HMM_HMM_CONCURRENT_INSERT_SET_HPP
+
+#include <utility>
+
+#include "hmm/flat-hash-set.hpp"
+#include "hmm/internal/concurrent-insert-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A flat hash set that many threads may insert into at once.
+///
+/// `concurrent_insert_set` suits parallel builds and deduplication: threads
+/// insert without locks, each claiming a slot by compare-and-swapping its
+/// control byte. Exactly one of several concurrent insertions of equal
+/// elements succeeds. Elements cannot be erased, and the capacity is fixed
+/// while threads insert; size the set up front or call `reserve` between
+/// parallel phases.
+///
+/// @tparam Contained The type of elements stored in the set.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Contained>`)
+///               2. Equality functor (Defaults to `std::equal_to<Contained>`)
+///               3. Allocator (Defaults to `std::allocator<Contained>`)
+template <class Contained, class... TArgs>
+class concurrent_insert_set
+    : protected internal::concurrent_insert_table<SetPolicy<Contained>,
+                                                  TArgs...> {
+    using Base =
+        internal::concurrent_insert_table<SetPolicy<Contained>, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using slot_type = typename Base::slot_type;
+    using allocator_type = typename Base::allocator_type;
+
+    /// @brief Constructs a set with room for `count` elements.
+    explicit concurrent_insert_set(
+        size_type count = 0, const hasher_type& hash = hasher_type(),
+        const key_equal& eq = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : Base(count, hash, eq, alloc) {}
+
+    /// @name Thread-Safe Operations
+    ///@{
+    using Base::capacity;
+    using Base::empty;
+    using Base::size;
+
+    /// @brief Inserts a copy of `value` if it is not present.
+    /// @return `true` if this call inserted the element.
+    /// @throws std::length_error If the set has run out of room.
+    bool insert(const value_type& value) {
+        return emplace_value(value);
+    }
+
+    /// @brief Inserts `value` via move semantics if it is not present.
+    /// @return `true` if this call inserted the element.
+    bool insert(value_type&& value) {
+        return emplace_value(std::move(value));
+    }
+
+    /// @brief Constructs an element from `args`, inserting it if it is not
+    /// present.
+    /// @return `true` if this call inserted the element.
+    template <class... Args> bool emplace(Args&&... args) {
+        return emplace_value(value_type(std::forward<Args>(args)...));
+    }
+
+    /// @brief Checks if an element equal to `key` is present.
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return Base::find_slot(key) != nullptr;
+    }
+
+    /// @brief Counts the elements equal to `key` (0 or 1).
+    template <class K> HMM_NODISCARD size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    /// @brief Invokes `f(const value_type&)` on every inserted element.
+    using Base::for_each;
+    ///@}
+
+    /// @name Exclusive Operations
+    /// These must not run concurrently with any other operation.
+    ///@{
+    using Base::clear;
+    using Base::reserve;
+    ///@}
+
+  private:
+    template <class V> bool emplace_value(V&& value) {
+        const value_type& key = value;
+        return Base::emplace_key(key, std::forward<V>(value)).second;
+    }
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_CONCURRENT_INSERT_SET_HPP
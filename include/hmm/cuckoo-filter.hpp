@@ -0,0 +1,332 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_CUCKOO_FILTER_HPP
+#define HMM_HMM_CUCKOO_FILTER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "hmm/city-hash.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/hash-mix.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Spreads a fingerprint across 64 bits, one copy per 16-bit lane.
+constexpr std::uint64_t kCuckooLanes = 0x0001000100010001ULL;
+
+/// @brief Checks whether any 16-bit lane of `bucket` equals `fp`, four lanes
+/// at a time.
+HMM_NODISCARD constexpr bool CuckooBucketHas(std::uint64_t bucket,
+                                             std::uint16_t fp) noexcept {
+    // The classic "has zero lane" test, applied to the XOR with the
+    // fingerprint broadcast to every lane.
+    return (((bucket ^ (fp * kCuckooLanes)) - kCuckooLanes) &
+            ~(bucket ^ (fp * kCuckooLanes)) & (kCuckooLanes << 15)) != 0;
+}
+
+} // namespace internal
+
+/// @brief A cuckoo filter: a probabilistic set, like a Bloom filter, that
+/// also supports removing keys.
+///
+/// The filter stores a 16-bit fingerprint of each key in one of two buckets of
+/// four. The two buckets are the key's home and the home XOR a hash of the
+/// fingerprint, so either can be found again from the fingerprint alone. When
+/// both are full an insertion evicts a resident fingerprint to its other
+/// bucket, and so on, up to `kMaxKicks` times. A lookup reads two 8-byte
+/// buckets and tests all four lanes of each with a few word operations. At
+/// up to 95% occupancy the false positive rate is about 2^-13.
+///
+/// Keys are hashed with the same functors as the tables, so a key hashed once
+/// can be checked here and then probed for in a table. See `filtered_table`.
+///
+/// Only remove keys that were inserted: removing anything else may remove a
+/// colliding key's fingerprint and cause a false negative.
+///
+/// @tparam T The type of the keys.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<T>`)
+///               2. Allocator (Defaults to `std::allocator<T>`)
+template <class T, class... TArgs> class cuckoo_filter {
+  public:
+    using key_type = T;
+    using hasher_type =
+        typename internal::detail::TypeAtIndexOrDefault<0, CityHash<T>,
+                                                        TArgs...>::type;
+    using allocator_type =
+        typename internal::detail::TypeAtIndexOrDefault<1, std::allocator<T>,
+                                                        TArgs...>::type;
+    using size_type = std::size_t;
+
+    /// @brief The filter can forget keys.
+    static constexpr bool supports_erase = true;
+
+    /// @brief Fingerprints per bucket.
+    static constexpr std::size_t kBucketSize = 4;
+
+    /// @brief Evictions tried before an insertion gives up.
+    static constexpr std::size_t kMaxKicks = 500;
+
+  private:
+    using BucketAlloc = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<std::uint64_t>;
+
+    /// @brief A fingerprint that was evicted and had nowhere to go. It keeps
+    /// answering lookups while the filter reports itself full.
+    struct Victim {
+        std::size_t index = 0;
+        std::uint16_t fp = 0;
+        bool used = false;
+    };
+
+  public:
+    /// @brief Builds an empty filter with room for at least `expected` keys.
+    /// @throws std::length_error If the bucket count would overflow.
+    explicit cuckoo_filter(size_type expected = 0,
+                           const hasher_type& hash = hasher_type(),
+                           const allocator_type& alloc = allocator_type())
+        : hash_(hash), buckets_(BucketAlloc(alloc)) {
+        reset(expected);
+    }
+
+    /// @brief Adds a key.
+    /// @return `false` if the filter is full; it is left unchanged and the
+    /// key is not added.
+    bool insert(const key_type& key) {
+        return insert_hash(hash_(key));
+    }
+
+    /// @brief Adds a key that was already hashed with `hasher_type`.
+    /// @return `false` if the filter is full; the key is not added.
+    bool insert_hash(std::size_t hash) noexcept {
+        if (victim_.used) {
+            return false;
+        }
+        const std::uint64_t mixed = internal::Mix64(hash);
+        insert_fingerprint(home(mixed), fingerprint(mixed));
+        return true;
+    }
+
+    /// @brief Checks for a key.
+    /// @return `false` if the key is absent. `true` if it is present or,
+    /// rarely, if a different key has the same fingerprint and bucket.
+    HMM_NODISCARD bool contains(const key_type& key) const {
+        return contains_hash(hash_(key));
+    }
+
+    /// @brief Checks for a key that was already hashed with `hasher_type`.
+    HMM_NODISCARD bool contains_hash(std::size_t hash) const noexcept {
+        const std::uint64_t mixed = internal::Mix64(hash);
+        const std::uint16_t fp = fingerprint(mixed);
+        const std::size_t index = home(mixed);
+        const std::size_t alt = alternate(index, fp);
+        if (internal::CuckooBucketHas(buckets_[index], fp) ||
+            internal::CuckooBucketHas(buckets_[alt], fp)) {
+            return true;
+        }
+        return victim_.used && victim_.fp == fp &&
+               (victim_.index == index || victim_.index == alt);
+    }
+
+    /// @brief Removes one copy of a key that was inserted.
+    /// @return `false` if no matching fingerprint was found.
+    bool erase(const key_type& key) {
+        return erase_hash(hash_(key));
+    }
+
+    /// @brief Removes one copy of a key that was already hashed with
+    /// `hasher_type`.
+    bool erase_hash(std::size_t hash) noexcept {
+        const std::uint64_t mixed = internal::Mix64(hash);
+        const std::uint16_t fp = fingerprint(mixed);
+        const std::size_t index = home(mixed);
+        const std::size_t alt = alternate(index, fp);
+        if (victim_.used && victim_.fp == fp &&
+            (victim_.index == index || victim_.index == alt)) {
+            victim_.used = false;
+            --size_;
+            return true;
+        }
+        if (!remove(index, fp) && !remove(alt, fp)) {
+            return false;
+        }
+        --size_;
+
+        // A lane is free again: give the victim another chance.
+        if (victim_.used) {
+            victim_.used = false;
+            --size_;
+            insert_fingerprint(victim_.index, victim_.fp);
+        }
+        return true;
+    }
+
+    /// @brief Forgets every key, keeping the size.
+    void clear() noexcept {
+        std::fill(buckets_.begin(), buckets_.end(), 0);
+        size_ = 0;
+        victim_ = Victim();
+    }
+
+    /// @brief Forgets every key and resizes for `expected` keys.
+    void reset(size_type expected) {
+        // Size for 95% occupancy, rounded up to a power of two buckets.
+        const size_type wanted = expected + expected / 19 + 1;
+        size_type buckets = 1;
+        while (buckets * kBucketSize < wanted) {
+            if (buckets > buckets_.max_size() / 2) {
+                throw std::length_error("cuckoo_filter is too large");
+            }
+            buckets *= 2;
+        }
+        buckets_.assign(buckets, 0);
+        size_ = 0;
+        victim_ = Victim();
+    }
+
+    /// @brief The number of keys held.
+    HMM_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /// @brief The number of keys the filter can hold at 95% occupancy.
+    HMM_NODISCARD size_type capacity() const noexcept {
+        const size_type lanes = buckets_.size() * kBucketSize;
+        return lanes - lanes / 20;
+    }
+
+    HMM_NODISCARD size_type bucket_count() const noexcept {
+        return buckets_.size();
+    }
+
+    /// @brief The bytes allocated for the buckets.
+    HMM_NODISCARD size_type memory_usage() const noexcept {
+        return buckets_.capacity() * sizeof(std::uint64_t);
+    }
+
+    HMM_NODISCARD const hasher_type& hash_function() const noexcept {
+        return hash_;
+    }
+
+    HMM_NODISCARD allocator_type get_allocator() const {
+        return allocator_type(buckets_.get_allocator());
+    }
+
+  private:
+    /// @brief The top 16 bits of the mixed hash. Zero marks an empty lane, so
+    /// it is remapped.
+    HMM_NODISCARD static std::uint16_t
+    fingerprint(std::uint64_t mixed) noexcept {
+        const auto fp = static_cast<std::uint16_t>(mixed >> 48);
+        return fp == 0 ? 1 : fp;
+    }
+
+    HMM_NODISCARD std::size_t home(std::uint64_t mixed) const noexcept {
+        return static_cast<std::size_t>(mixed) & (buckets_.size() - 1);
+    }
+
+    /// @brief The other bucket of a fingerprint. Applying it twice returns
+    /// the original bucket.
+    HMM_NODISCARD std::size_t alternate(std::size_t index,
+                                        std::uint16_t fp) const noexcept {
+        return (index ^ static_cast<std::size_t>(fp * 0x5bd1e995ULL)) &
+               (buckets_.size() - 1);
+    }
+
+    HMM_NODISCARD std::uint16_t lane_at(std::size_t index,
+                                        std::size_t lane) const noexcept {
+        return static_cast<std::uint16_t>(buckets_[index] >> (lane * 16));
+    }
+
+    void set_lane(std::size_t index, std::size_t lane,
+                  std::uint16_t fp) noexcept {
+        const std::size_t shift = lane * 16;
+        const std::uint64_t keep = ~(std::uint64_t{0xFFFF} << shift);
+        buckets_[index] =
+            (buckets_[index] & keep) | (std::uint64_t{fp} << shift);
+    }
+
+    /// @brief Stores `fp` in a free lane of a bucket, if there is one.
+    bool place(std::size_t index, std::uint16_t fp) noexcept {
+        if (!internal::CuckooBucketHas(buckets_[index], 0)) {
+            return false;
+        }
+        for (std::size_t lane = 0; lane < kBucketSize; ++lane) {
+            if (lane_at(index, lane) == 0) {
+                set_lane(index, lane, fp);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Clears one lane of a bucket holding `fp`, if there is one.
+    bool remove(std::size_t index, std::uint16_t fp) noexcept {
+        for (std::size_t lane = 0; lane < kBucketSize; ++lane) {
+            if (lane_at(index, lane) == fp) {
+                set_lane(index, lane, 0);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Stores a fingerprint in one of its two buckets, evicting
+    /// residents to their other bucket as needed. The last fingerprint
+    /// evicted becomes the victim if the chain grows too long.
+    void insert_fingerprint(std::size_t index, std::uint16_t fp) noexcept {
+        if (place(index, fp) || place(alternate(index, fp), fp)) {
+            ++size_;
+            return;
+        }
+        for (std::size_t kick = 0; kick < kMaxKicks; ++kick) {
+            const std::size_t lane = (fp + kick) % kBucketSize;
+            const std::uint16_t evicted = lane_at(index, lane);
+            set_lane(index, lane, fp);
+            fp = evicted;
+            index = alternate(index, fp);
+            if (place(index, fp)) {
+                ++size_;
+                return;
+            }
+        }
+        victim_.index = index;
+        victim_.fp = fp;
+        victim_.used = true;
+        ++size_;
+    }
+
+    hasher_type hash_;
+    std::vector<std::uint64_t, BucketAlloc> buckets_;
+    size_type size_ = 0;
+    Victim victim_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_CUCKOO_FILTER_HPP
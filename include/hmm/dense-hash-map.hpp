@@ -0,0 +1,509 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_DENSE_HASH_MAP_HPP
+#define HMM_HMM_DENSE_HASH_MAP_HPP
+
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/index-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief An insertion-ordered hash map storing its entries densely.
+///
+/// `dense_hash_map` keeps every `std::pair<Key, Value>` contiguously in a
+/// vector, in insertion order. Lookups go through a SwissTable of 32-bit
+/// indices into that vector, so probing retains the SIMD metadata scan of
+/// `flat_hash_map` while iteration becomes a linear scan with no holes.
+///
+/// Erasure moves the last entry into the erased position, so insertion order
+/// is only preserved for maps that are never erased from. Entries whose move
+/// may throw must be move assignable.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs> class dense_hash_map {
+    using Policy = MapPolicy<Key, Value>;
+
+  public:
+    using policy_type = Policy;
+    using hasher_type = typename internal::detail::TypeAtIndexOrDefault<
+        0, typename policy_type::default_hasher_type, TArgs...>::type;
+    using key_equal = typename internal::detail::TypeAtIndexOrDefault<
+        1, typename policy_type::default_eq_type, TArgs...>::type;
+    using key_type = typename policy_type::key_type;
+    using mapped_type = typename policy_type::mapped_type;
+    using value_type = typename policy_type::value_type;
+    using slot_type = typename policy_type::slot_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+  private:
+    using provided_allocator_type =
+        typename internal::detail::TypeAtIndexOrDefault<
+            2, typename policy_type::default_allocator_type, TArgs...>::type;
+
+  public:
+    using allocator_type = typename std::allocator_traits<
+        provided_allocator_type>::template rebind_alloc<slot_type>;
+
+  private:
+    using Entries = std::vector<slot_type, allocator_type>;
+    using Index = internal::index_table<dense_hash_map, hasher_type, key_equal,
+                                        allocator_type>;
+    using IndexHasher = internal::IndexHasher<dense_hash_map, hasher_type>;
+    using IndexEq = internal::IndexEq<dense_hash_map, key_equal>;
+
+    template <class, class> friend class internal::IndexHasher;
+    template <class, class> friend class internal::IndexEq;
+
+  public:
+    /// @brief Iterator over the dense entry vector.
+    /// @tparam Traits Differentiates between const and mutable iterators.
+    template <typename Traits> class BasicIterator {
+        friend dense_hash_map;
+        template <typename> friend class BasicIterator;
+
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename dense_hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer =
+            typename std::conditional<Traits::is_const, const value_type*,
+                                      value_type*>::type;
+        using reference =
+            typename std::conditional<Traits::is_const, const value_type&,
+                                      value_type&>::type;
+
+        constexpr BasicIterator() = default;
+
+        /// @brief Implicitly converts a mutable iterator to a const iterator.
+        template <typename OtherTraits,
+                  typename = typename std::enable_if<(!OtherTraits::is_const ||
+                                                      (Traits::is_const &&
+                                                       OtherTraits::is_const)),
+                                                     void>::type>
+        constexpr BasicIterator(const BasicIterator<OtherTraits>& other)
+            : slot_(other.slot_) {}
+
+        HMM_NODISCARD reference operator*() const {
+            return policy_type::value_from_slot(*slot_);
+        }
+
+        HMM_NODISCARD pointer operator->() const {
+            return std::addressof(operator*());
+        }
+
+        HMM_CONSTEXPR_14 BasicIterator& operator++() noexcept {
+            ++slot_;
+            return *this;
+        }
+
+        HMM_CONSTEXPR_14 BasicIterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        HMM_CONSTEXPR_14 BasicIterator& operator--() noexcept {
+            --slot_;
+            return *this;
+        }
+
+        HMM_CONSTEXPR_14 BasicIterator operator--(int) noexcept {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        HMM_NODISCARD constexpr bool
+        operator==(const BasicIterator& b) const noexcept {
+            return slot_ == b.slot_;
+        }
+        HMM_NODISCARD constexpr bool
+        operator!=(const BasicIterator& b) const noexcept {
+            return !this->operator==(b);
+        }
+
+      private:
+        constexpr explicit BasicIterator(slot_type* slot) : slot_(slot) {}
+
+        slot_type* slot_ = nullptr;
+    };
+
+    struct NormalIteratorTraits {
+        static constexpr bool is_const = false;
+    };
+
+    struct ConstIteratorTraits {
+        static constexpr bool is_const = true;
+    };
+
+    using iterator = BasicIterator<NormalIteratorTraits>;
+    using const_iterator = BasicIterator<ConstIteratorTraits>;
+
+    /// @brief Default constructs an empty dense hash map.
+    dense_hash_map() : dense_hash_map(allocator_type()) {}
+
+    /// @brief Constructs an empty map utilizing a specific allocator.
+    /// @param alloc The allocator instance.
+    explicit dense_hash_map(const allocator_type& alloc)
+        : entries_(alloc), index_(IndexHasher(this, hasher_type{}),
+                                  IndexEq(this, key_equal{}), alloc) {}
+
+    /// @brief Constructs the map with the contents of an initializer list.
+    /// @param initial The std::initializer_list of key-value pairs.
+    /// @param alloc The allocator instance to use.
+    dense_hash_map(std::initializer_list<slot_type> initial,
+                   const allocator_type& alloc = allocator_type())
+        : dense_hash_map(initial.begin(), initial.end(), alloc) {}
+
+    /// @brief Constructs the map with the contents of a range.
+    /// @param begin The beginning of the range.
+    /// @param end The end of the range.
+    /// @param alloc The allocator instance to use.
+    template <class Iter, class Sentinel>
+    dense_hash_map(Iter begin, Sentinel end,
+                   const allocator_type& alloc = allocator_type())
+        : dense_hash_map(alloc) {
+        insert(begin, end);
+    }
+
+    /// @brief Copy-constructs the map. Indices are copied as-is, since they
+    /// remain valid against the copied entries.
+    dense_hash_map(const dense_hash_map& other)
+        : entries_(other.entries_), index_(other.index_) {
+        rebind();
+    }
+
+    /// @brief Move-constructs the map, transferring both buffers.
+    dense_hash_map(dense_hash_map&& other) noexcept
+        : entries_(std::move(other.entries_)), index_(std::move(other.index_)) {
+        rebind();
+        other.entries_.clear();
+    }
+
+    dense_hash_map& operator=(const dense_hash_map& other) {
+        if (this != &other) {
+            dense_hash_map tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    dense_hash_map& operator=(dense_hash_map&& other) noexcept {
+        if (this != &other) {
+            entries_ = std::move(other.entries_);
+            index_ = std::move(other.index_);
+            rebind();
+            other.entries_.clear();
+        }
+        return *this;
+    }
+
+    /// @name Iteration
+    /// Iteration walks the entry vector, in insertion order.
+    ///@{
+    HMM_NODISCARD iterator begin() noexcept {
+        return iterator(entries_.data());
+    }
+    HMM_NODISCARD const_iterator begin() const noexcept {
+        return const_iterator(const_cast<slot_type*>(entries_.data()));
+    }
+    HMM_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    HMM_NODISCARD iterator end() noexcept {
+        return iterator(entries_.data() + entries_.size());
+    }
+    HMM_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(
+            const_cast<slot_type*>(entries_.data() + entries_.size()));
+    }
+    HMM_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+    ///@}
+
+    /// @brief Retrieves the number of entries in the map.
+    HMM_NODISCARD size_type size() const noexcept {
+        return entries_.size();
+    }
+
+    /// @brief Checks if the map has no entries.
+    HMM_NODISCARD bool empty() const noexcept {
+        return entries_.empty();
+    }
+
+    /// @brief Retrieves the number of slots in the index table.
+    HMM_NODISCARD size_type capacity() const noexcept {
+        return index_.capacity();
+    }
+
+    /// @brief Destroys all entries, keeping both buffers allocated.
+    void clear() {
+        index_.clear();
+        entries_.clear();
+    }
+
+    /// @brief Reserves room for `count` entries in both the entry vector and
+    /// the index table.
+    void reserve(size_type count) {
+        entries_.reserve(count);
+        index_.reserve(count);
+    }
+
+    /// @brief Finds the entry with the specified key.
+    /// @return An iterator to the entry, or `end()` if not found.
+    template <class K = key_type>
+    HMM_NODISCARD iterator find(const K& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return end();
+        }
+        return iterator(entries_.data() + it->index);
+    }
+
+    /// @brief Finds the entry with the specified key (const context).
+    template <class K = key_type>
+    HMM_NODISCARD const_iterator find(const K& key) const {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return end();
+        }
+        return const_iterator(
+            const_cast<slot_type*>(entries_.data() + it->index));
+    }
+
+    /// @brief Checks if an entry with the specified key exists.
+    template <class K = key_type>
+    HMM_NODISCARD bool contains(const K& key) const {
+        return index_.find(key) != index_.end();
+    }
+
+    /// @brief Inserts a key-value pair if its key does not already exist.
+    std::pair<iterator, bool> insert(const slot_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    /// @brief Inserts a key-value pair via move semantics if its key does not
+    /// already exist.
+    std::pair<iterator, bool> insert(slot_type&& value) {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    /// @brief Inserts a range of key-value pairs.
+    template <class InputIt> void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    /// @brief Constructs an entry in-place at the back of the entry vector,
+    /// discarding it if its key already exists.
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        check_index_space();
+        // Grow the index first, so that only the entry needs rolling back.
+        if (index_.needs_resize()) {
+            index_.rehash_and_grow();
+        }
+        entries_.emplace_back(std::forward<Args>(args)...);
+
+        typename Index::FindInfo info;
+        try {
+            info = index_.find_or_prepare_insert(entries_.back().first);
+        } catch (...) {
+            entries_.pop_back();
+            throw;
+        }
+        if (info.found) {
+            entries_.pop_back();
+            return {iterator(entries_.data() +
+                             index_.slots_ptr()[info.index].index),
+                    false};
+        }
+
+        const auto position = static_cast<std::uint32_t>(entries_.size() - 1);
+        index_.insert_at_index(info.index, info.full_hash,
+                               internal::IndexSlot{position});
+        return {iterator(entries_.data() + position), true};
+    }
+
+    /// @brief Appends an entry only if the provided key does not already
+    /// exist. If it does, no arguments are moved from.
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        auto info = index_.find_or_prepare_insert(key);
+        if (info.found) {
+            return {iterator(entries_.data() +
+                             index_.slots_ptr()[info.index].index),
+                    false};
+        }
+
+        check_index_space();
+        if (index_.needs_resize()) {
+            index_.rehash_and_grow();
+            info = index_.find_or_prepare_insert(key);
+        }
+
+        entries_.emplace_back(
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+
+        const auto position = static_cast<std::uint32_t>(entries_.size() - 1);
+        index_.insert_at_index(info.index, info.full_hash,
+                               internal::IndexSlot{position});
+        return {iterator(entries_.data() + position), true};
+    }
+
+    /// @brief Erases the entry at the specified position.
+    /// @details The last entry is moved into the vacated position.
+    /// @return An iterator to the entry that now occupies `pos`.
+    iterator erase(const_iterator pos) {
+        const auto position =
+            static_cast<std::uint32_t>(pos.slot_ - entries_.data());
+        index_.erase(index_.find(internal::IndexSlot{position}));
+        remove_entry(position);
+        return iterator(entries_.data() + position);
+    }
+
+    /// @brief Erases the entry matching the provided key.
+    /// @return 1 if an entry was erased, 0 otherwise.
+    size_type erase(const key_type& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return 0;
+        }
+        const auto position = it->index;
+        index_.erase(it);
+        remove_entry(position);
+        return 1;
+    }
+
+    /// @brief Accesses or inserts a value associated with the given key.
+    HMM_NODISCARD mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    HMM_NODISCARD mapped_type& operator[](key_type&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    /// @brief Accesses the mapped value associated with the given key, with
+    /// bounds checking.
+    /// @throws std::out_of_range If the requested key does not exist within the
+    /// container.
+    HMM_NODISCARD mapped_type& at(const key_type& key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("dense_hash_map::at");
+        }
+        return it->second;
+    }
+
+    /// @brief Accesses the mapped value associated with the given key, with
+    /// bounds checking (const context).
+    /// @throws std::out_of_range If the requested key does not exist within the
+    /// container.
+    HMM_NODISCARD const mapped_type& at(const key_type& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("dense_hash_map::at");
+        }
+        return it->second;
+    }
+
+    HMM_NODISCARD allocator_type get_allocator() const {
+        return entries_.get_allocator();
+    }
+
+  private:
+    /// @brief Resolves an index back to its key for the index table.
+    HMM_NODISCARD const key_type& key_at(std::uint32_t position) const {
+        return entries_[position].first;
+    }
+
+    /// @brief Re-points the index table's functors at this instance.
+    void rebind() noexcept {
+        index_.hasher().rebind(this);
+        index_.equal().rebind(this);
+    }
+
+    /// @brief Ensures another entry remains addressable by a 32-bit index.
+    void check_index_space() const {
+        if (entries_.size() >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("dense_hash_map exceeds 2^32 - 1 entries");
+        }
+    }
+
+    /// @brief Removes an entry whose index has already been erased, filling
+    /// the hole with the last entry.
+    /// @details The last entry is re-indexed only once it has moved, so a
+    /// throwing move leaves every entry alive and the last one still indexed.
+    void remove_entry(std::uint32_t position) {
+        const auto last = static_cast<std::uint32_t>(entries_.size() - 1);
+        if (position != last) {
+            auto moved = index_.find(internal::IndexSlot{last});
+            move_entry(position, last,
+                       std::is_nothrow_move_constructible<slot_type>());
+            moved->index = position;
+        }
+        entries_.pop_back();
+    }
+
+    /// @brief Relocates rather than assigns when that cannot throw, so that
+    /// values need not be assignable.
+    void move_entry(std::uint32_t to, std::uint32_t from,
+                    std::true_type /* nothrow */) noexcept {
+        auto alloc = entries_.get_allocator();
+        using traits = std::allocator_traits<allocator_type>;
+        traits::destroy(alloc, &entries_[to]);
+        traits::construct(alloc, &entries_[to], std::move(entries_[from]));
+    }
+
+    /// @brief Otherwise assigns, so that a throw leaves the target alive.
+    void move_entry(std::uint32_t to, std::uint32_t from,
+                    std::false_type /* nothrow */) {
+        entries_[to] = std::move(entries_[from]);
+    }
+
+    Entries entries_;
+    Index index_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_DENSE_HASH_MAP_HPP
@@ -0,0 +1,149 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_EXECUTOR_HPP
+#define HMM_HMM_EXECUTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief The built-in executor for the parallel operations of the tables.
+///
+/// Any type providing the same two members may be passed instead, to run the
+/// work on an existing thread pool:
+///
+/// - `std::size_t concurrency() const`: the number of tasks worth running
+///   at once.
+/// - `void parallel_for(std::size_t n, F&& f)`: invokes `f(i)` for every
+///   `i` in `[0, n)`, possibly concurrently, and returns once all calls
+///   have. An exception thrown by any call is rethrown.
+///
+/// `thread_executor` starts its workers for each `parallel_for` and hands out
+/// indices dynamically, with the calling thread taking part in the work. If
+/// a worker cannot be started, the work runs on the threads that could.
+class thread_executor {
+  public:
+    /// @brief Constructs an executor running up to `threads` threads,
+    /// defaulting to the hardware concurrency.
+    explicit thread_executor(
+        std::size_t threads = std::thread::hardware_concurrency())
+        : threads_(threads == 0 ? 1 : threads) {}
+
+    HMM_NODISCARD std::size_t concurrency() const noexcept {
+        return threads_;
+    }
+
+    /// @brief Invokes `f(i)` for every `i` in `[0, n)` across the threads.
+    template <class F> void parallel_for(std::size_t n, F&& f) const {
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto work = [&] {
+            try {
+                for (std::size_t i = next++; i < n; i = next++) {
+                    f(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                // Drain the remaining indices so that every worker stops.
+                next = n;
+            }
+        };
+
+        const std::size_t helpers = (threads_ < n ? threads_ : n) - (n != 0);
+        std::vector<std::thread> workers;
+        workers.reserve(helpers);
+        try {
+            for (std::size_t t = 0; t < helpers; ++t) {
+                workers.emplace_back(work);
+            }
+        } catch (...) {
+            // Out of threads: the ones already running and this one take
+            // all the indices instead, and must be joined either way.
+        }
+        work();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+  private:
+    std::size_t threads_;
+};
+
+/// @brief An executor running all work on the calling thread, in order.
+class inline_executor {
+  public:
+    HMM_NODISCARD std::size_t concurrency() const noexcept {
+        return 1;
+    }
+
+    template <class F> void parallel_for(std::size_t n, F&& f) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            f(i);
+        }
+    }
+};
+
+namespace execution {
+
+/// @brief Runs a table algorithm on the calling thread.
+struct sequenced_policy {};
+
+/// @brief Runs a table algorithm on a `thread_executor` sized to the
+/// hardware concurrency.
+struct parallel_policy {};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{};
+
+} // namespace execution
+
+/// @brief Builds a table from a range on `threads` threads.
+/// @details Equivalent to constructing `Table` from the range, but hashes the
+/// elements concurrently and fills disjoint regions of the final table from
+/// different threads; see `insert_parallel`.
+/// @tparam Table A table providing `insert_parallel`, e.g. `flat_hash_map`.
+/// @tparam RandomIt A random access iterator.
+template <class Table, class RandomIt>
+HMM_NODISCARD Table
+build_parallel(RandomIt first, RandomIt last,
+               std::size_t threads = std::thread::hardware_concurrency()) {
+    thread_executor executor(threads);
+    Table table;
+    table.insert_parallel(first, last, executor);
+    return table;
+}
+
+} // namespace hmm
+
+#endif // HMM_HMM_EXECUTOR_HPP
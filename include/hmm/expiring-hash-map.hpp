@@ -0,0 +1,440 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_EXPIRING_HASH_MAP_HPP
+#define HMM_HMM_EXPIRING_HASH_MAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/cache-storage.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A hash map whose entries expire at a deadline.
+///
+/// Entries are stored like `lru_cache` entries, at stable 32-bit positions
+/// indexed by a SwissTable, and every position is also linked into a
+/// hierarchical timing wheel. The wheel has four levels of 64 buckets, each
+/// level 64 times coarser than the one below, covering 2^24 ticks ahead; later
+/// deadlines wait in an overflow list. As time advances, a coarse bucket is
+/// redistributed into finer ones when its range begins, and the finest
+/// bucket of each tick holds exactly the entries due then. Occupancy bitmaps
+/// let `advance` jump straight to the next non-empty bucket, so expiry costs
+/// work proportional to the entries expired, not to the size of the map or
+/// the time elapsed.
+///
+/// Time is measured in caller-defined ticks and only moves forward through
+/// `advance`. Expired entries are erased from the index table, leaving
+/// tombstones that are purged in place, so steady churn does not lengthen
+/// probes.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs> class expiring_hash_map {
+    using Policy = MapPolicy<Key, Value>;
+
+  public:
+    using hasher_type = typename internal::detail::TypeAtIndexOrDefault<
+        0, typename Policy::default_hasher_type, TArgs...>::type;
+    using key_equal = typename internal::detail::TypeAtIndexOrDefault<
+        1, typename Policy::default_eq_type, TArgs...>::type;
+    using allocator_type = typename internal::detail::TypeAtIndexOrDefault<
+        2, typename Policy::default_allocator_type, TArgs...>::type;
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using tick_type = std::uint64_t;
+
+  private:
+    /// @brief An entry's deadline and its links within a wheel bucket.
+    struct Timer {
+        tick_type deadline;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint16_t bucket;
+    };
+
+    using Storage = internal::CacheStorage<Key, Value, Timer, hasher_type,
+                                           key_equal, allocator_type>;
+
+    static constexpr unsigned kLevelBits = 6;
+    static constexpr unsigned kLevels = 4;
+    static constexpr std::uint16_t kSlots = 1 << kLevelBits;
+    /// @brief Entries whose deadline has already passed.
+    static constexpr std::uint16_t kDue = kLevels * kSlots;
+    /// @brief Entries beyond the reach of the top level.
+    static constexpr std::uint16_t kOverflow = kDue + 1;
+
+  public:
+    /// @brief Constructs an empty map whose clock starts at tick 0.
+    expiring_hash_map() : expiring_hash_map(0) {}
+
+    /// @brief Constructs an empty map whose clock starts at `now`.
+    explicit expiring_hash_map(tick_type now,
+                               const hasher_type& hash = hasher_type(),
+                               const key_equal& eq = key_equal(),
+                               const allocator_type& alloc = allocator_type())
+        : storage_(0, hash, eq, alloc), now_(now) {
+        reset_wheel();
+    }
+
+    expiring_hash_map(const expiring_hash_map&) = default;
+
+    /// @brief Moves the map; the source is left empty.
+    expiring_hash_map(expiring_hash_map&& other) noexcept
+        : storage_(std::move(other.storage_)), now_(other.now_),
+          heads_(other.heads_), occupied_(other.occupied_),
+          overflow_at_(other.overflow_at_) {
+        other.reset_wheel();
+    }
+
+    expiring_hash_map& operator=(const expiring_hash_map&) = default;
+
+    expiring_hash_map& operator=(expiring_hash_map&& other) noexcept {
+        if (this != &other) {
+            storage_ = std::move(other.storage_);
+            now_ = other.now_;
+            heads_ = other.heads_;
+            occupied_ = other.occupied_;
+            overflow_at_ = other.overflow_at_;
+            other.reset_wheel();
+        }
+        return *this;
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return storage_.size();
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// @brief The tick the map was last advanced to.
+    HMM_NODISCARD tick_type now() const noexcept {
+        return now_;
+    }
+
+    /// @brief Inserts `value` under `key`, or assigns it if `key` is present,
+    /// and (re)schedules the entry to expire at `deadline`.
+    /// @details A deadline that is not after `now()` expires the entry on the
+    /// next call to `advance`.
+    /// @return `true` if a new entry was inserted.
+    template <class K, class V>
+    bool insert_or_assign(K&& key, V&& value, tick_type deadline) {
+        auto info = storage_.prepare(key);
+        if (info.found) {
+            const auto position = storage_.position(info);
+            storage_.entry(position).value.second = std::forward<V>(value);
+            unlink(position);
+            schedule(position, deadline);
+            return false;
+        }
+        if (size() == storage_.capacity()) {
+            storage_.grow(storage_.capacity() == 0 ? 16
+                                                   : storage_.capacity() * 2);
+            info = storage_.prepare(key);
+        }
+        const auto position = storage_.emplace_prepared(
+            info, std::forward<K>(key), std::forward<V>(value));
+        schedule(position, deadline);
+        return true;
+    }
+
+    /// @brief Reschedules the entry with `key` to expire at `deadline`.
+    /// @return `true` if the key was present.
+    template <class K> bool expire_at(const K& key, tick_type deadline) {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return false;
+        }
+        unlink(position);
+        schedule(position, deadline);
+        return true;
+    }
+
+    /// @brief Looks up `key`.
+    /// @return A pointer to the mapped value, or `nullptr` if absent. It
+    /// stays valid until the entry is erased or expires.
+    template <class K> HMM_NODISCARD mapped_type* find(const K& key) {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return nullptr;
+        }
+        return &storage_.entry(position).value.second;
+    }
+
+    template <class K>
+    HMM_NODISCARD const mapped_type* find(const K& key) const {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return nullptr;
+        }
+        return &storage_.entry(position).value.second;
+    }
+
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return storage_.find(key) != Storage::kNone;
+    }
+
+    /// @brief Retrieves the deadline of `key`, or `default_deadline` if
+    /// absent.
+    template <class K>
+    HMM_NODISCARD tick_type deadline(const K& key,
+                                     tick_type default_deadline) const {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return default_deadline;
+        }
+        return storage_.entry(position).meta.deadline;
+    }
+
+    /// @brief Erases the entry with `key` before it expires.
+    /// @return `true` if an entry was removed.
+    template <class K> bool erase(const K& key) {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return false;
+        }
+        unlink(position);
+        storage_.erase(position);
+        return true;
+    }
+
+    /// @brief Erases every entry, keeping the clock and all buffers.
+    void clear() {
+        storage_.clear();
+        reset_wheel();
+    }
+
+    /// @brief Moves the clock forward to `now`, erasing every entry whose
+    /// deadline is at or before it.
+    /// @return The number of entries expired.
+    size_type advance(tick_type now) {
+        return advance(now, [](value_type&) {});
+    }
+
+    /// @brief Moves the clock forward to `now`, invoking `f(value_type&)` on
+    /// each entry whose deadline is at or before it, just before erasing it.
+    /// @details Entries expire in deadline order, at tick granularity. If `f`
+    /// throws, the entry it was given and the others due at the same tick are
+    /// kept, and expire on the next call.
+    /// @return The number of entries expired.
+    template <class F> size_type advance(tick_type now, F&& f) {
+        size_type expired = expire_bucket(kDue, f);
+        while (true) {
+            // Pending events always lie after the clock; anything else means
+            // there are none.
+            const tick_type event = next_event();
+            if (event > now || event <= now_) {
+                break;
+            }
+            now_ = event;
+            if (heads_[kOverflow] != Storage::kNone && now_ >= overflow_at_) {
+                cascade(kOverflow);
+            }
+            for (unsigned level = kLevels - 1; level > 0; --level) {
+                const unsigned shift = level * kLevelBits;
+                if ((now_ & ((tick_type(1) << shift) - 1)) == 0) {
+                    cascade(static_cast<std::uint16_t>(
+                        level * kSlots + ((now_ >> shift) & (kSlots - 1))));
+                }
+            }
+            expired +=
+                expire_bucket(static_cast<std::uint16_t>(now_ & (kSlots - 1)),
+                              f);
+            expired += expire_bucket(kDue, f);
+        }
+        if (now > now_) {
+            now_ = now;
+        }
+        return expired;
+    }
+
+    /// @brief Invokes `f(const value_type&)` on every entry, in storage
+    /// order.
+    template <class F> void for_each(F&& f) const {
+        for (size_type i = 0; i < storage_.capacity(); ++i) {
+            const auto& entry = storage_.entry(static_cast<std::uint32_t>(i));
+            if (entry.live) {
+                f(static_cast<const value_type&>(entry.value));
+            }
+        }
+    }
+
+  private:
+    void reset_wheel() noexcept {
+        heads_.fill(Storage::kNone);
+        occupied_.fill(0);
+        overflow_at_ = std::numeric_limits<tick_type>::max();
+    }
+
+    /// @brief Selects the bucket of a deadline: the level is set by the
+    /// highest bit in which the deadline differs from the clock.
+    HMM_NODISCARD std::uint16_t bucket_for(tick_type deadline) const {
+        if (deadline <= now_) {
+            return kDue;
+        }
+        const tick_type diff = deadline ^ now_;
+        unsigned level = 0;
+        while (level < kLevels && (diff >> ((level + 1) * kLevelBits)) != 0) {
+            ++level;
+        }
+        if (level == kLevels) {
+            return kOverflow;
+        }
+        return static_cast<std::uint16_t>(
+            level * kSlots +
+            ((deadline >> (level * kLevelBits)) & (kSlots - 1)));
+    }
+
+    void schedule(std::uint32_t position, tick_type deadline) {
+        auto& timer = storage_.entry(position).meta;
+        timer.deadline = deadline;
+        timer.bucket = bucket_for(deadline);
+        timer.prev = Storage::kNone;
+        timer.next = heads_[timer.bucket];
+        if (timer.next != Storage::kNone) {
+            storage_.entry(timer.next).meta.prev = position;
+        }
+        heads_[timer.bucket] = position;
+
+        if (timer.bucket < kDue) {
+            occupied_[timer.bucket / kSlots] |= std::uint64_t(1)
+                                                << (timer.bucket % kSlots);
+        } else if (timer.bucket == kOverflow) {
+            // Overflow entries are revisited once the top level reaches the
+            // rotation of the earliest of them.
+            const unsigned top = kLevels * kLevelBits;
+            const tick_type at = (deadline >> top) << top;
+            if (at < overflow_at_) {
+                overflow_at_ = at;
+            }
+        }
+    }
+
+    void unlink(std::uint32_t position) {
+        const auto& timer = storage_.entry(position).meta;
+        if (timer.prev != Storage::kNone) {
+            storage_.entry(timer.prev).meta.next = timer.next;
+        } else {
+            heads_[timer.bucket] = timer.next;
+            if (timer.next == Storage::kNone && timer.bucket < kDue) {
+                occupied_[timer.bucket / kSlots] &=
+                    ~(std::uint64_t(1) << (timer.bucket % kSlots));
+            } else if (timer.next == Storage::kNone &&
+                       timer.bucket == kOverflow) {
+                // The clock may pass a stale mark, which `schedule` would
+                // then never lower again.
+                overflow_at_ = std::numeric_limits<tick_type>::max();
+            }
+        }
+        if (timer.next != Storage::kNone) {
+            storage_.entry(timer.next).meta.prev = timer.prev;
+        }
+    }
+
+    /// @brief The earliest tick after `now()` at which a bucket expires or
+    /// must be redistributed, or the largest tick if none is pending.
+    HMM_NODISCARD tick_type next_event() const {
+        tick_type event = std::numeric_limits<tick_type>::max();
+        for (unsigned level = 0; level < kLevels; ++level) {
+            const unsigned shift = level * kLevelBits;
+            const unsigned current = (now_ >> shift) & (kSlots - 1);
+            // Occupied buckets always lie ahead of the current one.
+            const std::uint64_t ahead =
+                occupied_[level] & ~((std::uint64_t(2) << current) - 1);
+            if (ahead != 0) {
+                const unsigned rotation = shift + kLevelBits;
+                const tick_type at =
+                    ((now_ >> rotation) << rotation) |
+                    (tick_type(internal::CountTrailingZeros64(ahead)) << shift);
+                if (at < event) {
+                    event = at;
+                }
+            }
+        }
+        if (heads_[kOverflow] != Storage::kNone && overflow_at_ < event) {
+            event = overflow_at_;
+        }
+        return event;
+    }
+
+    /// @brief Reschedules every entry of a bucket relative to the clock.
+    void cascade(std::uint16_t bucket) {
+        auto position = heads_[bucket];
+        heads_[bucket] = Storage::kNone;
+        if (bucket < kDue) {
+            occupied_[bucket / kSlots] &=
+                ~(std::uint64_t(1) << (bucket % kSlots));
+        } else {
+            overflow_at_ = std::numeric_limits<tick_type>::max();
+        }
+        while (position != Storage::kNone) {
+            const auto next = storage_.entry(position).meta.next;
+            schedule(position, storage_.entry(position).meta.deadline);
+            position = next;
+        }
+    }
+
+    /// @brief Expires every entry of a bucket. If `f` throws, the rest of
+    /// the bucket is moved to the due list.
+    template <class F> size_type expire_bucket(std::uint16_t bucket, F& f) {
+        size_type expired = 0;
+        while (heads_[bucket] != Storage::kNone) {
+            const auto position = heads_[bucket];
+            try {
+                f(storage_.entry(position).value);
+            } catch (...) {
+                if (bucket != kDue) {
+                    cascade(bucket);
+                }
+                throw;
+            }
+            unlink(position);
+            storage_.erase(position);
+            ++expired;
+        }
+        return expired;
+    }
+
+    Storage storage_;
+    tick_type now_;
+    std::array<std::uint32_t, kOverflow + 1> heads_;
+    std::array<std::uint64_t, kLevels> occupied_;
+    /// @brief The tick at which the overflow list is next redistributed.
+    tick_type overflow_at_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_EXPIRING_HASH_MAP_HPP
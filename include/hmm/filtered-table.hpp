@@ -0,0 +1,285 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_FILTERED_TABLE_HPP
+#define HMM_HMM_FILTERED_TABLE_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/algorithm.hpp"
+#include "hmm/blocked-bloom-filter.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A hash table fronted by a filter, so that lookups of absent keys
+/// usually touch the filter alone.
+///
+/// A key is hashed once. The hash is tested against the filter and, only if
+/// the filter may hold the key, handed to the table's `find_hashed`, which
+/// probes without rehashing. When most lookups miss and the table is much
+/// larger than the cache, a miss then costs one filter cache line instead of
+/// a probe sequence through the table.
+///
+/// Insertions go to both. Erasures go to the filter too when it
+/// `supports_erase`, as a `cuckoo_filter` does. A Bloom filter keeps stale
+/// bits instead, which only raise its false positive rate, and is rebuilt
+/// from the table once the stale keys outnumber the live ones. The filter is
+/// also rebuilt, twice as large, when the table outgrows it or it reports
+/// itself full. Should a few doublings not make room, which takes many keys
+/// with equal hashes, the filter is bypassed until the next `clear` or
+/// `rebuild_filter`.
+///
+/// @tparam Table The table, e.g. `flat_hash_set` or `flat_hash_map`. Its
+///         hasher also feeds the filter.
+/// @tparam Filter The filter. Defaults to a `blocked_bloom_filter` with a 1%
+///         false positive rate.
+template <class Table,
+          class Filter = blocked_bloom_filter<typename Table::key_type,
+                                              typename Table::hasher_type>>
+class filtered_table {
+    using Access = internal::TableAccess;
+    using Raw = Access::Raw<Table>;
+    using Policy = typename Raw::policy_type;
+
+  public:
+    using table_type = Table;
+    using filter_type = Filter;
+    using key_type = typename Table::key_type;
+    using value_type = typename Table::value_type;
+    using size_type = typename Table::size_type;
+    using hasher_type = typename Table::hasher_type;
+    using iterator = typename Table::iterator;
+    using const_iterator = typename Table::const_iterator;
+
+    /// @brief Builds an empty table and a filter sized for `expected` keys.
+    explicit filtered_table(size_type expected = 0,
+                            const Filter& filter = Filter())
+        : filter_(filter) {
+        table_.reserve(expected);
+        filter_.reset(expected);
+    }
+
+    /// @brief Takes over an existing table and builds a filter for it.
+    explicit filtered_table(Table table, const Filter& filter = Filter())
+        : table_(std::move(table)), filter_(filter) {
+        rebuild_filter(table_.size());
+    }
+
+    /// @brief Constructs an element in place if its key is not present.
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        Raw& raw = Access::raw(table_);
+        auto temp = Policy::new_slot(raw.get_allocator(),
+                                     std::forward<Args>(args)...);
+        const auto& key = Policy::key(temp);
+        typename Raw::FindInfo info{};
+        try {
+            // Look up first: a duplicate must not grow the table.
+            info = raw.find_or_prepare_insert(key);
+            if (!info.found && raw.needs_resize()) {
+                raw.rehash_and_grow();
+                info = raw.find_or_prepare_insert_hashed(key, info.full_hash);
+            }
+        } catch (...) {
+            Policy::drop_slot(raw.get_allocator(), temp);
+            throw;
+        }
+        if (info.found) {
+            Policy::drop_slot(raw.get_allocator(), temp);
+            return {raw.iterator_at(info.index), false};
+        }
+
+        raw.insert_at_index(info.index, info.full_hash, std::move(temp));
+        const iterator it = raw.iterator_at(info.index);
+        add_to_filter(info.full_hash);
+        return {it, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return emplace(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return emplace(std::move(value));
+    }
+
+    /// @brief Finds a key, consulting the filter first.
+    template <class K> HMM_NODISCARD iterator find(const K& key) {
+        Raw& raw = Access::raw(table_);
+        const std::size_t hash = raw.hasher()(key);
+        if (!may_contain(hash)) {
+            return table_.end();
+        }
+        return raw.find_hashed(key, hash);
+    }
+
+    template <class K> HMM_NODISCARD const_iterator find(const K& key) const {
+        const Raw& raw = Access::raw(table_);
+        const std::size_t hash = raw.hasher()(key);
+        if (!may_contain(hash)) {
+            return table_.end();
+        }
+        return raw.find_hashed(key, hash);
+    }
+
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return find(key) != table_.end();
+    }
+
+    template <class K> HMM_NODISCARD size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    /// @brief Removes a key.
+    /// @return 1 if it was present, 0 otherwise.
+    template <class K> size_type erase(const K& key) {
+        Raw& raw = Access::raw(table_);
+        const std::size_t hash = raw.hasher()(key);
+        if (!may_contain(hash)) {
+            return 0;
+        }
+        const auto it = raw.find_hashed(key, hash);
+        if (it == raw.end()) {
+            return 0;
+        }
+        raw.erase(it);
+        if (!bypass_) {
+            remove_from_filter(
+                hash, std::integral_constant<bool, Filter::supports_erase>());
+        }
+        return 1;
+    }
+
+    /// @brief Removes every element and clears the filter.
+    void clear() {
+        table_.clear();
+        filter_.clear();
+        stale_ = 0;
+        bypass_ = false;
+    }
+
+    /// @brief Reserves room for `count` elements in the table and the filter.
+    void reserve(size_type count) {
+        table_.reserve(count);
+        if (count > filter_.capacity()) {
+            rebuild_filter(count);
+        }
+    }
+
+    /// @brief Rebuilds the filter from the table, sized for at least
+    /// `expected` keys. Drops any stale keys.
+    void rebuild_filter(size_type expected) {
+        if (expected < table_.size()) {
+            expected = table_.size();
+        }
+        const Raw& raw = Access::raw(table_);
+        stale_ = 0;
+        for (int attempt = 0; attempt < kMaxDoublings; ++attempt) {
+            filter_.reset(expected);
+            bool fits = true;
+            for (std::size_t i = 0; fits && i < raw.capacity(); ++i) {
+                if (raw.ctrl_ptr()[i] >= 0) {
+                    fits = filter_.insert_hash(
+                        raw.hasher()(Policy::key(raw.slots_ptr()[i])));
+                }
+            }
+            if (fits) {
+                bypass_ = false;
+                return;
+            }
+            expected *= 2;
+        }
+        bypass_ = true;
+    }
+
+    HMM_NODISCARD iterator begin() {
+        return table_.begin();
+    }
+
+    HMM_NODISCARD const_iterator begin() const {
+        return table_.begin();
+    }
+
+    HMM_NODISCARD iterator end() {
+        return table_.end();
+    }
+
+    HMM_NODISCARD const_iterator end() const {
+        return table_.end();
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return table_.size();
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return table_.empty();
+    }
+
+    /// @brief Whether lookups skip the filter because it could not hold the
+    /// keys.
+    HMM_NODISCARD bool bypassed() const noexcept {
+        return bypass_;
+    }
+
+    /// @brief The underlying table. Modify it only through this adapter.
+    HMM_NODISCARD const Table& table() const noexcept {
+        return table_;
+    }
+
+    HMM_NODISCARD const Filter& filter() const noexcept {
+        return filter_;
+    }
+
+  private:
+    /// @brief Times the filter is doubled before it is bypassed.
+    static constexpr int kMaxDoublings = 4;
+
+    HMM_NODISCARD bool may_contain(std::size_t hash) const noexcept {
+        return bypass_ || filter_.contains_hash(hash);
+    }
+
+    void add_to_filter(std::size_t hash) {
+        if (bypass_) {
+            return;
+        }
+        if (table_.size() > filter_.capacity() ||
+            !filter_.insert_hash(hash)) {
+            rebuild_filter(table_.size() * 2);
+        }
+    }
+
+    void remove_from_filter(std::size_t hash, std::true_type) {
+        filter_.erase_hash(hash);
+    }
+
+    void remove_from_filter(std::size_t, std::false_type) {
+        if (++stale_ > table_.size()) {
+            rebuild_filter(filter_.capacity());
+        }
+    }
+
+    Table table_;
+    Filter filter_;
+    size_type stale_ = 0; ///< Keys erased from the table but not the filter.
+    bool bypass_ = false; ///< Set when the filter could not hold the keys.
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_FILTERED_TABLE_HPP
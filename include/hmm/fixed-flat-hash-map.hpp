@@ -0,0 +1,166 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_FIXED_FLAT_HASH_MAP_HPP
+#define HMM_HMM_FIXED_FLAT_HASH_MAP_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/fixed-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+#if HMM_HAS_CXX_20
+#include <span>
+#endif
+
+namespace hmm {
+
+/// @brief A flat hash map that lives in a caller-provided buffer and never
+/// allocates or grows.
+///
+/// Even with a pmr allocator, `flat_hash_map` may rehash on any insertion.
+/// `fixed_flat_hash_map` is for threads that must not touch the allocator
+/// after startup: the caller hands it a buffer, its capacity is the largest
+/// power-of-two slot count that fits, and it holds at most 7/8 of that. An
+/// insertion past the limit returns `{end(), false}` and changes nothing.
+/// No member allocates, and none throws except `at` and whatever the hasher,
+/// the equality and the element constructors throw.
+///
+/// Use `buffer_size(n)` to size a buffer for `n` elements. The buffer must
+/// outlive the map; the elements in it are destroyed with the map. The map
+/// can be moved, which hands over the buffer, but not copied.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+template <class Key, class Value, class... TArgs>
+class fixed_flat_hash_map
+    : protected internal::fixed_table<
+          MapPolicy<Key, Value>,
+          internal::BufferStorage<MapPolicy<Key, Value>>, TArgs...> {
+    using Storage = internal::BufferStorage<MapPolicy<Key, Value>>;
+    using Base =
+        internal::fixed_table<MapPolicy<Key, Value>, Storage, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using mapped_type = Value;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+
+    using iterator = typename Base::iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    /// @brief The buffer size, in bytes, that holds `n` elements whatever
+    /// the buffer's alignment.
+    HMM_NODISCARD static constexpr size_type buffer_size(size_type n) noexcept {
+        return Storage::bytes_for(internal::StaticCapacity(n));
+    }
+
+    /// @brief Builds an empty map in `bytes` bytes at `buffer`.
+    fixed_flat_hash_map(void* buffer, size_type bytes,
+                        const hasher_type& hash = hasher_type(),
+                        const key_equal& eq = key_equal())
+        : Base(hash, eq, buffer, bytes) {}
+
+#if HMM_HAS_CXX_20
+    /// @brief Builds an empty map in `buffer`.
+    explicit fixed_flat_hash_map(std::span<std::byte> buffer,
+                                 const hasher_type& hash = hasher_type(),
+                                 const key_equal& eq = key_equal())
+        : Base(hash, eq, buffer.data(), buffer.size()) {}
+#endif
+
+    /// @name Standard Container Interfaces
+    ///@{
+    using Base::begin;
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::empty;
+    using Base::end;
+    using Base::erase;
+    using Base::erase_element;
+    using Base::full;
+    using Base::max_size;
+    using Base::size;
+    ///@}
+
+    /// @name Modifiers
+    /// A new key that does not fit is reported as `{end(), false}`.
+    ///@{
+    using Base::emplace;
+    using Base::insert;
+    using Base::try_emplace;
+
+    /// @brief Inserts `value` under `key`, or assigns it to the existing
+    /// element.
+    template <class K, class V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+        auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+        if (!result.second && result.first != end()) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    using Base::contains;
+    using Base::count;
+    using Base::find;
+
+    /// @brief Accesses the value mapped to `key`.
+    /// @throws std::out_of_range If the key is not present.
+    template <class K = key_type> HMM_NODISCARD mapped_type& at(const K& key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("fixed_flat_hash_map::at");
+        }
+        return it->second;
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD const mapped_type& at(const K& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("fixed_flat_hash_map::at");
+        }
+        return it->second;
+    }
+    ///@}
+
+    /// @name Observers
+    ///@{
+    using Base::hash_function;
+    using Base::key_eq;
+    ///@}
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_FIXED_FLAT_HASH_MAP_HPP
@@ -0,0 +1,144 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_FIXED_FLAT_HASH_SET_HPP
+#define HMM_HMM_FIXED_FLAT_HASH_SET_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include "hmm/flat-hash-set.hpp"
+#include "hmm/internal/fixed-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+#if HMM_HAS_CXX_20
+#include <span>
+#endif
+
+namespace hmm {
+
+/// @brief A flat hash set that lives in a caller-provided buffer and never
+/// allocates or grows.
+///
+/// The set counterpart of `fixed_flat_hash_map`: sized to fit the buffer,
+/// reporting an insertion past 7/8 of its capacity as `{end(), false}`, and
+/// free of allocation and exceptions of its own.
+///
+/// @tparam Contained The type of elements stored in the set.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Contained>`)
+///               2. Equality functor (Defaults to `std::equal_to<Contained>`)
+template <class Contained, class... TArgs>
+class fixed_flat_hash_set
+    : protected internal::fixed_table<
+          SetPolicy<Contained>, internal::BufferStorage<SetPolicy<Contained>>,
+          TArgs...> {
+    using Storage = internal::BufferStorage<SetPolicy<Contained>>;
+    using Base = internal::fixed_table<SetPolicy<Contained>, Storage, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+
+    using iterator = typename Base::const_iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    /// @brief The buffer size, in bytes, that holds `n` elements whatever
+    /// the buffer's alignment.
+    HMM_NODISCARD static constexpr size_type buffer_size(size_type n) noexcept {
+        return Storage::bytes_for(internal::StaticCapacity(n));
+    }
+
+    /// @brief Builds an empty set in `bytes` bytes at `buffer`.
+    fixed_flat_hash_set(void* buffer, size_type bytes,
+                        const hasher_type& hash = hasher_type(),
+                        const key_equal& eq = key_equal())
+        : Base(hash, eq, buffer, bytes) {}
+
+#if HMM_HAS_CXX_20
+    /// @brief Builds an empty set in `buffer`.
+    explicit fixed_flat_hash_set(std::span<std::byte> buffer,
+                                 const hasher_type& hash = hasher_type(),
+                                 const key_equal& eq = key_equal())
+        : Base(hash, eq, buffer.data(), buffer.size()) {}
+#endif
+
+    /// @name Standard Container Interfaces
+    ///@{
+    HMM_NODISCARD const_iterator begin() const noexcept {
+        return Base::begin();
+    }
+    HMM_NODISCARD const_iterator end() const noexcept {
+        return Base::end();
+    }
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::empty;
+    using Base::erase_element;
+    using Base::full;
+    using Base::max_size;
+    using Base::size;
+    ///@}
+
+    /// @name Modifiers
+    /// A new element that does not fit is reported as `{end(), false}`.
+    ///@{
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return Base::insert(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return Base::insert(std::move(value));
+    }
+
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        return Base::emplace(std::forward<Args>(args)...);
+    }
+
+    /// @brief Removes the element at `pos`. A loop that erases while
+    /// iterating may visit an element twice; see `internal::fixed_table`.
+    iterator erase(const_iterator pos) {
+        return Base::erase(pos);
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    template <class K = key_type>
+    HMM_NODISCARD const_iterator find(const K& key) const {
+        return Base::find(key);
+    }
+    using Base::contains;
+    using Base::count;
+    ///@}
+
+    /// @name Observers
+    ///@{
+    using Base::hash_function;
+    using Base::key_eq;
+    ///@}
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_FIXED_FLAT_HASH_SET_HPP
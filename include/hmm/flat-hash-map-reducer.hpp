@@ -0,0 +1,303 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_FLAT_HASH_MAP_REDUCER_HPP
+#define HMM_HMM_FLAT_HASH_MAP_REDUCER_HPP
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "hmm/algorithm.hpp"
+#include "hmm/executor.hpp"
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief Thread-local accumulation with a parallel merge, for group-by and
+/// counting jobs.
+///
+/// Every thread calling `add` (or `local`) gets a private `flat_hash_map`,
+/// so accumulating needs no synchronization. `merge` then folds all of them
+/// into a single table:
+///
+/// 1. The entries of every private table are hashed once, in parallel, and
+///    bucketed by the top bits of their hash.
+/// 2. Each bucket is deduplicated by one task, folding repeated keys into
+///    their first copy with `combine`.
+/// 3. The distinct entries are moved into a table reserved for their exact
+///    count, reusing the hashes from step 1, one task per table partition.
+///
+/// @tparam Key The type of keys.
+/// @tparam Value The type of accumulated values.
+/// @tparam Combine A functor folding two values, `Value(Value, const Value&)`.
+///         Must be associative and commutative. Defaults to `std::plus`.
+/// @tparam TArgs Optional hash, equality and allocator types, as for
+///         `flat_hash_map`. The hasher must hash alike in every table.
+template <class Key, class Value, class Combine = std::plus<Value>,
+          class... TArgs>
+class flat_hash_map_reducer {
+  public:
+    using table_type = flat_hash_map<Key, Value, TArgs...>;
+    using key_type = typename table_type::key_type;
+    using mapped_type = typename table_type::mapped_type;
+    using size_type = typename table_type::size_type;
+
+    explicit flat_hash_map_reducer(Combine combine = Combine())
+        : combine_(std::move(combine)), id_(NextId()) {}
+
+    flat_hash_map_reducer(const flat_hash_map_reducer&) = delete;
+    flat_hash_map_reducer& operator=(const flat_hash_map_reducer&) = delete;
+
+    /// @brief The calling thread's private table.
+    /// @details Registered on first use by each thread, then cached in a
+    /// thread-local so that later calls take no lock. The cache holds one
+    /// entry per reducer id modulo `kCacheEntries`, so a thread feeding a few
+    /// reducers in turn keeps hitting it.
+    HMM_NODISCARD table_type& local() {
+        struct Cache {
+            std::uint64_t owner;
+            table_type* table;
+        };
+        static thread_local Cache caches[kCacheEntries] = {};
+
+        Cache& cache = caches[id_ % kCacheEntries];
+        if (cache.owner != id_) {
+            cache.table = &register_thread();
+            cache.owner = id_;
+        }
+        return *cache.table;
+    }
+
+    /// @brief Folds `value` into the calling thread's entry for `key`.
+    template <class K, class V> void add(K&& key, V&& value) {
+        auto result = local().try_emplace(std::forward<K>(key),
+                                          std::forward<V>(value));
+        if (!result.second) {
+            // The value was not consumed, as no element was constructed.
+            result.first->second =
+                combine_(std::move(result.first->second), value);
+        }
+    }
+
+    /// @brief Merges every private table into one, on a `thread_executor`.
+    HMM_NODISCARD table_type merge() {
+        thread_executor executor;
+        return merge(executor);
+    }
+
+    /// @brief Merges every private table into one, and starts over with no
+    /// private tables.
+    /// @details Must not run concurrently with `add` or `local`. Entries are
+    /// moved out of the private tables.
+    template <class Executor>
+    HMM_NODISCARD table_type merge(Executor& executor) {
+        std::vector<std::unique_ptr<table_type>> locals;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            locals.swap(locals_);
+            threads_.clear();
+            id_ = NextId();
+        }
+
+        if (locals.empty()) {
+            return table_type();
+        }
+        if (locals.size() == 1) {
+            return std::move(*locals.front());
+        }
+        return merge_tables(locals, executor);
+    }
+
+  private:
+    static constexpr std::size_t kCacheEntries = 8;
+
+    using Raw = internal::TableAccess::Raw<table_type>;
+    using slot_type = typename Raw::slot_type;
+    using policy_type = typename Raw::policy_type;
+
+    /// @brief An entry of a private table with its hash.
+    struct Entry {
+        std::size_t hash;
+        slot_type* slot;
+    };
+
+    static std::uint64_t NextId() noexcept {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    table_type& register_thread() {
+        const auto self = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& thread : threads_) {
+            if (thread.first == self) {
+                return *thread.second;
+            }
+        }
+        locals_.emplace_back(new table_type());
+        threads_.emplace_back(self, locals_.back().get());
+        return *locals_.back();
+    }
+
+    template <class Executor>
+    table_type
+    merge_tables(const std::vector<std::unique_ptr<table_type>>& locals,
+                 Executor& executor) {
+        // Step 1: hash every entry once and bucket the entries by the top
+        // bits of their hash, one task per range of a private table.
+        std::size_t bucket_bits = 0;
+        while ((std::size_t(1) << bucket_bits) < executor.concurrency() * 8) {
+            ++bucket_bits;
+        }
+        const std::size_t buckets = std::size_t(1) << bucket_bits;
+        const auto bucket_of = [&](std::size_t hash) {
+            return bucket_bits == 0
+                       ? 0
+                       : hash >> (sizeof(std::size_t) * CHAR_BIT - bucket_bits);
+        };
+
+        struct Task {
+            Raw* table;
+            std::size_t first;
+            std::size_t last;
+        };
+        std::vector<Task> tasks;
+        const std::size_t per_table = executor.concurrency();
+        for (const auto& local : locals) {
+            Raw& raw = internal::TableAccess::raw(*local);
+            for (std::size_t c = 0; c < per_table; ++c) {
+                tasks.push_back(Task{&raw, raw.capacity() * c / per_table,
+                                     raw.capacity() * (c + 1) / per_table});
+            }
+        }
+
+        std::vector<std::vector<Entry>> hashed(tasks.size());
+        std::vector<std::size_t> offsets(tasks.size() * buckets, 0);
+        executor.parallel_for(tasks.size(), [&](std::size_t t) {
+            const Task& task = tasks[t];
+            for (std::size_t i = task.first; i < task.last; ++i) {
+                if (task.table->ctrl_ptr()[i] >= 0) {
+                    slot_type* slot = &task.table->slots_ptr()[i];
+                    const std::size_t hash =
+                        task.table->hasher()(policy_type::key(*slot));
+                    hashed[t].push_back(Entry{hash, slot});
+                    ++offsets[t * buckets + bucket_of(hash)];
+                }
+            }
+        });
+
+        std::vector<std::size_t> bucket_begin(buckets + 1, 0);
+        std::size_t total = 0;
+        for (std::size_t b = 0; b < buckets; ++b) {
+            bucket_begin[b] = total;
+            for (std::size_t t = 0; t < tasks.size(); ++t) {
+                const std::size_t count = offsets[t * buckets + b];
+                offsets[t * buckets + b] = total;
+                total += count;
+            }
+        }
+        bucket_begin[buckets] = total;
+
+        std::vector<Entry> entries(total);
+        executor.parallel_for(tasks.size(), [&](std::size_t t) {
+            for (const Entry& entry : hashed[t]) {
+                entries[offsets[t * buckets + bucket_of(entry.hash)]++] =
+                    entry;
+            }
+        });
+        hashed.clear();
+
+        // Step 2: deduplicate each bucket with a scratch index of its first
+        // occurrences, folding the repeats into them.
+        const auto& eq = internal::TableAccess::raw(*locals.front()).equal();
+        std::vector<std::vector<std::size_t>> distinct(buckets);
+        executor.parallel_for(buckets, [&](std::size_t b) {
+            const std::size_t first = bucket_begin[b];
+            const std::size_t count = bucket_begin[b + 1] - first;
+            std::size_t mask = 1;
+            while (mask < count * 2) {
+                mask <<= 1;
+            }
+            --mask;
+
+            const std::size_t kNone = static_cast<std::size_t>(-1);
+            std::vector<std::size_t> index(mask + 1, kNone);
+            for (std::size_t k = first; k < first + count; ++k) {
+                Entry& entry = entries[k];
+                std::size_t pos = entry.hash & mask;
+                while (true) {
+                    if (index[pos] == kNone) {
+                        index[pos] = k;
+                        distinct[b].push_back(k);
+                        break;
+                    }
+                    Entry& seen = entries[index[pos]];
+                    if (seen.hash == entry.hash &&
+                        eq(policy_type::key(*seen.slot),
+                           policy_type::key(*entry.slot))) {
+                        seen.slot->second = combine_(
+                            std::move(seen.slot->second), entry.slot->second);
+                        break;
+                    }
+                    pos = (pos + 1) & mask;
+                }
+            }
+        });
+
+        // Step 3: move the distinct entries into a table sized for them.
+        std::vector<std::size_t> order;
+        for (const auto& items : distinct) {
+            order.insert(order.end(), items.begin(), items.end());
+        }
+
+        table_type result;
+        Raw& raw = internal::TableAccess::raw(result);
+        raw.reserve(order.size());
+        raw.insert_hashed_parallel(
+            order.size(), executor,
+            [&](std::size_t i) { return entries[order[i]].hash; },
+            [&](std::size_t i) -> const key_type& {
+                return policy_type::key(*entries[order[i]].slot);
+            },
+            [&](slot_type* slot, std::size_t i) {
+                policy_type::construct(raw.get_allocator(), slot,
+                                       std::move(*entries[order[i]].slot));
+            },
+            [](typename Raw::value_type&, std::size_t) {});
+        return result;
+    }
+
+    Combine combine_;
+    std::uint64_t id_;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<table_type>> locals_;
+    std::vector<std::pair<std::thread::id, table_type*>> threads_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_FLAT_HASH_MAP_REDUCER_HPP
@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "hmm/city-hash.hpp"
+#include "hmm/internal/detail.hpp"
 #include "hmm/internal/macros.hpp"
 #include "hmm/internal/raw-hash-map.hpp"
 
@@ -58,6 +59,7 @@ template <class Key, class Value, class... TArgs>
 class flat_hash_map
     : protected internal::raw_hash_map<MapPolicy<Key, Value>, TArgs...> {
     using Base = internal::raw_hash_map<MapPolicy<Key, Value>, TArgs...>;
+    friend struct internal::TableAccess;
 
   public:
     using policy_type = typename Base::policy_type;
@@ -121,7 +123,10 @@ class flat_hash_map
     using Base::erase;
     using Base::erase_element;
     using Base::insert;
+    using Base::insert_parallel;
+    using Base::partitions;
     using Base::reserve;
+    using Base::reserve_parallel;
     using Base::size;
     ///@}
 
@@ -319,6 +324,32 @@ template <typename K, typename V> struct MapPolicy {
     static HMM_CONSTEXPR_20 void destroy(Alloc& alloc, slot_type* ptr) {
         std::allocator_traits<Alloc>::destroy(alloc, ptr);
     }
+
+    /// @brief Relocates an element between slots, leaving `src` destroyed.
+    /// @tparam Alloc The allocator type.
+    template <class Alloc>
+    static HMM_CONSTEXPR_20 void transfer(Alloc& alloc, slot_type* dst,
+                                          slot_type* src) {
+        construct(alloc, dst, std::move(*src));
+        destroy(alloc, src);
+    }
+
+    /// @brief Builds a free-standing slot, used to extract the key of an
+    /// element before probing for it.
+    /// @details Falls back to aggregate initialization when direct
+    /// initialization is not possible.
+    template <class Alloc, class... Args>
+    static HMM_CONSTEXPR_20 slot_type new_slot(Alloc& /* alloc */,
+                                               Args&&... args) {
+        return internal::detail::construct<slot_type>(
+            std::forward<Args>(args)...);
+    }
+
+    /// @brief Disposes of a free-standing slot that was not inserted. The
+    /// slot owns its element by value, so its destructor does all the work.
+    template <class Alloc>
+    static HMM_CONSTEXPR_20 void drop_slot(Alloc& /* alloc */,
+                                           slot_type& /* slot */) noexcept {}
 };
 
 #if HMM_HAS_CXX_17
@@ -0,0 +1,221 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_FLAT_HASH_MULTIMAP_HPP
+#define HMM_HMM_FLAT_HASH_MULTIMAP_HPP
+
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/macros.hpp"
+#include "hmm/internal/raw-hash-multiset.hpp"
+
+#if HMM_HAS_CXX_17
+#include <memory_resource>
+#endif
+
+namespace hmm {
+
+/// @brief A SIMD-accelerated flat hash map admitting equal keys.
+///
+/// `flat_hash_multimap` is an unordered associative container that acts as a
+/// drop-in replacement for `std::unordered_multimap`. It shares the layout
+/// and policy of `flat_hash_map`, but every insertion claims a new slot.
+/// Pairs with equal keys share a probe sequence, so `equal_range` and `count`
+/// walk only the probe windows of the key rather than a bucket chain.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs>
+class flat_hash_multimap
+    : protected internal::raw_hash_multiset<MapPolicy<Key, Value>, TArgs...> {
+    using Base = internal::raw_hash_multiset<MapPolicy<Key, Value>, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using mapped_type = typename policy_type::mapped_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+
+    using slot_type = typename Base::slot_type;
+    using slot_allocator = typename Base::slot_allocator;
+    using slot_traits = typename Base::slot_traits;
+    using pointer = typename Base::pointer;
+    using allocator_type = typename Base::allocator_type;
+
+    using const_iterator = typename Base::const_iterator;
+    using iterator = typename Base::iterator;
+    using key_iterator = typename Base::key_iterator;
+    using const_key_iterator = typename Base::const_key_iterator;
+
+    /// @brief Default constructs an empty flat hash multimap.
+    HMM_CONSTEXPR_20 flat_hash_multimap() = default;
+
+    /// @brief Constructs the multimap with the contents of an initializer
+    /// list, keeping pairs with duplicate keys.
+    /// @param initial The std::initializer_list of key-value pairs.
+    /// @param alloc The allocator instance to use.
+    HMM_CONSTEXPR_20
+    flat_hash_multimap(std::initializer_list<slot_type> initial,
+                       const allocator_type& alloc = allocator_type())
+        : Base(initial.begin(), initial.end(), alloc) {}
+
+    /// @brief Constructs the multimap with the contents of a range.
+    /// @tparam Iter Iterator type.
+    /// @tparam Sentinel Sentinel type denoting the end of the range.
+    /// @param begin The beginning of the range.
+    /// @param end The end of the range.
+    /// @param alloc The allocator instance to use.
+    template <class Iter, class Sentinel>
+    HMM_CONSTEXPR_20
+    flat_hash_multimap(Iter begin, Sentinel end,
+                       const allocator_type& alloc = allocator_type())
+        : Base(begin, end, alloc) {}
+
+    /// @brief Constructs an empty multimap utilizing a specific allocator.
+    /// @param alloc The allocator instance.
+    HMM_CONSTEXPR_20
+    explicit flat_hash_multimap(const allocator_type& alloc) : Base(alloc) {}
+
+    /// @name Standard Container Interfaces
+    /// These functions provide standard capacity, iteration, and modifier
+    /// interfaces compliant with standard C++ container requirements.
+    ///@{
+    using Base::begin;
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::emplace;
+    using Base::empty;
+    using Base::end;
+    using Base::erase;
+    using Base::insert;
+    using Base::partitions;
+    using Base::reserve;
+    using Base::reserve_parallel;
+    using Base::size;
+    ///@}
+
+    /// @brief Inserts a list of key-value pairs into the multimap.
+    /// @param ilist The initializer list of pairs to insert.
+    void insert(std::initializer_list<value_type> ilist) {
+        Base::insert(ilist.begin(), ilist.end());
+    }
+
+    /// @brief Inserts one pair for every value of a range, all under `key`.
+    /// @details The key is hashed once for the whole range, and the new pairs
+    /// are laid out back to back along its probe sequence.
+    /// @param key The key shared by every inserted pair.
+    /// @param first The start of the range of mapped values.
+    /// @param last The end of the range of mapped values.
+    template <class InputIt>
+    void insert(const key_type& key, InputIt first, InputIt last) {
+        using Category =
+            typename std::iterator_traits<InputIt>::iterator_category;
+        reserve_for(first, last, Category{});
+        const auto full_hash = Base::hash_function()(key);
+        for (; first != last; ++first) {
+            Base::emplace_hashed(full_hash, key, *first);
+        }
+    }
+
+    /// @brief Erases every pair whose key matches `key`.
+    /// @return The number of pairs removed.
+    size_type erase(const key_type& key) {
+        return Base::erase_key(key);
+    }
+
+    /// @brief Finds a pair with the specified key.
+    /// @return An iterator to one of the matching pairs, or `end()`.
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 iterator find(const K& key) {
+        return Base::find(key);
+    }
+
+    /// @brief Finds a pair with the specified key (const context).
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 const_iterator find(const K& key) const {
+        return Base::find(key);
+    }
+
+    /// @brief Checks if a pair with the specified key exists.
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 bool contains(const K& key) const {
+        return Base::contains(key);
+    }
+
+    /// @brief Counts the pairs with the specified key.
+    template <typename K> HMM_NODISCARD size_type count(const K& key) const {
+        return Base::count(key);
+    }
+
+    /// @brief Retrieves the range of pairs with the specified key.
+    /// @details The range is traversed with key iterators, which visit only
+    /// the matching pairs. `key_iterator::base()` converts an element of the
+    /// range back to a table-wide iterator, e.g. for `erase`.
+    template <typename K>
+    HMM_NODISCARD std::pair<key_iterator, key_iterator>
+    equal_range(const K& key) {
+        return Base::equal_range(key);
+    }
+
+    /// @brief Retrieves the range of pairs with the specified key (const
+    /// context).
+    template <typename K>
+    HMM_NODISCARD std::pair<const_key_iterator, const_key_iterator>
+    equal_range(const K& key) const {
+        return Base::equal_range(key);
+    }
+
+  private:
+    template <class InputIt>
+    void reserve_for(InputIt first, InputIt last, std::forward_iterator_tag) {
+        reserve(size() + static_cast<size_type>(std::distance(first, last)));
+    }
+
+    template <class InputIt>
+    void reserve_for(InputIt /* first */, InputIt /* last */,
+                     std::input_iterator_tag) {}
+};
+
+#if HMM_HAS_CXX_17
+namespace pmr {
+/// @brief Type alias for `flat_hash_multimap` using C++17 Polymorphic Memory
+/// Resources.
+template <class Key, class Value,
+          class Hash = typename MapPolicy<Key, Value>::default_hasher_type,
+          class Eq = typename MapPolicy<Key, Value>::default_eq_type>
+using flat_hash_multimap = ::hmm::flat_hash_multimap<
+    Key, Value, Hash, Eq,
+    std::pmr::polymorphic_allocator<typename MapPolicy<Key, Value>::slot_type>>;
+} // namespace pmr
+#endif
+
+} // namespace hmm
+
+#endif // HMM_HMM_FLAT_HASH_MULTIMAP_HPP
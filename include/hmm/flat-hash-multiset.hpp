@@ -0,0 +1,215 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_FLAT_HASH_MULTISET_HPP
+#define HMM_HMM_FLAT_HASH_MULTISET_HPP
+
+#include <initializer_list>
+#include <utility>
+
+#include "hmm/flat-hash-set.hpp"
+#include "hmm/internal/macros.hpp"
+#include "hmm/internal/raw-hash-multiset.hpp"
+
+#if HMM_HAS_CXX_17
+#include <memory_resource>
+#endif
+
+namespace hmm {
+
+/// @brief A SIMD-accelerated flat hash set admitting equal elements.
+///
+/// `flat_hash_multiset` is an unordered associative container that acts as a
+/// drop-in replacement for `std::unordered_multiset`. It shares the layout
+/// and policy of `flat_hash_set`, but every insertion claims a new slot.
+/// Equal elements share a probe sequence, so `equal_range` and `count` walk
+/// only the probe windows of the key rather than a bucket chain.
+///
+/// @tparam Contained The type of elements stored in the set.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Contained>`)
+///               2. Equality functor (Defaults to `std::equal_to<Contained>`)
+///               3. Allocator (Defaults to `std::allocator<Contained>`)
+template <class Contained, class... TArgs>
+class flat_hash_multiset
+    : protected internal::raw_hash_multiset<SetPolicy<Contained>, TArgs...> {
+    using Base = internal::raw_hash_multiset<SetPolicy<Contained>, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+
+    using slot_type = typename Base::slot_type;
+    using slot_allocator = typename Base::slot_allocator;
+    using slot_traits = typename Base::slot_traits;
+    using pointer = typename Base::pointer;
+    using allocator_type = typename Base::allocator_type;
+
+    using iterator = typename Base::const_iterator;
+    using const_iterator = typename Base::const_iterator;
+    using key_iterator = typename Base::const_key_iterator;
+    using const_key_iterator = typename Base::const_key_iterator;
+
+  public:
+    /// @brief Default constructs an empty flat hash multiset.
+    HMM_CONSTEXPR_20 flat_hash_multiset() = default;
+
+    /// @brief Constructs the multiset with the contents of an initializer
+    /// list, keeping duplicates.
+    /// @param initial The std::initializer_list of elements.
+    /// @param alloc The allocator instance to use.
+    HMM_CONSTEXPR_20
+    flat_hash_multiset(std::initializer_list<slot_type> initial,
+                       const allocator_type& alloc = allocator_type())
+        : Base(initial.begin(), initial.end(), alloc) {}
+
+    /// @brief Constructs the multiset with the contents of a range, keeping
+    /// duplicates.
+    /// @tparam Iter Iterator type.
+    /// @tparam Sentinel Sentinel type denoting the end of the range.
+    /// @param begin The beginning of the range.
+    /// @param end The end of the range.
+    /// @param alloc The allocator instance to use.
+    template <class Iter, class Sentinel>
+    HMM_CONSTEXPR_20
+    flat_hash_multiset(Iter begin, Sentinel end,
+                       const allocator_type& alloc = allocator_type())
+        : Base(begin, end, alloc) {}
+
+    /// @brief Constructs an empty multiset utilizing a specific allocator.
+    /// @param alloc The allocator instance.
+    HMM_CONSTEXPR_20 explicit flat_hash_multiset(const allocator_type& alloc)
+        : Base(alloc) {}
+
+    /// @name Standard Container Interfaces
+    /// These functions provide standard capacity, iteration, and modifier
+    /// interfaces compliant with standard C++ container requirements.
+    ///@{
+    using Base::begin;
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::empty;
+    using Base::end;
+    using Base::partitions;
+    using Base::reserve;
+    using Base::reserve_parallel;
+    using Base::size;
+    ///@}
+
+    /// @brief Inserts an element, even if an equal one already exists.
+    /// @param value The value to insert.
+    /// @return An iterator to the inserted element.
+    iterator insert(const value_type& value) {
+        return Base::insert(value);
+    }
+
+    /// @brief Inserts an element via move semantics, even if an equal one
+    /// already exists.
+    /// @param value The value to move-insert.
+    /// @return An iterator to the inserted element.
+    iterator insert(value_type&& value) {
+        return Base::insert(std::move(value));
+    }
+
+    /// @brief Inserts a range of elements into the multiset.
+    /// @tparam InputIt Iterator type.
+    /// @param first The start of the range.
+    /// @param last The end of the range.
+    template <class InputIt> void insert(InputIt first, InputIt last) {
+        return Base::insert(first, last);
+    }
+
+    /// @brief Inserts a list of elements into the multiset.
+    /// @param ilist The initializer list of elements to insert.
+    void insert(std::initializer_list<value_type> ilist) {
+        return insert(ilist.begin(), ilist.end());
+    }
+
+    /// @brief Constructs an element in-place.
+    /// @tparam Args The types of the arguments to construct the element.
+    /// @param args The arguments to forward to the element's constructor.
+    /// @return An iterator to the inserted element.
+    template <class... Args> iterator emplace(Args&&... args) {
+        return Base::emplace(std::forward<Args>(args)...);
+    }
+
+    /// @brief Erases the element at the specified iterator position.
+    /// @return An iterator to the element following the erased one.
+    HMM_CONSTEXPR_20 iterator erase(const_iterator pos) {
+        return Base::erase(pos);
+    }
+
+    /// @brief Erases every element equal to `key`.
+    /// @return The number of elements removed.
+    size_type erase(const key_type& key) {
+        return Base::erase_key(key);
+    }
+
+    /// @brief Finds an element equal to the specified key.
+    /// @param key The key to look up.
+    /// @return An iterator to one of the matching elements, or `end()`.
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 iterator find(const K& key) const {
+        return Base::find(key);
+    }
+
+    /// @brief Checks if an element equal to the specified key exists.
+    /// @param key The key to look up.
+    /// @return `true` if the key exists, `false` otherwise.
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 bool contains(const K& key) const {
+        return Base::contains(key);
+    }
+
+    /// @brief Counts the elements equal to the specified key.
+    template <typename K> HMM_NODISCARD size_type count(const K& key) const {
+        return Base::count(key);
+    }
+
+    /// @brief Retrieves the range of elements equal to the specified key.
+    /// @details The range is traversed with key iterators, which visit only
+    /// the matching elements. `key_iterator::base()` converts an element of
+    /// the range back to a table-wide iterator, e.g. for `erase`.
+    template <typename K>
+    HMM_NODISCARD std::pair<key_iterator, key_iterator>
+    equal_range(const K& key) const {
+        return Base::equal_range(key);
+    }
+};
+
+#if HMM_HAS_CXX_17
+namespace pmr {
+/// @brief An alias for a `flat_hash_multiset` utilizing a polymorphic memory
+/// resource allocator.
+template <class Contained,
+          class Hash = typename SetPolicy<Contained>::default_hasher_type,
+          class Eq = typename SetPolicy<Contained>::default_eq_type>
+using flat_hash_multiset = ::hmm::flat_hash_multiset<
+    Contained, Hash, Eq,
+    std::pmr::polymorphic_allocator<typename SetPolicy<Contained>::slot_type>>;
+} // namespace pmr
+#endif
+
+} // namespace hmm
+
+#endif // HMM_HMM_FLAT_HASH_MULTISET_HPP
@@ -0,0 +1,134 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_FROZEN_HASH_MAP_HPP
+#define HMM_HMM_FROZEN_HASH_MAP_HPP
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/frozen-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief An immutable hash map addressed by a minimal perfect hash.
+///
+/// `frozen_hash_map` is built once from a range and never changes afterwards.
+/// Construction searches for a perfect hash function over the keys, so every
+/// lookup hashes the key, reads one slot and compares one key. There are no
+/// control bytes and no empty slots: the elements are stored contiguously and
+/// the index adds only a few bits per key.
+///
+/// Construction is far slower than filling a `flat_hash_map`, so the map
+/// suits read-only tables built at startup and queried in hot paths.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs>
+class frozen_hash_map
+    : protected internal::frozen_table<MapPolicy<Key, Value>, TArgs...> {
+    using Base = internal::frozen_table<MapPolicy<Key, Value>, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using mapped_type = Value;
+    using slot_type = typename Base::slot_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+    using allocator_type = typename Base::allocator_type;
+
+    using const_iterator = typename Base::const_iterator;
+    using iterator = typename Base::iterator;
+
+    /// @brief Constructs an empty map.
+    frozen_hash_map() : frozen_hash_map(std::initializer_list<slot_type>{}) {}
+
+    /// @brief Builds the map from a range. The first of several equal keys
+    /// is kept.
+    /// @param begin The beginning of the range.
+    /// @param end The end of the range.
+    /// @param hash The hash functor.
+    /// @param eq The equality functor.
+    /// @param alloc The allocator instance to use.
+    /// @throws std::invalid_argument If `hash` maps two distinct keys to the
+    /// same value.
+    template <class InputIt>
+    frozen_hash_map(InputIt begin, InputIt end,
+                    const hasher_type& hash = hasher_type(),
+                    const key_equal& eq = key_equal(),
+                    const allocator_type& alloc = allocator_type())
+        : Base(hash, eq, alloc) {
+        Base::build(begin, end);
+    }
+
+    /// @brief Builds the map from an initializer list.
+    frozen_hash_map(std::initializer_list<slot_type> initial,
+                    const hasher_type& hash = hasher_type(),
+                    const key_equal& eq = key_equal(),
+                    const allocator_type& alloc = allocator_type())
+        : frozen_hash_map(initial.begin(), initial.end(), hash, eq, alloc) {}
+
+    /// @name Read-Only Container Interfaces
+    ///@{
+    using Base::begin;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::empty;
+    using Base::end;
+    using Base::size;
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    using Base::contains;
+    using Base::count;
+    using Base::find;
+
+    /// @brief Accesses the value mapped to `key`.
+    /// @throws std::out_of_range If the key is not present.
+    template <class K = key_type>
+    HMM_NODISCARD const mapped_type& at(const K& key) const {
+        const auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("frozen_hash_map::at");
+        }
+        return it->second;
+    }
+    ///@}
+
+    /// @name Observers
+    ///@{
+    using Base::get_allocator;
+    using Base::hash_function;
+    using Base::key_eq;
+    ///@}
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_FROZEN_HASH_MAP_HPP
@@ -0,0 +1,106 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_FROZEN_HASH_SET_HPP
+#define HMM_HMM_FROZEN_HASH_SET_HPP
+
+#include <initializer_list>
+
+#include "hmm/flat-hash-set.hpp"
+#include "hmm/internal/frozen-table.hpp"
+
+namespace hmm {
+
+/// @brief An immutable hash set addressed by a minimal perfect hash.
+///
+/// The set counterpart of `frozen_hash_map`: built once from a range, stored
+/// without control bytes or empty slots, and answering each lookup with a
+/// single slot comparison.
+///
+/// @tparam Contained The type of elements stored in the set.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Contained>`)
+///               2. Equality functor (Defaults to `std::equal_to<Contained>`)
+///               3. Allocator (Defaults to `std::allocator<Contained>`)
+template <class Contained, class... TArgs>
+class frozen_hash_set
+    : protected internal::frozen_table<SetPolicy<Contained>, TArgs...> {
+    using Base = internal::frozen_table<SetPolicy<Contained>, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+    using allocator_type = typename Base::allocator_type;
+
+    using const_iterator = typename Base::const_iterator;
+    using iterator = typename Base::iterator;
+
+    /// @brief Constructs an empty set.
+    frozen_hash_set() : frozen_hash_set(std::initializer_list<value_type>{}) {}
+
+    /// @brief Builds the set from a range, dropping repeated elements.
+    /// @throws std::invalid_argument If `hash` maps two distinct elements to
+    /// the same value.
+    template <class InputIt>
+    frozen_hash_set(InputIt begin, InputIt end,
+                    const hasher_type& hash = hasher_type(),
+                    const key_equal& eq = key_equal(),
+                    const allocator_type& alloc = allocator_type())
+        : Base(hash, eq, alloc) {
+        Base::build(begin, end);
+    }
+
+    /// @brief Builds the set from an initializer list.
+    frozen_hash_set(std::initializer_list<value_type> initial,
+                    const hasher_type& hash = hasher_type(),
+                    const key_equal& eq = key_equal(),
+                    const allocator_type& alloc = allocator_type())
+        : frozen_hash_set(initial.begin(), initial.end(), hash, eq, alloc) {}
+
+    /// @name Read-Only Container Interfaces
+    ///@{
+    using Base::begin;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::empty;
+    using Base::end;
+    using Base::size;
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    using Base::contains;
+    using Base::count;
+    using Base::find;
+    ///@}
+
+    /// @name Observers
+    ///@{
+    using Base::get_allocator;
+    using Base::hash_function;
+    using Base::key_eq;
+    ///@}
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_FROZEN_HASH_SET_HPP
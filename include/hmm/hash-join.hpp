@@ -0,0 +1,365 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_HASH_JOIN_HPP
+#define HMM_HMM_HASH_JOIN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hmm/algorithm.hpp"
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/hash-mix.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief Tuning for `hash_join`, `hash_semi_join` and `hash_anti_join`.
+struct join_options {
+    /// @brief Lets the join pick the partition count from the build size.
+    static constexpr int kAutoPartitions = -1;
+
+    /// @brief The number of radix partitions per side, as a power of two,
+    /// or `kAutoPartitions`. Zero joins through a single table.
+    int partition_bits = 0;
+
+    /// @brief The number of rows hashed and prefetched together, at most
+    /// 64.
+    std::size_t batch_size = 16;
+};
+
+namespace internal {
+
+enum class JoinKind { kInner, kSemi, kAnti };
+
+/// @brief The build side of a join: a `flat_hash_map` from each distinct key
+/// to the first build row with it, with the later rows of a key chained
+/// through a shared `next` array of row indices.
+template <class Key> class JoinTable {
+    using Map = flat_hash_map<Key, std::uint32_t>;
+    using Raw = TableAccess::Raw<Map>;
+
+  public:
+    static constexpr std::uint32_t kNone =
+        std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief Builds an empty table; rows are chained through `next`, or
+    /// only the first row of each key is kept if it is null.
+    explicit JoinTable(std::uint32_t* next) : next_(next) {}
+
+    /// @brief Empties the table and sizes it for `n` rows.
+    void reset(std::size_t n) {
+        map_.clear();
+        map_.reserve(n);
+    }
+
+    HMM_NODISCARD std::size_t hash(const Key& key) const {
+        return raw().hasher()(key);
+    }
+
+    void prefetch(std::size_t hash) const noexcept {
+        raw().prefetch_hashed(hash);
+    }
+
+    /// @brief Adds build row `row`. Rows must be added in reverse order for
+    /// the chains to list them in build order.
+    void add(const Key& key, std::size_t hash, std::uint32_t row) {
+        Raw& table = raw();
+        auto info = table.find_or_prepare_insert_hashed(key, hash);
+        if (info.found) {
+            if (next_ != nullptr) {
+                auto& head = table.slots_ptr()[info.index].second;
+                next_[row] = head;
+                head = row;
+            }
+            return;
+        }
+        if (next_ != nullptr) {
+            next_[row] = kNone;
+        }
+        table.insert_at_index(info.index, hash,
+                              typename Raw::slot_type(key, row));
+    }
+
+    /// @brief Returns the first build row with `key`, or `kNone`.
+    HMM_NODISCARD std::uint32_t find(const Key& key, std::size_t hash) const {
+        const auto it = raw().find_hashed(key, hash);
+        return it == raw().end() ? kNone : it->second;
+    }
+
+    HMM_NODISCARD std::uint32_t next(std::uint32_t row) const noexcept {
+        return next_[row];
+    }
+
+  private:
+    Raw& raw() noexcept {
+        return TableAccess::raw(map_);
+    }
+    const Raw& raw() const noexcept {
+        return TableAccess::raw(map_);
+    }
+
+    Map map_;
+    std::uint32_t* next_;
+};
+
+template <JoinKind Kind>
+using JoinTag = std::integral_constant<JoinKind, Kind>;
+
+/// @brief Emits every build row in the chain starting at `match`.
+template <class Key, class BuildIt, class Row, class Emit>
+void EmitMatches(JoinTag<JoinKind::kInner>, const JoinTable<Key>& table,
+                 std::uint32_t match, BuildIt build, const Row& row,
+                 Emit& emit) {
+    for (; match != JoinTable<Key>::kNone; match = table.next(match)) {
+        emit(build[match], row);
+    }
+}
+
+template <class Key, class BuildIt, class Row, class Emit>
+void EmitMatches(JoinTag<JoinKind::kSemi>, const JoinTable<Key>&,
+                 std::uint32_t match, BuildIt, const Row& row, Emit& emit) {
+    if (match != JoinTable<Key>::kNone) {
+        emit(row);
+    }
+}
+
+template <class Key, class BuildIt, class Row, class Emit>
+void EmitMatches(JoinTag<JoinKind::kAnti>, const JoinTable<Key>&,
+                 std::uint32_t match, BuildIt, const Row& row, Emit& emit) {
+    if (match == JoinTable<Key>::kNone) {
+        emit(row);
+    }
+}
+
+/// @brief The largest batch of rows hashed and prefetched together.
+constexpr std::size_t kMaxJoinBatch = 64;
+
+/// @brief Probes `table` with the probe rows listed by `rows`, a batch at a
+/// time: every row of a batch is hashed and its first probe window
+/// prefetched before any is looked up, so that their cache misses overlap.
+template <JoinKind Kind, class Key, class BuildIt, class ProbeIt,
+          class Rows, class KeyFn, class Emit>
+void ProbeRows(const JoinTable<Key>& table, BuildIt build, ProbeIt probe,
+               const Rows& rows, std::size_t first, std::size_t last,
+               std::size_t batch, KeyFn& key_fn, Emit& emit) {
+    std::size_t hashes[kMaxJoinBatch];
+    while (first < last) {
+        const std::size_t n = last - first < batch ? last - first : batch;
+        for (std::size_t i = 0; i < n; ++i) {
+            hashes[i] = table.hash(key_fn(probe[rows(first + i)]));
+            table.prefetch(hashes[i]);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& row = probe[rows(first + i)];
+            EmitMatches(JoinTag<Kind>(), table,
+                        table.find(key_fn(row), hashes[i]), build, row, emit);
+        }
+        first += n;
+    }
+}
+
+/// @brief Adds the build rows listed by `rows` to `table`, last first and a
+/// batch at a time like `ProbeRows`.
+template <class Key, class BuildIt, class Rows, class KeyFn>
+void BuildRows(JoinTable<Key>& table, BuildIt build, const Rows& rows,
+               std::size_t first, std::size_t last, std::size_t batch,
+               KeyFn& key_fn) {
+    table.reset(last - first);
+    std::size_t hashes[kMaxJoinBatch];
+    while (last > first) {
+        const std::size_t n = last - first < batch ? last - first : batch;
+        for (std::size_t i = 0; i < n; ++i) {
+            hashes[i] = table.hash(key_fn(build[rows(last - 1 - i)]));
+            table.prefetch(hashes[i]);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t row = rows(last - 1 - i);
+            table.add(key_fn(build[row]), hashes[i],
+                      static_cast<std::uint32_t>(row));
+        }
+        last -= n;
+    }
+}
+
+/// @brief The row indices of one side of a join, grouped by partition.
+struct Partitioned {
+    std::vector<std::uint32_t> rows;
+    std::vector<std::size_t> offsets;
+
+    std::size_t operator()(std::size_t i) const noexcept {
+        return rows[i];
+    }
+};
+
+/// @brief Radix-partitions rows `[0, n)` by their hash, remixed so that the
+/// partition does not fix the bits the tables index or filter by.
+template <class Key, class It, class KeyFn>
+Partitioned PartitionRows(const JoinTable<Key>& table, It rows,
+                          std::size_t n, int bits, KeyFn& key_fn) {
+    const std::size_t parts = std::size_t(1) << bits;
+    std::vector<std::uint16_t> part(n);
+    Partitioned out;
+    out.offsets.assign(parts + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint64_t mixed = Mix64(table.hash(key_fn(rows[i])));
+        part[i] = static_cast<std::uint16_t>(mixed >> (64 - bits));
+        ++out.offsets[part[i] + 1];
+    }
+    for (std::size_t p = 0; p < parts; ++p) {
+        out.offsets[p + 1] += out.offsets[p];
+    }
+    std::vector<std::size_t> fill(out.offsets.begin(), out.offsets.end() - 1);
+    out.rows.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        out.rows[fill[part[i]]++] = static_cast<std::uint32_t>(i);
+    }
+    return out;
+}
+
+/// @brief Picks enough partitions for each partition's table to stay
+/// within about 512 KiB, the share of L2 a core can usually count on.
+template <class Key> int AutoPartitionBits(std::size_t build_rows) {
+    constexpr std::size_t kTableBudget = std::size_t(512) << 10;
+    // A slot and a control byte per row, at up to 7/8 load.
+    const std::size_t bytes =
+        build_rows * (sizeof(std::pair<Key, std::uint32_t>) + 1) * 8 / 7;
+    int bits = 0;
+    while (bits < 12 && (bytes >> bits) > kTableBudget) {
+        ++bits;
+    }
+    return bits;
+}
+
+template <JoinKind Kind, class BuildRange, class ProbeRange, class KeyFn,
+          class Emit>
+void HashJoin(const BuildRange& build_range, const ProbeRange& probe_range,
+              KeyFn& key_fn, Emit& emit, const join_options& options) {
+    using std::begin;
+    using std::end;
+    const auto build = begin(build_range);
+    const auto probe = begin(probe_range);
+    using BuildIt = typename std::decay<decltype(build)>::type;
+    using ProbeIt = typename std::decay<decltype(probe)>::type;
+    static_assert(
+        std::is_base_of<std::random_access_iterator_tag,
+                        typename std::iterator_traits<
+                            BuildIt>::iterator_category>::value &&
+            std::is_base_of<std::random_access_iterator_tag,
+                            typename std::iterator_traits<
+                                ProbeIt>::iterator_category>::value,
+        "hash_join requires random access ranges");
+    using Key = typename std::decay<decltype(key_fn(*build))>::type;
+
+    const auto n_build = static_cast<std::size_t>(end(build_range) - build);
+    const auto n_probe = static_cast<std::size_t>(end(probe_range) - probe);
+    if (n_build >= JoinTable<Key>::kNone || n_probe >= JoinTable<Key>::kNone) {
+        throw std::length_error("hash_join: 2^32 - 1 or more rows");
+    }
+
+    // Only inner joins need every build row of a key.
+    std::vector<std::uint32_t> next(Kind == JoinKind::kInner ? n_build : 0);
+    JoinTable<Key> table(next.empty() ? nullptr : next.data());
+    std::size_t batch = options.batch_size == 0 ? 1 : options.batch_size;
+    batch = batch > kMaxJoinBatch ? kMaxJoinBatch : batch;
+    const int bits = options.partition_bits == join_options::kAutoPartitions
+                         ? AutoPartitionBits<Key>(n_build)
+                         : options.partition_bits;
+
+    if (bits <= 0) {
+        const auto identity = [](std::size_t i) { return i; };
+        BuildRows(table, build, identity, 0, n_build, batch, key_fn);
+        ProbeRows<Kind>(table, build, probe, identity, 0, n_probe, batch,
+                        key_fn, emit);
+        return;
+    }
+
+    const int clamped = bits > 16 ? 16 : bits;
+    const Partitioned build_parts =
+        PartitionRows(table, build, n_build, clamped, key_fn);
+    const Partitioned probe_parts =
+        PartitionRows(table, probe, n_probe, clamped, key_fn);
+    for (std::size_t p = 0; p + 1 < build_parts.offsets.size(); ++p) {
+        BuildRows(table, build, build_parts, build_parts.offsets[p],
+                  build_parts.offsets[p + 1], batch, key_fn);
+        ProbeRows<Kind>(table, build, probe, probe_parts,
+                        probe_parts.offsets[p], probe_parts.offsets[p + 1],
+                        batch, key_fn, emit);
+    }
+}
+
+} // namespace internal
+
+/// @name Hash Joins
+/// Equi-joins of two random access ranges on `key_fn(row)`, which must
+/// accept rows of both sides and return the same hashable key type.
+///
+/// The build side goes into a `flat_hash_map` from each distinct key to its
+/// rows, reserved once for the whole side. Both sides are read in batches
+/// of `join_options::batch_size` rows, each batch hashed and its first probe
+/// windows prefetched before any lookup, so the cache misses of a batch
+/// overlap. Results come in probe order.
+///
+/// `join_options::partition_bits` first splits both sides into radix
+/// partitions by hash and joins each partition on its own, with a table
+/// small enough to stay in cache; `kAutoPartitions` sizes them for L2.
+/// Partitions then read rows out of order, so this pays off mainly when
+/// build keys repeat and their rows would otherwise be gathered from all
+/// over the build side. Results come grouped by partition.
+///
+/// Each side may hold at most 2^32 - 2 rows; more throws
+/// `std::length_error`.
+///@{
+
+/// @brief Calls `emit(build_row, probe_row)` for every pair of rows with
+/// equal keys. For a probe row, build rows come in build order.
+template <class BuildRange, class ProbeRange, class KeyFn, class Emit>
+void hash_join(const BuildRange& build, const ProbeRange& probe, KeyFn key_fn,
+               Emit emit, const join_options& options = join_options()) {
+    internal::HashJoin<internal::JoinKind::kInner>(build, probe, key_fn, emit,
+                                                   options);
+}
+
+/// @brief Calls `emit(probe_row)` once for every probe row whose key occurs
+/// on the build side.
+template <class BuildRange, class ProbeRange, class KeyFn, class Emit>
+void hash_semi_join(const BuildRange& build, const ProbeRange& probe,
+                    KeyFn key_fn, Emit emit,
+                    const join_options& options = join_options()) {
+    internal::HashJoin<internal::JoinKind::kSemi>(build, probe, key_fn, emit,
+                                                  options);
+}
+
+/// @brief Calls `emit(probe_row)` for every probe row whose key does not
+/// occur on the build side.
+template <class BuildRange, class ProbeRange, class KeyFn, class Emit>
+void hash_anti_join(const BuildRange& build, const ProbeRange& probe,
+                    KeyFn key_fn, Emit emit,
+                    const join_options& options = join_options()) {
+    internal::HashJoin<internal::JoinKind::kAnti>(build, probe, key_fn, emit,
+                                                  options);
+}
+///@}
+
+} // namespace hmm
+
+#endif // HMM_HMM_HASH_JOIN_HPP
@@ -0,0 +1,187 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INLINE_FLAT_HASH_MAP_HPP
+#define HMM_HMM_INLINE_FLAT_HASH_MAP_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/inline-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A flat hash map of at most `N` elements, stored entirely inside the
+/// object.
+///
+/// The map counterpart of `inline_flat_hash_set`: no heap allocation, the
+/// same group probing as `flat_hash_map`, `std::length_error` when a new key
+/// would exceed `N`, and trivially copyable when `Key` and `Value` are.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam N The maximum number of elements.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+template <class Key, class Value, std::size_t N, class... TArgs>
+class inline_flat_hash_map
+    : protected internal::inline_table<MapPolicy<Key, Value>, N, TArgs...> {
+    using Base = internal::inline_table<MapPolicy<Key, Value>, N, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using mapped_type = Value;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+
+    using iterator = typename Base::iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    /// @brief The number of slots, fixed at compile time.
+    static constexpr size_type kCapacity = Base::kCapacity;
+
+    /// @brief Constructs an empty map.
+    inline_flat_hash_map() = default;
+
+    explicit inline_flat_hash_map(const hasher_type& hash,
+                                  const key_equal& eq = key_equal())
+        : Base(hash, eq) {}
+
+    /// @brief Constructs the map with the contents of a range. The first of
+    /// several equal keys is kept.
+    /// @throws std::length_error If the range holds more than `N` distinct
+    /// keys.
+    template <class InputIt>
+    inline_flat_hash_map(InputIt first, InputIt last,
+                         const hasher_type& hash = hasher_type(),
+                         const key_equal& eq = key_equal())
+        : Base(hash, eq) {
+        insert(first, last);
+    }
+
+    /// @brief Constructs the map with the contents of an initializer list.
+    inline_flat_hash_map(std::initializer_list<value_type> initial,
+                         const hasher_type& hash = hasher_type(),
+                         const key_equal& eq = key_equal())
+        : inline_flat_hash_map(initial.begin(), initial.end(), hash, eq) {}
+
+    /// @name Standard Container Interfaces
+    ///@{
+    using Base::begin;
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::empty;
+    using Base::end;
+    using Base::erase;
+    using Base::erase_element;
+    using Base::full;
+    using Base::max_size;
+    using Base::size;
+    ///@}
+
+    /// @name Modifiers
+    ///@{
+    using Base::emplace;
+    using Base::insert;
+    using Base::try_emplace;
+
+    /// @brief Inserts a range of elements.
+    template <class InputIt> void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            Base::insert(*first);
+        }
+    }
+
+    /// @brief Inserts a list of elements.
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /// @brief Inserts `value` under `key`, or assigns it to the existing
+    /// element.
+    template <class K, class V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+        auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    using Base::contains;
+    using Base::count;
+    using Base::find;
+
+    /// @brief Accesses the value mapped to `key`.
+    /// @throws std::out_of_range If the key is not present.
+    template <class K = key_type> HMM_NODISCARD mapped_type& at(const K& key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("inline_flat_hash_map::at");
+        }
+        return it->second;
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD const mapped_type& at(const K& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("inline_flat_hash_map::at");
+        }
+        return it->second;
+    }
+
+    /// @brief Accesses the value mapped to `key`, value-initializing it first
+    /// if the key is new.
+    /// @throws std::length_error If the key is new and the map holds `N`
+    /// elements.
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+    ///@}
+
+    /// @name Observers
+    ///@{
+    using Base::hash_function;
+    using Base::key_eq;
+    ///@}
+};
+
+template <class Key, class Value, std::size_t N, class... TArgs>
+constexpr typename inline_flat_hash_map<Key, Value, N, TArgs...>::size_type
+    inline_flat_hash_map<Key, Value, N, TArgs...>::kCapacity;
+
+} // namespace hmm
+
+#endif // HMM_HMM_INLINE_FLAT_HASH_MAP_HPP
@@ -0,0 +1,173 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INLINE_FLAT_HASH_SET_HPP
+#define HMM_HMM_INLINE_FLAT_HASH_SET_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "hmm/flat-hash-set.hpp"
+#include "hmm/internal/inline-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A flat hash set of at most `N` elements, stored entirely inside the
+/// object.
+///
+/// The control bytes and slots are member arrays sized at compile time, so
+/// the set never touches the heap and can be embedded in other structs or
+/// kept on the stack as hot-path scratch space. Lookups use the same group
+/// probing as `flat_hash_set`.
+///
+/// Inserting a new element into a set that already holds `N` throws
+/// `std::length_error`; check `full()` first to avoid it. When `Contained` is
+/// trivially copyable, so is the set, and containers of sets relocate them
+/// with `memcpy`.
+///
+/// @tparam Contained The type of elements stored in the set.
+/// @tparam N The maximum number of elements.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Contained>`)
+///               2. Equality functor (Defaults to `std::equal_to<Contained>`)
+template <class Contained, std::size_t N, class... TArgs>
+class inline_flat_hash_set
+    : protected internal::inline_table<SetPolicy<Contained>, N, TArgs...> {
+    using Base = internal::inline_table<SetPolicy<Contained>, N, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+
+    using iterator = typename Base::const_iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    /// @brief The number of slots, fixed at compile time.
+    static constexpr size_type kCapacity = Base::kCapacity;
+
+    /// @brief Constructs an empty set.
+    inline_flat_hash_set() = default;
+
+    explicit inline_flat_hash_set(const hasher_type& hash,
+                                  const key_equal& eq = key_equal())
+        : Base(hash, eq) {}
+
+    /// @brief Constructs the set with the contents of a range.
+    /// @throws std::length_error If the range holds more than `N` distinct
+    /// elements.
+    template <class InputIt>
+    inline_flat_hash_set(InputIt first, InputIt last,
+                         const hasher_type& hash = hasher_type(),
+                         const key_equal& eq = key_equal())
+        : Base(hash, eq) {
+        insert(first, last);
+    }
+
+    /// @brief Constructs the set with the contents of an initializer list.
+    inline_flat_hash_set(std::initializer_list<value_type> initial,
+                         const hasher_type& hash = hasher_type(),
+                         const key_equal& eq = key_equal())
+        : inline_flat_hash_set(initial.begin(), initial.end(), hash, eq) {}
+
+    /// @name Standard Container Interfaces
+    ///@{
+    HMM_NODISCARD const_iterator begin() const noexcept {
+        return Base::begin();
+    }
+    HMM_NODISCARD const_iterator end() const noexcept {
+        return Base::end();
+    }
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::empty;
+    using Base::erase_element;
+    using Base::full;
+    using Base::max_size;
+    using Base::size;
+    ///@}
+
+    /// @name Modifiers
+    ///@{
+    /// @brief Inserts `value` unless it is already present.
+    /// @throws std::length_error If `value` is new and the set holds `N`
+    /// elements.
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return Base::insert(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return Base::insert(std::move(value));
+    }
+
+    /// @brief Constructs an element in place unless it is already present.
+    /// @throws std::length_error If the element is new and the set holds `N`
+    /// elements.
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        return Base::emplace(std::forward<Args>(args)...);
+    }
+
+    /// @brief Inserts a range of elements.
+    template <class InputIt> void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            Base::insert(*first);
+        }
+    }
+
+    /// @brief Inserts a list of elements.
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /// @brief Removes the element at `pos`. A loop that erases while
+    /// iterating may visit an element twice; see `internal::fixed_table`.
+    iterator erase(const_iterator pos) {
+        return Base::erase(pos);
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    template <class K = key_type>
+    HMM_NODISCARD const_iterator find(const K& key) const {
+        return Base::find(key);
+    }
+    using Base::contains;
+    using Base::count;
+    ///@}
+
+    /// @name Observers
+    ///@{
+    using Base::hash_function;
+    using Base::key_eq;
+    ///@}
+};
+
+template <class Contained, std::size_t N, class... TArgs>
+constexpr typename inline_flat_hash_set<Contained, N, TArgs...>::size_type
+    inline_flat_hash_set<Contained, N, TArgs...>::kCapacity;
+
+} // namespace hmm
+
+#endif // HMM_HMM_INLINE_FLAT_HASH_SET_HPP
@@ -0,0 +1,125 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_ATOMIC_CTRL_HPP
+#define HMM_HMM_INTERNAL_ATOMIC_CTRL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "hmm/internal/bit-mask.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Control bytes shared between threads, packed eight to an atomic
+/// word.
+///
+/// Concurrent tables cannot load a group with a plain vector load while
+/// another thread stores into it, so they keep their control bytes in
+/// atomic words instead. Probing then visits aligned groups: each group is
+/// exactly two words, which are loaded atomically and matched with the usual
+/// `Group` operations. Byte positions within a word follow memory order, so
+/// the encoding is independent of endianness.
+using CtrlWord = std::atomic<std::uint64_t>;
+
+constexpr std::size_t kCtrlWordBytes = sizeof(std::uint64_t);
+
+/// @brief A control word of eight empty bytes.
+constexpr std::uint64_t kEmptyCtrlWord = 0x8080808080808080ULL;
+
+/// @brief The number of control words for a table of `capacity` slots.
+constexpr std::size_t CtrlWordCount(std::size_t capacity) noexcept {
+    return capacity / kCtrlWordBytes;
+}
+
+/// @brief Extracts the control byte at `index` of a word.
+inline std::int8_t CtrlByte(std::uint64_t word, std::size_t index) noexcept {
+    std::int8_t c;
+    std::memcpy(&c,
+                reinterpret_cast<const unsigned char*>(&word) +
+                    index % kCtrlWordBytes,
+                1);
+    return c;
+}
+
+/// @brief Returns `word` with the control byte at `index` replaced by `c`.
+inline std::uint64_t WithCtrlByte(std::uint64_t word, std::size_t index,
+                                  std::int8_t c) noexcept {
+    std::memcpy(reinterpret_cast<unsigned char*>(&word) +
+                    index % kCtrlWordBytes,
+                &c, 1);
+    return word;
+}
+
+/// @brief Loads the aligned group `group` with acquire semantics.
+inline Group LoadCtrlGroup(const CtrlWord* ctrl, std::size_t group) noexcept {
+    const std::uint64_t words[2] = {
+        ctrl[group * 2].load(std::memory_order_acquire),
+        ctrl[group * 2 + 1].load(std::memory_order_acquire)};
+    std::int8_t bytes[Group::kWidth];
+    std::memcpy(bytes, words, Group::kWidth);
+    return Group::Load(bytes);
+}
+
+/// @brief Loads a single control byte with acquire semantics.
+inline std::int8_t LoadCtrl(const CtrlWord* ctrl, std::size_t index) noexcept {
+    const CtrlWord& word = ctrl[index / kCtrlWordBytes];
+    return CtrlByte(word.load(std::memory_order_acquire), index);
+}
+
+/// @brief Publishes a control byte with release semantics.
+/// @details Only valid while no other thread stores into the same word.
+inline void StoreCtrl(CtrlWord* ctrl, std::size_t index,
+                      std::int8_t c) noexcept {
+    CtrlWord& word = ctrl[index / kCtrlWordBytes];
+    word.store(WithCtrlByte(word.load(std::memory_order_relaxed), index, c),
+               std::memory_order_release);
+}
+
+/// @brief Atomically replaces the control byte at `index` if it holds
+/// `from`. Stores to neighbouring bytes are tolerated and retried.
+/// @return `true` if this thread performed the replacement.
+inline bool TryClaimCtrl(CtrlWord* ctrl, std::size_t index, std::int8_t from,
+                         std::int8_t to) noexcept {
+    CtrlWord& word = ctrl[index / kCtrlWordBytes];
+    std::uint64_t expected = word.load(std::memory_order_relaxed);
+    while (CtrlByte(expected, index) == from) {
+        if (word.compare_exchange_weak(expected,
+                                       WithCtrlByte(expected, index, to),
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Replaces a control byte owned by the calling thread, with release
+/// semantics, while other threads may store into neighbouring bytes.
+inline void ReleaseOwnedCtrl(CtrlWord* ctrl, std::size_t index,
+                             std::int8_t from, std::int8_t to) noexcept {
+    const std::uint64_t delta =
+        WithCtrlByte(0, index, static_cast<std::int8_t>(from ^ to));
+    ctrl[index / kCtrlWordBytes].fetch_xor(delta, std::memory_order_release);
+}
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_ATOMIC_CTRL_HPP
@@ -32,6 +32,10 @@
     (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
 #define HMM_SSE2 1
 #include <emmintrin.h>
+#if defined(__AVX2__)
+#define HMM_AVX2 1
+#include <immintrin.h>
+#endif
 #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
 #define HMM_NEON 1
 #include <arm_neon.h>
@@ -53,6 +57,19 @@ inline uint32_t CountTrailingZeros(uint32_t n) {
 #endif
 }
 
+// Portable Count Trailing Zeros for 64-bit words
+inline uint32_t CountTrailingZeros64(uint64_t n) {
+#if defined(_MSC_VER)
+    const uint32_t low = static_cast<uint32_t>(n);
+    if (low != 0) {
+        return CountTrailingZeros(low);
+    }
+    return 32 + CountTrailingZeros(static_cast<uint32_t>(n >> 32));
+#else
+    return n == 0 ? 64 : __builtin_ctzll(n);
+#endif
+}
+
 // Wrapper for the result of a SIMD comparison
 class BitMask {
   public:
@@ -72,6 +89,11 @@ class BitMask {
         return mask_ != 0;
     }
 
+    // Keep only the bits also set in `other`
+    constexpr BitMask operator&(BitMask other) const {
+        return BitMask(mask_ & other.mask_);
+    }
+
   private:
     uint32_t mask_;
 };
@@ -145,6 +167,38 @@ struct Group {
             }
         }
         return BitMask(mask);
+#endif
+    }
+
+    // Returns a mask where 1 bits indicate the byte holds an element (>= 0)
+    BitMask MatchFull() const {
+#if defined(HMM_SSE2)
+        return BitMask(~_mm_movemask_epi8(data) & 0xFFFF);
+#else
+        uint32_t mask = 0;
+        const int8_t* bytes = reinterpret_cast<const int8_t*>(&data);
+        for (std::size_t i = 0; i < 16; ++i) {
+            if (bytes[i] >= 0) {
+                mask |= (1 << i);
+            }
+        }
+        return BitMask(mask);
+#endif
+    }
+
+    // Returns a mask where 1 bits indicate the byte holds no element (< 0)
+    BitMask MatchNonFull() const {
+#if defined(HMM_SSE2)
+        return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(data)));
+#else
+        uint32_t mask = 0;
+        const int8_t* bytes = reinterpret_cast<const int8_t*>(&data);
+        for (std::size_t i = 0; i < 16; ++i) {
+            if (bytes[i] < 0) {
+                mask |= (1 << i);
+            }
+        }
+        return BitMask(mask);
 #endif
     }
 };
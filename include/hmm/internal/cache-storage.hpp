@@ -0,0 +1,367 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_INTERNAL_CACHE_STORAGE_HPP
+#define HMM_HMM_INTERNAL_CACHE_STORAGE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "hmm/internal/index-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Entry storage with stable positions, shared by the caches and
+/// `expiring_hash_map`.
+///
+/// All entries live in one array and are addressed by 32-bit positions,
+/// which a SwissTable of indices maps keys to. Erased positions are recycled
+/// through a free list, and the index table is sized so that tombstones are
+/// always purged in place. Unless explicitly grown, the storage therefore
+/// never allocates after construction.
+///
+/// @tparam Key The key type.
+/// @tparam Value The mapped value type.
+/// @tparam Meta The per-entry bookkeeping of the owning container.
+/// @tparam Hash The hashing functor.
+/// @tparam Eq The equality functor.
+/// @tparam Alloc The allocator, rebound for every internal buffer.
+template <class Key, class Value, class Meta, class Hash, class Eq,
+          class Alloc>
+class CacheStorage {
+  public:
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+
+    /// @brief A position of the storage; the element is only constructed
+    /// while `live` is set.
+    struct Entry {
+        Entry() {}
+        ~Entry() {}
+
+        union {
+            value_type value;
+        };
+        Meta meta{};
+        bool live = false;
+    };
+
+  private:
+    using EntryAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Entry>;
+    using EntryTraits = std::allocator_traits<EntryAlloc>;
+    using ValueAlloc = typename std::allocator_traits<
+        Alloc>::template rebind_alloc<value_type>;
+    using ValueTraits = std::allocator_traits<ValueAlloc>;
+    using PositionAlloc = typename std::allocator_traits<
+        Alloc>::template rebind_alloc<std::uint32_t>;
+    using Index = index_table<CacheStorage, Hash, Eq, Alloc>;
+
+    template <class, class> friend class IndexHasher;
+    template <class, class> friend class IndexEq;
+
+  public:
+    using FindInfo = typename Index::FindInfo;
+
+    /// @brief Marks the absence of a position.
+    static constexpr std::uint32_t kNone =
+        std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief Allocates room for `capacity` entries.
+    /// @throws std::length_error If `capacity` exceeds 2^32 - 2 entries.
+    CacheStorage(size_type capacity, const Hash& hash, const Eq& eq,
+                 const Alloc& alloc)
+        : alloc_(alloc), free_(PositionAlloc(alloc)),
+          index_(IndexHasher<CacheStorage, Hash>(this, hash),
+                 IndexEq<CacheStorage, Eq>(this, eq), alloc) {
+        check_capacity(capacity);
+        entries_ = allocate(capacity);
+        capacity_ = capacity;
+        add_free_positions(0);
+    }
+
+    /// @brief Copies every entry to the same position, so that positions
+    /// held by the cache remain valid.
+    CacheStorage(const CacheStorage& other)
+        : alloc_(EntryTraits::select_on_container_copy_construction(
+              other.alloc_)),
+          free_(other.free_), index_(other.index_) {
+        rebind();
+        entries_ = allocate(other.capacity_);
+        capacity_ = other.capacity_;
+        try {
+            for (size_type i = 0; i < capacity_; ++i) {
+                entries_[i].meta = other.entries_[i].meta;
+                if (other.entries_[i].live) {
+                    construct(static_cast<std::uint32_t>(i),
+                              other.entries_[i].value);
+                }
+            }
+        } catch (...) {
+            destroy_all();
+            throw;
+        }
+    }
+
+    /// @brief Moves the storage; the source is left with no capacity.
+    CacheStorage(CacheStorage&& other) noexcept
+        : alloc_(std::move(other.alloc_)), entries_(other.entries_),
+          capacity_(other.capacity_), free_(std::move(other.free_)),
+          index_(std::move(other.index_)) {
+        rebind();
+        other.entries_ = nullptr;
+        other.capacity_ = 0;
+        other.free_.clear();
+    }
+
+    CacheStorage& operator=(const CacheStorage& other) {
+        if (this != &other) {
+            CacheStorage tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    CacheStorage& operator=(CacheStorage&& other) noexcept {
+        if (this != &other) {
+            destroy_all();
+            alloc_ = std::move(other.alloc_);
+            entries_ = other.entries_;
+            capacity_ = other.capacity_;
+            free_ = std::move(other.free_);
+            index_ = std::move(other.index_);
+            rebind();
+            other.entries_ = nullptr;
+            other.capacity_ = 0;
+            other.free_.clear();
+        }
+        return *this;
+    }
+
+    ~CacheStorage() {
+        destroy_all();
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return index_.size();
+    }
+
+    HMM_NODISCARD size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    HMM_NODISCARD Entry& entry(std::uint32_t position) noexcept {
+        return entries_[position];
+    }
+
+    HMM_NODISCARD const Entry& entry(std::uint32_t position) const noexcept {
+        return entries_[position];
+    }
+
+    /// @brief Finds the position holding `key`.
+    /// @return The position, or `kNone` if `key` is not cached.
+    template <class K>
+    HMM_NODISCARD std::uint32_t find(const K& key) const {
+        auto it = index_.find(key);
+        return it == index_.end() ? kNone : it->index;
+    }
+
+    /// @brief Probes for `key` once, either finding its position or
+    /// preparing its insertion by `emplace_prepared`.
+    template <class K> HMM_NODISCARD FindInfo prepare(const K& key) {
+        return index_.find_or_prepare_insert(key);
+    }
+
+    /// @brief The position of a key found by `prepare`.
+    HMM_NODISCARD std::uint32_t position(const FindInfo& info) const noexcept {
+        return index_.slots_ptr()[info.index].index;
+    }
+
+    /// @brief Constructs the element for a key whose absence `prepare`
+    /// established, with fresh bookkeeping. A position must be free.
+    /// @return The position of the new element.
+    template <class K, class... Args>
+    std::uint32_t emplace_prepared(FindInfo info, K&& key, Args&&... args) {
+        if (index_.needs_resize()) {
+            index_.rehash_and_grow();
+            info = index_.find_or_prepare_insert_hashed(key, info.full_hash);
+        }
+        const std::uint32_t position = free_.back();
+        construct(position, std::piecewise_construct,
+                  std::forward_as_tuple(std::forward<K>(key)),
+                  std::forward_as_tuple(std::forward<Args>(args)...));
+        entries_[position].meta = Meta{};
+        free_.pop_back();
+        index_.insert_at_index(info.index, info.full_hash,
+                               IndexSlot{position});
+        return position;
+    }
+
+    /// @brief Destroys the element at `position` and frees the position.
+    void erase(std::uint32_t position) {
+        index_.erase(index_.find(IndexSlot{position}));
+        destroy(position);
+        free_.push_back(position);
+    }
+
+    /// @brief Enlarges the storage to `capacity` positions. Elements keep
+    /// their positions, and are moved if that cannot throw.
+    /// @throws std::length_error If `capacity` exceeds 2^32 - 2 entries.
+    void grow(size_type capacity) {
+        check_capacity(capacity);
+        Entry* entries = allocate(capacity);
+        size_type i = 0;
+        try {
+            for (; i < capacity_; ++i) {
+                entries[i].meta = entries_[i].meta;
+                if (entries_[i].live) {
+                    ValueAlloc alloc(alloc_);
+                    ValueTraits::construct(
+                        alloc, &entries[i].value,
+                        std::move_if_noexcept(entries_[i].value));
+                    entries[i].live = true;
+                }
+            }
+        } catch (...) {
+            release(entries, i, capacity);
+            throw;
+        }
+
+        const size_type old_capacity = capacity_;
+        destroy_all();
+        entries_ = entries;
+        capacity_ = capacity;
+        add_free_positions(old_capacity);
+    }
+
+    /// @brief Destroys every element, keeping all buffers.
+    void clear() {
+        index_.clear();
+        free_.clear();
+        for (size_type i = capacity_; i-- > 0;) {
+            destroy(static_cast<std::uint32_t>(i));
+            entries_[i].meta = Meta{};
+            free_.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+  private:
+    /// @brief Resolves a position back to its key for the index table.
+    HMM_NODISCARD const Key& key_at(std::uint32_t position) const {
+        return entries_[position].value.first;
+    }
+
+    /// @brief Re-points the index table's functors at this instance.
+    void rebind() noexcept {
+        index_.hasher().rebind(this);
+        index_.equal().rebind(this);
+    }
+
+    static void check_capacity(size_type capacity) {
+        if (capacity >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("cache exceeds 2^32 - 2 entries");
+        }
+    }
+
+    /// @brief Allocates an array of `capacity` entries, none of them live.
+    HMM_NODISCARD Entry* allocate(size_type capacity) {
+        if (capacity == 0) {
+            return nullptr;
+        }
+        Entry* entries =
+            std::addressof(*EntryTraits::allocate(alloc_, capacity));
+        for (size_type i = 0; i < capacity; ++i) {
+            EntryTraits::construct(alloc_, entries + i);
+        }
+        return entries;
+    }
+
+    /// @brief Pushes the positions from `first` up to the capacity onto the
+    /// free list, lowest on top, and sizes the index table to match.
+    void add_free_positions(size_type first) {
+        free_.reserve(capacity_);
+        for (size_type i = capacity_; i-- > first;) {
+            free_.push_back(static_cast<std::uint32_t>(i));
+        }
+        // Keeping the load at most 7/16 lets every rehash purge tombstones
+        // in place rather than grow.
+        index_.reserve(capacity_ * 2);
+    }
+
+    template <class... Args>
+    void construct(std::uint32_t position, Args&&... args) {
+        ValueAlloc alloc(alloc_);
+        ValueTraits::construct(alloc, &entries_[position].value,
+                               std::forward<Args>(args)...);
+        entries_[position].live = true;
+    }
+
+    void destroy(std::uint32_t position) {
+        if (entries_[position].live) {
+            ValueAlloc alloc(alloc_);
+            ValueTraits::destroy(alloc, &entries_[position].value);
+            entries_[position].live = false;
+        }
+    }
+
+    /// @brief Destroys the live elements among the first `live_range`
+    /// entries of an array, then the array itself.
+    void release(Entry* entries, size_type live_range,
+                 size_type capacity) noexcept {
+        if (!entries) {
+            return;
+        }
+        ValueAlloc alloc(alloc_);
+        for (size_type i = 0; i < capacity; ++i) {
+            if (i < live_range && entries[i].live) {
+                ValueTraits::destroy(alloc, &entries[i].value);
+            }
+            EntryTraits::destroy(alloc_, entries + i);
+        }
+        EntryTraits::deallocate(alloc_, entries, capacity);
+    }
+
+    /// @brief Destroys every element and releases the entry array.
+    void destroy_all() noexcept {
+        release(entries_, capacity_, capacity_);
+        entries_ = nullptr;
+        capacity_ = 0;
+    }
+
+    EntryAlloc alloc_;
+    Entry* entries_ = nullptr;
+    size_type capacity_ = 0;
+    std::vector<std::uint32_t, PositionAlloc> free_;
+    Index index_;
+};
+
+template <class Key, class Value, class Meta, class Hash, class Eq,
+          class Alloc>
+constexpr std::uint32_t
+    CacheStorage<Key, Value, Meta, Hash, Eq, Alloc>::kNone;
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_CACHE_STORAGE_HPP
@@ -0,0 +1,231 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_INTERNAL_CITY_HASH_CORE_HPP
+#define HMM_HMM_INTERNAL_CITY_HASH_CORE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "hmm/internal/city-hash-fwd.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+// The parts of CityHash64 that are usable in constant expressions. They are
+// always visible, even when the rest of the implementation is compiled into
+// its own translation unit.
+//
+// Implementation from: https://github.com/google/cityhash
+
+constexpr inline uint64 Rotate(uint64 val, int shift) {
+    return shift == 0 ? val : ((val >> shift) | (val << (64 - shift)));
+}
+
+constexpr inline uint64 ShiftMix(uint64 val) {
+    return val ^ (val >> 47);
+}
+
+HMM_CONSTEXPR_14 inline uint64 Hash128to64(uint128 x) {
+    uint64 a = (x.first ^ x.second) * kMul;
+    a ^= (a >> 47);
+    uint64 b = (x.second ^ a) * kMul;
+    b ^= (b >> 47);
+    b *= kMul;
+    return b;
+}
+
+/// @brief Reads `n` bytes as a little-endian integer. Constant evaluation
+/// cannot reinterpret memory, so this is the path taken there.
+HMM_CONSTEXPR_14 inline uint64 LoadLittleEndian(const char* p, int n) {
+    uint64 result = 0;
+    for (int i = n; i-- > 0;) {
+        result = (result << 8) | static_cast<uint8_t>(p[i]);
+    }
+    return result;
+}
+
+HMM_CONSTEXPR_14 inline uint64 Fetch64(const char* p) {
+#if defined(HMM_LITTLE_ENDIAN)
+    if (!HMM_IS_CONSTANT_EVALUATED()) {
+        uint64 result = 0;
+        std::memcpy(&result, p, sizeof(result));
+        return result;
+    }
+#endif
+    return LoadLittleEndian(p, 8);
+}
+
+HMM_CONSTEXPR_14 inline uint32 Fetch32(const char* p) {
+#if defined(HMM_LITTLE_ENDIAN)
+    if (!HMM_IS_CONSTANT_EVALUATED()) {
+        uint32 result = 0;
+        std::memcpy(&result, p, sizeof(result));
+        return result;
+    }
+#endif
+    return static_cast<uint32>(LoadLittleEndian(p, 4));
+}
+
+HMM_CONSTEXPR_14 inline uint64 HashLen16(uint64 u, uint64 v) {
+    return Hash128to64({u, v});
+}
+
+HMM_CONSTEXPR_14 inline uint64 HashLen16(uint64 u, uint64 v, uint64 mul) {
+    uint64 a = (u ^ v) * mul;
+    a ^= (a >> 47);
+    uint64 b = (v ^ a) * mul;
+    b ^= (b >> 47);
+    b *= mul;
+    return b;
+}
+
+HMM_CONSTEXPR_14 inline uint64 HashLen0to16(const char* s, std::size_t len) {
+    if (len >= 8) {
+        uint64 mul = k2 + (len * 2);
+        uint64 a = Fetch64(s) + k2;
+        uint64 b = Fetch64(s + len - 8);
+        uint64 c = (Rotate(b, 37) * mul) + a;
+        uint64 d = (Rotate(a, 25) + b) * mul;
+        return HashLen16(c, d, mul);
+    }
+    if (len >= 4) {
+        uint64 mul = k2 + (len * 2);
+        uint64 a = Fetch32(s);
+        return HashLen16(len + (a << 3), Fetch32(s + len - 4), mul);
+    }
+    if (len > 0) {
+        auto a = static_cast<uint8_t>(s[0]);
+        auto b = static_cast<uint8_t>(s[len >> 1]);
+        auto c = static_cast<uint8_t>(s[len - 1]);
+        uint32 y = static_cast<uint32>(a) + (static_cast<uint32>(b) << 8);
+        uint32 z = static_cast<uint32>(len) + (static_cast<uint32>(c) << 2);
+        return ShiftMix((y * k2) ^ (z * k0)) * k2;
+    }
+    return k2;
+}
+
+HMM_CONSTEXPR_14 inline uint64 HashLen17to32(const char* s, std::size_t len) {
+    uint64 mul = k2 + (len * 2);
+    uint64 a = Fetch64(s) * k1;
+    uint64 b = Fetch64(s + 8);
+    uint64 c = Fetch64(s + len - 8) * mul;
+    uint64 d = Fetch64(s + len - 16) * k2;
+    return HashLen16(Rotate(a + b, 43) + Rotate(c, 30) + d,
+                     a + Rotate(b + k2, 18) + c, mul);
+}
+
+HMM_CONSTEXPR_14 inline uint64 HashLen33to64(const char* s, std::size_t len) {
+    uint64 z = Fetch64(s + 24);
+    uint64 a = Fetch64(s) + ((len + Fetch64(s + len - 16)) * k0);
+    uint64 b = Rotate(a + z, 52);
+    uint64 c = Rotate(a, 37);
+    a += Fetch64(s + 8);
+    c += Rotate(a, 7);
+    a += Fetch64(s + 16);
+    uint64 vf = a + z;
+    uint64 vs = b + Rotate(a, 31) + c;
+    a = Fetch64(s + 16) + Fetch64(s + len - 32);
+    z = Fetch64(s + len - 8);
+    b = Rotate(a + z, 52);
+    c = Rotate(a, 37);
+    a += Fetch64(s + len - 24);
+    c += Rotate(a, 7);
+    a += Fetch64(s + len - 16);
+    uint64 wf = a + z;
+    uint64 ws = b + Rotate(a, 31) + c;
+    uint64 r = ShiftMix(((vf + ws) * k2) + ((wf + vs) * k0));
+    return ShiftMix((r * k0) + vs) * k2;
+}
+
+HMM_CONSTEXPR_14 inline std::pair<uint64, uint64>
+WeakHashLen32WithSeeds(uint64 w, uint64 x, uint64 y, uint64 z, uint64 a,
+                       uint64 b) {
+    a += w;
+    b = Rotate(b + a + z, 21);
+    uint64 c = a;
+    a += x;
+    a += y;
+    b += Rotate(a, 44);
+    return std::pair<uint64, uint64>(a + z, b + c);
+}
+
+HMM_CONSTEXPR_14 inline std::pair<uint64, uint64>
+WeakHashLen32WithSeeds(const char* s, uint64 a, uint64 b) {
+    return WeakHashLen32WithSeeds(Fetch64(s), Fetch64(s + 8), Fetch64(s + 16),
+                                  Fetch64(s + 24), a, b);
+}
+
+/// @brief The body of `CityHash64`.
+/// @details `std::pair` assignment and `std::swap` only become constexpr in
+/// C++20, so the running pairs are updated member by member.
+HMM_CONSTEXPR_14 inline uint64 CityHash64Core(const char* s,
+                                              std::size_t len) {
+    if (len <= 16) {
+        return HashLen0to16(s, len);
+    }
+    if (len <= 32) {
+        return HashLen17to32(s, len);
+    }
+    if (len <= 64) {
+        return HashLen33to64(s, len);
+    }
+
+    uint64 x = Fetch64(s + len - 40);
+    uint64 y = Fetch64(s + len - 16) + Fetch64(s + len - 56);
+    uint64 z = HashLen16(Fetch64(s + len - 48) + len, Fetch64(s + len - 24));
+    std::pair<uint64, uint64> v = WeakHashLen32WithSeeds(s + len - 64, len, z);
+    std::pair<uint64, uint64> w =
+        WeakHashLen32WithSeeds(s + len - 32, y + k1, x);
+    x = (x * k1) + Fetch64(s);
+
+    len = (len - 1) & ~static_cast<size_t>(63);
+    do {
+        x = Rotate(x + y + v.first + Fetch64(s + 8), 37) * k1;
+        y = Rotate(y + v.second + Fetch64(s + 48), 42) * k1;
+        x ^= w.second;
+        y += v.first + Fetch64(s + 40);
+        z = Rotate(z + w.first, 33) * k1;
+        const auto nv = WeakHashLen32WithSeeds(s, v.second * k1, x + w.first);
+        const auto nw =
+            WeakHashLen32WithSeeds(s + 32, z + w.second, y + Fetch64(s + 16));
+        v.first = nv.first;
+        v.second = nv.second;
+        w.first = nw.first;
+        w.second = nw.second;
+        const uint64 t = z;
+        z = x;
+        x = t;
+        s += 64;
+        len -= 64;
+    } while (len != 0);
+    return HashLen16(HashLen16(v.first, w.first) + (ShiftMix(y) * k1) + z,
+                     HashLen16(v.second, w.second) + x);
+}
+
+/// @brief The body of `CityHash64WithSeed`.
+HMM_CONSTEXPR_14 inline uint64
+CityHash64WithSeedCore(const char* s, std::size_t len, uint64 seed) {
+    return HashLen16(CityHash64Core(s, len) - k2, seed);
+}
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_CITY_HASH_CORE_HPP
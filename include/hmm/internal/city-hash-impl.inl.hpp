@@ -18,9 +18,9 @@
 #define HMM_HMM_INTERNAL_CITY_HASH_IMPL_INL_HPP
 
 #include <cstdint>
-#include <cstring>
 #include <utility>
 
+#include "hmm/internal/city-hash-core.hpp"
 #include "hmm/internal/city-hash-fwd.hpp"
 
 namespace hmm {
@@ -36,124 +36,6 @@ namespace internal {
 #endif
 #endif
 
-inline uint64 Rotate(uint64 val, int shift) {
-    return shift == 0 ? val : ((val >> shift) | (val << (64 - shift)));
-}
-
-inline uint64 ShiftMix(uint64 val) {
-    return val ^ (val >> 47);
-}
-
-inline uint64 Hash128to64(uint128 x) {
-    uint64 a = (x.first ^ x.second) * kMul;
-    a ^= (a >> 47);
-    uint64 b = (x.second ^ a) * kMul;
-    b ^= (b >> 47);
-    b *= kMul;
-    return b;
-}
-
-inline uint64 Fetch64(const char* p) {
-    uint64 result;
-    std::memcpy(&result, p, sizeof(result));
-    return result;
-}
-
-inline uint32 Fetch32(const char* p) {
-    uint32 result;
-    std::memcpy(&result, p, sizeof(result));
-    return result;
-}
-
-inline uint64 HashLen16(uint64 u, uint64 v) {
-    return Hash128to64({u, v});
-}
-
-inline uint64 HashLen16(uint64 u, uint64 v, uint64 mul) {
-    uint64 a = (u ^ v) * mul;
-    a ^= (a >> 47);
-    uint64 b = (v ^ a) * mul;
-    b ^= (b >> 47);
-    b *= mul;
-    return b;
-}
-
-inline uint64 HashLen0to16(const char* s, std::size_t len) {
-    if (len >= 8) {
-        uint64 mul = k2 + (len * 2);
-        uint64 a = Fetch64(s) + k2;
-        uint64 b = Fetch64(s + len - 8);
-        uint64 c = (Rotate(b, 37) * mul) + a;
-        uint64 d = (Rotate(a, 25) + b) * mul;
-        return HashLen16(c, d, mul);
-    }
-    if (len >= 4) {
-        uint64 mul = k2 + (len * 2);
-        uint64 a = Fetch32(s);
-        return HashLen16(len + (a << 3), Fetch32(s + len - 4), mul);
-    }
-    if (len > 0) {
-        auto a = static_cast<uint8_t>(s[0]);
-        auto b = static_cast<uint8_t>(s[len >> 1]);
-        auto c = static_cast<uint8_t>(s[len - 1]);
-        uint32 y = static_cast<uint32>(a) + (static_cast<uint32>(b) << 8);
-        uint32 z = static_cast<uint32>(len) + (static_cast<uint32>(c) << 2);
-        return ShiftMix((y * k2) ^ (z * k0)) * k2;
-    }
-    return k2;
-}
-
-inline uint64 HashLen17to32(const char* s, std::size_t len) {
-    uint64 mul = k2 + (len * 2);
-    uint64 a = Fetch64(s) * k1;
-    uint64 b = Fetch64(s + 8);
-    uint64 c = Fetch64(s + len - 8) * mul;
-    uint64 d = Fetch64(s + len - 16) * k2;
-    return HashLen16(Rotate(a + b, 43) + Rotate(c, 30) + d,
-                     a + Rotate(b + k2, 18) + c, mul);
-}
-
-inline uint64 HashLen33to64(const char* s, std::size_t len) {
-    uint64 z = Fetch64(s + 24);
-    uint64 a = Fetch64(s) + ((len + Fetch64(s + len - 16)) * k0);
-    uint64 b = Rotate(a + z, 52);
-    uint64 c = Rotate(a, 37);
-    a += Fetch64(s + 8);
-    c += Rotate(a, 7);
-    a += Fetch64(s + 16);
-    uint64 vf = a + z;
-    uint64 vs = b + Rotate(a, 31) + c;
-    a = Fetch64(s + 16) + Fetch64(s + len - 32);
-    z = Fetch64(s + len - 8);
-    b = Rotate(a + z, 52);
-    c = Rotate(a, 37);
-    a += Fetch64(s + len - 24);
-    c += Rotate(a, 7);
-    a += Fetch64(s + len - 16);
-    uint64 wf = a + z;
-    uint64 ws = b + Rotate(a, 31) + c;
-    uint64 r = ShiftMix(((vf + ws) * k2) + ((wf + vs) * k0));
-    return ShiftMix((r * k0) + vs) * k2;
-}
-
-inline std::pair<uint64, uint64> WeakHashLen32WithSeeds(uint64 w, uint64 x,
-                                                        uint64 y, uint64 z,
-                                                        uint64 a, uint64 b) {
-    a += w;
-    b = Rotate(b + a + z, 21);
-    uint64 c = a;
-    a += x;
-    a += y;
-    b += Rotate(a, 44);
-    return std::make_pair(a + z, b + c);
-}
-
-inline std::pair<uint64, uint64> WeakHashLen32WithSeeds(const char* s, uint64 a,
-                                                        uint64 b) {
-    return WeakHashLen32WithSeeds(Fetch64(s), Fetch64(s + 8), Fetch64(s + 16),
-                                  Fetch64(s + 24), a, b);
-}
-
 inline uint64 CityHash64WithSeeds(const char* s, std::size_t len, uint64 seed0,
                                   uint64 seed1) {
     return HashLen16(CityHash64(s, len) - seed0, seed1);
@@ -189,39 +71,7 @@ inline uint128 CityMurmur(const char* s, std::size_t len, uint128 seed) {
 }
 
 HMM_HASH_QUALIFIER uint64 CityHash64(const char* s, std::size_t len) {
-    if (len <= 16) {
-        return HashLen0to16(s, len);
-    }
-    if (len <= 32) {
-        return HashLen17to32(s, len);
-    }
-    if (len <= 64) {
-        return HashLen33to64(s, len);
-    }
-
-    uint64 x = Fetch64(s + len - 40);
-    uint64 y = Fetch64(s + len - 16) + Fetch64(s + len - 56);
-    uint64 z = HashLen16(Fetch64(s + len - 48) + len, Fetch64(s + len - 24));
-    std::pair<uint64, uint64> v = WeakHashLen32WithSeeds(s + len - 64, len, z);
-    std::pair<uint64, uint64> w =
-        WeakHashLen32WithSeeds(s + len - 32, y + k1, x);
-    x = (x * k1) + Fetch64(s);
-
-    len = (len - 1) & ~static_cast<size_t>(63);
-    do {
-        x = Rotate(x + y + v.first + Fetch64(s + 8), 37) * k1;
-        y = Rotate(y + v.second + Fetch64(s + 48), 42) * k1;
-        x ^= w.second;
-        y += v.first + Fetch64(s + 40);
-        z = Rotate(z + w.first, 33) * k1;
-        v = WeakHashLen32WithSeeds(s, v.second * k1, x + w.first);
-        w = WeakHashLen32WithSeeds(s + 32, z + w.second, y + Fetch64(s + 16));
-        std::swap(z, x);
-        s += 64;
-        len -= 64;
-    } while (len != 0);
-    return HashLen16(HashLen16(v.first, w.first) + (ShiftMix(y) * k1) + z,
-                     HashLen16(v.second, w.second) + x);
+    return CityHash64Core(s, len);
 }
 
 HMM_HASH_QUALIFIER uint64 CityHash64WithSeed(const char* s, std::size_t len,
@@ -25,6 +25,10 @@
 #include "hmm/internal/city-hash-fwd.hpp"
 #include "hmm/internal/macros.hpp"
 
+#if HMM_HAS_CXX_17
+#include <string_view>
+#endif
+
 #ifndef HMM_HASH_IMPL_COMPILED
 #include "hmm/internal/city-hash-impl.inl.hpp" // IWYU pragma: export
 #endif
@@ -81,6 +85,13 @@ template <typename H> H HashValue(H h, const std::string& s) {
     return H::combine_contiguous(std::move(h), s.data(), s.size());
 }
 
+#if HMM_HAS_CXX_17
+// 4b. std::string_view, hashing like the equal std::string
+template <typename H> H HashValue(H h, std::string_view s) {
+    return H::combine_contiguous(std::move(h), s.data(), s.size());
+}
+#endif
+
 // 5. std::pair
 template <typename H, typename T1, typename T2>
 H HashValue(H h, const std::pair<T1, T2>& p) {
@@ -0,0 +1,317 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_CONCURRENT_INSERT_TABLE_HPP
+#define HMM_HMM_INTERNAL_CONCURRENT_INSERT_TABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "hmm/internal/atomic-ctrl.hpp"
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief An insert-only SwissTable that many threads may fill at once.
+///
+/// A thread inserting a key walks the aligned groups of its hash, matching
+/// H2 with `Group::Match` as `raw_hash_set` does. When it meets an empty slot
+/// it claims it by compare-and-swapping the control byte from `kEmpty` to
+/// `kBusy`. It then constructs the element and publishes H2 with release
+/// semantics.
+///
+/// Equal keys cannot both be inserted. Every inserter of a key claims the
+/// first empty slot of the first group with room along the same probe. Only
+/// one CAS on that byte succeeds, and the losers rescan the group. A scan
+/// that meets a `kBusy` byte waits for it to resolve, as it may be the very
+/// key being inserted.
+///
+/// Elements never move while threads insert, so pointers to them are stable.
+/// `reserve` and `clear` are the only operations that need exclusive access.
+///
+/// @tparam Policy A trait struct that dictates how keys and values are
+///                extracted from the underlying slot.
+/// @tparam TArgs Variadic pack defining [Hash, Eq, Allocator]. Falls back to
+/// Policy defaults.
+template <class Policy, class... TArgs> class concurrent_insert_table {
+  public:
+    using policy_type = Policy;
+
+    using hasher_type = typename detail::TypeAtIndexOrDefault<
+        0, typename policy_type::default_hasher_type, TArgs...>::type;
+    using key_equal = typename detail::TypeAtIndexOrDefault<
+        1, typename policy_type::default_eq_type, TArgs...>::type;
+
+    using key_type = typename policy_type::key_type;
+    using value_type = typename policy_type::value_type;
+    using size_type = std::size_t;
+    using slot_type = typename policy_type::slot_type;
+
+    using allocator_type =
+        typename std::allocator_traits<typename detail::TypeAtIndexOrDefault<
+            2, typename policy_type::default_allocator_type,
+            TArgs...>::type>::template rebind_alloc<slot_type>;
+
+    /// @brief Constructs a table with room for `count` elements.
+    explicit concurrent_insert_table(
+        size_type count = 0, const hasher_type& hash = hasher_type(),
+        const key_equal& eq = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : hash_(hash), eq_(eq), alloc_(alloc) {
+        // Allocated directly, so that elements need not be movable unless
+        // the table is later reserved.
+        if (count != 0) {
+            allocate(capacity_for(count));
+        }
+    }
+
+    concurrent_insert_table(const concurrent_insert_table&) = delete;
+    concurrent_insert_table& operator=(const concurrent_insert_table&) = delete;
+
+    ~concurrent_insert_table() {
+        destroy_elements();
+        deallocate(ctrl_, slots_, capacity_);
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    HMM_NODISCARD size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    /// @brief Constructs an element from `args` unless an element with `key`
+    /// exists. Safe to call from many threads at once.
+    /// @details `args` are only consumed if this call inserts.
+    /// @return The slot holding the element with `key`, and whether this
+    /// call inserted it.
+    /// @throws std::length_error If no empty slot is left along the probe.
+    template <class K, class... Args>
+    std::pair<slot_type*, bool> emplace_key(const K& key, Args&&... args) {
+        const std::size_t full_hash = hash_(key);
+        const auto h2 = detail::H2(full_hash);
+        const std::size_t groups = capacity_ / Group::kWidth;
+        std::size_t group = start_group(full_hash);
+
+        for (std::size_t n = 0; n < groups; ++n) {
+            while (true) {
+                Group g = LoadCtrlGroup(ctrl_, group);
+                if (g.Match(detail::slots::kBusy)) {
+                    continue;
+                }
+                for (BitMask mask = g.Match(h2); mask; ++mask) {
+                    slot_type* slot =
+                        slots_ + group * Group::kWidth + mask.first_index();
+                    if (eq_(key, policy_type::key(*slot))) {
+                        return {slot, false};
+                    }
+                }
+
+                auto empty = g.MatchEmpty();
+                if (!empty) {
+                    break;
+                }
+                const std::size_t index =
+                    group * Group::kWidth + empty.first_index();
+                if (!TryClaimCtrl(ctrl_, index, detail::slots::kEmpty,
+                                  detail::slots::kBusy)) {
+                    // Another thread took the slot, possibly for this key.
+                    continue;
+                }
+
+                try {
+                    policy_type::construct(alloc_, slots_ + index,
+                                           std::forward<Args>(args)...);
+                } catch (...) {
+                    // Retire the slot rather than empty it again, so that
+                    // no scan could have skipped past a group that regains
+                    // room.
+                    ReleaseOwnedCtrl(ctrl_, index, detail::slots::kBusy,
+                                     detail::slots::kDeleted);
+                    throw;
+                }
+                ReleaseOwnedCtrl(ctrl_, index, detail::slots::kBusy, h2);
+                size_.fetch_add(1, std::memory_order_relaxed);
+                return {slots_ + index, true};
+            }
+            group = (group + 1) & (groups - 1);
+        }
+        throw std::length_error("concurrent_insert_table is full");
+    }
+
+    /// @brief Locates the element with `key`. Safe to call while other
+    /// threads insert; an element still being constructed is not found.
+    template <class K>
+    HMM_NODISCARD const slot_type* find_slot(const K& key) const noexcept {
+        if (capacity_ == 0) {
+            return nullptr;
+        }
+
+        const std::size_t full_hash = hash_(key);
+        const auto h2 = detail::H2(full_hash);
+        const std::size_t groups = capacity_ / Group::kWidth;
+        std::size_t group = start_group(full_hash);
+
+        for (std::size_t n = 0; n < groups; ++n) {
+            Group g = LoadCtrlGroup(ctrl_, group);
+            for (BitMask mask = g.Match(h2); mask; ++mask) {
+                const slot_type* slot =
+                    slots_ + group * Group::kWidth + mask.first_index();
+                if (eq_(key, policy_type::key(*slot))) {
+                    return slot;
+                }
+            }
+            if (g.MatchEmpty()) {
+                return nullptr;
+            }
+            group = (group + 1) & (groups - 1);
+        }
+        return nullptr;
+    }
+
+    /// @brief Grows the table to hold `count` elements at a 7/8 load.
+    /// @details Requires exclusive access.
+    void reserve(size_type count) {
+        const size_type cap = capacity_for(count);
+        if (cap <= capacity_) {
+            return;
+        }
+
+        CtrlWord* old_ctrl = ctrl_;
+        slot_type* old_slots = slots_;
+        const size_type old_cap = capacity_;
+        allocate(cap);
+
+        for (std::size_t i = 0; i < old_cap; ++i) {
+            const auto c = LoadCtrl(old_ctrl, i);
+            if (c >= 0) {
+                const std::size_t index =
+                    first_empty(hash_(policy_type::key(old_slots[i])));
+                policy_type::transfer(alloc_, slots_ + index, old_slots + i);
+                StoreCtrl(ctrl_, index, c);
+            }
+        }
+        deallocate(old_ctrl, old_slots, old_cap);
+    }
+
+    /// @brief Destroys every element, keeping the capacity.
+    /// @details Requires exclusive access.
+    void clear() {
+        destroy_elements();
+        for (std::size_t i = 0; i < CtrlWordCount(capacity_); ++i) {
+            ctrl_[i].store(kEmptyCtrlWord, std::memory_order_relaxed);
+        }
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+    /// @brief Invokes `f(const value_type&)` on every published element.
+    template <class F> void for_each(F&& f) const {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (LoadCtrl(ctrl_, i) >= 0) {
+                f(policy_type::value_from_slot(slots_[i]));
+            }
+        }
+    }
+
+  private:
+    using CtrlAlloc = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<CtrlWord>;
+
+    /// @brief The smallest capacity holding `count` elements at a 7/8 load.
+    HMM_NODISCARD static size_type capacity_for(size_type count) noexcept {
+        const size_type min_cap = (count * 8 + 6) / 7;
+        size_type cap = count == 0 ? 0 : Group::kWidth;
+        while (cap < min_cap) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    HMM_NODISCARD std::size_t
+    start_group(std::size_t full_hash) const noexcept {
+        return detail::IndexWithoutProbing(detail::H1(full_hash), capacity_) /
+               Group::kWidth;
+    }
+
+    /// @brief Single-threaded placement used while rehashing.
+    HMM_NODISCARD std::size_t first_empty(std::size_t full_hash) const {
+        const std::size_t groups = capacity_ / Group::kWidth;
+        std::size_t group = start_group(full_hash);
+        while (true) {
+            Group g = LoadCtrlGroup(ctrl_, group);
+            if (auto mask = g.MatchEmpty()) {
+                return group * Group::kWidth + mask.first_index();
+            }
+            group = (group + 1) & (groups - 1);
+        }
+    }
+
+    void allocate(size_type cap) {
+        CtrlAlloc ctrl_alloc(alloc_);
+        const std::size_t words = CtrlWordCount(cap);
+        ctrl_ = std::allocator_traits<CtrlAlloc>::allocate(ctrl_alloc, words);
+        for (std::size_t i = 0; i < words; ++i) {
+            std::allocator_traits<CtrlAlloc>::construct(ctrl_alloc, ctrl_ + i,
+                                                        kEmptyCtrlWord);
+        }
+        slots_ = std::allocator_traits<allocator_type>::allocate(alloc_, cap);
+        capacity_ = cap;
+    }
+
+    void deallocate(CtrlWord* ctrl, slot_type* slots, size_type cap) {
+        if (cap == 0) {
+            return;
+        }
+        CtrlAlloc ctrl_alloc(alloc_);
+        std::allocator_traits<CtrlAlloc>::deallocate(ctrl_alloc, ctrl,
+                                                     CtrlWordCount(cap));
+        std::allocator_traits<allocator_type>::deallocate(alloc_, slots, cap);
+    }
+
+    void destroy_elements() {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (LoadCtrl(ctrl_, i) >= 0) {
+                policy_type::destroy(alloc_, slots_ + i);
+            }
+        }
+    }
+
+    hasher_type hash_;
+    key_equal eq_;
+    allocator_type alloc_;
+
+    CtrlWord* ctrl_ = nullptr;
+    slot_type* slots_ = nullptr;
+    size_type capacity_ = 0;
+    alignas(64) std::atomic<size_type> size_{0};
+};
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_CONCURRENT_INSERT_TABLE_HPP
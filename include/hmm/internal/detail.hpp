@@ -53,6 +53,8 @@ IndexWithoutProbing(const std::size_t h1, const std::size_t capacity) noexcept {
 namespace slots {
 constexpr std::int8_t kEmpty = -128;
 constexpr std::int8_t kDeleted = -2;
+/// @brief A slot claimed by a concurrent writer that is still being filled.
+constexpr std::int8_t kBusy = -3;
 } // namespace slots
 
 namespace construction {
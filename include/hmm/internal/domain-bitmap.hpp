@@ -0,0 +1,76 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_DOMAIN_BITMAP_HPP
+#define HMM_HMM_INTERNAL_DOMAIN_BITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief A fixed set of bits marking which indices of a key domain are
+/// present.
+/// @tparam N The size of the domain.
+template <std::size_t N> class DomainBitmap {
+  public:
+    HMM_NODISCARD bool test(std::size_t i) const noexcept {
+        return (words_[i / 64] >> (i % 64)) & 1;
+    }
+
+    void set(std::size_t i) noexcept {
+        words_[i / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    void reset(std::size_t i) noexcept {
+        words_[i / 64] &= ~(uint64_t(1) << (i % 64));
+    }
+
+    void clear() noexcept {
+        std::memset(words_, 0, sizeof(words_));
+    }
+
+    /// @brief Returns the first set index at or after `i`, or `N`.
+    HMM_NODISCARD std::size_t next(std::size_t i) const noexcept {
+        if (i >= N) {
+            return N;
+        }
+        std::size_t word = i / 64;
+        uint64_t bits = words_[word] & (~uint64_t(0) << (i % 64));
+        while (bits == 0) {
+            if (++word == kWords) {
+                return N;
+            }
+            bits = words_[word];
+        }
+        return word * 64 + CountTrailingZeros64(bits);
+    }
+
+  private:
+    static constexpr std::size_t kWords = (N + 63) / 64;
+
+    uint64_t words_[kWords] = {};
+};
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_DOMAIN_BITMAP_HPP
@@ -0,0 +1,291 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_EPOCH_HPP
+#define HMM_HMM_INTERNAL_EPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Epoch-based reclamation for lock-free readers.
+///
+/// Readers pin the domain for the duration of a read, announcing the global
+/// epoch they observed in a reader slot. Slots form an unbounded list, one
+/// per concurrent pin, each alone on its cache lines. A thread remembers the
+/// slot it last used in each domain and returns to it, so pinning writes to
+/// a line no other reader touches. Pinning never waits: when every slot is
+/// taken, a new one is added.
+///
+/// A writer that unlinks an object calls `advance()` and remembers the epoch
+/// it returns. The object may be reclaimed once `is_safe(epoch)` holds: every
+/// reader that could still observe it has unpinned since.
+///
+/// All accesses are sequentially consistent. A reader that pins at or after
+/// the retiring epoch therefore also observes the unlinking store.
+class EpochDomain {
+    struct ReaderSlot {
+        ReaderSlot* next;
+        // Padding on both sides keeps the epoch off the lines of every other
+        // allocation, wherever the slot is placed.
+        char before[64 - sizeof(ReaderSlot*)];
+        std::atomic<std::uint64_t> epoch;
+        char after[64 - sizeof(std::uint64_t)];
+    };
+
+  public:
+    /// @brief Keeps the domain pinned while alive.
+    class Guard {
+        friend EpochDomain;
+
+      public:
+        Guard(Guard&& other) noexcept
+            : slot_(other.slot_), epoch_(other.epoch_) {
+            other.slot_ = nullptr;
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard() {
+            unpin();
+        }
+
+        /// @brief Leaves the domain early.
+        /// @return The epoch the guard was pinned at.
+        std::uint64_t unpin() noexcept {
+            if (slot_) {
+                slot_->epoch.store(kIdle);
+                slot_ = nullptr;
+            }
+            return epoch_;
+        }
+
+      private:
+        Guard(ReaderSlot* slot, std::uint64_t epoch)
+            : slot_(slot), epoch_(epoch) {}
+
+        ReaderSlot* slot_;
+        std::uint64_t epoch_;
+    };
+
+    EpochDomain() : id_(NextId()) {}
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /// @brief Requires that no guard is alive.
+    ~EpochDomain() {
+        ReaderSlot* slot = head_.load(std::memory_order_relaxed);
+        while (slot != nullptr) {
+            ReaderSlot* next = slot->next;
+            delete slot;
+            slot = next;
+        }
+    }
+
+    /// @brief Announces a reader at the current epoch.
+    /// @details Allocates a slot when more guards than ever before are alive
+    /// at once.
+    HMM_NODISCARD Guard pin() {
+        const std::uint64_t epoch = epoch_.load();
+        Hint& hint = HintFor(id_);
+        if (hint.domain == id_ && claim(*hint.slot, epoch)) {
+            return Guard(hint.slot, epoch);
+        }
+        ReaderSlot* slot = claim_any(epoch);
+        hint.domain = id_;
+        hint.slot = slot;
+        return Guard(slot, epoch);
+    }
+
+    /// @brief Starts a new epoch. Called after unlinking an object.
+    /// @return The epoch the unlinked object was retired in.
+    std::uint64_t advance() noexcept {
+        return epoch_.fetch_add(1) + 1;
+    }
+
+    /// @brief Checks if every reader pinned before `epoch` has left.
+    HMM_NODISCARD bool is_safe(std::uint64_t epoch) const noexcept {
+        for (const ReaderSlot* slot = head_.load(); slot != nullptr;
+             slot = slot->next) {
+            const std::uint64_t pinned = slot->epoch.load();
+            if (pinned != kIdle && pinned < epoch) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    static constexpr std::uint64_t kIdle = 0;
+    static constexpr std::size_t kHints = 8;
+
+    /// @brief The slot a thread last used in a domain.
+    struct Hint {
+        std::uint64_t domain;
+        ReaderSlot* slot;
+    };
+
+    static std::uint64_t NextId() noexcept {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief The calling thread's hint for domain `id`. Ids are never
+    /// reused, so a hint left by a destroyed domain never matches.
+    static Hint& HintFor(std::uint64_t id) noexcept {
+        static thread_local Hint hints[kHints] = {};
+        return hints[id % kHints];
+    }
+
+    static bool claim(ReaderSlot& slot, std::uint64_t epoch) noexcept {
+        std::uint64_t expected = kIdle;
+        return slot.epoch.load(std::memory_order_relaxed) == kIdle &&
+               slot.epoch.compare_exchange_strong(expected, epoch);
+    }
+
+    /// @brief Claims the first free slot, or adds one if there is none.
+    ReaderSlot* claim_any(std::uint64_t epoch) {
+        for (ReaderSlot* slot = head_.load(); slot != nullptr;
+             slot = slot->next) {
+            if (claim(*slot, epoch)) {
+                return slot;
+            }
+        }
+        ReaderSlot* slot = new ReaderSlot;
+        slot->epoch.store(epoch, std::memory_order_relaxed);
+        slot->next = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(slot->next, slot)) {
+        }
+        return slot;
+    }
+
+    alignas(64) std::atomic<std::uint64_t> epoch_{1};
+    std::atomic<ReaderSlot*> head_{nullptr};
+    const std::uint64_t id_;
+};
+
+/// @brief Objects unlinked from a structure read under an `EpochDomain`,
+/// waiting for the readers that may still hold them.
+///
+/// Writers publish replacements through `publish`, which also reclaims
+/// whatever no reader can still observe; `collect` does the same without a
+/// write. Reclamation runs under a mutex of its own, never under the
+/// writers' lock. Readers that would rather not wait for the next write may
+/// end with `unpin`, which helps only when the mutex is free and so never
+/// blocks.
+///
+/// @tparam T The type of retired objects.
+template <class T> class RetiredList {
+  public:
+    RetiredList() = default;
+    RetiredList(const RetiredList&) = delete;
+    RetiredList& operator=(const RetiredList&) = delete;
+
+    /// @brief Swaps `next` into `current` and retires the previous object.
+    /// Owns `next`, which is freed with `free` if it cannot be published.
+    template <class Free>
+    void publish(EpochDomain& domain, std::atomic<T*>& current, T* next,
+                 Free free) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Make room first, so that the old object cannot be lost once
+        // swapped out.
+        try {
+            if (entries_.size() == entries_.capacity()) {
+                entries_.reserve(2 * entries_.size() + 1);
+            }
+        } catch (...) {
+            free(next);
+            throw;
+        }
+        T* old = current.exchange(next);
+        if (old != nullptr) {
+            const std::uint64_t epoch = domain.advance();
+            entries_.push_back(Entry{epoch, old});
+            newest_.store(epoch);
+        }
+        collect_locked(domain, free);
+    }
+
+    /// @brief Reclaims the retired objects no reader can still observe.
+    template <class Free> void collect(const EpochDomain& domain, Free free) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        collect_locked(domain, free);
+    }
+
+    /// @brief Ends a read. If the read began before the latest retirement
+    /// and no one else is collecting, reclaims what no reader can still
+    /// observe. Otherwise, the objects wait for the next `publish` or
+    /// `collect`.
+    template <class Free>
+    void unpin(EpochDomain::Guard& guard, const EpochDomain& domain,
+               Free free) {
+        if (guard.unpin() < newest_.load()) {
+            std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+            if (lock.owns_lock()) {
+                collect_locked(domain, free);
+            }
+        }
+    }
+
+    /// @brief Frees every retired object. Requires that no reader is pinned.
+    template <class Free> void free_all(Free free) noexcept {
+        for (auto& entry : entries_) {
+            free(entry.object);
+        }
+        entries_.clear();
+    }
+
+  private:
+    struct Entry {
+        std::uint64_t epoch;
+        T* object;
+    };
+
+    template <class Free>
+    void collect_locked(const EpochDomain& domain, Free& free) {
+        std::size_t kept = 0;
+        for (auto& entry : entries_) {
+            if (domain.is_safe(entry.epoch)) {
+                free(entry.object);
+            } else {
+                entries_[kept++] = entry;
+            }
+        }
+        entries_.resize(kept);
+        if (kept == 0) {
+            newest_.store(0);
+        }
+    }
+
+    std::atomic<std::uint64_t> newest_{0};
+    std::mutex mutex_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_EPOCH_HPP
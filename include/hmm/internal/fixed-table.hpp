@@ -0,0 +1,608 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_FIXED_TABLE_HPP
+#define HMM_HMM_INTERNAL_FIXED_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief The smallest power-of-two capacity, of at least one group, that
+/// holds `n` elements within the 7/8 maximum load factor.
+constexpr std::size_t StaticCapacity(std::size_t n, std::size_t cap = 16) {
+    return n * 8 <= cap * 7 ? cap : StaticCapacity(n, cap * 2);
+}
+
+/// @brief Destroys the elements in the full slots of a fixed table.
+template <class Policy>
+void DestroyFullSlots(const std::int8_t* ctrl,
+                      typename Policy::slot_type* slots,
+                      std::size_t capacity) noexcept {
+    std::allocator<typename Policy::slot_type> alloc;
+    for (std::size_t i = 0; i < capacity; ++i) {
+        if (ctrl[i] >= 0) {
+            Policy::destroy(alloc, slots + i);
+        }
+    }
+}
+
+/// @brief Fixed table storage carved out of a caller-owned buffer.
+///
+/// The control bytes come first, then the slots at their natural alignment.
+/// The capacity is the largest power of two, of at least one group, that
+/// fits. A buffer too small for one group gives a capacity of zero, and every
+/// insertion reports the table full. The buffer must outlive the storage;
+/// the elements in it are destroyed with the storage.
+template <class Policy> struct BufferStorage {
+    using slot_type = typename Policy::slot_type;
+    using ctrl_t = std::int8_t;
+
+    static constexpr std::size_t kMinCapacity = Group::kWidth;
+
+    /// @brief The bytes a buffer needs for `capacity` slots, whatever its
+    /// alignment.
+    HMM_NODISCARD static constexpr std::size_t
+    bytes_for(std::size_t capacity) noexcept {
+        return capacity + Group::kWidth - 1 + alignof(slot_type) - 1 +
+               capacity * sizeof(slot_type);
+    }
+
+    BufferStorage(void* data, std::size_t bytes) noexcept {
+        const auto start = reinterpret_cast<std::uintptr_t>(data);
+        for (std::size_t cap = kMinCapacity; cap <= bytes / sizeof(slot_type);
+             cap *= 2) {
+            const std::uintptr_t slots =
+                AlignUp(start + cap + Group::kWidth - 1);
+            if (slots - start + cap * sizeof(slot_type) > bytes) {
+                break;
+            }
+            ctrl_ = static_cast<ctrl_t*>(data);
+            slots_ = reinterpret_cast<slot_type*>(slots);
+            capacity_ = cap;
+        }
+        max_size_ = capacity_ - capacity_ / 8;
+        if (capacity_ != 0) {
+            reset_ctrl();
+        }
+    }
+
+    BufferStorage(const BufferStorage&) = delete;
+    BufferStorage& operator=(const BufferStorage&) = delete;
+
+    /// @brief Takes over the buffer; `other` is left without one.
+    BufferStorage(BufferStorage&& other) noexcept
+        : ctrl_(other.ctrl_), slots_(other.slots_),
+          capacity_(other.capacity_), max_size_(other.max_size_),
+          size_(other.size_) {
+        other.release();
+    }
+
+    BufferStorage& operator=(BufferStorage&& other) noexcept {
+        if (this != &other) {
+            destroy_all();
+            ctrl_ = other.ctrl_;
+            slots_ = other.slots_;
+            capacity_ = other.capacity_;
+            max_size_ = other.max_size_;
+            size_ = other.size_;
+            other.release();
+        }
+        return *this;
+    }
+
+    ~BufferStorage() {
+        if (capacity_ != 0) {
+            DestroyFullSlots<Policy>(ctrl_, slots_, capacity_);
+        }
+    }
+
+    HMM_NODISCARD ctrl_t* ctrl() noexcept {
+        return ctrl_;
+    }
+    HMM_NODISCARD const ctrl_t* ctrl() const noexcept {
+        return ctrl_;
+    }
+    HMM_NODISCARD slot_type* slots() noexcept {
+        return slots_;
+    }
+    HMM_NODISCARD const slot_type* slots() const noexcept {
+        return slots_;
+    }
+    HMM_NODISCARD std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+    HMM_NODISCARD std::size_t max_size() const noexcept {
+        return max_size_;
+    }
+
+    /// @brief Destroys every element and marks every slot empty.
+    void destroy_all() noexcept {
+        if (capacity_ == 0) {
+            return;
+        }
+        DestroyFullSlots<Policy>(ctrl_, slots_, capacity_);
+        reset_ctrl();
+    }
+
+    ctrl_t* ctrl_ = nullptr;
+    slot_type* slots_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t max_size_ = 0;
+    std::size_t size_ = 0;
+
+  private:
+    void reset_ctrl() noexcept {
+        for (std::size_t i = 0; i < capacity_ + Group::kWidth - 1; ++i) {
+            ctrl_[i] = detail::slots::kEmpty;
+        }
+        size_ = 0;
+    }
+
+    HMM_NODISCARD static std::uintptr_t AlignUp(std::uintptr_t p) noexcept {
+        const std::uintptr_t align = alignof(slot_type);
+        return (p + align - 1) / align * align;
+    }
+
+    void release() noexcept {
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        max_size_ = 0;
+        size_ = 0;
+    }
+};
+
+/// @brief A SwissTable that never grows, over storage it does not allocate.
+///
+/// The storage provides the control bytes, with the usual mirror of the
+/// first group after them, the slots, the element count and two limits:
+/// `capacity()` slots, a power of two of at least one group, and
+/// `max_size()` elements, at most 7/8 of the slots so that every probe meets
+/// an empty slot. Lookups use the group scan of `raw_hash_set`.
+///
+/// Elements are placed in the first empty slot of their probe sequence, so
+/// erasing one shifts later members of its run back instead of leaving a
+/// tombstone. The table therefore never needs cleaning up, and any mix of
+/// insertions and erasures stays within the storage.
+///
+/// Nothing here allocates or throws, beyond what the hasher, the equality
+/// and the element constructors do. An insertion that would pass
+/// `max_size()` returns `{end(), false}` and leaves the table unchanged.
+///
+/// @tparam Policy `SetPolicy` or `MapPolicy`.
+/// @tparam Storage `InlineStorage` or `BufferStorage`.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to the policy's hasher)
+///               2. Equality functor (Defaults to the policy's equality)
+template <class Policy, class Storage, class... TArgs> class fixed_table {
+  public:
+    using policy_type = Policy;
+    using hasher_type = typename detail::TypeAtIndexOrDefault<
+        0, typename Policy::default_hasher_type, TArgs...>::type;
+    using key_equal = typename detail::TypeAtIndexOrDefault<
+        1, typename Policy::default_eq_type, TArgs...>::type;
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using slot_type = typename Policy::slot_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+  private:
+    using ctrl_t = std::int8_t;
+
+    static constexpr size_type kGroupWidth = Group::kWidth;
+
+    /// @brief Where a key is, or where it should go.
+    struct FindInfo {
+        size_type index;
+        ctrl_t h2;
+        bool found;
+    };
+
+  public:
+    /// @brief Iterator over the occupied slots.
+    template <bool IsConst> class BasicIterator {
+        friend fixed_table;
+
+        using Table = typename std::conditional<IsConst, const fixed_table,
+                                                fixed_table>::type;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename fixed_table::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const value_type*,
+                                                  value_type*>::type;
+        using reference =
+            typename std::conditional<IsConst, const value_type&,
+                                      value_type&>::type;
+
+        BasicIterator() = default;
+
+        /// @brief Implicitly converts a mutable iterator to a const iterator.
+        template <bool OtherConst,
+                  typename = typename std::enable_if<IsConst &&
+                                                     !OtherConst>::type>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : table_(other.table_), index_(other.index_) {}
+
+        HMM_NODISCARD reference operator*() const {
+            return Policy::value_from_slot(table_->storage_.slots()[index_]);
+        }
+
+        HMM_NODISCARD pointer operator->() const {
+            return std::addressof(operator*());
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            skip_empty();
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        HMM_NODISCARD bool operator==(const BasicIterator& b) const noexcept {
+            return index_ == b.index_;
+        }
+        HMM_NODISCARD bool operator!=(const BasicIterator& b) const noexcept {
+            return !this->operator==(b);
+        }
+
+      private:
+        template <bool> friend class BasicIterator;
+
+        BasicIterator(Table* table, size_type index) noexcept
+            : table_(table), index_(index) {}
+
+        void skip_empty() noexcept {
+            const size_type cap = table_->storage_.capacity();
+            while (index_ < cap && table_->storage_.ctrl()[index_] < 0) {
+                ++index_;
+            }
+        }
+
+        Table* table_ = nullptr;
+        size_type index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    /// @brief Builds an empty table, forwarding `args` to the storage.
+    template <class... StorageArgs>
+    explicit fixed_table(const hasher_type& hash, const key_equal& eq,
+                         StorageArgs&&... args)
+        : storage_(std::forward<StorageArgs>(args)...), hash_(hash), eq_(eq) {}
+
+    /// @name Container Interfaces
+    ///@{
+    HMM_NODISCARD iterator begin() noexcept {
+        iterator it(this, 0);
+        it.skip_empty();
+        return it;
+    }
+    HMM_NODISCARD const_iterator begin() const noexcept {
+        const_iterator it(this, 0);
+        it.skip_empty();
+        return it;
+    }
+    HMM_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    HMM_NODISCARD iterator end() noexcept {
+        return iterator(this, capacity());
+    }
+    HMM_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(this, capacity());
+    }
+    HMM_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return storage_.size_;
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return storage_.size_ == 0;
+    }
+
+    /// @brief Whether another new key would exceed `max_size()`.
+    HMM_NODISCARD bool full() const noexcept {
+        return storage_.size_ == max_size();
+    }
+
+    HMM_NODISCARD size_type max_size() const noexcept {
+        return storage_.max_size();
+    }
+
+    HMM_NODISCARD size_type capacity() const noexcept {
+        return storage_.capacity();
+    }
+
+    /// @brief Destroys every element.
+    void clear() noexcept {
+        storage_.destroy_all();
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    template <class K = key_type>
+    HMM_NODISCARD iterator find(const K& key) {
+        return iterator(this, find_index(key));
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD const_iterator find(const K& key) const {
+        return const_iterator(this, find_index(key));
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD bool contains(const K& key) const {
+        return find_index(key) != capacity();
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+    ///@}
+
+    /// @name Modifiers
+    ///@{
+    /// @brief Inserts a copy of `value` unless its key is already present.
+    /// @return `{end(), false}` if the key is new and the table is full.
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert_value(value);
+    }
+
+    /// @brief Inserts `value` unless its key is already present, in which
+    /// case, or when the table is full, `value` is left untouched.
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_value(std::move(value));
+    }
+
+    /// @brief Constructs an element unless its key is already present.
+    /// @return `{end(), false}` if the key is new and the table is full.
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        std::allocator<slot_type> alloc;
+        slot_type temp = Policy::new_slot(alloc, std::forward<Args>(args)...);
+        const FindInfo info = prepare_insert(Policy::key(temp));
+        if (!info.found && info.index != capacity()) {
+            Policy::construct(alloc, storage_.slots() + info.index,
+                              std::move(temp));
+            commit(info);
+        }
+        return result(info);
+    }
+
+    /// @brief Constructs an element from `key` and `args` unless the key is
+    /// already present, in which case the arguments are not used.
+    /// @return `{end(), false}` if the key is new and the table is full.
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const FindInfo info = prepare_insert(key);
+        if (!info.found && info.index != capacity()) {
+            std::allocator<slot_type> alloc;
+            Policy::construct(
+                alloc, storage_.slots() + info.index, std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            commit(info);
+        }
+        return result(info);
+    }
+
+    /// @brief Removes the element at `pos`.
+    /// @details Later members of the probe run shift back. A run that wraps
+    /// past the last slot can shift an element from the first slots, which
+    /// iteration has already passed, to `pos` or beyond; a loop that erases
+    /// while iterating then visits that element again.
+    /// @return An iterator to the next position, which may be `pos` itself
+    /// holding an element shifted into it.
+    iterator erase(const_iterator pos) {
+        erase_at(pos.index_);
+        iterator it(this, pos.index_);
+        it.skip_empty();
+        return it;
+    }
+
+    /// @brief Removes the element with `key`.
+    /// @return 1 if an element was removed, 0 otherwise.
+    template <class K = key_type> size_type erase_element(const K& key) {
+        const size_type index = find_index(key);
+        if (index == capacity()) {
+            return 0;
+        }
+        erase_at(index);
+        return 1;
+    }
+    ///@}
+
+    /// @name Observers
+    ///@{
+    HMM_NODISCARD const hasher_type& hash_function() const noexcept {
+        return hash_;
+    }
+
+    HMM_NODISCARD const key_equal& key_eq() const noexcept {
+        return eq_;
+    }
+    ///@}
+
+  protected:
+    /// @brief Locates `key`, returning `capacity()` when it is absent.
+    template <class K>
+    HMM_NODISCARD size_type find_index(const K& key) const {
+        const size_type cap = capacity();
+        if (cap == 0) {
+            return 0;
+        }
+        const std::size_t hash = hash_(key);
+        const auto h2 = detail::H2(hash);
+        size_type index = home(hash);
+        while (true) {
+            Group g = Group::Load(storage_.ctrl() + index);
+            for (auto mask = g.Match(h2); mask; ++mask) {
+                const size_type probe =
+                    (index + mask.first_index()) & (cap - 1);
+                if (eq_(key, Policy::key(storage_.slots()[probe]))) {
+                    return probe;
+                }
+            }
+            if (g.MatchEmpty()) {
+                return cap;
+            }
+            index = (index + kGroupWidth) & (cap - 1);
+        }
+    }
+
+    /// @brief Finds `key`, or the free slot it should go into. A free slot
+    /// is only marked full by `commit`, once its element is built. The index
+    /// is `capacity()` if the key is new and the table is full.
+    template <class K> FindInfo prepare_insert(const K& key) {
+        const size_type cap = capacity();
+        if (full()) {
+            // Only a lookup is possible, and it reports a new key as full.
+            const size_type index = find_index(key);
+            return {index, 0, index != cap};
+        }
+        const std::size_t hash = hash_(key);
+        const auto h2 = detail::H2(hash);
+        size_type index = home(hash);
+        while (true) {
+            Group g = Group::Load(storage_.ctrl() + index);
+            for (auto mask = g.Match(h2); mask; ++mask) {
+                const size_type probe =
+                    (index + mask.first_index()) & (cap - 1);
+                if (eq_(key, Policy::key(storage_.slots()[probe]))) {
+                    return {probe, h2, true};
+                }
+            }
+            if (auto mask = g.MatchEmpty()) {
+                return {(index + mask.first_index()) & (cap - 1), h2, false};
+            }
+            index = (index + kGroupWidth) & (cap - 1);
+        }
+    }
+
+    /// @brief Marks a slot found by `prepare_insert` as full.
+    void commit(const FindInfo& info) noexcept {
+        set_ctrl(info.index, info.h2);
+        ++storage_.size_;
+    }
+
+    template <class V> std::pair<iterator, bool> insert_value(V&& value) {
+        const FindInfo info = prepare_insert(Policy::key(value));
+        if (!info.found && info.index != capacity()) {
+            std::allocator<slot_type> alloc;
+            Policy::construct(alloc, storage_.slots() + info.index,
+                              std::forward<V>(value));
+            commit(info);
+        }
+        return result(info);
+    }
+
+    Storage storage_;
+
+  private:
+    std::pair<iterator, bool> result(const FindInfo& info) noexcept {
+        return {iterator(this, info.index),
+                !info.found && info.index != capacity()};
+    }
+
+    HMM_NODISCARD size_type home(std::size_t hash) const noexcept {
+        return detail::IndexWithoutProbing(detail::H1(hash), capacity());
+    }
+
+    void set_ctrl(size_type index, ctrl_t c) noexcept {
+        storage_.ctrl()[index] = c;
+        // Mirror the first group into the tail so group loads never wrap.
+        if (index < kGroupWidth - 1) {
+            storage_.ctrl()[capacity() + index] = c;
+        }
+    }
+
+    /// @brief Destroys the element at `index` and closes the gap by shifting
+    /// back each later member of the run whose home is not past the gap.
+    /// @details If the hasher or a move throws, the current gap is emptied,
+    /// so no slot marked full is left without an element; later members of
+    /// the run may then no longer be found.
+    void erase_at(size_type index) {
+        std::allocator<slot_type> alloc;
+        const size_type cap = capacity();
+        slot_type* slots = storage_.slots();
+        Policy::destroy(alloc, slots + index);
+
+        size_type gap = index;
+        size_type next = index;
+        try {
+            while (true) {
+                next = (next + 1) & (cap - 1);
+                if (storage_.ctrl()[next] < 0) {
+                    break;
+                }
+                const size_type h = home(hash_(Policy::key(slots[next])));
+                // The element may fill the gap unless its home lies
+                // cyclically within (gap, next].
+                const bool stays = gap <= next ? (gap < h && h <= next)
+                                               : (gap < h || h <= next);
+                if (stays) {
+                    continue;
+                }
+                Policy::transfer(alloc, slots + gap, slots + next);
+                set_ctrl(gap, storage_.ctrl()[next]);
+                gap = next;
+            }
+        } catch (...) {
+            set_ctrl(gap, detail::slots::kEmpty);
+            --storage_.size_;
+            throw;
+        }
+        set_ctrl(gap, detail::slots::kEmpty);
+        --storage_.size_;
+    }
+
+    hasher_type hash_;
+    key_equal eq_;
+};
+
+template <class Policy, class Storage, class... TArgs>
+constexpr typename fixed_table<Policy, Storage, TArgs...>::size_type
+    fixed_table<Policy, Storage, TArgs...>::kGroupWidth;
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_FIXED_TABLE_HPP
@@ -0,0 +1,450 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_INTERNAL_FROZEN_TABLE_HPP
+#define HMM_HMM_INTERNAL_FROZEN_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "hmm/internal/city-hash-fwd.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/hash-mix.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief An immutable table addressed by a minimal perfect hash.
+///
+/// The table is built once from a range, PTHash style. The key's hash is
+/// re-seeded with `CityHash64WithSeed`. Keys are split into buckets, with 60%
+/// of them going to 30% of the buckets. The buckets are processed largest
+/// first. Each bucket gets the first 16-bit pilot for which
+/// `hash ^ Mix64(pilot + seed)` sends all of its keys to distinct free
+/// positions.
+///
+/// Positions are drawn from slightly more than `n` values. The few keys
+/// landing past `n` are remapped onto the holes below it, so the elements fill
+/// exactly `n` slots. A lookup computes one position and compares one key.
+/// There are no control bytes and no probing.
+///
+/// Memory is `n` slots, plus about 2 * 6 / log2(n) bytes of pilots per key,
+/// plus 4 bytes for every 64 keys of remapping.
+///
+/// @tparam Policy A flat policy such as `MapPolicy` or `SetPolicy`.
+/// @tparam TArgs Optionally the hash functor, equality functor and allocator.
+template <class Policy, class... TArgs> class frozen_table {
+  public:
+    using policy_type = Policy;
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using slot_type = typename Policy::slot_type;
+    using hasher_type = typename detail::TypeAtIndexOrDefault<
+        0, typename Policy::default_hasher_type, TArgs...>::type;
+    using key_equal = typename detail::TypeAtIndexOrDefault<
+        1, typename Policy::default_eq_type, TArgs...>::type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+  private:
+    using provided_allocator_type = typename detail::TypeAtIndexOrDefault<
+        2, typename Policy::default_allocator_type, TArgs...>::type;
+    template <class T>
+    using rebind_alloc = typename std::allocator_traits<
+        provided_allocator_type>::template rebind_alloc<T>;
+
+  public:
+    using allocator_type = rebind_alloc<value_type>;
+
+    /// @brief Read-only iterator over the stored elements.
+    class const_iterator {
+        friend frozen_table;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename frozen_table::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        constexpr const_iterator() = default;
+
+        HMM_NODISCARD reference operator*() const {
+            return Policy::value_from_slot(*slot_);
+        }
+
+        HMM_NODISCARD pointer operator->() const {
+            return std::addressof(operator*());
+        }
+
+        HMM_CONSTEXPR_14 const_iterator& operator++() noexcept {
+            ++slot_;
+            return *this;
+        }
+
+        HMM_CONSTEXPR_14 const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        HMM_NODISCARD constexpr bool
+        operator==(const const_iterator& b) const noexcept {
+            return slot_ == b.slot_;
+        }
+        HMM_NODISCARD constexpr bool
+        operator!=(const const_iterator& b) const noexcept {
+            return !this->operator==(b);
+        }
+
+      private:
+        constexpr explicit const_iterator(const slot_type* slot)
+            : slot_(slot) {}
+
+        const slot_type* slot_ = nullptr;
+    };
+    using iterator = const_iterator;
+
+    frozen_table(const hasher_type& hash, const key_equal& eq,
+                 const allocator_type& alloc)
+        : hash_(hash), eq_(eq), slots_(rebind_alloc<slot_type>(alloc)),
+          pilots_(rebind_alloc<std::uint16_t>(alloc)),
+          remap_(rebind_alloc<std::uint32_t>(alloc)) {}
+
+    HMM_NODISCARD const_iterator begin() const noexcept {
+        return const_iterator(slots_.data());
+    }
+    HMM_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    HMM_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(slots_.data() + slots_.size());
+    }
+    HMM_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return slots_.size();
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return slots_.empty();
+    }
+
+    /// @brief Finds the element with `key`, checking a single slot.
+    /// @return An iterator to the element, or `end()` if not found.
+    template <class K = key_type>
+    HMM_NODISCARD const_iterator find(const K& key) const {
+        if (slots_.empty()) {
+            return end();
+        }
+        const auto slot = &slots_[position_of(hash_(key))];
+        return eq_(key, Policy::key(*slot)) ? const_iterator(slot) : end();
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD bool contains(const K& key) const {
+        return find(key) != end();
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    HMM_NODISCARD const hasher_type& hash_function() const noexcept {
+        return hash_;
+    }
+
+    HMM_NODISCARD const key_equal& key_eq() const noexcept {
+        return eq_;
+    }
+
+    HMM_NODISCARD allocator_type get_allocator() const {
+        return allocator_type(slots_.get_allocator());
+    }
+
+  protected:
+    /// @brief Builds the table from a range. The first of several equal keys
+    /// is kept.
+    /// @throws std::invalid_argument If the hasher maps two distinct keys to
+    /// the same value, which no seed can separate.
+    /// @throws std::length_error If the range holds 2^32 or more keys.
+    template <class InputIt> void build(InputIt first, InputIt last) {
+        std::vector<slot_type, rebind_alloc<slot_type>> staged(
+            slots_.get_allocator());
+        for (; first != last; ++first) {
+            staged.emplace_back(*first);
+        }
+        if (staged.size() >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("frozen table exceeds 2^32 - 1 keys");
+        }
+
+        std::vector<std::size_t> ids;
+        std::vector<std::uint64_t> hashes;
+        unique_keys(staged, ids, hashes);
+        const std::size_t n = ids.size();
+        if (n == 0) {
+            return;
+        }
+
+        std::vector<std::uint32_t> positions(n);
+        for (std::uint64_t attempt = 0;; ++attempt) {
+            if (attempt == kMaxAttempts) {
+                throw std::runtime_error("frozen table found no perfect hash");
+            }
+            init_layout(n, Mix64(attempt + 1));
+            if (search_pilots(hashes, positions)) {
+                break;
+            }
+        }
+
+        // Remap the positions past `n` onto the holes below it, in order.
+        std::vector<std::uint32_t> slot_of(n);
+        std::vector<bool> taken(n, false);
+        for (std::size_t j = 0; j < n; ++j) {
+            if (positions[j] < n) {
+                taken[positions[j]] = true;
+            }
+        }
+        remap_.assign(table_size_ - n, 0);
+        std::uint32_t hole = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            if (positions[j] >= n) {
+                while (taken[hole]) {
+                    ++hole;
+                }
+                taken[hole] = true;
+                remap_[positions[j] - n] = hole;
+                positions[j] = hole;
+            }
+            slot_of[positions[j]] = static_cast<std::uint32_t>(j);
+        }
+
+        slots_.reserve(n);
+        for (std::size_t p = 0; p < n; ++p) {
+            slots_.emplace_back(std::move(staged[ids[slot_of[p]]]));
+        }
+    }
+
+  private:
+    /// @brief Attempts before giving up on finding pilots; each succeeds with
+    /// high probability.
+    static constexpr std::uint64_t kMaxAttempts = 64;
+    /// @brief Keys whose re-seeded hash has its top 32 bits below this go to
+    /// the dense 30% of buckets (60% of 2^32).
+    static constexpr std::uint64_t kDenseThreshold = 2576980377ULL;
+
+    HMM_NODISCARD std::uint64_t seeded(std::uint64_t hash) const noexcept {
+        return CityHash64WithSeed(reinterpret_cast<const char*>(&hash),
+                                  sizeof(hash), seed_);
+    }
+
+    HMM_NODISCARD std::size_t bucket_of(std::uint64_t k) const noexcept {
+        const std::uint64_t spread = k * 0x9E3779B97F4A7C15ULL;
+        if (dense_buckets_ != 0 && (k >> 32) < kDenseThreshold) {
+            return FastRange64(spread, dense_buckets_);
+        }
+        return dense_buckets_ +
+               FastRange64(spread, pilots_.size() - dense_buckets_);
+    }
+
+    HMM_NODISCARD std::uint64_t position_for(std::uint64_t k,
+                                             std::uint16_t pilot) const
+        noexcept {
+        return FastRange64(k ^ Mix64(pilot + seed_), table_size_);
+    }
+
+    HMM_NODISCARD std::size_t position_of(std::uint64_t hash) const noexcept {
+        const std::uint64_t k = seeded(hash);
+        const auto p = position_for(k, pilots_[bucket_of(k)]);
+        return p < slots_.size() ? p : remap_[p - slots_.size()];
+    }
+
+    /// @brief Drops repeated keys, keeping the first, and collects the
+    /// indices and hashes of the rest in input order.
+    void unique_keys(const std::vector<slot_type, rebind_alloc<slot_type>>&
+                         staged,
+                     std::vector<std::size_t>& ids,
+                     std::vector<std::uint64_t>& hashes) const {
+        std::vector<std::uint64_t> all(staged.size());
+        std::vector<std::size_t> order(staged.size());
+        for (std::size_t i = 0; i < staged.size(); ++i) {
+            all[i] = hash_(Policy::key(staged[i]));
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(),
+                  [&](std::size_t a, std::size_t b) {
+                      return all[a] != all[b] ? all[a] < all[b] : a < b;
+                  });
+
+        std::vector<bool> keep(staged.size(), true);
+        for (std::size_t i = 1; i < order.size(); ++i) {
+            std::size_t run = i - 1;
+            while (run > 0 && !keep[order[run]]) {
+                --run;
+            }
+            if (all[order[i]] != all[order[run]]) {
+                continue;
+            }
+            if (!eq_(Policy::key(staged[order[i]]),
+                     Policy::key(staged[order[run]]))) {
+                throw std::invalid_argument(
+                    "frozen table keys share a hash value");
+            }
+            keep[order[i]] = false;
+        }
+
+        for (std::size_t i = 0; i < staged.size(); ++i) {
+            if (keep[i]) {
+                ids.push_back(i);
+                hashes.push_back(all[i]);
+            }
+        }
+    }
+
+    /// @brief Sizes the position range and the buckets for `n` keys.
+    void init_layout(std::size_t n, std::uint64_t seed) {
+        seed_ = seed;
+        table_size_ = n + n / 64 + 1;
+        std::size_t log2 = 1;
+        while ((std::size_t(1) << log2) < n) {
+            ++log2;
+        }
+        pilots_.assign(std::max<std::size_t>(1, n * 6 / log2), 0);
+        dense_buckets_ = pilots_.size() * 3 / 10;
+    }
+
+    /// @brief Assigns a pilot to every bucket, largest bucket first.
+    /// @return `false` if some bucket found no pilot, so that another seed
+    /// must be tried.
+    bool search_pilots(const std::vector<std::uint64_t>& hashes,
+                       std::vector<std::uint32_t>& positions) {
+        const std::size_t n = hashes.size();
+        const std::size_t buckets = pilots_.size();
+
+        // Group the keys by bucket with a counting sort.
+        std::vector<std::uint64_t> keys(n);
+        std::vector<std::uint32_t> bucket(n);
+        std::vector<std::size_t> begin(buckets + 1, 0);
+        for (std::size_t j = 0; j < n; ++j) {
+            keys[j] = seeded(hashes[j]);
+            bucket[j] = static_cast<std::uint32_t>(bucket_of(keys[j]));
+            ++begin[bucket[j] + 1];
+        }
+        for (std::size_t b = 0; b < buckets; ++b) {
+            begin[b + 1] += begin[b];
+        }
+        std::vector<std::uint32_t> members(n);
+        {
+            std::vector<std::size_t> fill(begin.begin(), begin.end() - 1);
+            for (std::size_t j = 0; j < n; ++j) {
+                members[fill[bucket[j]]++] = static_cast<std::uint32_t>(j);
+            }
+        }
+
+        std::vector<std::uint32_t> by_size(buckets);
+        for (std::size_t b = 0; b < buckets; ++b) {
+            by_size[b] = static_cast<std::uint32_t>(b);
+        }
+        std::stable_sort(by_size.begin(), by_size.end(),
+                         [&](std::uint32_t a, std::uint32_t b) {
+                             return begin[a + 1] - begin[a] >
+                                    begin[b + 1] - begin[b];
+                         });
+
+        std::vector<bool> taken(table_size_, false);
+        for (const auto b : by_size) {
+            const std::size_t first = begin[b];
+            const std::size_t last = begin[b + 1];
+            if (first == last) {
+                break;
+            }
+            bool placed = false;
+            for (std::uint32_t pilot = 0;
+                 pilot <= std::numeric_limits<std::uint16_t>::max() &&
+                 !placed;
+                 ++pilot) {
+                placed = try_pilot(static_cast<std::uint16_t>(pilot), keys,
+                                   members, first, last, taken, positions);
+                if (placed) {
+                    pilots_[b] = static_cast<std::uint16_t>(pilot);
+                }
+            }
+            if (!placed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Places a bucket's keys with `pilot` if they all land on
+    /// distinct free positions.
+    bool try_pilot(std::uint16_t pilot, const std::vector<std::uint64_t>& keys,
+                   const std::vector<std::uint32_t>& members,
+                   std::size_t first, std::size_t last,
+                   std::vector<bool>& taken,
+                   std::vector<std::uint32_t>& positions) const {
+        std::size_t i = first;
+        for (; i < last; ++i) {
+            const auto j = members[i];
+            const auto p = position_for(keys[j], pilot);
+            if (taken[p]) {
+                break;
+            }
+            taken[p] = true;
+            positions[j] = static_cast<std::uint32_t>(p);
+        }
+        if (i == last) {
+            return true;
+        }
+        // Release the positions claimed before the collision.
+        while (i-- > first) {
+            taken[positions[members[i]]] = false;
+        }
+        return false;
+    }
+
+    hasher_type hash_;
+    key_equal eq_;
+    std::vector<slot_type, rebind_alloc<slot_type>> slots_;
+    std::vector<std::uint16_t, rebind_alloc<std::uint16_t>> pilots_;
+    std::vector<std::uint32_t, rebind_alloc<std::uint32_t>> remap_;
+    std::uint64_t seed_ = 0;
+    std::uint64_t table_size_ = 0;
+    std::size_t dense_buckets_ = 0;
+};
+
+template <class Policy, class... TArgs>
+constexpr std::uint64_t frozen_table<Policy, TArgs...>::kMaxAttempts;
+
+template <class Policy, class... TArgs>
+constexpr std::uint64_t frozen_table<Policy, TArgs...>::kDenseThreshold;
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_FROZEN_TABLE_HPP
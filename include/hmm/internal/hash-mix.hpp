@@ -0,0 +1,49 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_HASH_MIX_HPP
+#define HMM_HMM_INTERNAL_HASH_MIX_HPP
+
+#include <cstdint>
+
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Maps `x` onto `[0, n)`, using the high half of a 128-bit product
+/// where the compiler provides one.
+HMM_NODISCARD inline std::uint64_t FastRange64(std::uint64_t x,
+                                               std::uint64_t n) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128_t = unsigned __int128;
+    return static_cast<std::uint64_t>((uint128_t(x) * n) >> 64);
+#else
+    return x % n;
+#endif
+}
+
+/// @brief The splitmix64 finalizer, a cheap bijective 64-bit mixer.
+HMM_NODISCARD inline std::uint64_t Mix64(std::uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_HASH_MIX_HPP
@@ -0,0 +1,185 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_INDEX_TABLE_HPP
+#define HMM_HMM_INTERNAL_INDEX_TABLE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "hmm/internal/macros.hpp"
+#include "hmm/internal/raw-hash-set.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief The slot of an index table: a 32-bit position into storage that is
+/// owned by the enclosing container.
+struct IndexSlot {
+    std::uint32_t index;
+};
+
+/// @brief Hashing functor for index tables.
+///
+/// Keys are resolved through the owning container, so the table itself only
+/// ever stores 32-bit indices. Lookups by key hash the key directly, while
+/// rehashing resolves each stored index back to its key first.
+///
+/// @tparam Owner The container holding the keys. Must provide
+///               `key_at(std::uint32_t)`.
+/// @tparam Hash The user-facing hashing functor.
+template <class Owner, class Hash> class IndexHasher {
+  public:
+    IndexHasher() = default;
+
+    HMM_CONSTEXPR_14 IndexHasher(const Owner* owner, const Hash& hash)
+        : owner_(owner), hash_(hash) {}
+
+    HMM_NODISCARD std::size_t operator()(IndexSlot slot) const {
+        return hash_(owner_->key_at(slot.index));
+    }
+
+    template <class K>
+    HMM_NODISCARD std::size_t operator()(const K& key) const {
+        return hash_(key);
+    }
+
+    /// @brief Points the functor at a new owner after it has been moved.
+    HMM_CONSTEXPR_14 void rebind(const Owner* owner) noexcept {
+        owner_ = owner;
+    }
+
+    HMM_NODISCARD constexpr const Hash& hash_function() const noexcept {
+        return hash_;
+    }
+
+  private:
+    const Owner* owner_ = nullptr;
+    Hash hash_;
+};
+
+/// @brief Equality functor for index tables.
+///
+/// Comparing two indices never touches the keys, which makes relocating an
+/// entry (looking up its own index) a pure integer comparison.
+///
+/// @tparam Owner The container holding the keys. Must provide
+///               `key_at(std::uint32_t)`.
+/// @tparam Eq The user-facing equality functor.
+template <class Owner, class Eq> class IndexEq {
+  public:
+    IndexEq() = default;
+
+    HMM_CONSTEXPR_14 IndexEq(const Owner* owner, const Eq& eq)
+        : owner_(owner), eq_(eq) {}
+
+    HMM_NODISCARD constexpr bool operator()(IndexSlot lhs,
+                                            IndexSlot rhs) const noexcept {
+        return lhs.index == rhs.index;
+    }
+
+    template <class K>
+    HMM_NODISCARD bool operator()(const K& key, IndexSlot slot) const {
+        return eq_(key, owner_->key_at(slot.index));
+    }
+
+    /// @brief Points the functor at a new owner after it has been moved.
+    HMM_CONSTEXPR_14 void rebind(const Owner* owner) noexcept {
+        owner_ = owner;
+    }
+
+    HMM_NODISCARD constexpr const Eq& key_eq() const noexcept {
+        return eq_;
+    }
+
+  private:
+    const Owner* owner_ = nullptr;
+    Eq eq_;
+};
+
+/// @brief Policy trait for tables whose slots are small trivially copyable
+/// handles into storage owned elsewhere, `IndexSlot`s by default.
+/// @tparam Alloc The allocator the owning container was given.
+/// @tparam Slot The handle stored in each slot.
+template <class Alloc, class Slot = IndexSlot> struct IndexPolicy {
+    using key_type = Slot;
+    using mapped_type = void;
+    using value_type = Slot;
+    using slot_type = Slot;
+
+    using default_hasher_type = void;
+    using default_eq_type = void;
+    using default_allocator_type = typename std::allocator_traits<
+        Alloc>::template rebind_alloc<slot_type>;
+
+    HMM_NODISCARD static constexpr const key_type&
+    key(const slot_type& slot) noexcept {
+        // NOLINTNEXTLINE(bugprone-return-const-ref-from-parameter)
+        return slot;
+    }
+
+    HMM_NODISCARD static HMM_CONSTEXPR_14 value_type&
+    value_from_slot(slot_type& slot) noexcept {
+        return slot;
+    }
+
+    HMM_NODISCARD static constexpr const value_type&
+    value_from_slot(const slot_type& slot) noexcept {
+        // NOLINTNEXTLINE(bugprone-return-const-ref-from-parameter)
+        return slot;
+    }
+
+    template <class A, class... Args>
+    static HMM_CONSTEXPR_20 void construct(A& alloc, slot_type* ptr,
+                                           Args&&... args) {
+        std::allocator_traits<A>::construct(alloc, ptr,
+                                            std::forward<Args>(args)...);
+    }
+
+    template <class A>
+    static HMM_CONSTEXPR_20 void destroy(A& alloc, slot_type* ptr) {
+        std::allocator_traits<A>::destroy(alloc, ptr);
+    }
+
+    template <class A>
+    static HMM_CONSTEXPR_20 void transfer(A& /* alloc */, slot_type* dst,
+                                          slot_type* src) noexcept {
+        *dst = *src;
+    }
+
+    template <class A>
+    static HMM_CONSTEXPR_14 slot_type new_slot(A& /* alloc */,
+                                               slot_type slot) noexcept {
+        return slot;
+    }
+
+    template <class A>
+    static HMM_CONSTEXPR_14 void drop_slot(A& /* alloc */,
+                                           slot_type& /* slot */) noexcept {}
+};
+
+/// @brief A SwissTable of 32-bit indices into storage owned by `Owner`.
+template <class Owner, class Hash, class Eq, class Alloc>
+using index_table =
+    raw_hash_set<IndexPolicy<Alloc>, IndexHasher<Owner, Hash>,
+                 IndexEq<Owner, Eq>,
+                 typename IndexPolicy<Alloc>::default_allocator_type>;
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_INDEX_TABLE_HPP
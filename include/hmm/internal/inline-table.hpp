@@ -0,0 +1,270 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_INLINE_TABLE_HPP
+#define HMM_HMM_INTERNAL_INLINE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/fixed-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Whether slots of type `Slot` may be copied and relocated as raw
+/// bytes, which makes an inline table of them trivially copyable.
+template <class Slot>
+struct IsInlineTrivial
+    : std::integral_constant<
+          bool, std::is_trivially_copy_constructible<Slot>::value &&
+                    std::is_trivially_move_constructible<Slot>::value &&
+                    std::is_trivially_destructible<Slot>::value> {};
+
+/// @brief Fixed table storage for up to `N` elements, as member arrays.
+///
+/// When the slots are trivial, copying and destroying the storage is left to
+/// the compiler, so the whole table is trivially copyable and can be moved
+/// around with `memcpy`, as `std::vector` does when it grows. Otherwise the
+/// specialization below copies slot by slot into the same positions.
+template <class Policy, std::size_t N,
+          bool Trivial = IsInlineTrivial<typename Policy::slot_type>::value>
+struct InlineStorage {
+    using slot_type = typename Policy::slot_type;
+    using ctrl_t = std::int8_t;
+
+    static constexpr std::size_t kCapacity = StaticCapacity(N);
+    static constexpr std::size_t kCtrlBytes = kCapacity + Group::kWidth - 1;
+
+    InlineStorage() noexcept {
+        reset_ctrl();
+    }
+
+    HMM_NODISCARD ctrl_t* ctrl() noexcept {
+        return ctrl_;
+    }
+    HMM_NODISCARD const ctrl_t* ctrl() const noexcept {
+        return ctrl_;
+    }
+    HMM_NODISCARD slot_type* slots() noexcept {
+        return reinterpret_cast<slot_type*>(bytes_);
+    }
+    HMM_NODISCARD const slot_type* slots() const noexcept {
+        return reinterpret_cast<const slot_type*>(bytes_);
+    }
+    HMM_NODISCARD static constexpr std::size_t capacity() noexcept {
+        return kCapacity;
+    }
+    HMM_NODISCARD static constexpr std::size_t max_size() noexcept {
+        return N;
+    }
+
+    /// @brief Marks every slot empty without destroying anything.
+    void reset_ctrl() noexcept {
+        for (auto& c : ctrl_) {
+            c = detail::slots::kEmpty;
+        }
+        size_ = 0;
+    }
+
+    /// @brief Destroys every element and marks every slot empty.
+    void destroy_all() noexcept {
+        reset_ctrl();
+    }
+
+    ctrl_t ctrl_[kCtrlBytes];
+    std::size_t size_;
+    alignas(slot_type) unsigned char bytes_[kCapacity * sizeof(slot_type)];
+};
+
+template <class Policy, std::size_t N>
+struct InlineStorage<Policy, N, false> : InlineStorage<Policy, N, true> {
+    using Base = InlineStorage<Policy, N, true>;
+    using slot_type = typename Policy::slot_type;
+
+    InlineStorage() noexcept = default;
+
+    InlineStorage(const InlineStorage& other) : Base() {
+        clone_from(other);
+    }
+
+    /// @brief Moves each element into the same slot and empties `other`.
+    InlineStorage(InlineStorage&& other) noexcept(
+        std::is_nothrow_move_constructible<slot_type>::value)
+        : Base() {
+        steal_from(other);
+    }
+
+    InlineStorage& operator=(const InlineStorage& other) {
+        if (this != &other) {
+            destroy_all();
+            clone_from(other);
+        }
+        return *this;
+    }
+
+    InlineStorage& operator=(InlineStorage&& other) noexcept(
+        std::is_nothrow_move_constructible<slot_type>::value) {
+        if (this != &other) {
+            destroy_all();
+            steal_from(other);
+        }
+        return *this;
+    }
+
+    ~InlineStorage() {
+        destroy_all();
+    }
+
+    void destroy_all() noexcept {
+        DestroyFullSlots<Policy>(this->ctrl_, this->slots(), Base::kCapacity);
+        this->reset_ctrl();
+    }
+
+  private:
+    /// @brief Copies every element of `other` into an empty table.
+    /// @details If a copy throws, the copies already made are destroyed: a
+    /// throwing constructor leaves no destructor to run.
+    void clone_from(const InlineStorage& other) {
+        std::allocator<slot_type> alloc;
+        try {
+            for (std::size_t i = 0; i < Base::kCapacity; ++i) {
+                if (other.ctrl_[i] >= 0) {
+                    Policy::construct(alloc, this->slots() + i,
+                                      other.slots()[i]);
+                    copy_ctrl(other, i);
+                }
+            }
+        } catch (...) {
+            destroy_all();
+            throw;
+        }
+    }
+
+    /// @brief Moves every element of `other` into an empty table, as
+    /// `clone_from` copies them.
+    void steal_from(InlineStorage& other) {
+        std::allocator<slot_type> alloc;
+        try {
+            for (std::size_t i = 0; i < Base::kCapacity; ++i) {
+                if (other.ctrl_[i] >= 0) {
+                    Policy::construct(alloc, this->slots() + i,
+                                      std::move(other.slots()[i]));
+                    copy_ctrl(other, i);
+                }
+            }
+        } catch (...) {
+            destroy_all();
+            throw;
+        }
+        other.destroy_all();
+    }
+
+    /// @brief Takes over the control byte of slot `i`, and its mirror, once
+    /// the slot has been built, so that `destroy_all` sees exactly the
+    /// slots built before a throw.
+    void copy_ctrl(const InlineStorage& other, std::size_t i) noexcept {
+        this->ctrl_[i] = other.ctrl_[i];
+        if (i < Group::kWidth - 1) {
+            this->ctrl_[Base::kCapacity + i] = other.ctrl_[i];
+        }
+        ++this->size_;
+    }
+};
+
+/// @brief A fixed table over `InlineStorage`, for the inline containers.
+///
+/// Up to `N` elements live in `StaticCapacity(N)` slots inside the object.
+/// Unlike the base table, inserting a new key into a full table throws.
+///
+/// @tparam Policy `SetPolicy` or `MapPolicy`.
+/// @tparam N The maximum number of elements.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to the policy's hasher)
+///               2. Equality functor (Defaults to the policy's equality)
+template <class Policy, std::size_t N, class... TArgs>
+class inline_table
+    : public fixed_table<Policy, InlineStorage<Policy, N>, TArgs...> {
+    using Base = fixed_table<Policy, InlineStorage<Policy, N>, TArgs...>;
+
+  public:
+    using typename Base::hasher_type;
+    using typename Base::iterator;
+    using typename Base::key_equal;
+    using typename Base::size_type;
+    using typename Base::value_type;
+
+    /// @brief The number of slots, fixed at compile time.
+    static constexpr size_type kCapacity = StaticCapacity(N);
+
+    explicit inline_table(const hasher_type& hash = hasher_type(),
+                          const key_equal& eq = key_equal())
+        : Base(hash, eq) {}
+
+    HMM_NODISCARD static constexpr size_type max_size() noexcept {
+        return N;
+    }
+
+    HMM_NODISCARD static constexpr size_type capacity() noexcept {
+        return kCapacity;
+    }
+
+    /// @name Modifiers
+    /// As in `fixed_table`, but a new key that does not fit throws
+    /// `std::length_error`.
+    ///@{
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return checked(Base::insert(value));
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return checked(Base::insert(std::move(value)));
+    }
+
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        return checked(Base::emplace(std::forward<Args>(args)...));
+    }
+
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return checked(Base::try_emplace(std::forward<K>(key),
+                                         std::forward<Args>(args)...));
+    }
+    ///@}
+
+  private:
+    std::pair<iterator, bool> checked(std::pair<iterator, bool> result) {
+        if (!result.second && result.first == this->end()) {
+            throw std::length_error("inline table capacity exceeded");
+        }
+        return result;
+    }
+};
+
+template <class Policy, std::size_t N, class... TArgs>
+constexpr typename inline_table<Policy, N, TArgs...>::size_type
+    inline_table<Policy, N, TArgs...>::kCapacity;
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_INLINE_TABLE_HPP
@@ -0,0 +1,159 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_KEY_MATCH_HPP
+#define HMM_HMM_INTERNAL_KEY_MATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Compares the keys of a whole group of 16 slots against one key.
+/// @details Only specialized for 4 byte keys, stored alone or at the start
+/// of an 8 byte slot, whose group spans at most two cache lines. Wider
+/// layouts read up to four lines per group and measured slower than
+/// comparing the candidates one by one. `kSupported` is false for them.
+/// @tparam KeySize The size of the key in bytes.
+/// @tparam Stride The size of a slot in bytes.
+template <std::size_t KeySize, std::size_t Stride> struct KeyGroup {
+    static constexpr bool kSupported = false;
+};
+
+#if defined(HMM_SSE2)
+
+/// @brief Four byte keys packed densely, as in `flat_hash_set<uint32_t>`.
+template <> struct KeyGroup<4, 4> {
+    static constexpr bool kSupported = true;
+
+    static uint32_t Match(const unsigned char* slots, uint32_t key) {
+        uint32_t mask = 0;
+#if defined(HMM_AVX2)
+        const __m256i k = _mm256_set1_epi32(static_cast<int32_t>(key));
+        for (int i = 0; i < 2; ++i) {
+            const __m256i v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(slots + 32 * i));
+            const __m256i eq = _mm256_cmpeq_epi32(v, k);
+            mask |= static_cast<uint32_t>(
+                        _mm256_movemask_ps(_mm256_castsi256_ps(eq)))
+                    << (8 * i);
+        }
+#else
+        const __m128i k = _mm_set1_epi32(static_cast<int32_t>(key));
+        for (int i = 0; i < 4; ++i) {
+            const __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(slots + 16 * i));
+            const __m128i eq = _mm_cmpeq_epi32(v, k);
+            mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(eq)))
+                    << (4 * i);
+        }
+#endif
+        return mask;
+    }
+};
+
+/// @brief Four byte keys followed by four bytes of value, as in
+/// `flat_hash_map<uint32_t, float>`. Pairs of loads are shuffled so that
+/// only the keys are compared.
+template <> struct KeyGroup<4, 8> {
+    static constexpr bool kSupported = true;
+
+    static uint32_t Match(const unsigned char* slots, uint32_t key) {
+        const __m128i k = _mm_set1_epi32(static_cast<int32_t>(key));
+        uint32_t mask = 0;
+        for (int i = 0; i < 4; ++i) {
+            const __m128 lo = _mm_loadu_ps(
+                reinterpret_cast<const float*>(slots + 32 * i));
+            const __m128 hi = _mm_loadu_ps(
+                reinterpret_cast<const float*>(slots + 32 * i + 16));
+            const __m128i keys = _mm_castps_si128(
+                _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m128i eq = _mm_cmpeq_epi32(keys, k);
+            mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(eq)))
+                    << (4 * i);
+        }
+        return mask;
+    }
+};
+
+#endif
+
+/// @brief Detects whether the key of `Slot` is a `Key` at offset zero: the
+/// slot is the key itself, or a `std::pair` whose first member is the key.
+template <class Slot, class Key>
+struct KeyLeadsSlot : std::is_same<Slot, Key> {};
+
+template <class Key, class V>
+struct KeyLeadsSlot<std::pair<Key, V>, Key> : std::true_type {};
+
+/// @brief Detects whether `Eq` compares keys of type `Key` with `==`.
+template <class Eq, class Key> struct IsPlainEqual : std::false_type {};
+
+template <class Key>
+struct IsPlainEqual<std::equal_to<Key>, Key> : std::true_type {};
+
+#if HMM_HAS_CXX_14
+template <class Key>
+struct IsPlainEqual<std::equal_to<>, Key> : std::true_type {};
+#endif
+
+/// @brief Decides whether lookups of a `K` in a table with `Policy` and
+/// `Eq` may compare the keys of a whole group at once.
+/// @details This requires an integral or enum key, for which `==` is the
+/// same as comparing bytes, compared by plain `==`, at the start of a slot
+/// layout that `KeyGroup` supports. Floating point keys are left out since
+/// `0.0 == -0.0` while their bytes differ. The slot must be trivially
+/// copy constructible and destructible, so that its bytes stay initialized
+/// once written: the group compare also reads free slots, whose storage
+/// `raw_hash_set` zeroes on allocation for these layouts.
+template <class Policy, class Eq, class K> struct DirectKeyMatch {
+    using key_type = typename Policy::key_type;
+    using slot_type = typename Policy::slot_type;
+
+    static constexpr bool value =
+        std::is_same<typename std::decay<K>::type, key_type>::value &&
+        (std::is_integral<key_type>::value ||
+         std::is_enum<key_type>::value) &&
+        KeyLeadsSlot<slot_type, key_type>::value &&
+        std::is_trivially_copy_constructible<slot_type>::value &&
+        std::is_trivially_destructible<slot_type>::value &&
+        IsPlainEqual<Eq, key_type>::value &&
+        KeyGroup<sizeof(key_type), sizeof(slot_type)>::kSupported;
+};
+
+/// @brief Returns the 16 slots starting at `slots` whose key equals `key`,
+/// ignoring whether the slots are in use. Requires `KeyGroup` support for
+/// the layout, and 16 slots of initialized memory.
+template <class Slot, class Key>
+inline uint32_t MatchKeys(const Slot* slots, const Key& key) {
+    uint32_t bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return KeyGroup<sizeof(Key), sizeof(Slot)>::Match(
+        reinterpret_cast<const unsigned char*>(slots), bits);
+}
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_KEY_MATCH_HPP
@@ -57,6 +57,43 @@
 
 #define HMM_NODISCARD [[nodiscard]]
 
+// Detect __builtin_is_constant_evaluated, usable in every language mode.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define HMM_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define HMM_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
+// True during constant evaluation of an HMM_CONSTEXPR_14 function. Before
+// C++14 those are never constant evaluated. Conservatively true when the
+// compiler cannot tell, so that callers fall back to their constexpr-safe path.
+#if !HMM_HAS_CXX_14
+#define HMM_IS_CONSTANT_EVALUATED() false
+#elif defined(HMM_HAS_IS_CONSTANT_EVALUATED)
+#define HMM_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define HMM_IS_CONSTANT_EVALUATED() true
+#endif
+
+#if (defined(__BYTE_ORDER__) &&                                                \
+     __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ||                             \
+    defined(_MSC_VER)
+#define HMM_LITTLE_ENDIAN 1
+#endif
+
+// Hint that the cache line holding `addr` will be read soon.
+#if defined(__GNUC__) || defined(__clang__)
+#define HMM_PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HMM_PREFETCH(addr)                                                     \
+    _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define HMM_PREFETCH(addr) static_cast<void>(addr)
+#endif
+
 #ifdef HMM_NO_CHECKS
 #define HMM_ASSERT(...)
 #else
@@ -0,0 +1,96 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_MUTEX_HPP
+#define HMM_HMM_INTERNAL_MUTEX_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A mutex that performs no synchronization.
+///
+/// Selecting it as the mutex of a sharded container removes all locking, for
+/// containers that are only ever touched by one thread at a time but still
+/// benefit from sharding (e.g. smaller, independent rehashes).
+struct null_mutex {
+    HMM_CONSTEXPR_14 void lock() noexcept {}
+    HMM_CONSTEXPR_14 void unlock() noexcept {}
+    HMM_NODISCARD HMM_CONSTEXPR_14 bool try_lock() noexcept {
+        return true;
+    }
+    HMM_CONSTEXPR_14 void lock_shared() noexcept {}
+    HMM_CONSTEXPR_14 void unlock_shared() noexcept {}
+};
+
+namespace internal {
+
+/// @brief Detects whether a mutex supports shared (reader) locking.
+template <class Mutex, class = void> struct HasLockShared : std::false_type {};
+
+template <class Mutex>
+struct HasLockShared<Mutex,
+                     decltype(std::declval<Mutex&>().lock_shared(), void())>
+    : std::true_type {};
+
+/// @brief Scoped exclusive lock over any `Lockable` mutex.
+template <class Mutex> class WriteLock {
+  public:
+    explicit WriteLock(Mutex& mutex) : mutex_(mutex) {
+        mutex_.lock();
+    }
+    ~WriteLock() {
+        mutex_.unlock();
+    }
+
+    WriteLock(const WriteLock&) = delete;
+    WriteLock& operator=(const WriteLock&) = delete;
+
+  private:
+    Mutex& mutex_;
+};
+
+/// @brief Scoped reader lock. Takes a shared lock when the mutex supports
+/// one, and falls back to an exclusive lock otherwise.
+template <class Mutex, bool Shared = HasLockShared<Mutex>::value>
+class ReadLock {
+  public:
+    explicit ReadLock(Mutex& mutex) : mutex_(mutex) {
+        mutex_.lock_shared();
+    }
+    ~ReadLock() {
+        mutex_.unlock_shared();
+    }
+
+    ReadLock(const ReadLock&) = delete;
+    ReadLock& operator=(const ReadLock&) = delete;
+
+  private:
+    Mutex& mutex_;
+};
+
+template <class Mutex> class ReadLock<Mutex, false> : public WriteLock<Mutex> {
+  public:
+    explicit ReadLock(Mutex& mutex) : WriteLock<Mutex>(mutex) {}
+};
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_MUTEX_HPP
@@ -0,0 +1,121 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_NODE_SLOT_HPP
+#define HMM_HMM_INTERNAL_NODE_SLOT_HPP
+
+#include <memory>
+#include <utility>
+
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Shared slot operations for node-based policies.
+///
+/// Node policies store a pointer to a separately allocated element in each
+/// slot. Elements therefore never move once constructed, and relocating a
+/// slot during a rehash only copies the pointer.
+///
+/// @tparam Node The element type housed by each node.
+template <class Node> struct NodeSlotOps {
+    using slot_type = Node*;
+
+    /// @brief Allocates and constructs a node through a rebound copy of the
+    /// table's allocator.
+    template <class Alloc, class... Args>
+    static HMM_CONSTEXPR_20 slot_type new_node(Alloc& alloc, Args&&... args) {
+        using NodeAlloc =
+            typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+        NodeAlloc node_alloc(alloc);
+        Node* node = std::addressof(*NodeTraits::allocate(node_alloc, 1));
+        try {
+            NodeTraits::construct(node_alloc, node,
+                                  std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(node_alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    /// @brief Destroys and deallocates a node.
+    template <class Alloc>
+    static HMM_CONSTEXPR_20 void delete_node(Alloc& alloc, slot_type node) {
+        using NodeAlloc =
+            typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+        NodeAlloc node_alloc(alloc);
+        NodeTraits::destroy(node_alloc, node);
+        NodeTraits::deallocate(node_alloc, node, 1);
+    }
+
+    /// @brief Adopts an already allocated node into a slot.
+    template <class Alloc>
+    static HMM_CONSTEXPR_20 void construct(Alloc& /* alloc */, slot_type* ptr,
+                                           slot_type&& node) noexcept {
+        *ptr = node;
+    }
+
+    /// @brief Allocates a new node directly into a slot.
+    template <class Alloc, class... Args>
+    static HMM_CONSTEXPR_20 void construct(Alloc& alloc, slot_type* ptr,
+                                           Args&&... args) {
+        *ptr = new_node(alloc, std::forward<Args>(args)...);
+    }
+
+    /// @brief Destroys the node owned by a slot.
+    template <class Alloc>
+    static HMM_CONSTEXPR_20 void destroy(Alloc& alloc, slot_type* ptr) {
+        delete_node(alloc, *ptr);
+    }
+
+    /// @brief Relocates a node between slots. Only the pointer moves.
+    template <class Alloc>
+    static HMM_CONSTEXPR_20 void transfer(Alloc& /* alloc */, slot_type* dst,
+                                          slot_type* src) noexcept {
+        *dst = *src;
+    }
+
+    /// @brief Allocates a free-standing node, used to extract the key of an
+    /// element before probing for it.
+    template <class Alloc, class... Args>
+    static HMM_CONSTEXPR_20 slot_type new_slot(Alloc& alloc, Args&&... args) {
+        return new_node(alloc, std::forward<Args>(args)...);
+    }
+
+    /// @brief Releases a free-standing node that was not inserted.
+    template <class Alloc>
+    static HMM_CONSTEXPR_20 void drop_slot(Alloc& alloc, slot_type& node) {
+        delete_node(alloc, node);
+    }
+
+    /// @name Value Access
+    ///@{
+    HMM_NODISCARD static constexpr Node& value_from_slot(slot_type slot) {
+        return *slot;
+    }
+    ///@}
+};
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_NODE_SLOT_HPP
@@ -110,7 +110,10 @@ class raw_hash_map : protected raw_hash_set<Policy, TArgs...> {
     using Base::erase_element;
     using Base::find;
     using Base::insert;
+    using Base::insert_parallel;
+    using Base::partitions;
     using Base::reserve;
+    using Base::reserve_parallel;
     using Base::size;
     using Base::try_emplace;
 
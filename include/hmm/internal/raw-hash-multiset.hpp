@@ -0,0 +1,391 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_INTERNAL_RAW_HASH_MULTISET_HPP
+#define HMM_HMM_INTERNAL_RAW_HASH_MULTISET_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/macros.hpp"
+#include "hmm/internal/raw-hash-set.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief The core SwissTable-style hash table admitting equal keys.
+///
+/// `raw_hash_multiset` builds on top of `raw_hash_set` by utilizing protected
+/// inheritance. Equal keys share a hash, and therefore a probe sequence, and
+/// every insertion claims the first empty slot along it. Elements with equal
+/// keys thus sit one after another along the probe windows of their key, and
+/// `equal_range` is a single forward walk over those windows that stops at
+/// the first window containing an empty slot.
+///
+/// @tparam Policy A trait struct that dictates how keys and values are
+///                extracted from the underlying slot.
+/// @tparam TArgs Variadic pack defining [Hash, Eq, Allocator]. Falls back to
+/// Policy defaults.
+template <class Policy, class... TArgs>
+class raw_hash_multiset : protected raw_hash_set<Policy, TArgs...> {
+    using Base = raw_hash_set<Policy, TArgs...>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = typename Base::hasher_type;
+    using key_equal = typename Base::key_equal;
+    using key_type = typename Base::key_type;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+
+    using slot_type = typename Base::slot_type;
+    using slot_allocator = typename Base::slot_allocator;
+    using slot_traits = typename Base::slot_traits;
+    using pointer = typename Base::pointer;
+    using allocator_type = typename Base::allocator_type;
+
+    using const_iterator = typename Base::const_iterator;
+    using iterator = typename Base::iterator;
+
+    /// @brief Forward iterator over the elements matching a single key.
+    ///
+    /// The iterator walks the probe windows of the key, testing only the
+    /// slots whose control byte matches the key's H2. After the first match,
+    /// candidates are compared against the key stored in that element, so
+    /// the iterator never refers back to the caller's key object.
+    ///
+    /// @tparam Traits Differentiates between const and mutable iterators.
+    template <typename Traits> class KeyIterator {
+        friend raw_hash_multiset;
+        template <typename> friend class KeyIterator;
+
+        using TablePtr = typename std::conditional<Traits::is_const,
+                                                   const Base*, Base*>::type;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename raw_hash_multiset::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer =
+            typename std::conditional<Traits::is_const, const value_type*,
+                                      value_type*>::type;
+        using reference =
+            typename std::conditional<Traits::is_const, const value_type&,
+                                      value_type&>::type;
+
+        /// @brief Constructs the past-the-end iterator of any key range.
+        constexpr KeyIterator() = default;
+
+        /// @brief Implicitly converts a mutable iterator to a const iterator.
+        template <typename OtherTraits,
+                  typename = typename std::enable_if<(!OtherTraits::is_const ||
+                                                      (Traits::is_const &&
+                                                       OtherTraits::is_const)),
+                                                     void>::type>
+        constexpr KeyIterator(const KeyIterator<OtherTraits>& other)
+            : table_(other.table_), key_(other.key_), probe_(other.probe_),
+              index_(other.index_), mask_(other.mask_),
+              window_has_empty_(other.window_has_empty_), h2_(other.h2_) {}
+
+        HMM_NODISCARD reference operator*() const {
+            return policy_type::value_from_slot(table_->slots_ptr()[index_]);
+        }
+
+        HMM_NODISCARD pointer operator->() const {
+            return std::addressof(operator*());
+        }
+
+        KeyIterator& operator++() {
+            seek(*key_);
+            return *this;
+        }
+
+        KeyIterator operator++(int) {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        /// @brief Converts to the table-wide iterator at the same element.
+        HMM_NODISCARD const_iterator base() const {
+            return table_->iterator_at(index_);
+        }
+
+        HMM_NODISCARD constexpr bool
+        operator==(const KeyIterator& b) const noexcept {
+            return table_ == b.table_ && index_ == b.index_;
+        }
+        HMM_NODISCARD constexpr bool
+        operator!=(const KeyIterator& b) const noexcept {
+            return !this->operator==(b);
+        }
+
+      private:
+        /// @brief Starts a walk over the probe sequence of `full_hash`.
+        KeyIterator(TablePtr table, std::size_t full_hash)
+            : table_(table),
+              probe_(detail::IndexWithoutProbing(detail::H1(full_hash),
+                                                 table->capacity())),
+              h2_(detail::H2(full_hash)) {
+            load_window();
+        }
+
+        /// @brief Advances to the next slot holding a key equal to `key`, or
+        /// to the end of the range.
+        template <class K> void seek(const K& key) {
+            while (true) {
+                for (; mask_; ++mask_) {
+                    const std::size_t index =
+                        (probe_ + mask_.first_index()) &
+                        (table_->capacity() - 1);
+                    const auto& candidate =
+                        policy_type::key(table_->slots_ptr()[index]);
+                    if (table_->equal()(key, candidate)) {
+                        ++mask_;
+                        index_ = index;
+                        key_ = std::addressof(candidate);
+                        return;
+                    }
+                }
+                if (window_has_empty_) {
+                    *this = KeyIterator();
+                    return;
+                }
+                probe_ = table_->next_probe(probe_);
+                load_window();
+            }
+        }
+
+        void load_window() {
+            Group g = Group::Load(table_->ctrl_ptr() + probe_);
+            mask_ = g.Match(h2_);
+            window_has_empty_ = static_cast<bool>(g.MatchEmpty());
+        }
+
+        TablePtr table_ = nullptr;
+        const key_type* key_ = nullptr;
+        std::size_t probe_ = 0;
+        std::size_t index_ = 0;
+        BitMask mask_{0};
+        bool window_has_empty_ = false;
+        ctrl_t h2_ = 0;
+    };
+
+    using key_iterator = KeyIterator<typename Base::NormalIteratorTraits>;
+    using const_key_iterator = KeyIterator<typename Base::ConstIteratorTraits>;
+
+    /// @brief Default constructs an empty multiset.
+    HMM_CONSTEXPR_20 raw_hash_multiset() = default;
+
+    /// @brief Constructs an empty multiset utilizing a specific allocator.
+    HMM_CONSTEXPR_20 explicit raw_hash_multiset(const allocator_type& alloc)
+        : Base(alloc) {}
+
+    /// @brief Constructs a multiset from a range, keeping every element.
+    template <class Iter, class Sentinel>
+    HMM_CONSTEXPR_20
+    raw_hash_multiset(Iter begin, Sentinel end,
+                      const allocator_type& alloc = allocator_type())
+        : Base(alloc) {
+        insert(begin, end);
+    }
+
+    /// @brief Copy-constructs the multiset. Every duplicate is kept, as the
+    /// base copy clones the layout without looking up keys.
+    raw_hash_multiset(const raw_hash_multiset& other) : Base(other) {}
+
+    raw_hash_multiset& operator=(const raw_hash_multiset& other) {
+        if (this != &other) {
+            Base::clear();
+            insert(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    raw_hash_multiset(raw_hash_multiset&&) noexcept = default;
+    raw_hash_multiset& operator=(raw_hash_multiset&&) noexcept = default;
+
+    // Public Base Functionality Exposure
+    using Base::begin;
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::contains;
+    using Base::empty;
+    using Base::end;
+    using Base::find;
+    using Base::partitions;
+    using Base::reserve;
+    using Base::reserve_parallel;
+    using Base::size;
+
+    /// @brief Constructs an element in-place. Equal keys are always admitted.
+    /// @return An iterator to the inserted element.
+    template <class... Args> iterator emplace(Args&&... args) {
+        if (Base::needs_resize()) {
+            Base::rehash_and_grow();
+        }
+
+        slot_type temp = policy_type::new_slot(Base::get_allocator(),
+                                               std::forward<Args>(args)...);
+        const auto full_hash = Base::hasher()(policy_type::key(temp));
+        const auto index = Base::find_first_empty(full_hash);
+        Base::insert_at_index(index, full_hash, std::move(temp));
+        return Base::iterator_at(index);
+    }
+
+    /// @brief Constructs an element in-place whose key hashes to `full_hash`.
+    /// @details Allows bulk insertion under a single key to hash it once.
+    template <class... Args>
+    iterator emplace_hashed(std::size_t full_hash, Args&&... args) {
+        if (Base::needs_resize()) {
+            Base::rehash_and_grow();
+        }
+
+        const auto index = Base::find_first_empty(full_hash);
+        policy_type::construct(Base::get_allocator(),
+                               &Base::slots_ptr()[index],
+                               std::forward<Args>(args)...);
+        Base::finish_insert(index, full_hash);
+        return Base::iterator_at(index);
+    }
+
+    /// @brief Inserts a copy of an element.
+    iterator insert(const value_type& value) {
+        return emplace(value);
+    }
+
+    /// @brief Inserts an element via move semantics.
+    iterator insert(value_type&& value) {
+        return emplace(std::move(value));
+    }
+
+    /// @brief Inserts a range of elements, keeping duplicates.
+    /// @details Forward ranges reserve space for the whole range up front, so
+    /// the table grows at most once.
+    template <class InputIt> void insert(InputIt first, InputIt last) {
+        using Category =
+            typename std::iterator_traits<InputIt>::iterator_category;
+        reserve_for(first, last, Category{});
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    /// @brief Counts the elements matching the provided key.
+    template <class K> HMM_NODISCARD size_type count(const K& key) const {
+        size_type n = 0;
+        for (auto range = equal_range(key); range.first != range.second;
+             ++range.first) {
+            ++n;
+        }
+        return n;
+    }
+
+    /// @brief Retrieves the range of elements matching the provided key.
+    /// @return A pair of key iterators; the second is the past-the-end
+    /// iterator shared by every key range.
+    template <class K>
+    HMM_NODISCARD std::pair<key_iterator, key_iterator>
+    equal_range(const K& key) {
+        if (empty()) {
+            return {key_iterator(), key_iterator()};
+        }
+        key_iterator first(static_cast<Base*>(this), Base::hasher()(key));
+        first.seek(key);
+        return {first, key_iterator()};
+    }
+
+    /// @brief Retrieves the range of elements matching the provided key
+    /// (const context).
+    template <class K>
+    HMM_NODISCARD std::pair<const_key_iterator, const_key_iterator>
+    equal_range(const K& key) const {
+        if (empty()) {
+            return {const_key_iterator(), const_key_iterator()};
+        }
+        const_key_iterator first(static_cast<const Base*>(this),
+                                 Base::hasher()(key));
+        first.seek(key);
+        return {first, const_key_iterator()};
+    }
+
+    /// @brief Erases the element at the specified iterator position.
+    HMM_CONSTEXPR_20 iterator erase(const_iterator pos) {
+        return Base::erase(pos);
+    }
+
+    /// @brief Erases every element matching the provided key.
+    /// @details Each probe window is snapshotted before erasing from it, so a
+    /// single walk removes the whole range.
+    /// @return The number of elements removed.
+    template <class K> size_type erase_key(const K& key) {
+        if (empty()) {
+            return 0;
+        }
+
+        const auto full_hash = Base::hasher()(key);
+        const auto h2 = detail::H2(full_hash);
+        std::size_t index =
+            detail::IndexWithoutProbing(detail::H1(full_hash), capacity());
+
+        size_type erased = 0;
+        while (true) {
+            Group g = Group::Load(Base::ctrl_ptr() + index);
+            for (BitMask mask = g.Match(h2); mask; ++mask) {
+                std::size_t probe_index =
+                    (index + mask.first_index()) & (capacity() - 1);
+                if (Base::equal()(key, policy_type::key(
+                                           Base::slots_ptr()[probe_index]))) {
+                    Base::erase_at(probe_index);
+                    ++erased;
+                }
+            }
+            if (g.MatchEmpty()) {
+                return erased;
+            }
+            index = Base::next_probe(index);
+        }
+    }
+
+    HMM_NODISCARD HMM_CONSTEXPR_14 const hasher_type&
+    hash_function() const noexcept {
+        return Base::hasher();
+    }
+
+  private:
+    template <class InputIt>
+    void reserve_for(InputIt first, InputIt last, std::forward_iterator_tag) {
+        reserve(size() + static_cast<size_type>(std::distance(first, last)));
+    }
+
+    template <class InputIt>
+    void reserve_for(InputIt /* first */, InputIt /* last */,
+                     std::input_iterator_tag) {}
+};
+
+} // namespace internal
+} // namespace hmm
+
+#endif // HMM_HMM_INTERNAL_RAW_HASH_MULTISET_HPP
@@ -26,15 +26,21 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "hmm/internal/bit-mask.hpp"
 #include "hmm/internal/compressed-tuple.hpp"
 #include "hmm/internal/detail.hpp"
+#include "hmm/internal/key-match.hpp"
 #include "hmm/internal/macros.hpp"
 
 namespace hmm {
 namespace internal {
 
+/// @brief Grants the table algorithms access to the table under a container;
+/// defined in `hmm/algorithm.hpp`.
+struct TableAccess;
+
 /// @brief A wrapper union that prevents default initialization of a pointer.
 ///
 /// This union is utilized to hold pointers that might point to uninitialized
@@ -159,6 +165,8 @@ struct SizeInfo {
 
     std::size_t capacity_ =
         0; ///< The total number of allocated slots (must be a power of two).
+
+    std::size_t deleted_ = 0; ///< The number of tombstoned (erased) slots.
 };
 
 /// @brief Centralized state object storing policy dependencies and table
@@ -263,7 +271,8 @@ struct HasIsTransparent<T,
 /// control group array and the tightly packed data slots array.
 ///
 /// @tparam Policy Determines how keys and values are extracted (differentiates
-/// set vs map) and provides default types.
+/// set vs map), how slots are constructed, relocated and destroyed, and
+/// provides default types.
 /// @tparam TArgs Variadic pack defining [Hash, Eq, Allocator]. Falls back to
 /// Policy defaults.
 template <class Policy, class... TArgs> class raw_hash_set {
@@ -280,6 +289,9 @@ template <class Policy, class... TArgs> class raw_hash_set {
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using slot_type = typename policy_type::slot_type;
+    /// @brief The table type itself, named by `internal::TableAccess` to
+    /// reach the table under a container.
+    using raw_table_type = raw_hash_set;
 
   private:
     using provided_allocator_type = typename detail::TypeAtIndexOrDefault<
@@ -416,6 +428,15 @@ template <class Policy, class... TArgs> class raw_hash_set {
     HMM_CONSTEXPR_20 explicit raw_hash_set(const allocator_type& alloc)
         : members_(hasher_type{}, key_equal{}, byte_allocator(alloc)) {}
 
+    /// @brief Constructs an empty hash set with explicit hashing and equality
+    /// functors.
+    /// @details Required by stateful functors, which cannot be default
+    /// constructed into a meaningful state.
+    HMM_CONSTEXPR_20
+    raw_hash_set(const hasher_type& hash, const key_equal& eq,
+                 const allocator_type& alloc = allocator_type())
+        : members_(hash, eq, byte_allocator(alloc)) {}
+
     /// @brief Constructs a hash set from an iterator range.
     template <class Iter, class Sentinel>
     HMM_CONSTEXPR_20
@@ -445,6 +466,7 @@ template <class Policy, class... TArgs> class raw_hash_set {
         other.members_.set_slots(nullptr);
         other.members_.size_info_.capacity_ = 0;
         other.members_.size_info_.size_ = 0;
+        other.members_.size_info_.deleted_ = 0;
     }
 
     /// @brief Move-assigns the hash set, releasing old memory and transferring
@@ -457,21 +479,22 @@ template <class Policy, class... TArgs> class raw_hash_set {
             other.members_.set_slots(nullptr);
             other.members_.size_info_.capacity_ = 0;
             other.members_.size_info_.size_ = 0;
+            other.members_.size_info_.deleted_ = 0;
         }
         return *this;
     }
 
     /// @brief Copy-constructs the hash set, duplicating elements into a new
     /// allocation.
+    /// @details The copy shares the hasher of `other`, so it clones the
+    /// layout instead of rehashing: control bytes are copied wholesale and
+    /// each element is copy-constructed at its original index.
     raw_hash_set(const raw_hash_set& other)
         : members_(other.hasher(), other.equal(),
                    std::allocator_traits<byte_allocator>::
                        select_on_container_copy_construction(
                            other.get_allocator())) {
-        reserve(other.size());
-        for (const auto& elem : other) {
-            insert(elem);
-        }
+        clone_layout_from(other);
     }
 
     /// @brief Copy-assigns the hash set, destroying current elements and
@@ -530,6 +553,46 @@ template <class Policy, class... TArgs> class raw_hash_set {
         return end();
     }
 
+    /// @brief A contiguous range of slots that iterates on its own, handed
+    /// out by `partitions`.
+    template <class Iter> class SlotRange {
+      public:
+        constexpr SlotRange(Iter first, Iter last)
+            : begin_(first), end_(last) {}
+
+        HMM_NODISCARD constexpr Iter begin() const {
+            return begin_;
+        }
+
+        HMM_NODISCARD constexpr Iter end() const {
+            return end_;
+        }
+
+        HMM_NODISCARD constexpr bool empty() const {
+            return begin_ == end_;
+        }
+
+      private:
+        Iter begin_;
+        Iter end_;
+    };
+
+    /// @brief Splits the table into `n` sub-ranges for external schedulers.
+    /// @details The ranges cover the slots in order, begin and end on group
+    /// boundaries, and span nearly equal numbers of slots. Each can be
+    /// iterated independently and concurrently with the others; some are
+    /// empty when `n` exceeds the number of groups. Like iterators, they are
+    /// invalidated by a rehash.
+    HMM_NODISCARD std::vector<SlotRange<iterator>> partitions(size_type n) {
+        return make_partitions<iterator>(n);
+    }
+
+    /// @brief Splits the table into `n` sub-ranges of const iterators.
+    HMM_NODISCARD std::vector<SlotRange<const_iterator>>
+    partitions(size_type n) const {
+        return make_partitions<const_iterator>(n);
+    }
+
     /// @brief Retrieves the number of elements currently stored in the set.
     HMM_NODISCARD constexpr size_type size() const noexcept {
         return members_.size_info_.size_;
@@ -555,6 +618,7 @@ template <class Policy, class... TArgs> class raw_hash_set {
         std::memset(ctrl_ptr(), detail::slots::kEmpty,
                     capacity() + kGroupWidth);
         members_.size_info_.size_ = 0;
+        members_.size_info_.deleted_ = 0;
     }
 
     /// @brief Destroys all elements but leaves the capacity unchanged.
@@ -581,17 +645,164 @@ template <class Policy, class... TArgs> class raw_hash_set {
             return;
         }
 
-        // capacity * 0.875 >= count
-        size_type min_cap = (count * 8 + 6) / 7;
-        size_type cap = 16;
-        while (cap < min_cap) {
-            cap <<= 1;
-        }
+        const size_type cap = capacity_for(count);
         if (cap > capacity()) {
             rehash_and_grow(cap);
         }
     }
 
+    /// @brief Like `reserve`, but spreads the rehash over an executor.
+    /// @details The old table is split into ranges that are hashed
+    /// concurrently, and each worker then fills its own partitions of the
+    /// new table. The result matches `reserve` slot for slot.
+    /// @param count The number of elements to make room for.
+    /// @param executor An executor such as `hmm::thread_executor`.
+    template <class Executor>
+    void reserve_parallel(size_type count, Executor& executor) {
+        if (count == 0) {
+            return;
+        }
+
+        const size_type cap = capacity_for(count);
+        if (cap > capacity()) {
+            rehash_parallel(cap, executor);
+        }
+    }
+
+    /// @brief Bulk-inserts a range, spreading the work over an executor.
+    /// @details Sizes the table for the whole range up front, hashes the
+    /// range concurrently, buckets it by destination partition, and lets
+    /// each worker insert into its own partitions. As with a loop over
+    /// `insert`, keys already in the table are kept, and the first copy of a
+    /// key repeated in the range wins. Elements are constructed on the
+    /// workers, so the allocator must support concurrent use.
+    /// @tparam RandomIt A random access iterator over values, or over
+    /// key/value pairs for maps.
+    /// @param executor An executor such as `hmm::thread_executor`.
+    template <class RandomIt, class Executor>
+    void insert_parallel(RandomIt first, RandomIt last, Executor& executor) {
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (n == 0) {
+            return;
+        }
+
+        // Reserve once, so that neither pass below ever needs to grow.
+        const size_type cap = capacity_for(size() + n);
+        if (cap > capacity()) {
+            rehash_parallel(cap, executor);
+        } else if ((size() + deleted() + n) * 8 > capacity() * 7) {
+            rehash_parallel(capacity(), executor);
+        }
+
+        insert_hashed_parallel(
+            n, executor,
+            [&](std::size_t i) { return hasher()(input_key(first[i])); },
+            [&](std::size_t i) -> decltype(input_key(first[i])) {
+                return input_key(first[i]);
+            },
+            [&](slot_type* slot, std::size_t i) {
+                policy_type::construct(get_allocator(), slot, first[i]);
+            },
+            [](value_type&, std::size_t) {});
+    }
+
+    /// @brief Internal Hook: Inserts `n` items with an executor, hashing each
+    /// one exactly once.
+    /// @details Item `i` hashes to `hash_at(i)` and has the key `key_at(i)`.
+    /// A new element is built by `construct_at(slot, i)`; for a key already
+    /// present, `on_found(value, i)` is called on the existing element
+    /// instead. Items sharing a key are handled in item order.
+    ///
+    /// Each partition of the table is filled by a single task, which stops
+    /// at the load limit of its partition. Items that do not fit, or whose
+    /// probe leaves the partition, are inserted serially afterwards,
+    /// growing the table if needed.
+    template <class Executor, class HashAt, class KeyAt, class ConstructAt,
+              class OnFound>
+    void insert_hashed_parallel(std::size_t n, Executor& executor,
+                                const HashAt& hash_at, const KeyAt& key_at,
+                                const ConstructAt& construct_at,
+                                const OnFound& on_found) {
+        if (n == 0) {
+            return;
+        }
+        if (capacity() == 0) {
+            rehash_and_grow();
+        }
+
+        const auto buckets = bucket_by_partition(
+            n, capacity(), executor, [](std::size_t) { return true; },
+            hash_at);
+        const std::size_t partitions = buckets.begin.size() - 1;
+        const std::size_t partition = rehash_partition(capacity());
+
+        std::vector<std::size_t> placed(partitions, 0);
+        std::vector<std::vector<std::size_t>> deferred(partitions);
+        const auto settle = [&] {
+            for (std::size_t count : placed) {
+                members_.size_info_.size_ += count;
+            }
+        };
+        try {
+            executor.parallel_for(partitions, [&](std::size_t p) {
+                // Keep the partition below the table-wide load limit, so
+                // that probing always finds an empty slot.
+                std::size_t used = 0;
+                for (std::size_t i = p * partition; i < (p + 1) * partition;
+                     ++i) {
+                    used += ctrl_ptr()[i] != detail::slots::kEmpty;
+                }
+                const std::size_t limit = partition / 8 * 7;
+
+                for (std::size_t k = buckets.begin[p];
+                     k < buckets.begin[p + 1]; ++k) {
+                    const std::size_t i = buckets.order[k];
+                    if (used >= limit) {
+                        deferred[p].push_back(i);
+                        continue;
+                    }
+                    const auto info = find_or_prepare_insert_in_partition(
+                        key_at(i), buckets.hashes[i]);
+                    if (info.found) {
+                        on_found(policy_type::value_from_slot(
+                                     slots_ptr()[info.index]),
+                                 i);
+                    } else if (info.index == capacity()) {
+                        deferred[p].push_back(i);
+                    } else {
+                        construct_at(&slots_ptr()[info.index], i);
+                        set_ctrl(info.index, detail::H2(info.full_hash));
+                        ++placed[p];
+                        ++used;
+                    }
+                }
+            });
+        } catch (...) {
+            settle();
+            throw;
+        }
+        settle();
+
+        for (const auto& items : deferred) {
+            for (std::size_t i : items) {
+                const std::size_t full_hash = buckets.hashes[i];
+                auto info = find_or_prepare_insert_hashed(key_at(i), full_hash);
+                if (info.found) {
+                    on_found(
+                        policy_type::value_from_slot(slots_ptr()[info.index]),
+                        i);
+                    continue;
+                }
+                if (needs_resize()) {
+                    rehash_and_grow();
+                    info = find_or_prepare_insert_hashed(key_at(i), full_hash);
+                }
+                construct_at(&slots_ptr()[info.index], i);
+                finish_insert(info.index, full_hash);
+            }
+        }
+    }
+
     /// @brief Locates an element matching the provided key.
     /// @param key The key to look for.
     /// @return An iterator to the element, or `end()` if not found.
@@ -600,15 +811,36 @@ template <class Policy, class... TArgs> class raw_hash_set {
         if (empty()) {
             return end();
         }
+        return find_hashed(key, hasher()(key));
+    }
+
+    /// @brief Locates an element matching the provided key (const context).
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 const_iterator
+    find(const K& key) const noexcept {
+        if (empty()) {
+            return end();
+        }
+        return find_hashed(key, hasher()(key));
+    }
+
+    /// @brief Internal Hook: Locates an element whose key has already been
+    /// hashed to `full_hash`.
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 iterator
+    find_hashed(const K& key, std::size_t full_hash) noexcept {
+        if (empty()) {
+            return end();
+        }
 
-        const auto full_hash = hasher()(key);
         const auto h2 = detail::H2(full_hash);
         std::size_t index =
             detail::IndexWithoutProbing(detail::H1(full_hash), capacity());
 
         while (true) {
             Group g = Group::Load(ctrl_ptr() + index);
-            for (BitMask mask = g.Match(h2); mask; ++mask) {
+            for (BitMask mask = match_group(g, h2, index, key); mask;
+                 ++mask) {
                 std::size_t probe_index =
                     (index + mask.first_index()) & (capacity() - 1);
                 if (equal()(key, policy_type::key(slots_ptr()[probe_index]))) {
@@ -620,28 +852,27 @@ template <class Policy, class... TArgs> class raw_hash_set {
             if (g.MatchEmpty()) {
                 return end();
             }
-            index += kGroupWidth;
-            if (index >= capacity()) {
-                index = 0;
-            }
+            index = next_probe(index);
         }
     }
 
-    /// @brief Locates an element matching the provided key (const context).
+    /// @brief Internal Hook: Locates an element whose key has already been
+    /// hashed to `full_hash` (const context).
     template <typename K>
     HMM_NODISCARD HMM_CONSTEXPR_20 const_iterator
-    find(const K& key) const noexcept {
+    find_hashed(const K& key, std::size_t full_hash) const noexcept {
         if (empty()) {
             return end();
         }
-        const auto full_hash = hasher()(key);
+
         const auto h2 = detail::H2(full_hash);
         std::size_t index =
             detail::IndexWithoutProbing(detail::H1(full_hash), capacity());
 
         while (true) {
             Group g = Group::Load(ctrl_ptr() + index);
-            for (BitMask mask = g.Match(h2); mask; ++mask) {
+            for (BitMask mask = match_group(g, h2, index, key); mask;
+                 ++mask) {
                 std::size_t probe_index =
                     (index + mask.first_index()) & (capacity() - 1);
                 if (equal()(key, policy_type::key(slots_ptr()[probe_index]))) {
@@ -653,10 +884,7 @@ template <class Policy, class... TArgs> class raw_hash_set {
             if (g.MatchEmpty()) {
                 return end();
             }
-            index += kGroupWidth;
-            if (index >= capacity()) {
-                index = 0;
-            }
+            index = next_probe(index);
         }
     }
 
@@ -682,7 +910,14 @@ template <class Policy, class... TArgs> class raw_hash_set {
     template <typename K>
     HMM_NODISCARD HMM_CONSTEXPR_20 FindInfo
     find_or_prepare_insert(const K& key) {
-        const auto full_hash = hasher()(key);
+        return find_or_prepare_insert_hashed(key, hasher()(key));
+    }
+
+    /// @brief Internal Hook: Computes the target slot for a key that has
+    /// already been hashed to `full_hash`.
+    template <typename K>
+    HMM_NODISCARD HMM_CONSTEXPR_20 FindInfo
+    find_or_prepare_insert_hashed(const K& key, std::size_t full_hash) {
         if (capacity() == 0) {
             return {0, full_hash, false};
         }
@@ -693,7 +928,8 @@ template <class Policy, class... TArgs> class raw_hash_set {
 
         while (true) {
             Group g = Group::Load(ctrl_ptr() + index);
-            for (BitMask mask = g.Match(h2); mask; ++mask) {
+            for (BitMask mask = match_group(g, h2, index, key); mask;
+                 ++mask) {
                 std::size_t probe_index =
                     (index + mask.first_index()) & (capacity() - 1);
                 if (equal()(key, policy_type::key(slots_ptr()[probe_index]))) {
@@ -705,10 +941,7 @@ template <class Policy, class... TArgs> class raw_hash_set {
                     (index + mask.first_index()) & (capacity() - 1);
                 return {probe_index, full_hash, false};
             }
-            index += kGroupWidth;
-            if (index >= capacity()) {
-                index = 0;
-            }
+            index = next_probe(index);
         }
     }
 
@@ -716,16 +949,24 @@ template <class Policy, class... TArgs> class raw_hash_set {
     /// provided arguments.
     template <typename... Args>
     HMM_CONSTEXPR_20 std::pair<iterator, bool> emplace(Args&&... args) {
-        if (needs_resize()) {
-            rehash_and_grow();
-        }
-
         slot_type temp =
-            detail::construct<slot_type>(std::forward<Args>(args)...);
+            policy_type::new_slot(get_allocator(), std::forward<Args>(args)...);
         const auto& key = policy_type::key(temp);
 
-        auto info = find_or_prepare_insert(key);
+        FindInfo info{};
+        try {
+            // Look up first: a duplicate must not grow the table.
+            info = find_or_prepare_insert(key);
+            if (!info.found && needs_resize()) {
+                rehash_and_grow();
+                info = find_or_prepare_insert_hashed(key, info.full_hash);
+            }
+        } catch (...) {
+            policy_type::drop_slot(get_allocator(), temp);
+            throw;
+        }
         if (info.found) {
+            policy_type::drop_slot(get_allocator(), temp);
             return {iterator(ctrl_ptr() + info.index, slots_ptr() + info.index,
                              ctrl_ptr() + capacity()),
                     false};
@@ -763,9 +1004,8 @@ template <class Policy, class... TArgs> class raw_hash_set {
             rehash_and_grow();
 
             // The table just changed size/location. The 'info' index is now
-            // invalid. We must re-calculate the hash (if needed) and find the
-            // new slot.
-            info = find_or_prepare_insert(key);
+            // invalid, but the hash is not; find the new slot with it.
+            info = find_or_prepare_insert_hashed(key, info.full_hash);
         }
 
         policy_type::construct(
@@ -784,16 +1024,7 @@ template <class Policy, class... TArgs> class raw_hash_set {
     /// @return An iterator to the element immediately following the removed
     /// element.
     HMM_CONSTEXPR_20 iterator erase(const_iterator cit) {
-        std::size_t index = cit.get_slots() - slots_ptr();
-
-        policy_type::destroy(get_allocator(), &slots_ptr()[index]);
-
-        ctrl_ptr()[index] = detail::slots::kDeleted;
-        if (index < kGroupWidth) {
-            ctrl_ptr()[capacity() + index] = detail::slots::kDeleted;
-        }
-
-        --members_.size_info_.size_;
+        erase_at(cit.get_slots() - slots_ptr());
         auto it =
             iterator(cit.get_ctrl(), const_cast<slot_type*>(cit.get_slots()),
                      cit.get_end_ctrl());
@@ -825,6 +1056,182 @@ template <class Policy, class... TArgs> class raw_hash_set {
         return 1;
     }
 
+    /// @brief Internal Hook: Destroys the element at `index` and tombstones
+    /// its slot.
+    HMM_CONSTEXPR_20 void erase_at(std::size_t index) {
+        tombstone_at(index);
+        account_erased(1);
+    }
+
+    /// @brief Internal Hook: Destroys the element at `index` and tombstones
+    /// its slot, leaving the size counters to `account_erased`.
+    HMM_CONSTEXPR_20 void tombstone_at(std::size_t index) {
+        policy_type::destroy(get_allocator(), &slots_ptr()[index]);
+        set_ctrl(index, detail::slots::kDeleted);
+    }
+
+    /// @brief Internal Hook: Records `count` elements erased by
+    /// `tombstone_at`.
+    void account_erased(size_type count) noexcept {
+        members_.size_info_.size_ -= count;
+        members_.size_info_.deleted_ += count;
+    }
+
+    /// @brief Internal Hook: The number of ranges `parallel_scan` splits the
+    /// slots into, each a whole number of groups.
+    template <class Executor>
+    HMM_NODISCARD std::size_t
+    scan_chunks(const Executor& executor) const noexcept {
+        const std::size_t groups = capacity() / kGroupWidth;
+        const std::size_t chunks = executor.concurrency() * 4;
+        return chunks < groups ? chunks : groups;
+    }
+
+    /// @brief Internal Hook: Calls `f(chunk, index)` for every full slot,
+    /// scanning the `scan_chunks` ranges concurrently.
+    /// @details Each range is visited by one task, in slot order, so `f` may
+    /// tombstone the slots it is handed.
+    template <class Executor, class F>
+    void parallel_scan(Executor& executor, const F& f) const {
+        const std::size_t groups = capacity() / kGroupWidth;
+        const std::size_t chunks = scan_chunks(executor);
+        executor.parallel_for(chunks, [&](std::size_t chunk) {
+            const std::size_t last =
+                groups * (chunk + 1) / chunks * kGroupWidth;
+            for (std::size_t index = groups * chunk / chunks * kGroupWidth;
+                 index < last; index += kGroupWidth) {
+                Group g = Group::Load(ctrl_ptr() + index);
+                for (BitMask mask = g.MatchFull(); mask; ++mask) {
+                    f(chunk, index + mask.first_index());
+                }
+            }
+        });
+    }
+
+    /// @brief Internal Hook: Builds an iterator to the slot at `index`.
+    HMM_NODISCARD HMM_CONSTEXPR_20 iterator iterator_at(std::size_t index) {
+        return iterator(ctrl_ptr() + index, slots_ptr() + index,
+                        ctrl_ptr() + capacity());
+    }
+
+    /// @brief Internal Hook: Builds a const iterator to the slot at `index`.
+    HMM_NODISCARD HMM_CONSTEXPR_20 const_iterator
+    iterator_at(std::size_t index) const {
+        return const_iterator(ctrl_ptr() + index, slots_ptr() + index,
+                              ctrl_ptr() + capacity());
+    }
+
+    /// @brief Internal Hook: Copies `other` into this unallocated table slot
+    /// for slot, tombstones included, without hashing any element.
+    /// @details Only valid when both tables hash alike, as after copying the
+    /// hasher. If a copy throws, the table is left unallocated.
+    HMM_CONSTEXPR_20 void clone_layout_from(const raw_hash_set& other) {
+        const size_type cap = other.capacity();
+        if (cap == 0) {
+            return;
+        }
+
+        allocate_storage(cap);
+        std::memset(ctrl_ptr(), detail::slots::kEmpty, cap + kGroupWidth);
+        try {
+            for (std::size_t i = 0; i < cap; ++i) {
+                if (other.ctrl_ptr()[i] >= 0) {
+                    policy_type::construct(
+                        get_allocator(), &slots_ptr()[i],
+                        policy_type::value_from_slot(
+                            static_cast<const slot_type&>(
+                                other.slots_ptr()[i])));
+                    ctrl_ptr()[i] = other.ctrl_ptr()[i];
+                }
+            }
+        } catch (...) {
+            clear_and_deallocate();
+            throw;
+        }
+
+        std::memcpy(ctrl_ptr(), other.ctrl_ptr(), cap + kGroupWidth);
+        members_.size_info_.size_ = other.size();
+        members_.size_info_.deleted_ = other.deleted();
+    }
+
+    /// @brief Internal Hook: Builds the ranges returned by `partitions`.
+    template <class Iter>
+    HMM_NODISCARD std::vector<SlotRange<Iter>>
+    make_partitions(size_type n) const {
+        const std::size_t groups = capacity() / kGroupWidth;
+        std::vector<SlotRange<Iter>> out;
+        out.reserve(n);
+        for (size_type i = 0; i < n; ++i) {
+            const std::size_t first = groups * i / n * kGroupWidth;
+            const std::size_t last = groups * (i + 1) / n * kGroupWidth;
+            ctrl_t* const end_ctrl = ctrl_ptr() + last;
+            Iter it(ctrl_ptr() + first, slots_ptr() + first, end_ctrl);
+            it.skip_empty_or_deleted();
+            out.emplace_back(it, Iter(end_ctrl, slots_ptr() + last, end_ctrl));
+        }
+        return out;
+    }
+
+    /// @brief Internal Hook: Advances a probe to the next group-sized window.
+    /// @details Windows start at the hashed index and advance by a full group,
+    /// wrapping around the table. As the capacity is a multiple of the group
+    /// width, the windows of a probe never overlap.
+    HMM_NODISCARD constexpr std::size_t
+    next_probe(std::size_t index) const noexcept {
+        return (index + kGroupWidth) & (capacity() - 1);
+    }
+
+    /// @brief Internal Hook: Returns the slots of the group `g` at `index`
+    /// that may hold `key`.
+    /// @details These are the slots whose control byte is `h2`. A weak hash
+    /// can give many of them; then, for small integral keys (see
+    /// `DirectKeyMatch`), the keys of the whole group are compared at once
+    /// and only the slots that hold `key` are returned. A single candidate
+    /// is cheaper to compare on its own.
+    template <typename K>
+    HMM_NODISCARD BitMask match_group(const Group& g, ctrl_t h2,
+                                      std::size_t index,
+                                      const K& key) const noexcept {
+        using Direct = std::integral_constant<
+            bool, DirectKeyMatch<policy_type, key_equal, K>::value>;
+        return match_group(g, h2, index, key, Direct());
+    }
+
+    template <typename K>
+    HMM_NODISCARD BitMask match_group(const Group& g, ctrl_t h2,
+                                      std::size_t /* index */, const K&,
+                                      std::false_type) const noexcept {
+        return g.Match(h2);
+    }
+
+    template <typename K>
+    HMM_NODISCARD BitMask match_group(const Group& g, ctrl_t h2,
+                                      std::size_t index, const K& key,
+                                      std::true_type) const noexcept {
+        const BitMask candidates = g.Match(h2);
+        BitMask rest = candidates;
+        if (!++rest || index + kGroupWidth > capacity()) {
+            return candidates;
+        }
+        return BitMask(MatchKeys(slots_ptr() + index, key)) & g.MatchFull();
+    }
+
+    /// @brief Internal Hook: Locates the first empty slot along the probe
+    /// sequence of `full_hash`, without looking for an existing key.
+    /// @details The table must have capacity, and at least one empty slot.
+    HMM_NODISCARD std::size_t
+    find_first_empty(std::size_t full_hash) const noexcept {
+        std::size_t index =
+            detail::IndexWithoutProbing(detail::H1(full_hash), capacity());
+        while (true) {
+            Group g = Group::Load(ctrl_ptr() + index);
+            if (auto mask = g.MatchEmpty()) {
+                return (index + mask.first_index()) & (capacity() - 1);
+            }
+            index = next_probe(index);
+        }
+    }
+
     /// @brief Internal Hook: Retrieves a mutable reference to the internal size
     /// counter.
     HMM_NODISCARD constexpr size_type& size_ref() noexcept {
@@ -843,13 +1250,85 @@ template <class Policy, class... TArgs> class raw_hash_set {
 
     /// @brief Forces the container to dynamically allocate a larger block and
     /// re-insert all items.
+    /// @details When tombstones rather than live elements are what filled the
+    /// table, the capacity is kept and the tombstones are purged in place,
+    /// without allocating (see `drop_deletes_in_place`).
     HMM_CONSTEXPR_20 void rehash_and_grow() {
-        size_type new_cap = (capacity() == 0) ? 16 : capacity() * 2;
-        rehash_and_grow(new_cap);
+        if (deleted() != 0 && size() * 16 <= capacity() * 7) {
+            drop_deletes_in_place();
+            return;
+        }
+        rehash_and_grow((capacity() == 0) ? 16 : capacity() * 2);
+    }
+
+    /// @brief Internal Hook: Turns every tombstone back into an empty slot,
+    /// re-placing the elements within the current allocation.
+    /// @details Live control bytes are first marked deleted, meaning "still to
+    /// be placed", and tombstones marked empty. Each pending element then
+    /// probes for the first slot that holds no placed element. If that slot
+    /// is its own it stays put; if it is empty the element moves there;
+    /// otherwise the two pending elements swap and the displaced one is
+    /// processed next. Placed elements never move again, so, as after an
+    /// insert, no element has an empty slot before it on its probe. That
+    /// keeps every lookup intact, including the partition-bounded probes of
+    /// `find_or_prepare_insert_in_partition`; staying anywhere in the first
+    /// free window would not. Elements move without any key comparison,
+    /// which also preserves equal keys in multi-tables.
+    void drop_deletes_in_place() {
+        const std::size_t mask = capacity() - 1;
+        for (std::size_t i = 0; i < capacity(); ++i) {
+            set_ctrl(i, ctrl_ptr()[i] >= 0 ? detail::slots::kDeleted
+                                           : detail::slots::kEmpty);
+        }
+
+        alignas(slot_type) unsigned char buffer[sizeof(slot_type)];
+        slot_type* temp = reinterpret_cast<slot_type*>(buffer);
+        for (std::size_t i = 0; i < capacity(); ++i) {
+            if (ctrl_ptr()[i] != detail::slots::kDeleted) {
+                continue;
+            }
+            const auto full_hash = hasher()(policy_type::key(slots_ptr()[i]));
+            const std::size_t home =
+                detail::IndexWithoutProbing(detail::H1(full_hash), capacity());
+            std::size_t index = home;
+            BitMask free = Group::Load(ctrl_ptr() + index).MatchNonFull();
+            while (!free) {
+                index = next_probe(index);
+                free = Group::Load(ctrl_ptr() + index).MatchNonFull();
+            }
+            const std::size_t target = (index + free.first_index()) & mask;
+
+            if (target == i) {
+                set_ctrl(i, detail::H2(full_hash));
+                continue;
+            }
+            if (ctrl_ptr()[target] == detail::slots::kEmpty) {
+                policy_type::transfer(get_allocator(), &slots_ptr()[target],
+                                      &slots_ptr()[i]);
+                set_ctrl(target, detail::H2(full_hash));
+                set_ctrl(i, detail::slots::kEmpty);
+                continue;
+            }
+            policy_type::transfer(get_allocator(), temp, &slots_ptr()[target]);
+            policy_type::transfer(get_allocator(), &slots_ptr()[target],
+                                  &slots_ptr()[i]);
+            policy_type::transfer(get_allocator(), &slots_ptr()[i], temp);
+            set_ctrl(target, detail::H2(full_hash));
+            --i;
+        }
+        members_.size_info_.deleted_ = 0;
     }
 
     /// @brief Rehashes the table and grows it to an explicit new capacity.
     /// @param new_cap The exact new capacity. Must be a power of two.
+    /// @details Elements are placed in two passes, so that the layout does
+    /// not depend on how the work is divided (see `rehash_parallel`). The new
+    /// table is cut into partitions of `rehash_partition` slots. The first
+    /// pass moves elements in slot order to the first empty slot of their
+    /// probe, without letting the probe leave the partition of their home
+    /// slot. The second pass places the rest, again in slot order, with
+    /// unrestricted probing. Both passes move elements without comparing
+    /// keys, which also preserves equal keys in multi-tables.
     HMM_CONSTEXPR_20 void rehash_and_grow(const size_type new_cap) {
         auto old_ctrl = ctrl_ptr();
         auto old_slots = slots_ptr();
@@ -858,23 +1337,318 @@ template <class Policy, class... TArgs> class raw_hash_set {
         allocate_storage(new_cap);
         std::memset(ctrl_ptr(), detail::slots::kEmpty, new_cap + kGroupWidth);
         members_.size_info_.size_ = 0;
+        members_.size_info_.deleted_ = 0;
 
         if (old_slots) {
             for (std::size_t i = 0; i < old_cap; ++i) {
                 if (old_ctrl[i] >= 0) {
-                    auto& val = old_slots[i];
-                    auto info = find_or_prepare_insert(policy_type::key(val));
-                    policy_type::construct(get_allocator(),
-                                           &slots_ptr()[info.index],
-                                           std::move(val));
-                    finish_insert(info.index, info.full_hash);
-                    policy_type::destroy(get_allocator(), &old_slots[i]);
+                    const auto full_hash =
+                        hasher()(policy_type::key(old_slots[i]));
+                    const auto index = find_empty_in_partition(full_hash);
+                    if (index != capacity()) {
+                        policy_type::transfer(get_allocator(),
+                                              &slots_ptr()[index],
+                                              &old_slots[i]);
+                        finish_insert(index, full_hash);
+                        old_ctrl[i] = detail::slots::kEmpty;
+                    }
                 }
             }
+            place_overflow(old_ctrl, old_slots, old_cap);
             deallocate_storage(old_ctrl, old_cap);
         }
     }
 
+    /// @brief Rehashes the table into `new_cap` slots across an executor.
+    /// @details Produces exactly the layout of `rehash_and_grow(new_cap)`:
+    /// 1. Workers hash disjoint ranges of the old table and bucket the
+    ///    elements by destination partition, keeping slot order.
+    /// 2. Each partition is filled by a single worker, with the same
+    ///    partition-bounded probing as the serial first pass.
+    /// 3. Elements whose probe left their partition are placed serially.
+    template <class Executor>
+    void rehash_parallel(const size_type new_cap, Executor& executor) {
+        auto old_ctrl = ctrl_ptr();
+        auto old_slots = slots_ptr();
+        auto old_cap = capacity();
+
+        // Phase 1: bucket the elements by destination partition. This runs
+        // before the new storage is swapped in, so that a throwing hasher or
+        // allocation leaves the table untouched.
+        PartitionedHashes buckets;
+        if (old_slots) {
+            buckets = bucket_by_partition(
+                old_cap, new_cap, executor,
+                [&](std::size_t i) { return old_ctrl[i] >= 0; },
+                [&](std::size_t i) {
+                    return hasher()(policy_type::key(old_slots[i]));
+                });
+        }
+
+        allocate_storage(new_cap);
+        std::memset(ctrl_ptr(), detail::slots::kEmpty, new_cap + kGroupWidth);
+        members_.size_info_.size_ = 0;
+        members_.size_info_.deleted_ = 0;
+        if (!old_slots) {
+            return;
+        }
+        const std::size_t partitions = buckets.begin.size() - 1;
+
+        // Phase 2: every partition is owned by one worker, which only reads
+        // and writes control bytes and slots inside of it.
+        std::vector<std::size_t> placed(partitions, 0);
+        executor.parallel_for(partitions, [&](std::size_t p) {
+            for (std::size_t k = buckets.begin[p]; k < buckets.begin[p + 1];
+                 ++k) {
+                const std::size_t i = buckets.order[k];
+                const auto full_hash = buckets.hashes[i];
+                const auto index = find_empty_in_partition(full_hash);
+                if (index != capacity()) {
+                    policy_type::transfer(get_allocator(), &slots_ptr()[index],
+                                          &old_slots[i]);
+                    set_ctrl(index, detail::H2(full_hash));
+                    old_ctrl[i] = detail::slots::kEmpty;
+                    ++placed[p];
+                }
+            }
+        });
+        for (std::size_t count : placed) {
+            members_.size_info_.size_ += count;
+        }
+
+        // Phase 3: whatever could not stay inside its partition.
+        place_overflow(old_ctrl, old_slots, old_cap);
+        deallocate_storage(old_ctrl, old_cap);
+    }
+
+    /// @brief The elements of a parallel operation, grouped by the rehash
+    /// partition of their home slot.
+    struct PartitionedHashes {
+        /// The hash of every source item, indexed by item.
+        std::vector<std::size_t> hashes;
+        /// The present items, partition by partition, each partition in
+        /// item order.
+        std::vector<std::size_t> order;
+        /// Partition `p` owns `order[begin[p]]` up to `order[begin[p + 1]]`.
+        std::vector<std::size_t> begin;
+    };
+
+    /// @brief Internal Hook: Hashes the items `[0, n)` across an executor and
+    /// buckets them by destination partition with a stable counting sort.
+    /// @param cap The capacity of the destination table, which need not be
+    /// allocated yet.
+    /// @param present Whether an item takes part, e.g. an old slot is full.
+    /// @param hash Computes the full hash of an item.
+    template <class Executor, class Present, class Hash>
+    PartitionedHashes bucket_by_partition(std::size_t n, std::size_t cap,
+                                          Executor& executor,
+                                          const Present& present,
+                                          const Hash& hash) const {
+        const std::size_t partition = rehash_partition(cap);
+        const std::size_t partitions = cap / partition;
+        const auto home = [cap](std::size_t full_hash) {
+            return detail::IndexWithoutProbing(detail::H1(full_hash), cap);
+        };
+        std::size_t chunks = executor.concurrency() * 4;
+        if (chunks > n / 1024 + 1) {
+            chunks = n / 1024 + 1;
+        }
+
+        PartitionedHashes out;
+        out.hashes.resize(n);
+        std::vector<std::size_t> offsets(chunks * partitions, 0);
+        executor.parallel_for(chunks, [&](std::size_t chunk) {
+            for (std::size_t i = n * chunk / chunks;
+                 i < n * (chunk + 1) / chunks; ++i) {
+                if (present(i)) {
+                    out.hashes[i] = hash(i);
+                    ++offsets[chunk * partitions +
+                              home(out.hashes[i]) / partition];
+                }
+            }
+        });
+
+        // Turn the counts into offsets, ordering partitions first and then
+        // chunks, so that each partition lists its items in order.
+        out.begin.resize(partitions + 1);
+        std::size_t total = 0;
+        for (std::size_t p = 0; p < partitions; ++p) {
+            out.begin[p] = total;
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                const std::size_t count = offsets[chunk * partitions + p];
+                offsets[chunk * partitions + p] = total;
+                total += count;
+            }
+        }
+        out.begin[partitions] = total;
+
+        out.order.resize(total);
+        executor.parallel_for(chunks, [&](std::size_t chunk) {
+            for (std::size_t i = n * chunk / chunks;
+                 i < n * (chunk + 1) / chunks; ++i) {
+                if (present(i)) {
+                    const std::size_t p = home(out.hashes[i]) / partition;
+                    out.order[offsets[chunk * partitions + p]++] = i;
+                }
+            }
+        });
+        return out;
+    }
+
+    /// @brief The number of slots owned by one worker of a parallel rehash,
+    /// at most 16K. Serial rehashes use the same partitions to produce the
+    /// same layout.
+    HMM_NODISCARD static constexpr std::size_t
+    rehash_partition(std::size_t cap) noexcept {
+        return cap < (std::size_t(1) << 14) ? cap : (std::size_t(1) << 14);
+    }
+
+    /// @brief The smallest capacity holding `count` elements below the 7/8
+    /// load limit.
+    HMM_NODISCARD static HMM_CONSTEXPR_14 size_type
+    capacity_for(size_type count) noexcept {
+        // capacity * 0.875 >= count
+        size_type min_cap = (count * 8 + 6) / 7;
+        size_type cap = 16;
+        while (cap < min_cap) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    /// @brief Internal Hook: The key of an element passed to a bulk insert:
+    /// the element itself for sets, its first member for maps.
+    template <class V>
+    HMM_NODISCARD static constexpr const V& input_key(const V& value,
+                                                      std::true_type) noexcept {
+        return value;
+    }
+
+    template <class V>
+    HMM_NODISCARD static constexpr auto input_key(const V& value,
+                                                  std::false_type) noexcept
+        -> decltype((value.first)) {
+        return value.first;
+    }
+
+    template <class V>
+    HMM_NODISCARD static constexpr auto input_key(const V& value) noexcept
+        -> decltype(input_key(
+            value,
+            std::is_void<typename policy_type::mapped_type>())) {
+        return input_key(value,
+                         std::is_void<typename policy_type::mapped_type>());
+    }
+
+    /// @brief Internal Hook: Prefetches the control bytes and slots of the
+    /// first probe window of `full_hash`, ahead of a `find_hashed`.
+    void prefetch_hashed(std::size_t full_hash) const noexcept {
+        if (capacity() == 0) {
+            return;
+        }
+        const std::size_t index = home_index(full_hash);
+        HMM_PREFETCH(ctrl_ptr() + index);
+        HMM_PREFETCH(slots_ptr() + index);
+    }
+
+    /// @brief Internal Hook: The slot a hash probes first.
+    HMM_NODISCARD constexpr std::size_t
+    home_index(std::size_t full_hash) const noexcept {
+        return detail::IndexWithoutProbing(detail::H1(full_hash), capacity());
+    }
+
+    /// @brief Locates the first empty slot along the probe of `full_hash`
+    /// that lies in the rehash partition of its home slot.
+    /// @details Never touches a control byte outside the partition, which
+    /// lets workers fill disjoint partitions concurrently.
+    /// @return The slot index, or `capacity()` if the probe leaves the
+    /// partition first.
+    HMM_NODISCARD std::size_t
+    find_empty_in_partition(std::size_t full_hash) const noexcept {
+        const std::size_t partition = rehash_partition(capacity());
+        std::size_t index = home_index(full_hash);
+        const std::size_t end = (index / partition + 1) * partition;
+
+        for (; index < end; index += kGroupWidth) {
+            if (index + kGroupWidth <= end) {
+                Group g = Group::Load(ctrl_ptr() + index);
+                if (auto mask = g.MatchEmpty()) {
+                    return index + mask.first_index();
+                }
+            } else {
+                for (std::size_t i = index; i < end; ++i) {
+                    if (ctrl_ptr()[i] == detail::slots::kEmpty) {
+                        return i;
+                    }
+                }
+            }
+        }
+        return capacity();
+    }
+
+    /// @brief Internal Hook: Like `find_or_prepare_insert_hashed`, but never
+    /// probes outside the rehash partition of the home slot.
+    /// @details Sound because no element has an empty slot before it on its
+    /// probe: erasing leaves tombstones, and both inserts and
+    /// `drop_deletes_in_place` place elements at the first free slot. A key
+    /// stored past its partition therefore implies the partition part of
+    /// its probe holds no empty slot, so this probe defers rather than
+    /// inserting a duplicate.
+    /// @return The result of the probe, with `index == capacity()` if it
+    /// left the partition without finding the key or an empty slot.
+    template <typename K>
+    HMM_NODISCARD FindInfo find_or_prepare_insert_in_partition(
+        const K& key, std::size_t full_hash) const {
+        const std::size_t partition = rehash_partition(capacity());
+        const auto h2 = detail::H2(full_hash);
+        std::size_t index = home_index(full_hash);
+        const std::size_t end = (index / partition + 1) * partition;
+
+        for (; index < end; index += kGroupWidth) {
+            if (index + kGroupWidth <= end) {
+                Group g = Group::Load(ctrl_ptr() + index);
+                for (BitMask mask = g.Match(h2); mask; ++mask) {
+                    const std::size_t i = index + mask.first_index();
+                    if (equal()(key, policy_type::key(slots_ptr()[i]))) {
+                        return {i, full_hash, true};
+                    }
+                }
+                if (auto mask = g.MatchEmpty()) {
+                    return {index + mask.first_index(), full_hash, false};
+                }
+            } else {
+                for (std::size_t i = index; i < end; ++i) {
+                    if (ctrl_ptr()[i] == h2 &&
+                        equal()(key, policy_type::key(slots_ptr()[i]))) {
+                        return {i, full_hash, true};
+                    }
+                }
+                for (std::size_t i = index; i < end; ++i) {
+                    if (ctrl_ptr()[i] == detail::slots::kEmpty) {
+                        return {i, full_hash, false};
+                    }
+                }
+            }
+        }
+        return {capacity(), full_hash, false};
+    }
+
+    /// @brief Final rehash pass: moves the elements still marked full in the
+    /// old table, in slot order, with unrestricted probing.
+    HMM_CONSTEXPR_20 void place_overflow(ctrl_t* old_ctrl,
+                                         slot_type* old_slots,
+                                         size_type old_cap) {
+        for (std::size_t i = 0; i < old_cap; ++i) {
+            if (old_ctrl[i] >= 0) {
+                const auto full_hash = hasher()(policy_type::key(old_slots[i]));
+                const auto index = find_first_empty(full_hash);
+                policy_type::transfer(get_allocator(), &slots_ptr()[index],
+                                      &old_slots[i]);
+                finish_insert(index, full_hash);
+            }
+        }
+    }
+
     /// @brief Internal Hook: Given a guaranteed index and hash, constructs the
     /// element into the slot array.
     void insert_at_index(std::size_t index, std::size_t full_hash,
@@ -886,12 +1660,16 @@ template <class Policy, class... TArgs> class raw_hash_set {
 
     /// @brief Commits an insertion by updating the control byte metadata array.
     void finish_insert(std::size_t index, std::size_t full_hash) {
-        auto h2 = detail::H2(full_hash);
-        ctrl_ptr()[index] = h2;
+        set_ctrl(index, detail::H2(full_hash));
+        ++members_.size_info_.size_;
+    }
+
+    /// @brief Internal Hook: Writes a control byte along with its mirror.
+    void set_ctrl(std::size_t index, ctrl_t c) noexcept {
+        ctrl_ptr()[index] = c;
         if (index < kGroupWidth) {
-            ctrl_ptr()[capacity() + index] = h2;
+            ctrl_ptr()[capacity() + index] = c;
         }
-        ++members_.size_info_.size_;
     }
 
     /// @brief Acquires memory via the allocator for a specified capacity.
@@ -906,6 +1684,10 @@ template <class Policy, class... TArgs> class raw_hash_set {
 
         unsigned char* ptr = std::allocator_traits<byte_allocator>::allocate(
             get_allocator(), total_bytes);
+        // Group key compares read free slots too (see `match_group`).
+        if (DirectKeyMatch<policy_type, key_equal, key_type>::value) {
+            std::memset(ptr + slot_offset, 0, cap * sizeof(slot_type));
+        }
 
         members_.set_ctrl(reinterpret_cast<ctrl_t*>(ptr));
         members_.set_slots(reinterpret_cast<slot_type*>(ptr + slot_offset));
@@ -949,12 +1731,20 @@ template <class Policy, class... TArgs> class raw_hash_set {
         members_.set_slots(nullptr);
         members_.size_info_.capacity_ = 0;
         members_.size_info_.size_ = 0;
+        members_.size_info_.deleted_ = 0;
+    }
+
+    /// @brief Internal Hook: Retrieves the number of tombstoned slots.
+    HMM_NODISCARD constexpr size_type deleted() const noexcept {
+        return members_.size_info_.deleted_;
     }
 
     /// @brief Computes if the container's load factor exceeds the threshold
     /// triggering a resize (7/8).
+    /// @details Tombstones count towards the load, as they consume empty slots
+    /// just like live elements and would otherwise let probing run forever.
     HMM_NODISCARD constexpr bool needs_resize() const noexcept {
-        return capacity() == 0 || size() * 8 > capacity() * 7;
+        return capacity() == 0 || (size() + deleted()) * 8 > capacity() * 7;
     }
 
     /// @brief Internal Hook: Retrieves the hashing functor.
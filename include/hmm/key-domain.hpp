@@ -0,0 +1,123 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_KEY_DOMAIN_HPP
+#define HMM_HMM_KEY_DOMAIN_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace hmm {
+
+/// @brief Maps every value of a key type onto a distinct index in
+/// `[0, size)`, for the direct-indexed `small_domain_map` and
+/// `small_domain_set`.
+///
+/// A specialization provides:
+/// - `static constexpr std::size_t size`, the number of indices;
+/// - `static constexpr std::size_t index(Key)`, which may return `size` or
+///   more for a value outside the domain;
+/// - `static constexpr Key key(std::size_t)`, the inverse of `index`.
+///
+/// Integers of at most 16 bits, `bool`, and enums over such integers are
+/// covered here. Other enums declare their domain, usually through
+/// `enum_domain`:
+/// @code
+/// enum class Color { kRed, kGreen, kBlue, kCount };
+/// namespace hmm {
+/// template <> struct key_domain<Color> : enum_domain<Color, Color::kCount> {};
+/// } // namespace hmm
+/// @endcode
+///
+/// The primary template is empty, which marks a type without a domain.
+template <class Key, class = void> struct key_domain {};
+
+/// @brief The domain of `bool`: `false` and `true`.
+template <> struct key_domain<bool> {
+    static constexpr std::size_t size = 2;
+
+    static constexpr std::size_t index(bool key) noexcept {
+        return key ? 1 : 0;
+    }
+
+    static constexpr bool key(std::size_t index) noexcept {
+        return index != 0;
+    }
+};
+
+/// @brief The domain of an 8 or 16-bit integer: every value, in the order of
+/// its unsigned representation.
+template <class Key>
+struct key_domain<
+    Key, typename std::enable_if<std::is_integral<Key>::value &&
+                                 !std::is_same<Key, bool>::value &&
+                                 sizeof(Key) <= 2>::type> {
+    static constexpr std::size_t size = std::size_t(1) << (8 * sizeof(Key));
+
+    static constexpr std::size_t index(Key key) noexcept {
+        return static_cast<typename std::make_unsigned<Key>::type>(key);
+    }
+
+    static constexpr Key key(std::size_t index) noexcept {
+        return static_cast<Key>(index);
+    }
+};
+
+/// @brief The domain of an enum over an 8 or 16-bit integer: every value of
+/// the underlying type.
+template <class Key>
+struct key_domain<
+    Key, typename std::enable_if<std::is_enum<Key>::value &&
+                                 sizeof(Key) <= 2>::type> {
+    using underlying_type = typename std::underlying_type<Key>::type;
+    using underlying_domain = key_domain<underlying_type>;
+
+    static constexpr std::size_t size = underlying_domain::size;
+
+    static constexpr std::size_t index(Key key) noexcept {
+        return underlying_domain::index(static_cast<underlying_type>(key));
+    }
+
+    static constexpr Key key(std::size_t index) noexcept {
+        return static_cast<Key>(underlying_domain::key(index));
+    }
+};
+
+/// @brief The domain of an enum whose enumerators run from 0 up to, but not
+/// including, `Count`.
+template <class Enum, Enum Count> struct enum_domain {
+    static constexpr std::size_t size = static_cast<std::size_t>(Count);
+
+    static constexpr std::size_t index(Enum key) noexcept {
+        return static_cast<std::size_t>(key);
+    }
+
+    static constexpr Enum key(std::size_t index) noexcept {
+        return static_cast<Enum>(index);
+    }
+};
+
+/// @brief Detects whether `Key` has a `key_domain`.
+template <class Key, class = void> struct has_key_domain : std::false_type {};
+
+template <class Key>
+struct has_key_domain<
+    Key, typename std::enable_if<(key_domain<Key>::size > 0)>::type>
+    : std::true_type {};
+
+} // namespace hmm
+
+#endif // HMM_HMM_KEY_DOMAIN_HPP
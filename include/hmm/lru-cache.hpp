@@ -0,0 +1,245 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_LRU_CACHE_HPP
+#define HMM_HMM_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/cache-storage.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A fixed-capacity cache evicting the least recently used entry.
+///
+/// Entries are stored in a single array allocated at construction, indexed by
+/// a SwissTable of 32-bit positions. Recency is an intrusive doubly linked
+/// list threaded through the entries as pairs of positions, so unlike the
+/// usual `std::list` plus `std::unordered_map` design there is no node per
+/// entry: `get`, `put` and `erase` never allocate after construction.
+///
+/// @tparam Key The type of keys stored in the cache.
+/// @tparam Value The type of cached values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs> class lru_cache {
+    using Policy = MapPolicy<Key, Value>;
+
+  public:
+    using hasher_type = typename internal::detail::TypeAtIndexOrDefault<
+        0, typename Policy::default_hasher_type, TArgs...>::type;
+    using key_equal = typename internal::detail::TypeAtIndexOrDefault<
+        1, typename Policy::default_eq_type, TArgs...>::type;
+    using allocator_type = typename internal::detail::TypeAtIndexOrDefault<
+        2, typename Policy::default_allocator_type, TArgs...>::type;
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+
+  private:
+    /// @brief Neighbours in recency order, towards the most and the least
+    /// recently used entry.
+    struct Links {
+        std::uint32_t newer;
+        std::uint32_t older;
+    };
+
+    using Storage = internal::CacheStorage<Key, Value, Links, hasher_type,
+                                           key_equal, allocator_type>;
+
+  public:
+    /// @brief Constructs an empty cache holding up to `capacity` entries.
+    /// @throws std::length_error If `capacity` exceeds 2^32 - 2 entries.
+    explicit lru_cache(size_type capacity,
+                       const hasher_type& hash = hasher_type(),
+                       const key_equal& eq = key_equal(),
+                       const allocator_type& alloc = allocator_type())
+        : storage_(capacity, hash, eq, alloc) {}
+
+    lru_cache(const lru_cache&) = default;
+
+    /// @brief Moves the cache; the source is left empty with no capacity.
+    lru_cache(lru_cache&& other) noexcept
+        : storage_(std::move(other.storage_)), newest_(other.newest_),
+          oldest_(other.oldest_) {
+        other.newest_ = Storage::kNone;
+        other.oldest_ = Storage::kNone;
+    }
+
+    lru_cache& operator=(const lru_cache&) = default;
+
+    lru_cache& operator=(lru_cache&& other) noexcept {
+        if (this != &other) {
+            storage_ = std::move(other.storage_);
+            newest_ = other.newest_;
+            oldest_ = other.oldest_;
+            other.newest_ = Storage::kNone;
+            other.oldest_ = Storage::kNone;
+        }
+        return *this;
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return storage_.size();
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// @brief The maximum number of entries held at once.
+    HMM_NODISCARD size_type capacity() const noexcept {
+        return storage_.capacity();
+    }
+
+    /// @brief Looks up `key`, marking it as the most recently used entry.
+    /// @return A pointer to the cached value, or `nullptr` on a miss. It
+    /// stays valid until the entry is evicted or erased.
+    template <class K> HMM_NODISCARD mapped_type* get(const K& key) {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return nullptr;
+        }
+        touch(position);
+        return &storage_.entry(position).value.second;
+    }
+
+    /// @brief Looks up `key` without updating its recency.
+    template <class K>
+    HMM_NODISCARD const mapped_type* peek(const K& key) const {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return nullptr;
+        }
+        return &storage_.entry(position).value.second;
+    }
+
+    /// @brief Checks if `key` is cached, without updating its recency.
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return storage_.find(key) != Storage::kNone;
+    }
+
+    /// @brief Caches `value` under `key`, or assigns it if `key` is present,
+    /// and marks the entry as the most recently used. When the cache is full,
+    /// the least recently used entry is evicted first.
+    /// @return `true` if a new entry was inserted.
+    template <class K, class V> bool put(K&& key, V&& value) {
+        if (capacity() == 0) {
+            return false;
+        }
+        auto info = storage_.prepare(key);
+        if (info.found) {
+            const auto position = storage_.position(info);
+            storage_.entry(position).value.second = std::forward<V>(value);
+            touch(position);
+            return false;
+        }
+        if (size() == capacity()) {
+            evict(oldest_);
+        }
+        const auto position = storage_.emplace_prepared(
+            info, std::forward<K>(key), std::forward<V>(value));
+        link_front(position);
+        return true;
+    }
+
+    /// @brief Removes `key` from the cache.
+    /// @return `true` if an entry was removed.
+    template <class K> bool erase(const K& key) {
+        const auto position = storage_.find(key);
+        if (position == Storage::kNone) {
+            return false;
+        }
+        evict(position);
+        return true;
+    }
+
+    /// @brief Removes every entry, keeping all buffers.
+    void clear() {
+        storage_.clear();
+        newest_ = Storage::kNone;
+        oldest_ = Storage::kNone;
+    }
+
+    /// @brief Invokes `f(const value_type&)` on every entry, from the most to
+    /// the least recently used.
+    template <class F> void for_each(F&& f) const {
+        for (auto p = newest_; p != Storage::kNone;
+             p = storage_.entry(p).meta.older) {
+            f(static_cast<const value_type&>(storage_.entry(p).value));
+        }
+    }
+
+  private:
+    /// @brief Unlinks the entry at `position` and releases it.
+    void evict(std::uint32_t position) {
+        unlink(position);
+        storage_.erase(position);
+    }
+
+    /// @brief Moves an entry to the front of the recency list.
+    void touch(std::uint32_t position) {
+        if (position != newest_) {
+            unlink(position);
+            link_front(position);
+        }
+    }
+
+    void link_front(std::uint32_t position) {
+        auto& links = storage_.entry(position).meta;
+        links.newer = Storage::kNone;
+        links.older = newest_;
+        if (newest_ != Storage::kNone) {
+            storage_.entry(newest_).meta.newer = position;
+        } else {
+            oldest_ = position;
+        }
+        newest_ = position;
+    }
+
+    void unlink(std::uint32_t position) {
+        const auto links = storage_.entry(position).meta;
+        if (links.newer != Storage::kNone) {
+            storage_.entry(links.newer).meta.older = links.older;
+        } else {
+            newest_ = links.older;
+        }
+        if (links.older != Storage::kNone) {
+            storage_.entry(links.older).meta.newer = links.newer;
+        } else {
+            oldest_ = links.newer;
+        }
+    }
+
+    Storage storage_;
+    std::uint32_t newest_ = Storage::kNone;
+    std::uint32_t oldest_ = Storage::kNone;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_LRU_CACHE_HPP
@@ -0,0 +1,563 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_PARALLEL_FLAT_HASH_MAP_HPP
+#define HMM_HMM_PARALLEL_FLAT_HASH_MAP_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/epoch.hpp"
+#include "hmm/internal/macros.hpp"
+#include "hmm/internal/mutex.hpp"
+#include "hmm/internal/raw-hash-set.hpp"
+#include "hmm/node-hash-map.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief Detects `std::atomic` mapped values, which are updated without
+/// taking the shard lock.
+template <class T> struct IsAtomic : std::false_type {};
+template <class T> struct IsAtomic<std::atomic<T>> : std::true_type {};
+
+} // namespace internal
+
+/// @brief A flat hash map split into independently locked shards.
+///
+/// `parallel_flat_hash_map` partitions the key space into `2^N` submaps,
+/// each a SwissTable with its own mutex. A key's shard is chosen from the
+/// hash bits directly below the 7 bits used for H2, which the submaps never
+/// use for indexing while they hold fewer than `2^(57 - N)` slots. Keys are
+/// hashed once; the hash both selects the shard and probes within it.
+///
+/// Operations lock exactly one shard, once. Because references into a shard
+/// are only safe while its lock is held, the interface exposes callbacks
+/// (`if_contains`, `modify_if`, `lazy_emplace_l`, ...) that run under the lock
+/// instead of returning iterators. Readers take a shared lock when `Mutex`
+/// provides `lock_shared` (e.g. `std::shared_mutex`).
+///
+/// `add`, `compute` and `update_or_insert` update a value in place, inserting
+/// it if needed, with a single probe. When `Value` is a `std::atomic`, updates
+/// to existing keys take no lock at all and rely on the atomic for exclusion:
+/// they pin the shard's epoch, which writes only a per-thread slot, and probe
+/// the shard while no writer is restructuring it. Writers that insert a new
+/// key or erase one first wait for such updates to leave that shard, so hot
+/// keys never contend on anything but their value, at some cost to inserts
+/// and erases in the same shard. Atomics cannot be relocated by a rehash, so such values are held
+/// in nodes.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam Hash The hashing functor.
+/// @tparam Eq The equality functor.
+/// @tparam Alloc The allocator used by every submap.
+/// @tparam N The base-2 logarithm of the number of shards.
+/// @tparam Mutex The lock guarding each shard. `hmm::null_mutex` disables
+///               locking altogether.
+template <class Key, class Value,
+          class Hash = typename MapPolicy<Key, Value>::default_hasher_type,
+          class Eq = typename MapPolicy<Key, Value>::default_eq_type,
+          class Alloc = typename MapPolicy<Key, Value>::default_allocator_type,
+          std::size_t N = 4, class Mutex = std::mutex>
+class parallel_flat_hash_map {
+    static_assert(N <= 12, "parallel_flat_hash_map supports up to 2^12 shards");
+
+    static constexpr bool kAtomicValues = internal::IsAtomic<Value>::value;
+
+    using Table = internal::raw_hash_set<
+        typename std::conditional<kAtomicValues, NodeMapPolicy<Key, Value>,
+                                  MapPolicy<Key, Value>>::type,
+        Hash, Eq, Alloc>;
+    using ReadLock = internal::ReadLock<Mutex>;
+    using WriteLock = internal::WriteLock<Mutex>;
+
+  public:
+    using policy_type = typename Table::policy_type;
+    using hasher_type = typename Table::hasher_type;
+    using key_equal = typename Table::key_equal;
+    using key_type = typename Table::key_type;
+    using mapped_type = Value;
+    using value_type = typename Table::value_type;
+    using size_type = typename Table::size_type;
+    using difference_type = typename Table::difference_type;
+    using slot_type = typename Table::slot_type;
+    using allocator_type = typename Table::allocator_type;
+    using mutex_type = Mutex;
+
+    /// @brief Handed to `lazy_emplace_l` constructors; constructs the new
+    /// element in place from the arguments it is called with.
+    class constructor {
+        friend parallel_flat_hash_map;
+
+      public:
+        template <class... Args> void operator()(Args&&... args) const {
+            policy_type::construct(alloc_, slot_, std::forward<Args>(args)...);
+        }
+
+      private:
+        constructor(typename Table::byte_allocator& alloc, slot_type* slot)
+            : alloc_(alloc), slot_(slot) {}
+
+        typename Table::byte_allocator& alloc_;
+        slot_type* slot_;
+    };
+
+    /// @brief Default constructs an empty map.
+    parallel_flat_hash_map() = default;
+
+    /// @brief Constructs an empty map with explicit functors and allocator,
+    /// shared by every shard.
+    explicit parallel_flat_hash_map(
+        const hasher_type& hash, const key_equal& eq = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : hash_(hash) {
+        for (auto& shard : shards_) {
+            shard.table = Table(hash, eq, alloc);
+        }
+    }
+
+    /// @brief Constructs the map with the contents of an initializer list.
+    parallel_flat_hash_map(std::initializer_list<value_type> init) {
+        insert(init.begin(), init.end());
+    }
+
+    // Each shard owns a mutex, which can be neither copied nor moved.
+    parallel_flat_hash_map(const parallel_flat_hash_map&) = delete;
+    parallel_flat_hash_map& operator=(const parallel_flat_hash_map&) = delete;
+
+    /// @brief The number of shards.
+    HMM_NODISCARD static constexpr size_type subcnt() noexcept {
+        return kShardCount;
+    }
+
+    /// @brief Counts the elements of every shard.
+    /// @details Shards are locked one after another, so under concurrent
+    /// modification the result is not a snapshot of a single instant.
+    HMM_NODISCARD size_type size() const {
+        size_type total = 0;
+        for (const auto& shard : shards_) {
+            ReadLock lock(shard.mutex);
+            total += shard.table.size();
+        }
+        return total;
+    }
+
+    HMM_NODISCARD bool empty() const {
+        return size() == 0;
+    }
+
+    /// @brief Destroys all elements, keeping the capacity of every shard.
+    void clear() {
+        for (auto& shard : shards_) {
+            WriteLock lock(shard.mutex);
+            ClosedShard closed(shard);
+            shard.table.clear();
+        }
+    }
+
+    /// @brief Reserves room for `count` elements, spread evenly across the
+    /// shards.
+    void reserve(size_type count) {
+        const size_type per_shard = (count + kShardCount - 1) / kShardCount;
+        for (auto& shard : shards_) {
+            WriteLock lock(shard.mutex);
+            ClosedShard closed(shard);
+            shard.table.reserve(per_shard);
+        }
+    }
+
+    /// @brief Inserts a copy of `value` if its key is not present.
+    /// @return `true` if the element was inserted.
+    bool insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    /// @brief Inserts `value` via move semantics if its key is not present.
+    /// @return `true` if the element was inserted.
+    bool insert(value_type&& value) {
+        return try_emplace(value.first, std::move(value.second));
+    }
+
+    /// @brief Inserts a range of elements, skipping keys already present.
+    template <class InputIt> void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    /// @brief Constructs an element in place if its key is not present.
+    /// @return `true` if the element was inserted.
+    template <class... Args> bool emplace(Args&&... args) {
+        auto& alloc = shards_[0].table.get_allocator();
+        slot_type temp =
+            policy_type::new_slot(alloc, std::forward<Args>(args)...);
+        bool inserted = false;
+        try {
+            inserted = lazy_emplace_l(
+                policy_type::key(temp), [](value_type&) {},
+                [&temp](const constructor& ctor) { ctor(std::move(temp)); });
+        } catch (...) {
+            policy_type::drop_slot(alloc, temp);
+            throw;
+        }
+        // Only an inserted slot is adopted by the table.
+        if (!inserted) {
+            policy_type::drop_slot(alloc, temp);
+        }
+        return inserted;
+    }
+
+    /// @brief Constructs the mapped value in place if `key` is not present.
+    /// @return `true` if the element was inserted.
+    template <class K, class... Args>
+    bool try_emplace(K&& key, Args&&... args) {
+        return try_emplace_l(
+            std::forward<K>(key), [](value_type&) {},
+            std::forward<Args>(args)...);
+    }
+
+    /// @brief Inserts `value` under `key`, or assigns it if `key` is present.
+    /// @return `true` if the element was inserted.
+    template <class K, class V> bool insert_or_assign(K&& key, V&& value) {
+        return try_emplace_l(
+            std::forward<K>(key),
+            [&value](value_type& elem) {
+                elem.second = std::forward<V>(value);
+            },
+            std::forward<V>(value));
+    }
+
+    /// @brief Invokes `fexist` on the element with `key` if present, otherwise
+    /// constructs the mapped value from `args`. Both happen under the lock.
+    /// @return `true` if the element was inserted.
+    template <class K, class FExist, class... Args>
+    bool try_emplace_l(K&& key, FExist&& fexist, Args&&... args) {
+        const key_type& k = key;
+        return emplace_hashed(
+            k, hash_(k), std::forward<FExist>(fexist),
+            [&](const constructor& ctor) {
+                ctor(std::piecewise_construct,
+                     std::forward_as_tuple(std::forward<K>(key)),
+                     std::forward_as_tuple(std::forward<Args>(args)...));
+            },
+            [](value_type&) {});
+    }
+
+    /// @brief The most general insertion primitive. Under a single lock of
+    /// the key's shard, invokes `fexist(value_type&)` if `key` is present, and
+    /// otherwise `fctor(const constructor&)`, which must call the constructor
+    /// exactly once to build the new element.
+    /// @return `true` if the element was inserted.
+    template <class K, class FExist, class FCtor>
+    bool lazy_emplace_l(const K& key, FExist&& fexist, FCtor&& fctor) {
+        return emplace_hashed(key, hash_(key), std::forward<FExist>(fexist),
+                              std::forward<FCtor>(fctor), [](value_type&) {});
+    }
+
+    /// @brief Adds `delta` to the value of `key`, inserting `delta` itself if
+    /// `key` is not present.
+    /// @return `true` if the element was inserted.
+    template <class K, class T> bool add(K&& key, const T& delta) {
+        return update_or_insert(std::forward<K>(key), delta,
+                                [&delta](mapped_type& value) {
+                                    value += delta;
+                                });
+    }
+
+    /// @brief Invokes `f(mapped_type&)` on the value of `key`, value
+    /// initializing it first if `key` is not present.
+    /// @details With `std::atomic` values, `f` may run concurrently with
+    /// other updates of the same value and must only use atomic operations.
+    /// @return `true` if the element was inserted.
+    template <class K, class F> bool compute(K&& key, F&& f) {
+        const key_type& k = key;
+        const auto full_hash = hash_(k);
+        if (update_existing(k, full_hash, f,
+                            std::integral_constant<bool, kAtomicValues>())) {
+            return false;
+        }
+        auto apply = [&f](value_type& elem) { f(elem.second); };
+        return emplace_hashed(
+            k, full_hash, apply,
+            [&](const constructor& ctor) {
+                ctor(std::piecewise_construct,
+                     std::forward_as_tuple(std::forward<K>(key)),
+                     std::forward_as_tuple());
+            },
+            apply);
+    }
+
+    /// @brief Invokes `f(mapped_type&)` on the value of `key` if present, and
+    /// otherwise inserts a value constructed from `init`.
+    /// @details With `std::atomic` values, `f` may run concurrently with
+    /// other updates of the same value and must only use atomic operations.
+    /// @return `true` if the element was inserted.
+    template <class K, class T, class F>
+    bool update_or_insert(K&& key, T&& init, F&& f) {
+        const key_type& k = key;
+        const auto full_hash = hash_(k);
+        if (update_existing(k, full_hash, f,
+                            std::integral_constant<bool, kAtomicValues>())) {
+            return false;
+        }
+        return emplace_hashed(
+            k, full_hash, [&f](value_type& elem) { f(elem.second); },
+            [&](const constructor& ctor) {
+                ctor(std::piecewise_construct,
+                     std::forward_as_tuple(std::forward<K>(key)),
+                     std::forward_as_tuple(std::forward<T>(init)));
+            },
+            [](value_type&) {});
+    }
+
+    /// @brief Invokes `f(const value_type&)` on the element with `key`, under
+    /// a reader lock.
+    /// @return `true` if the key was present.
+    template <class K, class F> bool if_contains(const K& key, F&& f) const {
+        const auto full_hash = hash_(key);
+        const auto& shard = shard_for(full_hash);
+        ReadLock lock(shard.mutex);
+
+        auto it = shard.table.find_hashed(key, full_hash);
+        if (it == shard.table.end()) {
+            return false;
+        }
+        f(*it);
+        return true;
+    }
+
+    /// @brief Invokes `f(value_type&)` on the element with `key`, under an
+    /// exclusive lock.
+    /// @return `true` if the key was present.
+    template <class K, class F> bool modify_if(const K& key, F&& f) {
+        const auto full_hash = hash_(key);
+        auto& shard = shard_for(full_hash);
+        WriteLock lock(shard.mutex);
+
+        auto it = shard.table.find_hashed(key, full_hash);
+        if (it == shard.table.end()) {
+            return false;
+        }
+        f(*it);
+        return true;
+    }
+
+    /// @brief Erases the element with `key`.
+    /// @return The number of elements removed.
+    template <class K> size_type erase(const K& key) {
+        return erase_if(key, [](value_type&) { return true; });
+    }
+
+    /// @brief Erases the element with `key` if `pred(value_type&)` holds,
+    /// evaluating the predicate under the lock.
+    /// @return `true` if an element was removed.
+    template <class K, class Pred> bool erase_if(const K& key, Pred&& pred) {
+        const auto full_hash = hash_(key);
+        auto& shard = shard_for(full_hash);
+        WriteLock lock(shard.mutex);
+
+        auto it = shard.table.find_hashed(key, full_hash);
+        if (it == shard.table.end() || !pred(*it)) {
+            return false;
+        }
+        ClosedShard closed(shard);
+        shard.table.erase(it);
+        return true;
+    }
+
+    /// @brief Checks if an element with `key` exists.
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return if_contains(key, [](const value_type&) {});
+    }
+
+    /// @brief Counts the elements with `key` (0 or 1).
+    template <class K> HMM_NODISCARD size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    /// @brief Invokes `f(const value_type&)` on every element, holding one
+    /// shard's reader lock at a time.
+    template <class F> void for_each(F&& f) const {
+        for (const auto& shard : shards_) {
+            ReadLock lock(shard.mutex);
+            for (const auto& elem : shard.table) {
+                f(elem);
+            }
+        }
+    }
+
+    /// @brief Invokes `f(value_type&)` on every element, holding one shard's
+    /// exclusive lock at a time.
+    template <class F> void for_each_m(F&& f) {
+        for (auto& shard : shards_) {
+            WriteLock lock(shard.mutex);
+            for (auto& elem : shard.table) {
+                f(elem);
+            }
+        }
+    }
+
+    HMM_NODISCARD const hasher_type& hash_function() const noexcept {
+        return hash_;
+    }
+
+  private:
+    static constexpr size_type kShardCount = size_type(1) << N;
+
+    /// @brief Tracks the lock-free updates of atomic values in flight.
+    struct NoUpdaters {};
+    using Updaters = typename std::conditional<kAtomicValues,
+                                               internal::EpochDomain,
+                                               NoUpdaters>::type;
+
+    /// @brief A submap and its lock, padded to a cache line so that shards
+    /// locked by different threads never share one.
+    struct alignas(64) Shard {
+        mutable Mutex mutex;
+        /// @brief Set while a writer changes the table's layout, keeping
+        /// lock-free updates of atomic values out.
+        std::atomic<bool> restructuring{false};
+        /// @brief The lock-free updates in this shard. Kept per shard, so
+        /// that closing a shard never waits on updates to the others.
+        Updaters updaters;
+        Table table;
+    };
+
+    /// @brief Marks a shard as restructuring and waits for the lock-free
+    /// updates already in it to finish. Held under the exclusive lock.
+    class ClosedShard {
+      public:
+        explicit ClosedShard(Shard& shard) : shard_(shard) {
+            close(shard.updaters, shard);
+        }
+        ClosedShard(const ClosedShard&) = delete;
+        ClosedShard& operator=(const ClosedShard&) = delete;
+
+        ~ClosedShard() {
+            shard_.restructuring.store(false);
+        }
+
+      private:
+        static void close(internal::EpochDomain& updaters, Shard& shard) {
+            // An update pinned after the epoch advances sees the flag.
+            shard.restructuring.store(true);
+            const std::uint64_t epoch = updaters.advance();
+            while (!updaters.is_safe(epoch)) {
+                std::this_thread::yield();
+            }
+        }
+        static void close(NoUpdaters&, Shard&) noexcept {}
+
+        Shard& shard_;
+    };
+
+    /// @brief Selects a shard from the hash bits directly below H2.
+    HMM_NODISCARD static constexpr size_type
+    shard_index(std::size_t full_hash) noexcept {
+        return (full_hash >> (sizeof(std::size_t) * 8 - 7 - N)) &
+               (kShardCount - 1);
+    }
+
+    HMM_NODISCARD Shard& shard_for(std::size_t full_hash) noexcept {
+        return shards_[shard_index(full_hash)];
+    }
+
+    HMM_NODISCARD const Shard& shard_for(std::size_t full_hash) const noexcept {
+        return shards_[shard_index(full_hash)];
+    }
+
+    /// @brief Probes for `key` once under the exclusive lock of its shard.
+    /// Invokes `fexist` on an existing element, or builds a new one with
+    /// `fctor` and then invokes `finserted` on it.
+    template <class K, class FExist, class FCtor, class FInserted>
+    bool emplace_hashed(const K& key, std::size_t full_hash, FExist&& fexist,
+                        FCtor&& fctor, FInserted&& finserted) {
+        auto& shard = shard_for(full_hash);
+        WriteLock lock(shard.mutex);
+
+        auto& table = shard.table;
+        auto info = table.find_or_prepare_insert_hashed(key, full_hash);
+        if (info.found) {
+            fexist(policy_type::value_from_slot(table.slots_ptr()[info.index]));
+            return false;
+        }
+        ClosedShard closed(shard);
+        if (table.needs_resize()) {
+            table.rehash_and_grow();
+            info = table.find_or_prepare_insert_hashed(key, full_hash);
+        }
+        fctor(constructor(table.get_allocator(),
+                          &table.slots_ptr()[info.index]));
+        table.finish_insert(info.index, full_hash);
+        finserted(policy_type::value_from_slot(table.slots_ptr()[info.index]));
+        return true;
+    }
+
+    /// @brief Updates an existing atomic value without locking, or under the
+    /// reader lock while a writer restructures the shard.
+    /// @return `false` if `key` is absent and must be inserted.
+    template <class F>
+    bool update_existing(const key_type& key, std::size_t full_hash, F& f,
+                         std::true_type /* atomic */) {
+        auto& shard = shard_for(full_hash);
+        {
+            const auto pinned = shard.updaters.pin();
+            if (!shard.restructuring.load()) {
+                auto it = shard.table.find_hashed(key, full_hash);
+                if (it == shard.table.end()) {
+                    return false;
+                }
+                f(it->second);
+                return true;
+            }
+        }
+
+        ReadLock lock(shard.mutex);
+
+        auto it = shard.table.find_hashed(key, full_hash);
+        if (it == shard.table.end()) {
+            return false;
+        }
+        f(it->second);
+        return true;
+    }
+
+    /// @brief Plain values are only updated under the exclusive lock, by the
+    /// same probe that would insert them.
+    template <class F>
+    bool update_existing(const key_type& /* key */,
+                         std::size_t /* full_hash */, F& /* f */,
+                         std::false_type /* atomic */) {
+        return false;
+    }
+
+    hasher_type hash_;
+    std::array<Shard, kShardCount> shards_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_PARALLEL_FLAT_HASH_MAP_HPP
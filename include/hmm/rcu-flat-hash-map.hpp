@@ -0,0 +1,267 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_RCU_FLAT_HASH_MAP_HPP
+#define HMM_HMM_RCU_FLAT_HASH_MAP_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/epoch.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A flat hash map published as immutable versions (read-copy-update).
+///
+/// `rcu_flat_hash_map` targets tables read by many threads and rebuilt or
+/// updated in batches. The current version is an ordinary `flat_hash_map`
+/// reached through an atomic pointer and never modified once published:
+///
+/// - Readers take a `Snapshot`, which pins an epoch and loads the pointer.
+///   Lookups through the snapshot are plain `flat_hash_map` lookups and pay
+///   no synchronization at all.
+/// - Writers serialize on a mutex, build the next version, either from
+///   scratch with `publish` or by copying the current one in `update`, and
+///   swap it in. Copies clone the table layout rather than rehashing.
+/// - Replaced versions are destroyed by the last reader that could still
+///   hold them, when it unpins while no one else is collecting. Otherwise
+///   they wait for the next `publish` or `collect`. Snapshots are not
+///   limited in number and may be held for long, though a held snapshot
+///   keeps every version published since alive.
+///
+/// Every write copies the table, so writes should be batched through
+/// `update`. For frequent single-key writes prefer
+/// `read_mostly_flat_hash_map`.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs> class rcu_flat_hash_map {
+  public:
+    using table_type = flat_hash_map<Key, Value, TArgs...>;
+    using key_type = typename table_type::key_type;
+    using mapped_type = typename table_type::mapped_type;
+    using value_type = typename table_type::value_type;
+    using size_type = typename table_type::size_type;
+    using allocator_type = typename table_type::allocator_type;
+
+    /// @brief A pinned version of the map. The version stays alive, and
+    /// unchanged, for as long as the snapshot does.
+    class Snapshot {
+        friend rcu_flat_hash_map;
+
+      public:
+        Snapshot(Snapshot&& other) noexcept
+            : map_(other.map_), guard_(std::move(other.guard_)),
+              table_(other.table_) {
+            other.map_ = nullptr;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        ~Snapshot() {
+            if (map_ != nullptr) {
+                map_->retired_.unpin(guard_, map_->domain_,
+                                     TableFree{map_});
+            }
+        }
+
+        HMM_NODISCARD const table_type& operator*() const noexcept {
+            return *table_;
+        }
+
+        HMM_NODISCARD const table_type* operator->() const noexcept {
+            return table_;
+        }
+
+      private:
+        Snapshot(const rcu_flat_hash_map* map,
+                 internal::EpochDomain::Guard guard, const table_type* table)
+            : map_(map), guard_(std::move(guard)), table_(table) {}
+
+        const rcu_flat_hash_map* map_;
+        internal::EpochDomain::Guard guard_;
+        const table_type* table_;
+    };
+
+    /// @brief Constructs an empty map.
+    rcu_flat_hash_map() : rcu_flat_hash_map(allocator_type()) {}
+
+    /// @brief Constructs an empty map whose versions use `alloc`.
+    explicit rcu_flat_hash_map(const allocator_type& alloc) : alloc_(alloc) {
+        current_.store(new_table(table_type(alloc_)));
+    }
+
+    // Readers hold raw pointers to the published versions.
+    rcu_flat_hash_map(const rcu_flat_hash_map&) = delete;
+    rcu_flat_hash_map& operator=(const rcu_flat_hash_map&) = delete;
+
+    ~rcu_flat_hash_map() {
+        delete_table(current_.load(std::memory_order_relaxed));
+        retired_.free_all(TableFree{this});
+    }
+
+    /// @name Readers
+    ///@{
+
+    /// @brief Pins and returns the current version.
+    HMM_NODISCARD Snapshot snapshot() const {
+        auto guard = domain_.pin();
+        return Snapshot(this, std::move(guard), current_.load());
+    }
+
+    /// @brief Copies the value mapped to `key` into `out`.
+    /// @return `true` if the key was present.
+    template <class K> bool find(const K& key, mapped_type& out) const {
+        const auto snap = snapshot();
+        const auto it = snap->find(key);
+        if (it == snap->end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        return snapshot()->contains(key);
+    }
+
+    HMM_NODISCARD size_type size() const {
+        return snapshot()->size();
+    }
+
+    HMM_NODISCARD bool empty() const {
+        return size() == 0;
+    }
+    ///@}
+
+    /// @name Writers
+    ///@{
+
+    /// @brief Applies a batch of changes and publishes the result.
+    /// @details `f` receives a copy of the current version to modify. If it
+    /// throws, nothing is published.
+    template <class F> void update(F&& f) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        table_type* next = new_table(*current_.load(std::memory_order_relaxed));
+        try {
+            f(*next);
+        } catch (...) {
+            delete_table(next);
+            throw;
+        }
+        publish_locked(next);
+    }
+
+    /// @brief Replaces the whole map with `table`, e.g. after a rebuild.
+    void publish(table_type table) {
+        table_type* next = new_table(std::move(table));
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        publish_locked(next);
+    }
+
+    /// @brief Publishes a version with `key` mapped to `value`.
+    void insert_or_assign(const key_type& key, const mapped_type& value) {
+        update([&](table_type& table) {
+            auto result = table.try_emplace(key, value);
+            if (!result.second) {
+                result.first->second = value;
+            }
+        });
+    }
+
+    /// @brief Publishes a version without `key`.
+    /// @return `true` if the key was present.
+    bool erase(const key_type& key) {
+        bool erased = false;
+        update([&](table_type& table) {
+            erased = table.erase_element(key) != 0;
+        });
+        return erased;
+    }
+
+    /// @brief Publishes an empty version.
+    void clear() {
+        publish(table_type(alloc_));
+    }
+
+    /// @brief Destroys the replaced versions that no snapshot still holds,
+    /// without publishing.
+    void collect() {
+        retired_.collect(domain_, TableFree{this});
+    }
+    ///@}
+
+  private:
+    struct TableFree {
+        const rcu_flat_hash_map* map;
+
+        void operator()(table_type* table) const noexcept {
+            map->delete_table(table);
+        }
+    };
+
+    using TableAlloc = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<table_type>;
+
+    template <class... Args> table_type* new_table(Args&&... args) {
+        TableAlloc table_alloc(alloc_);
+        table_type* table = std::addressof(
+            *std::allocator_traits<TableAlloc>::allocate(table_alloc, 1));
+        try {
+            std::allocator_traits<TableAlloc>::construct(
+                table_alloc, table, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator_traits<TableAlloc>::deallocate(table_alloc, table,
+                                                          1);
+            throw;
+        }
+        return table;
+    }
+
+    void delete_table(table_type* table) const noexcept {
+        TableAlloc table_alloc(alloc_);
+        std::allocator_traits<TableAlloc>::destroy(table_alloc, table);
+        std::allocator_traits<TableAlloc>::deallocate(table_alloc, table, 1);
+    }
+
+    /// @brief Swaps in `next` and retires the previous version. Owns
+    /// `next`, which is deleted if it cannot be published.
+    void publish_locked(table_type* next) {
+        retired_.publish(domain_, current_, next, TableFree{this});
+    }
+
+    allocator_type alloc_;
+
+    alignas(64) std::atomic<table_type*> current_{nullptr};
+    mutable internal::EpochDomain domain_;
+
+    std::mutex write_mutex_;
+    mutable internal::RetiredList<table_type> retired_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_RCU_FLAT_HASH_MAP_HPP
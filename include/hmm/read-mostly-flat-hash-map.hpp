@@ -0,0 +1,488 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_READ_MOSTLY_FLAT_HASH_MAP_HPP
+#define HMM_HMM_READ_MOSTLY_FLAT_HASH_MAP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/atomic-ctrl.hpp"
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/epoch.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A concurrent flat hash map whose readers never lock.
+///
+/// `read_mostly_flat_hash_map` targets workloads dominated by lookups. It
+/// keeps the SwissTable control-byte encoding and 16-wide group matching, but
+/// stores control bytes and slots as atomic 64-bit words so that readers
+/// racing with a writer stay well defined.
+///
+/// - Writers serialize on a mutex. A new element is written into an empty
+///   slot first, and its control byte is then published with release
+///   semantics, so readers either miss it or see it whole. Slots are never
+///   reused in place: erasing only tombstones the control byte.
+/// - Overwriting an existing value is guarded by a sequence lock. Readers
+///   validate the sequence after copying a value out and retry on change.
+/// - Growing builds a new array and publishes it atomically. The old array is
+///   reclaimed through an epoch domain by the next write, or by `collect()`,
+///   after the last reader that could still be using it leaves. Readers
+///   never reclaim, so a lookup never waits on a writer or frees memory.
+///
+/// Readers copy values out rather than returning references, which requires
+/// keys and values to be trivially copyable. Probing visits aligned groups,
+/// so unlike the other tables no control bytes are mirrored.
+///
+/// @tparam Key The type of keys stored in the map. Must be trivially copyable.
+/// @tparam Value The type of mapped values. Must be trivially copyable.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::CityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+///               3. Allocator (Defaults to `std::allocator<std::pair<Key,
+///               Value>>`)
+template <class Key, class Value, class... TArgs>
+class read_mostly_flat_hash_map {
+    static_assert(std::is_trivially_copyable<Key>::value &&
+                      std::is_trivially_copyable<Value>::value,
+                  "read_mostly_flat_hash_map copies keys and values out of "
+                  "slots that may be concurrently written");
+
+    using Policy = MapPolicy<Key, Value>;
+    using Word = std::atomic<std::uint64_t>;
+    using Group = internal::Group;
+    using BitMask = internal::BitMask;
+    using ctrl_t = std::int8_t;
+
+  public:
+    using hasher_type = typename internal::detail::TypeAtIndexOrDefault<
+        0, typename Policy::default_hasher_type, TArgs...>::type;
+    using key_equal = typename internal::detail::TypeAtIndexOrDefault<
+        1, typename Policy::default_eq_type, TArgs...>::type;
+    using allocator_type = typename internal::detail::TypeAtIndexOrDefault<
+        2, typename Policy::default_allocator_type, TArgs...>::type;
+    using key_type = Key;
+    using mapped_type = Value;
+    using size_type = std::size_t;
+
+    /// @brief Default constructs an empty map with no allocated memory.
+    read_mostly_flat_hash_map() = default;
+
+    /// @brief Constructs an empty map with explicit functors and allocator.
+    explicit read_mostly_flat_hash_map(
+        const hasher_type& hash, const key_equal& eq = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : hash_(hash), eq_(eq), alloc_(alloc) {}
+
+    // Readers hold raw pointers into the storage, which must never move.
+    read_mostly_flat_hash_map(const read_mostly_flat_hash_map&) = delete;
+    read_mostly_flat_hash_map&
+    operator=(const read_mostly_flat_hash_map&) = delete;
+
+    ~read_mostly_flat_hash_map() {
+        free_storage(storage_.load(std::memory_order_relaxed));
+        retired_.free_all(StorageFree{this});
+    }
+
+    /// @name Lock-Free Readers
+    ///@{
+
+    /// @brief Copies the value mapped to `key` into `out`.
+    /// @return `true` if the key was present.
+    template <class K> bool find(const K& key, mapped_type& out) const {
+        const std::size_t full_hash = hash_(key);
+        const ReadGuard guard(*this);
+
+        while (true) {
+            const std::uint64_t seq = seq_.load(std::memory_order_acquire);
+            if (seq & 1) {
+                continue;
+            }
+
+            bool found = false;
+            Entry entry;
+            if (const Storage* st = storage_.load()) {
+                std::size_t index = 0;
+                found = probe(st, key, full_hash, index);
+                if (found) {
+                    entry = read_entry(st, index);
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == seq) {
+                if (found) {
+                    out = entry.second;
+                }
+                return found;
+            }
+        }
+    }
+
+    /// @brief Checks if an element with `key` exists.
+    template <class K> HMM_NODISCARD bool contains(const K& key) const {
+        const std::size_t full_hash = hash_(key);
+        const ReadGuard guard(*this);
+
+        // Membership is decided by control bytes alone, which are published
+        // atomically, so no sequence validation is needed.
+        const Storage* st = storage_.load();
+        std::size_t index = 0;
+        return st != nullptr && probe(st, key, full_hash, index);
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    ///@}
+
+    /// @name Serialized Writers
+    ///@{
+
+    /// @brief Inserts `value` under `key` if `key` is not present.
+    /// @return `true` if the element was inserted.
+    bool insert(const key_type& key, const mapped_type& value) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        return emplace_locked(key, value, false);
+    }
+
+    /// @brief Inserts `value` under `key`, or overwrites the existing value.
+    /// @return `true` if the element was inserted.
+    bool insert_or_assign(const key_type& key, const mapped_type& value) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        return emplace_locked(key, value, true);
+    }
+
+    /// @brief Erases the element with `key`.
+    /// @return The number of elements removed.
+    template <class K> size_type erase(const K& key) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        Storage* st = storage_.load(std::memory_order_relaxed);
+        std::size_t index = 0;
+        if (st == nullptr || !probe(st, key, hash_(key), index)) {
+            return 0;
+        }
+        // The slot itself is left intact, so readers that already matched
+        // it still copy out a consistent element.
+        internal::StoreCtrl(st->ctrl, index,
+                            internal::detail::slots::kDeleted);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        ++deleted_;
+        return 1;
+    }
+
+    /// @brief Grows the table to hold `count` elements without rehashing.
+    void reserve(size_type count) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        const size_type min_cap = (count * 8 + 6) / 7;
+        size_type cap = kGroupWidth;
+        while (cap < min_cap) {
+            cap <<= 1;
+        }
+        if (cap > capacity()) {
+            rehash(cap);
+        }
+    }
+
+    /// @brief Removes every element. The storage is swapped for an empty one
+    /// and the old one is reclaimed once readers leave it.
+    void clear() {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (capacity() != 0) {
+            publish(allocate_storage(capacity()));
+            size_.store(0, std::memory_order_relaxed);
+            deleted_ = 0;
+        }
+    }
+
+    /// @brief Frees the retired arrays that no reader is still using,
+    /// without waiting for the next write.
+    void collect() {
+        retired_.collect(domain_, StorageFree{this});
+    }
+
+    /// @brief Invokes `f(const key_type&, const mapped_type&)` on every
+    /// element, excluding writers for the duration.
+    template <class F> void for_each(F&& f) const {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        const Storage* st = storage_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; st != nullptr && i < st->capacity; ++i) {
+            if (internal::LoadCtrl(st->ctrl, i) >= 0) {
+                const Entry entry = read_entry(st, i);
+                f(entry.first, entry.second);
+            }
+        }
+    }
+
+    ///@}
+
+    HMM_NODISCARD size_type capacity() const noexcept {
+        const Storage* st = storage_.load(std::memory_order_relaxed);
+        return st ? st->capacity : 0;
+    }
+
+  private:
+    static constexpr std::size_t kGroupWidth = Group::kWidth;
+    static constexpr std::size_t kWordBytes = sizeof(std::uint64_t);
+
+    /// @brief A trivially copyable key-value pair, unlike `std::pair`.
+    struct Entry {
+        Key first;
+        Value second;
+    };
+
+    static constexpr std::size_t kSlotWords =
+        (sizeof(Entry) + kWordBytes - 1) / kWordBytes;
+
+    /// @brief Control words followed by slot words, in one allocation.
+    struct Storage {
+        std::size_t capacity;
+        Word* ctrl;
+        Word* slots;
+    };
+
+    struct StorageFree {
+        const read_mostly_flat_hash_map* map;
+
+        void operator()(Storage* st) const noexcept {
+            map->free_storage(st);
+        }
+    };
+
+    /// @brief Pins the domain for one read. Reclaiming what the read held
+    /// back is left to writers.
+    class ReadGuard {
+      public:
+        explicit ReadGuard(const read_mostly_flat_hash_map& map)
+            : guard_(map.domain_.pin()) {}
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+      private:
+        internal::EpochDomain::Guard guard_;
+    };
+
+    using StorageAlloc = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<Storage>;
+    using WordAlloc = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<Word>;
+
+    /// @brief Walks the aligned groups of `full_hash` looking for `key`.
+    /// @details The walk is bounded by the number of groups, as a reader may
+    /// observe a table that is concurrently filling up.
+    template <class K>
+    bool probe(const Storage* st, const K& key, std::size_t full_hash,
+               std::size_t& index) const {
+        const std::size_t groups = st->capacity / kGroupWidth;
+        const auto h2 = internal::detail::H2(full_hash);
+        std::size_t group =
+            internal::detail::IndexWithoutProbing(
+                internal::detail::H1(full_hash), st->capacity) /
+            kGroupWidth;
+
+        for (std::size_t n = 0; n < groups; ++n) {
+            Group g = internal::LoadCtrlGroup(st->ctrl, group);
+            for (BitMask mask = g.Match(h2); mask; ++mask) {
+                const std::size_t candidate =
+                    group * kGroupWidth + mask.first_index();
+                if (eq_(key, read_entry(st, candidate).first)) {
+                    index = candidate;
+                    return true;
+                }
+            }
+            if (g.MatchEmpty()) {
+                return false;
+            }
+            group = (group + 1) & (groups - 1);
+        }
+        return false;
+    }
+
+    /// @brief Finds the first empty slot along the probe of `full_hash`.
+    static std::size_t find_first_empty(const Storage* st,
+                                        std::size_t full_hash) {
+        const std::size_t groups = st->capacity / kGroupWidth;
+        std::size_t group =
+            internal::detail::IndexWithoutProbing(
+                internal::detail::H1(full_hash), st->capacity) /
+            kGroupWidth;
+        while (true) {
+            Group g = internal::LoadCtrlGroup(st->ctrl, group);
+            if (auto mask = g.MatchEmpty()) {
+                return group * kGroupWidth + mask.first_index();
+            }
+            group = (group + 1) & (groups - 1);
+        }
+    }
+
+    bool emplace_locked(const key_type& key, const mapped_type& value,
+                        bool assign) {
+        const std::size_t full_hash = hash_(key);
+        Storage* st = storage_.load(std::memory_order_relaxed);
+
+        std::size_t index = 0;
+        if (st != nullptr && probe(st, key, full_hash, index)) {
+            if (assign) {
+                write_value_locked(st, index, key, value);
+            }
+            return false;
+        }
+
+        if (st == nullptr ||
+            (size() + deleted_ + 1) * 8 > st->capacity * 7) {
+            // Like raw_hash_set, a table filled mostly by tombstones is only
+            // rehashed at the same capacity.
+            size_type new_cap = kGroupWidth;
+            if (st != nullptr) {
+                new_cap = (deleted_ != 0 && size() * 16 <= st->capacity * 7)
+                              ? st->capacity
+                              : st->capacity * 2;
+            }
+            st = rehash(new_cap);
+        }
+
+        index = find_first_empty(st, full_hash);
+        write_entry(st, index, Entry{key, value});
+        internal::StoreCtrl(st->ctrl, index, internal::detail::H2(full_hash));
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// @brief Overwrites a published slot inside a sequence-lock write
+    /// section.
+    void write_value_locked(Storage* st, std::size_t index,
+                            const key_type& key, const mapped_type& value) {
+        const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        write_entry(st, index, Entry{key, value});
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /// @brief Moves every element into fresh storage of `new_cap` slots and
+    /// publishes it.
+    Storage* rehash(size_type new_cap) {
+        Storage* old_st = storage_.load(std::memory_order_relaxed);
+        Storage* new_st = allocate_storage(new_cap);
+        for (std::size_t i = 0; old_st != nullptr && i < old_st->capacity;
+             ++i) {
+            const ctrl_t c = internal::LoadCtrl(old_st->ctrl, i);
+            if (c >= 0) {
+                const Entry entry = read_entry(old_st, i);
+                const std::size_t index =
+                    find_first_empty(new_st, hash_(entry.first));
+                write_entry(new_st, index, entry);
+                internal::StoreCtrl(new_st->ctrl, index, c);
+            }
+        }
+        publish(new_st);
+        deleted_ = 0;
+        return new_st;
+    }
+
+    /// @brief Swaps in `st` and retires the previous storage. Owns `st`,
+    /// which is freed if it cannot be published.
+    void publish(Storage* st) {
+        retired_.publish(domain_, storage_, st, StorageFree{this});
+    }
+
+    static Entry read_entry(const Storage* st, std::size_t index) {
+        std::uint64_t words[kSlotWords];
+        for (std::size_t w = 0; w < kSlotWords; ++w) {
+            words[w] = st->slots[index * kSlotWords + w].load(
+                std::memory_order_relaxed);
+        }
+        Entry entry;
+        std::memcpy(&entry, words, sizeof(Entry));
+        return entry;
+    }
+
+    static void write_entry(Storage* st, std::size_t index,
+                            const Entry& entry) {
+        std::uint64_t words[kSlotWords] = {};
+        std::memcpy(words, &entry, sizeof(Entry));
+        for (std::size_t w = 0; w < kSlotWords; ++w) {
+            st->slots[index * kSlotWords + w].store(words[w],
+                                                    std::memory_order_relaxed);
+        }
+    }
+
+    Storage* allocate_storage(std::size_t cap) {
+        StorageAlloc storage_alloc(alloc_);
+        WordAlloc word_alloc(alloc_);
+        using StorageTraits = std::allocator_traits<StorageAlloc>;
+        using WordTraits = std::allocator_traits<WordAlloc>;
+
+        const std::size_t ctrl_words = internal::CtrlWordCount(cap);
+        const std::size_t total_words = ctrl_words + cap * kSlotWords;
+        Word* words = WordTraits::allocate(word_alloc, total_words);
+        for (std::size_t i = 0; i < total_words; ++i) {
+            const std::uint64_t init =
+                i < ctrl_words ? internal::kEmptyCtrlWord : 0;
+            WordTraits::construct(word_alloc, words + i, init);
+        }
+
+        Storage* st = StorageTraits::allocate(storage_alloc, 1);
+        StorageTraits::construct(storage_alloc, st,
+                                 Storage{cap, words, words + ctrl_words});
+        return st;
+    }
+
+    void free_storage(Storage* st) const noexcept {
+        if (st == nullptr) {
+            return;
+        }
+        StorageAlloc storage_alloc(alloc_);
+        WordAlloc word_alloc(alloc_);
+        const std::size_t total_words =
+            internal::CtrlWordCount(st->capacity) + st->capacity * kSlotWords;
+        std::allocator_traits<WordAlloc>::deallocate(word_alloc, st->ctrl,
+                                                     total_words);
+        std::allocator_traits<StorageAlloc>::deallocate(storage_alloc, st, 1);
+    }
+
+    hasher_type hash_;
+    key_equal eq_;
+    allocator_type alloc_;
+
+    alignas(64) std::atomic<Storage*> storage_{nullptr};
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<size_type> size_{0};
+    mutable internal::EpochDomain domain_;
+
+    mutable std::mutex write_mutex_;
+    size_type deleted_ = 0;
+    mutable internal::RetiredList<Storage> retired_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_READ_MOSTLY_FLAT_HASH_MAP_HPP
@@ -0,0 +1,420 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_SMALL_DOMAIN_MAP_HPP
+#define HMM_HMM_SMALL_DOMAIN_MAP_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "hmm/flat-hash-map.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/domain-bitmap.hpp"
+#include "hmm/internal/macros.hpp"
+#include "hmm/key-domain.hpp"
+
+namespace hmm {
+
+/// @brief A map over a small key domain, stored as a presence bitmap and an
+/// array with one slot per possible key.
+///
+/// For keys such as `uint8_t`, `uint16_t` or an enum, a hash table hashes and
+/// probes to find what a direct index would give. `small_domain_map` turns
+/// the key into an index with `key_domain<Key>`, tests one bit and loads one
+/// slot. There is no hashing, no probing and no rehashing, and iterators stay
+/// valid until their element is erased.
+///
+/// The bitmap lives in the map (`size / 8` bytes, so 8 KiB for a 16-bit
+/// key). The slot array is allocated on the first insertion and holds
+/// `max_size()` slots whatever the number of elements, so the map suits
+/// dense use of small domains. Iteration is in index order, and skips 64
+/// absent keys per bitmap word.
+///
+/// @tparam Key A type with a `key_domain`.
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Optionally the allocator (Defaults to
+///               `std::allocator<std::pair<Key, Value>>`).
+template <class Key, class Value, class... TArgs> class small_domain_map {
+    static_assert(has_key_domain<Key>::value,
+                  "small_domain_map requires a key_domain for its key");
+
+    using Domain = key_domain<Key>;
+    using Policy = MapPolicy<Key, Value>;
+    using provided_allocator_type = typename internal::detail::
+        TypeAtIndexOrDefault<0, typename Policy::default_allocator_type,
+                             TArgs...>::type;
+    template <class T>
+    using rebind_alloc = typename std::allocator_traits<
+        provided_allocator_type>::template rebind_alloc<T>;
+
+    static constexpr std::size_t kDomainSize = Domain::size;
+
+  public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = typename Policy::value_type;
+    using slot_type = typename Policy::slot_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = rebind_alloc<value_type>;
+
+  private:
+    using slot_allocator = rebind_alloc<slot_type>;
+    using slot_traits = std::allocator_traits<slot_allocator>;
+
+  public:
+    /// @brief Iterator over the present keys, in index order.
+    template <bool IsConst> class BasicIterator {
+        friend small_domain_map;
+
+        using Map = typename std::conditional<IsConst, const small_domain_map,
+                                              small_domain_map>::type;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename small_domain_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const value_type*,
+                                                  value_type*>::type;
+        using reference =
+            typename std::conditional<IsConst, const value_type&,
+                                      value_type&>::type;
+
+        BasicIterator() = default;
+
+        /// @brief Implicitly converts a mutable iterator to a const iterator.
+        template <bool OtherConst,
+                  typename = typename std::enable_if<IsConst &&
+                                                     !OtherConst>::type>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : map_(other.map_), index_(other.index_) {}
+
+        HMM_NODISCARD reference operator*() const {
+            return Policy::value_from_slot(map_->slots_[index_]);
+        }
+
+        HMM_NODISCARD pointer operator->() const {
+            return std::addressof(operator*());
+        }
+
+        BasicIterator& operator++() noexcept {
+            index_ = map_->present_.next(index_ + 1);
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        HMM_NODISCARD bool operator==(const BasicIterator& b) const noexcept {
+            return index_ == b.index_;
+        }
+        HMM_NODISCARD bool operator!=(const BasicIterator& b) const noexcept {
+            return !this->operator==(b);
+        }
+
+      private:
+        template <bool> friend class BasicIterator;
+
+        BasicIterator(Map* map, size_type index) noexcept
+            : map_(map), index_(index) {}
+
+        Map* map_ = nullptr;
+        size_type index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    /// @brief Default constructs an empty map, without allocating.
+    small_domain_map() = default;
+
+    /// @brief Constructs an empty map utilizing a specific allocator.
+    explicit small_domain_map(const allocator_type& alloc) : alloc_(alloc) {}
+
+    /// @brief Constructs the map with the contents of an initializer list.
+    small_domain_map(std::initializer_list<slot_type> initial,
+                     const allocator_type& alloc = allocator_type())
+        : small_domain_map(initial.begin(), initial.end(), alloc) {}
+
+    /// @brief Constructs the map with the contents of a range. The first of
+    /// several equal keys is kept.
+    template <class Iter, class Sentinel>
+    small_domain_map(Iter begin, Sentinel end,
+                     const allocator_type& alloc = allocator_type())
+        : small_domain_map(alloc) {
+        for (; begin != end; ++begin) {
+            emplace(*begin);
+        }
+    }
+
+    small_domain_map(const small_domain_map& other)
+        : small_domain_map(allocator_type(
+              slot_traits::select_on_container_copy_construction(
+                  other.alloc_))) {
+        for (const auto& kv : other) {
+            try_emplace(kv.first, kv.second);
+        }
+    }
+
+    small_domain_map(small_domain_map&& other) noexcept
+        : alloc_(std::move(other.alloc_)), slots_(other.slots_),
+          size_(other.size_), present_(other.present_) {
+        other.release();
+    }
+
+    small_domain_map& operator=(const small_domain_map& other) {
+        if (this != &other) {
+            small_domain_map copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    small_domain_map& operator=(small_domain_map&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            alloc_ = std::move(other.alloc_);
+            slots_ = other.slots_;
+            size_ = other.size_;
+            present_ = other.present_;
+            other.release();
+        }
+        return *this;
+    }
+
+    ~small_domain_map() {
+        destroy();
+    }
+
+    /// @name Container Interfaces
+    ///@{
+    HMM_NODISCARD iterator begin() noexcept {
+        return iterator(this, present_.next(0));
+    }
+    HMM_NODISCARD const_iterator begin() const noexcept {
+        return const_iterator(this, present_.next(0));
+    }
+    HMM_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    HMM_NODISCARD iterator end() noexcept {
+        return iterator(this, kDomainSize);
+    }
+    HMM_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(this, kDomainSize);
+    }
+    HMM_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /// @brief The number of keys in the domain.
+    HMM_NODISCARD static constexpr size_type max_size() noexcept {
+        return kDomainSize;
+    }
+
+    /// @brief Destroys every element. The slot array is kept.
+    void clear() noexcept {
+        for (size_type i = present_.next(0); i < kDomainSize;
+             i = present_.next(i + 1)) {
+            slot_traits::destroy(alloc_, slots_ + i);
+        }
+        present_.clear();
+        size_ = 0;
+    }
+
+    HMM_NODISCARD allocator_type get_allocator() const {
+        return allocator_type(alloc_);
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    HMM_NODISCARD iterator find(const key_type& key) {
+        return iterator(this, find_index(key));
+    }
+
+    HMM_NODISCARD const_iterator find(const key_type& key) const {
+        return const_iterator(this, find_index(key));
+    }
+
+    HMM_NODISCARD bool contains(const key_type& key) const {
+        return find_index(key) != kDomainSize;
+    }
+
+    HMM_NODISCARD size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    /// @brief Accesses the value mapped to `key`.
+    /// @throws std::out_of_range If the key is not present.
+    HMM_NODISCARD mapped_type& at(const key_type& key) {
+        const size_type i = find_index(key);
+        if (i == kDomainSize) {
+            throw std::out_of_range("small_domain_map::at");
+        }
+        return slots_[i].second;
+    }
+
+    HMM_NODISCARD const mapped_type& at(const key_type& key) const {
+        const size_type i = find_index(key);
+        if (i == kDomainSize) {
+            throw std::out_of_range("small_domain_map::at");
+        }
+        return slots_[i].second;
+    }
+    ///@}
+
+    /// @name Modifiers
+    /// Inserting a key whose index falls outside the domain throws
+    /// `std::out_of_range`.
+    ///@{
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(value.first, std::move(value.second));
+    }
+
+    /// @brief Constructs an element unless its key is already present.
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        slot_type temp = Policy::new_slot(alloc_, std::forward<Args>(args)...);
+        return try_emplace(temp.first, std::move(temp.second));
+    }
+
+    /// @brief Constructs an element from `key` and `args` unless the key is
+    /// already present, in which case the arguments are not used.
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const size_type i = checked_index(key);
+        if (present_.test(i)) {
+            return {iterator(this, i), false};
+        }
+        if (slots_ == nullptr) {
+            slots_ = slot_traits::allocate(alloc_, kDomainSize);
+        }
+        slot_traits::construct(
+            alloc_, slots_ + i, std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        present_.set(i);
+        ++size_;
+        return {iterator(this, i), true};
+    }
+
+    /// @brief Inserts `value` under `key`, or assigns it to the existing
+    /// element.
+    template <class K, class V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+        auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    /// @brief Accesses the value mapped to `key`, default constructing it if
+    /// the key is absent.
+    HMM_NODISCARD mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    /// @brief Removes the element at `pos`.
+    /// @return An iterator to the next element.
+    iterator erase(const_iterator pos) noexcept {
+        erase_at(pos.index_);
+        return iterator(this, present_.next(pos.index_ + 1));
+    }
+
+    /// @brief Removes the element with `key`.
+    /// @return 1 if an element was removed, 0 otherwise.
+    size_type erase_element(const key_type& key) noexcept {
+        const size_type i = find_index(key);
+        if (i == kDomainSize) {
+            return 0;
+        }
+        erase_at(i);
+        return 1;
+    }
+    ///@}
+
+  private:
+    /// @brief Returns the index of `key`, or `max_size()` if it is absent.
+    HMM_NODISCARD size_type find_index(const key_type& key) const noexcept {
+        const size_type i = Domain::index(key);
+        return i < kDomainSize && present_.test(i) ? i : kDomainSize;
+    }
+
+    HMM_NODISCARD static size_type checked_index(const key_type& key) {
+        const size_type i = Domain::index(key);
+        if (i >= kDomainSize) {
+            throw std::out_of_range("small_domain_map: key outside domain");
+        }
+        return i;
+    }
+
+    void erase_at(size_type i) noexcept {
+        slot_traits::destroy(alloc_, slots_ + i);
+        present_.reset(i);
+        --size_;
+    }
+
+    void destroy() noexcept {
+        if (slots_ != nullptr) {
+            clear();
+            slot_traits::deallocate(alloc_, slots_, kDomainSize);
+        }
+        release();
+    }
+
+    void release() noexcept {
+        slots_ = nullptr;
+        size_ = 0;
+        present_.clear();
+    }
+
+    slot_allocator alloc_;
+    slot_type* slots_ = nullptr;
+    size_type size_ = 0;
+    internal::DomainBitmap<kDomainSize> present_;
+};
+
+/// @brief A `small_domain_map` keyed by an enum.
+/// @details Enums over 8 or 16-bit integers work as they are; others declare
+/// their domain with `enum_domain`, as shown on `key_domain`.
+template <class Enum, class Value, class... TArgs>
+using enum_map = small_domain_map<Enum, Value, TArgs...>;
+
+} // namespace hmm
+
+#endif // HMM_HMM_SMALL_DOMAIN_MAP_HPP
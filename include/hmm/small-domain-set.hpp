@@ -0,0 +1,228 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef HMM_HMM_SMALL_DOMAIN_SET_HPP
+#define HMM_HMM_SMALL_DOMAIN_SET_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "hmm/internal/domain-bitmap.hpp"
+#include "hmm/internal/macros.hpp"
+#include "hmm/key-domain.hpp"
+
+namespace hmm {
+
+/// @brief A set over a small key domain, stored as a bitmap with one bit per
+/// possible key.
+///
+/// Membership is one bit test at the index `key_domain<Key>` gives the key:
+/// no hashing, no probing and no allocation. The set occupies `size / 8`
+/// bytes whatever it holds, so 32 bytes for `uint8_t` and 8 KiB for
+/// `uint16_t`.
+///
+/// The elements are not stored, only their bits, so iterators yield keys by
+/// value, rebuilt from their index. They visit the keys in index order.
+///
+/// @tparam Key A type with a `key_domain`.
+template <class Key> class small_domain_set {
+    static_assert(has_key_domain<Key>::value,
+                  "small_domain_set requires a key_domain for its key");
+
+    using Domain = key_domain<Key>;
+
+    static constexpr std::size_t kDomainSize = Domain::size;
+
+  public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /// @brief Iterator over the present keys, in index order.
+    class const_iterator {
+        friend small_domain_set;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Key;
+
+        const_iterator() = default;
+
+        HMM_NODISCARD reference operator*() const noexcept {
+            return Domain::key(index_);
+        }
+
+        const_iterator& operator++() noexcept {
+            index_ = set_->present_.next(index_ + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        HMM_NODISCARD bool
+        operator==(const const_iterator& b) const noexcept {
+            return index_ == b.index_;
+        }
+        HMM_NODISCARD bool
+        operator!=(const const_iterator& b) const noexcept {
+            return !this->operator==(b);
+        }
+
+      private:
+        const_iterator(const small_domain_set* set, size_type index) noexcept
+            : set_(set), index_(index) {}
+
+        const small_domain_set* set_ = nullptr;
+        size_type index_ = 0;
+    };
+    using iterator = const_iterator;
+
+    /// @brief Default constructs an empty set.
+    small_domain_set() = default;
+
+    /// @brief Constructs the set with the contents of an initializer list.
+    small_domain_set(std::initializer_list<value_type> initial)
+        : small_domain_set(initial.begin(), initial.end()) {}
+
+    /// @brief Constructs the set with the contents of a range.
+    template <class Iter, class Sentinel>
+    small_domain_set(Iter begin, Sentinel end) {
+        for (; begin != end; ++begin) {
+            insert(*begin);
+        }
+    }
+
+    /// @name Container Interfaces
+    ///@{
+    HMM_NODISCARD const_iterator begin() const noexcept {
+        return const_iterator(this, present_.next(0));
+    }
+    HMM_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    HMM_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(this, kDomainSize);
+    }
+    HMM_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    HMM_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /// @brief The number of keys in the domain.
+    HMM_NODISCARD static constexpr size_type max_size() noexcept {
+        return kDomainSize;
+    }
+
+    void clear() noexcept {
+        present_.clear();
+        size_ = 0;
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    HMM_NODISCARD const_iterator find(const key_type& key) const noexcept {
+        return const_iterator(this, find_index(key));
+    }
+
+    HMM_NODISCARD bool contains(const key_type& key) const noexcept {
+        return find_index(key) != kDomainSize;
+    }
+
+    HMM_NODISCARD size_type count(const key_type& key) const noexcept {
+        return contains(key) ? 1 : 0;
+    }
+    ///@}
+
+    /// @name Modifiers
+    ///@{
+    /// @brief Adds `key` unless it is already present.
+    /// @throws std::out_of_range If the key's index falls outside the domain.
+    std::pair<const_iterator, bool> insert(const key_type& key) {
+        const size_type i = Domain::index(key);
+        if (i >= kDomainSize) {
+            throw std::out_of_range("small_domain_set: key outside domain");
+        }
+        const bool inserted = !present_.test(i);
+        if (inserted) {
+            present_.set(i);
+            ++size_;
+        }
+        return {const_iterator(this, i), inserted};
+    }
+
+    /// @brief Adds the key built from `args` unless it is already present.
+    template <class... Args>
+    std::pair<const_iterator, bool> emplace(Args&&... args) {
+        return insert(key_type(std::forward<Args>(args)...));
+    }
+
+    /// @brief Removes the key at `pos`.
+    /// @return An iterator to the next key.
+    const_iterator erase(const_iterator pos) noexcept {
+        erase_at(pos.index_);
+        return const_iterator(this, present_.next(pos.index_ + 1));
+    }
+
+    /// @brief Removes `key`.
+    /// @return 1 if the key was removed, 0 otherwise.
+    size_type erase_element(const key_type& key) noexcept {
+        const size_type i = find_index(key);
+        if (i == kDomainSize) {
+            return 0;
+        }
+        erase_at(i);
+        return 1;
+    }
+    ///@}
+
+  private:
+    /// @brief Returns the index of `key`, or `max_size()` if it is absent.
+    HMM_NODISCARD size_type find_index(const key_type& key) const noexcept {
+        const size_type i = Domain::index(key);
+        return i < kDomainSize && present_.test(i) ? i : kDomainSize;
+    }
+
+    void erase_at(size_type i) noexcept {
+        present_.reset(i);
+        --size_;
+    }
+
+    size_type size_ = 0;
+    internal::DomainBitmap<kDomainSize> present_;
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_SMALL_DOMAIN_SET_HPP
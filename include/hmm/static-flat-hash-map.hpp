@@ -0,0 +1,333 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_STATIC_FLAT_HASH_MAP_HPP
+#define HMM_HMM_STATIC_FLAT_HASH_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "hmm/city-hash.hpp"
+#include "hmm/internal/bit-mask.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/fixed-table.hpp"
+#include "hmm/internal/macros.hpp"
+
+namespace hmm {
+
+/// @brief A fixed-capacity flat hash map that can be built at compile time.
+///
+/// `static_flat_hash_map` holds up to `N` elements inline, with no heap
+/// allocation, using the same control bytes and probe sequence as
+/// `flat_hash_map`. Its constructors are `constexpr` from C++14, so keyword,
+/// opcode or MIME tables can be declared `constexpr` (or `constinit` in C++20)
+/// and placed in read-only data with no startup cost:
+///
+/// @code
+/// constexpr hmm::static_flat_hash_map<std::string_view, int, 3> kOps = {
+///     {"add", 1}, {"sub", 2}, {"mul", 3}};
+/// static_assert(kOps.at("sub") == 2, "");
+/// @endcode
+///
+/// Lookups made during constant evaluation probe one control byte at a time.
+/// At run time they use the SIMD group scan of `flat_hash_map`.
+///
+/// The map is read-only once built. Keys and values must be default
+/// constructible, and for compile-time construction they must be literal
+/// types and the hasher must be `constexpr`, as `ConstexprCityHash` is.
+///
+/// @tparam Key The type of keys stored in the map.
+/// @tparam Value The type of mapped values.
+/// @tparam N The maximum number of elements.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to `hmm::ConstexprCityHash<Key>`)
+///               2. Equality functor (Defaults to `std::equal_to<Key>`)
+template <class Key, class Value, std::size_t N, class... TArgs>
+class static_flat_hash_map {
+  public:
+    using hasher_type = typename internal::detail::TypeAtIndexOrDefault<
+        0, ConstexprCityHash<Key>, TArgs...>::type;
+    using key_equal = typename internal::detail::TypeAtIndexOrDefault<
+        1, std::equal_to<Key>, TArgs...>::type;
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /// @brief The number of slots, fixed at compile time.
+    static constexpr size_type kCapacity = internal::StaticCapacity(N);
+
+  private:
+    using ctrl_t = std::int8_t;
+    using Group = internal::Group;
+
+    static constexpr size_type kGroupWidth = Group::kWidth;
+
+  public:
+    /// @brief Read-only iterator over the occupied slots.
+    class const_iterator {
+        friend static_flat_hash_map;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename static_flat_hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        constexpr const_iterator() = default;
+
+        HMM_NODISCARD constexpr reference operator*() const {
+            return map_->slots_[index_];
+        }
+
+        HMM_NODISCARD constexpr pointer operator->() const {
+            return &map_->slots_[index_];
+        }
+
+        HMM_CONSTEXPR_14 const_iterator& operator++() noexcept {
+            ++index_;
+            skip_empty();
+            return *this;
+        }
+
+        HMM_CONSTEXPR_14 const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        HMM_NODISCARD constexpr bool
+        operator==(const const_iterator& b) const noexcept {
+            return index_ == b.index_;
+        }
+        HMM_NODISCARD constexpr bool
+        operator!=(const const_iterator& b) const noexcept {
+            return !this->operator==(b);
+        }
+
+      private:
+        HMM_CONSTEXPR_14 const_iterator(const static_flat_hash_map* map,
+                                        size_type index)
+            : map_(map), index_(index) {}
+
+        HMM_CONSTEXPR_14 void skip_empty() noexcept {
+            while (index_ < kCapacity &&
+                   map_->ctrl_[index_] == internal::detail::slots::kEmpty) {
+                ++index_;
+            }
+        }
+
+        const static_flat_hash_map* map_ = nullptr;
+        size_type index_ = kCapacity;
+    };
+    using iterator = const_iterator;
+
+    /// @brief Constructs an empty map.
+    HMM_CONSTEXPR_14 static_flat_hash_map(
+        const hasher_type& hash = hasher_type(),
+        const key_equal& eq = key_equal())
+        : hash_(hash), eq_(eq) {
+        for (auto& c : ctrl_) {
+            c = internal::detail::slots::kEmpty;
+        }
+    }
+
+    /// @brief Builds the map from a range. The first of several equal keys
+    /// is kept.
+    /// @throws std::length_error If the range holds more than `N` distinct
+    /// keys. During constant evaluation this is a compile error.
+    template <class InputIt>
+    HMM_CONSTEXPR_14 static_flat_hash_map(
+        InputIt first, InputIt last, const hasher_type& hash = hasher_type(),
+        const key_equal& eq = key_equal())
+        : static_flat_hash_map(hash, eq) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    /// @brief Builds the map from an initializer list.
+    HMM_CONSTEXPR_14 static_flat_hash_map(
+        std::initializer_list<value_type> initial,
+        const hasher_type& hash = hasher_type(),
+        const key_equal& eq = key_equal())
+        : static_flat_hash_map(initial.begin(), initial.end(), hash, eq) {}
+
+    /// @name Read-Only Container Interfaces
+    ///@{
+    HMM_NODISCARD HMM_CONSTEXPR_14 const_iterator begin() const noexcept {
+        const_iterator it(this, 0);
+        it.skip_empty();
+        return it;
+    }
+    HMM_NODISCARD HMM_CONSTEXPR_14 const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    HMM_NODISCARD HMM_CONSTEXPR_14 const_iterator end() const noexcept {
+        return const_iterator(this, kCapacity);
+    }
+    HMM_NODISCARD HMM_CONSTEXPR_14 const_iterator cend() const noexcept {
+        return end();
+    }
+
+    HMM_NODISCARD constexpr size_type size() const noexcept {
+        return size_;
+    }
+
+    HMM_NODISCARD constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    HMM_NODISCARD static constexpr size_type max_size() noexcept {
+        return N;
+    }
+
+    HMM_NODISCARD static constexpr size_type capacity() noexcept {
+        return kCapacity;
+    }
+    ///@}
+
+    /// @name Lookup
+    ///@{
+    /// @brief Finds the element with `key`.
+    /// @return An iterator to the element, or `end()` if not found.
+    template <class K = key_type>
+    HMM_NODISCARD HMM_CONSTEXPR_14 const_iterator find(const K& key) const {
+        return const_iterator(this, find_index(key));
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD HMM_CONSTEXPR_14 bool contains(const K& key) const {
+        return find_index(key) != kCapacity;
+    }
+
+    template <class K = key_type>
+    HMM_NODISCARD HMM_CONSTEXPR_14 size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    /// @brief Accesses the value mapped to `key`.
+    /// @throws std::out_of_range If the key is not present.
+    template <class K = key_type>
+    HMM_NODISCARD HMM_CONSTEXPR_14 const mapped_type& at(const K& key) const {
+        const auto index = find_index(key);
+        if (index == kCapacity) {
+            throw std::out_of_range("static_flat_hash_map::at");
+        }
+        return slots_[index].second;
+    }
+    ///@}
+
+    /// @name Observers
+    ///@{
+    HMM_NODISCARD constexpr const hasher_type& hash_function() const noexcept {
+        return hash_;
+    }
+
+    HMM_NODISCARD constexpr const key_equal& key_eq() const noexcept {
+        return eq_;
+    }
+    ///@}
+
+  private:
+    /// @brief Inserts an element unless its key is already present.
+    HMM_CONSTEXPR_14 void insert(const value_type& value) {
+        const std::size_t hash = hash_(value.first);
+        const auto h2 = internal::detail::H2(hash);
+        size_type index =
+            internal::detail::IndexWithoutProbing(internal::detail::H1(hash),
+                                                  kCapacity);
+        while (ctrl_[index] != internal::detail::slots::kEmpty) {
+            if (ctrl_[index] == h2 && eq_(value.first, slots_[index].first)) {
+                return;
+            }
+            index = (index + 1) & (kCapacity - 1);
+        }
+        if (size_ == N) {
+            throw std::length_error("static_flat_hash_map capacity exceeded");
+        }
+        slots_[index].first = value.first;
+        slots_[index].second = value.second;
+        ctrl_[index] = h2;
+        // Mirror the first group into the tail so group loads never wrap.
+        if (index < kGroupWidth - 1) {
+            ctrl_[kCapacity + index] = h2;
+        }
+        ++size_;
+    }
+
+    /// @brief Locates `key`, returning `kCapacity` when it is absent.
+    template <class K>
+    HMM_NODISCARD HMM_CONSTEXPR_14 size_type find_index(const K& key) const {
+        const std::size_t hash = hash_(key);
+        const auto h2 = internal::detail::H2(hash);
+        size_type index =
+            internal::detail::IndexWithoutProbing(internal::detail::H1(hash),
+                                                  kCapacity);
+
+        if (!HMM_IS_CONSTANT_EVALUATED()) {
+            while (true) {
+                Group g = Group::Load(ctrl_ + index);
+                for (auto mask = g.Match(h2); mask; ++mask) {
+                    const size_type probe =
+                        (index + mask.first_index()) & (kCapacity - 1);
+                    if (eq_(key, slots_[probe].first)) {
+                        return probe;
+                    }
+                }
+                if (g.MatchEmpty()) {
+                    return kCapacity;
+                }
+                index = (index + kGroupWidth) & (kCapacity - 1);
+            }
+        }
+
+        // The same probe sequence, one control byte at a time.
+        while (ctrl_[index] != internal::detail::slots::kEmpty) {
+            if (ctrl_[index] == h2 && eq_(key, slots_[index].first)) {
+                return index;
+            }
+            index = (index + 1) & (kCapacity - 1);
+        }
+        return kCapacity;
+    }
+
+    hasher_type hash_;
+    key_equal eq_;
+    size_type size_ = 0;
+    ctrl_t ctrl_[kCapacity + kGroupWidth - 1] = {};
+    value_type slots_[kCapacity] = {};
+};
+
+template <class Key, class Value, std::size_t N, class... TArgs>
+constexpr typename static_flat_hash_map<Key, Value, N, TArgs...>::size_type
+    static_flat_hash_map<Key, Value, N, TArgs...>::kCapacity;
+
+template <class Key, class Value, std::size_t N, class... TArgs>
+constexpr typename static_flat_hash_map<Key, Value, N, TArgs...>::size_type
+    static_flat_hash_map<Key, Value, N, TArgs...>::kGroupWidth;
+
+} // namespace hmm
+
+#endif // HMM_HMM_STATIC_FLAT_HASH_MAP_HPP
@@ -0,0 +1,476 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_STRING_FLAT_HASH_MAP_HPP
+#define HMM_HMM_STRING_FLAT_HASH_MAP_HPP
+
+#include "hmm/internal/macros.hpp"
+
+#if !HMM_HAS_CXX_17
+#error "hmm/string-flat-hash-map.hpp requires C++17 (std::string_view)"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "hmm/city-hash.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/raw-hash-set.hpp"
+
+namespace hmm {
+
+/// @brief A 24-byte string key holding its length and the first bytes of the
+/// string inline.
+///
+/// Strings of up to `kInline` bytes are stored entirely inline. Longer strings
+/// keep a 12-byte prefix inline, followed by a pointer to the full string.
+/// Unused inline bytes are always zero, so two keys differing in length or
+/// prefix are told apart by comparing two 64-bit words, and two short keys by
+/// comparing three.
+///
+/// A `string_key` built from a string only borrows the bytes of a long
+/// string, like `std::string_view`. The keys stored in a
+/// `string_flat_hash_map` own their copy, which stays valid until the element
+/// is erased.
+class string_key {
+  public:
+    /// @brief The longest string stored entirely inline.
+    static constexpr std::size_t kInline = 20;
+    /// @brief The bytes of a long string kept inline.
+    static constexpr std::size_t kPrefix = kInline - sizeof(const char*);
+
+    string_key() noexcept = default;
+
+    /// @throws std::length_error If `text` is 2^32 bytes or longer.
+    string_key(std::string_view text) {
+        if (text.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("string_key exceeds 2^32 - 1 bytes");
+        }
+        size_ = static_cast<std::uint32_t>(text.size());
+        if (text.size() <= kInline) {
+            std::memcpy(data_, text.data(), text.size());
+        } else {
+            std::memcpy(data_, text.data(), kPrefix);
+            set_pointer(text.data());
+        }
+    }
+
+    string_key(const char* text) : string_key(std::string_view(text)) {}
+
+    string_key(const std::string& text) : string_key(std::string_view(text)) {}
+
+    HMM_NODISCARD std::size_t size() const noexcept {
+        return size_;
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /// @brief Whether the whole string is stored inline.
+    HMM_NODISCARD bool is_inline() const noexcept {
+        return size_ <= kInline;
+    }
+
+    HMM_NODISCARD const char* data() const noexcept {
+        return is_inline() ? data_ : pointer();
+    }
+
+    HMM_NODISCARD std::string_view view() const noexcept {
+        return std::string_view(data(), size_);
+    }
+
+    operator std::string_view() const noexcept {
+        return view();
+    }
+
+    /// @brief Compares the length and prefix as two words first; only long
+    /// strings sharing both read their remaining bytes.
+    HMM_NODISCARD friend bool operator==(const string_key& a,
+                                         const string_key& b) noexcept {
+        if (a.word(0) != b.word(0) || a.word(1) != b.word(1)) {
+            return false;
+        }
+        if (a.is_inline()) {
+            return a.word(2) == b.word(2);
+        }
+        return std::memcmp(a.pointer() + kPrefix, b.pointer() + kPrefix,
+                           a.size_ - kPrefix) == 0;
+    }
+
+    HMM_NODISCARD friend bool operator!=(const string_key& a,
+                                         const string_key& b) noexcept {
+        return !(a == b);
+    }
+
+  private:
+    template <class> friend struct StringMapPolicy;
+
+    /// @brief Reads the `i`-th 64-bit word of the key: the length and the
+    /// first 4 bytes, then bytes 4 to 11, then bytes 12 to 19.
+    HMM_NODISCARD std::uint64_t word(std::size_t i) const noexcept {
+        std::uint64_t w = 0;
+        if (i == 0) {
+            std::memcpy(&w, &size_, sizeof(size_));
+            std::memcpy(reinterpret_cast<char*>(&w) + sizeof(size_), data_,
+                        sizeof(w) - sizeof(size_));
+        } else {
+            std::memcpy(&w, data_ + 8 * i - sizeof(size_), sizeof(w));
+        }
+        return w;
+    }
+
+    HMM_NODISCARD const char* pointer() const noexcept {
+        const char* p = nullptr;
+        std::memcpy(&p, data_ + kPrefix, sizeof(p));
+        return p;
+    }
+
+    void set_pointer(const char* p) noexcept {
+        std::memcpy(data_ + kPrefix, &p, sizeof(p));
+    }
+
+    std::uint32_t size_ = 0;
+    char data_[kInline] = {};
+};
+
+namespace internal {
+
+/// @brief Hashes a `string_key` through a functor over `std::string_view`.
+template <class Hash> struct StringKeyHasher {
+    StringKeyHasher() = default;
+    explicit StringKeyHasher(const Hash& hash) : hash_(hash) {}
+
+    HMM_NODISCARD std::size_t operator()(const string_key& key) const {
+        return hash_(key.view());
+    }
+
+    HMM_NODISCARD const Hash& hash_function() const noexcept {
+        return hash_;
+    }
+
+  private:
+    Hash hash_;
+};
+
+/// @brief The word-wise equality of `string_key`.
+struct StringKeyEq {
+    HMM_NODISCARD bool operator()(const string_key& a,
+                                  const string_key& b) const noexcept {
+        return a == b;
+    }
+};
+
+} // namespace internal
+
+/// @brief Policy trait for `string_flat_hash_map`. Slots own the bytes of
+/// long keys, which are allocated through the table's allocator.
+template <class V> struct StringMapPolicy {
+    using key_type = string_key;
+    using mapped_type = V;
+    using value_type = std::pair<const string_key, V>;
+    using slot_type = std::pair<string_key, V>;
+
+    using default_hasher_type = CityHash<std::string_view>;
+    using default_eq_type = internal::StringKeyEq;
+    using default_allocator_type = std::allocator<slot_type>;
+
+    /// @name Key Extraction
+    ///@{
+    HMM_NODISCARD static const key_type& key(const slot_type& pair) noexcept {
+        return pair.first;
+    }
+
+    HMM_NODISCARD static const key_type& key(const value_type& pair) noexcept {
+        return pair.first;
+    }
+    ///@}
+
+    /// @brief Views a slot as the public `value_type`, as `MapPolicy` does.
+    HMM_NODISCARD static value_type& value_from_slot(slot_type& slot) noexcept {
+        return reinterpret_cast<value_type&>(slot);
+    }
+
+    HMM_NODISCARD static const value_type&
+    value_from_slot(const slot_type& slot) noexcept {
+        return reinterpret_cast<const value_type&>(slot);
+    }
+
+    /// @brief Relocates a slot; ownership of the key's bytes moves with it.
+    template <class Alloc>
+    static void construct(Alloc& alloc, slot_type* ptr, slot_type&& other) {
+        std::allocator_traits<Alloc>::construct(alloc, ptr, std::move(other));
+    }
+
+    /// @brief Copies a slot, including the bytes of a long key.
+    template <class Alloc>
+    static void construct(Alloc& alloc, slot_type* ptr,
+                          const slot_type& other) {
+        construct_owned(alloc, ptr, other);
+    }
+
+    /// @brief Constructs an element, copying the bytes of a long key.
+    template <class Alloc, class... Args>
+    static void construct(Alloc& alloc, slot_type* ptr, Args&&... args) {
+        construct_owned(alloc, ptr, std::forward<Args>(args)...);
+    }
+
+    /// @brief Destroys an element and frees the bytes of a long key.
+    template <class Alloc> static void destroy(Alloc& alloc, slot_type* ptr) {
+        release_key(alloc, ptr->first);
+        std::allocator_traits<Alloc>::destroy(alloc, ptr);
+    }
+
+    template <class Alloc>
+    static void transfer(Alloc& alloc, slot_type* dst, slot_type* src) {
+        std::allocator_traits<Alloc>::construct(alloc, dst, std::move(*src));
+        std::allocator_traits<Alloc>::destroy(alloc, src);
+    }
+
+    /// @brief Builds a free-standing slot that owns its key.
+    template <class Alloc, class... Args>
+    static slot_type new_slot(Alloc& alloc, Args&&... args) {
+        slot_type slot(std::forward<Args>(args)...);
+        own_key(alloc, slot.first);
+        return slot;
+    }
+
+    /// @brief Disposes of a free-standing slot that was not inserted.
+    template <class Alloc>
+    static void drop_slot(Alloc& alloc, slot_type& slot) noexcept {
+        release_key(alloc, slot.first);
+    }
+
+  private:
+    template <class Alloc>
+    using CharAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<char>;
+
+    template <class Alloc, class... Args>
+    static void construct_owned(Alloc& alloc, slot_type* ptr,
+                                Args&&... args) {
+        std::allocator_traits<Alloc>::construct(alloc, ptr,
+                                                std::forward<Args>(args)...);
+        try {
+            own_key(alloc, ptr->first);
+        } catch (...) {
+            std::allocator_traits<Alloc>::destroy(alloc, ptr);
+            throw;
+        }
+    }
+
+    /// @brief Replaces a borrowed long key with a copy of its bytes.
+    template <class Alloc> static void own_key(Alloc& alloc, string_key& key) {
+        if (key.is_inline()) {
+            return;
+        }
+        CharAlloc<Alloc> chars(alloc);
+        char* copy = std::addressof(*std::allocator_traits<
+                                    CharAlloc<Alloc>>::allocate(chars,
+                                                                key.size()));
+        std::memcpy(copy, key.pointer(), key.size());
+        key.set_pointer(copy);
+    }
+
+    template <class Alloc>
+    static void release_key(Alloc& alloc, string_key& key) noexcept {
+        if (key.is_inline()) {
+            return;
+        }
+        CharAlloc<Alloc> chars(alloc);
+        std::allocator_traits<CharAlloc<Alloc>>::deallocate(
+            chars, const_cast<char*>(key.pointer()), key.size());
+    }
+};
+
+/// @brief A flat hash map keyed by strings, comparing keys without chasing
+/// pointers.
+///
+/// Each slot holds a 24-byte `string_key`: the length and up to 20 bytes of
+/// the string inline, or a 12-byte prefix and a pointer to an owned copy of a
+/// longer string. After an H2 match, a candidate is rejected by comparing the
+/// length and prefix as two machine words, so heap bytes are only read for
+/// long keys sharing a 12-byte prefix. A `std::string` slot, by contrast, is
+/// 32 bytes and `std::equal_to` may dereference heap memory on every match.
+///
+/// Every lookup takes a `std::string_view`, so string literals and
+/// `std::string`s are accepted without constructing a `std::string`.
+/// Iteration yields `std::pair<const string_key, Value>`. The key converts to
+/// `std::string_view`.
+///
+/// @tparam Value The type of mapped values.
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor over `std::string_view` (Defaults to
+///               `hmm::CityHash<std::string_view>`)
+///               2. Allocator (Defaults to `std::allocator<std::pair<
+///               string_key, Value>>`), also used for long keys
+template <class Value, class... TArgs>
+class string_flat_hash_map
+    : protected internal::raw_hash_set<
+          StringMapPolicy<Value>,
+          internal::StringKeyHasher<
+              typename internal::detail::TypeAtIndexOrDefault<
+                  0, CityHash<std::string_view>, TArgs...>::type>,
+          internal::StringKeyEq,
+          typename internal::detail::TypeAtIndexOrDefault<
+              1, std::allocator<std::pair<string_key, Value>>,
+              TArgs...>::type> {
+    using Hash = typename internal::detail::TypeAtIndexOrDefault<
+        0, CityHash<std::string_view>, TArgs...>::type;
+    using Base = internal::raw_hash_set<
+        StringMapPolicy<Value>, internal::StringKeyHasher<Hash>,
+        internal::StringKeyEq,
+        typename internal::detail::TypeAtIndexOrDefault<
+            1, std::allocator<std::pair<string_key, Value>>,
+            TArgs...>::type>;
+
+  public:
+    using policy_type = typename Base::policy_type;
+    using hasher_type = Hash;
+    using key_type = string_key;
+    using mapped_type = Value;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using difference_type = typename Base::difference_type;
+    using allocator_type = typename Base::allocator_type;
+
+    using const_iterator = typename Base::const_iterator;
+    using iterator = typename Base::iterator;
+
+    string_flat_hash_map() = default;
+
+    explicit string_flat_hash_map(const allocator_type& alloc)
+        : Base(alloc) {}
+
+    /// @brief Constructs the map from a list of key-value pairs. The first
+    /// of several equal keys is kept.
+    string_flat_hash_map(
+        std::initializer_list<std::pair<std::string_view, Value>> initial,
+        const allocator_type& alloc = allocator_type())
+        : Base(alloc) {
+        reserve(initial.size());
+        for (const auto& kv : initial) {
+            try_emplace(kv.first, kv.second);
+        }
+    }
+
+    /// @name Standard Container Interfaces
+    ///@{
+    using Base::begin;
+    using Base::capacity;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::clear;
+    using Base::empty;
+    using Base::end;
+    using Base::reserve;
+    using Base::size;
+    ///@}
+
+    /// @name Lookup
+    /// Each converts the key to a `string_key` once and hashes it once.
+    ///@{
+    HMM_NODISCARD iterator find(std::string_view key) {
+        return Base::find(string_key(key));
+    }
+
+    HMM_NODISCARD const_iterator find(std::string_view key) const {
+        return Base::find(string_key(key));
+    }
+
+    HMM_NODISCARD bool contains(std::string_view key) const {
+        return find(key) != end();
+    }
+
+    HMM_NODISCARD size_type count(std::string_view key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    /// @throws std::out_of_range If the key is not present.
+    HMM_NODISCARD mapped_type& at(std::string_view key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("string_flat_hash_map::at");
+        }
+        return it->second;
+    }
+
+    /// @throws std::out_of_range If the key is not present.
+    HMM_NODISCARD const mapped_type& at(std::string_view key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("string_flat_hash_map::at");
+        }
+        return it->second;
+    }
+    ///@}
+
+    /// @name Modifiers
+    ///@{
+    /// @brief Constructs the value from `args` if `key` is absent. A long key
+    /// is copied only when inserted.
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(std::string_view key,
+                                          Args&&... args) {
+        return Base::try_emplace(string_key(key),
+                                 std::forward<Args>(args)...);
+    }
+
+    template <class V>
+    std::pair<iterator, bool> insert_or_assign(std::string_view key,
+                                               V&& value) {
+        auto result = try_emplace(key, std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    HMM_NODISCARD mapped_type& operator[](std::string_view key) {
+        return try_emplace(key).first->second;
+    }
+
+    iterator erase(const_iterator pos) {
+        return Base::erase(pos);
+    }
+
+    size_type erase(std::string_view key) {
+        return Base::erase_element(string_key(key));
+    }
+    ///@}
+
+    /// @name Observers
+    ///@{
+    HMM_NODISCARD const hasher_type& hash_function() const noexcept {
+        return Base::hasher().hash_function();
+    }
+
+    using Base::get_allocator;
+    ///@}
+};
+
+} // namespace hmm
+
+#endif // HMM_HMM_STRING_FLAT_HASH_MAP_HPP
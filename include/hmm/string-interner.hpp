@@ -0,0 +1,412 @@
+// Copyright 2025 Robert Williamson
+//
+// Licensed under the MIT License;
+// You may not used this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//       https://opensource.org/license/mit
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef HMM_HMM_STRING_INTERNER_HPP
+#define HMM_HMM_STRING_INTERNER_HPP
+
+#include "hmm/internal/macros.hpp"
+
+#if !HMM_HAS_CXX_17
+#error "hmm/string-interner.hpp requires C++17 (std::string_view)"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "hmm/city-hash.hpp"
+#include "hmm/internal/detail.hpp"
+#include "hmm/internal/index-table.hpp"
+#include "hmm/internal/raw-hash-set.hpp"
+
+namespace hmm {
+namespace internal {
+
+/// @brief The slot of an interner's table: the symbol, plus 32 bits of its
+/// hash that are independent of the H1 and H2 bits for tables below 2^25
+/// slots.
+struct InternSlot {
+    std::uint32_t id;
+    std::uint32_t tag;
+};
+
+HMM_NODISCARD constexpr std::uint32_t InternTag(std::size_t hash) noexcept {
+    return static_cast<std::uint32_t>(hash >> 25);
+}
+
+/// @brief A string being looked up, hashed once up front.
+struct InternKey {
+    std::string_view text;
+    std::size_t hash;
+};
+
+/// @brief Hashing functor for interner tables. Rehashing reads the stored
+/// hash of each symbol instead of the string.
+template <class Owner> class InternHasher {
+  public:
+    InternHasher() = default;
+
+    explicit InternHasher(const Owner* owner) : owner_(owner) {}
+
+    HMM_NODISCARD std::size_t operator()(InternSlot slot) const {
+        return owner_->hash_at(slot.id);
+    }
+
+    HMM_NODISCARD std::size_t operator()(const InternKey& key) const {
+        return key.hash;
+    }
+
+    /// @brief Points the functor at a new owner after it has been moved.
+    void rebind(const Owner* owner) noexcept {
+        owner_ = owner;
+    }
+
+  private:
+    const Owner* owner_ = nullptr;
+};
+
+/// @brief Equality functor for interner tables. The hash tag is compared
+/// before the string bytes, so mismatches rarely touch the arena.
+template <class Owner, class Eq> class InternEq {
+  public:
+    InternEq() = default;
+
+    InternEq(const Owner* owner, const Eq& eq) : owner_(owner), eq_(eq) {}
+
+    HMM_NODISCARD constexpr bool operator()(InternSlot lhs,
+                                            InternSlot rhs) const noexcept {
+        return lhs.id == rhs.id;
+    }
+
+    HMM_NODISCARD bool operator()(const InternKey& key,
+                                  InternSlot slot) const {
+        return InternTag(key.hash) == slot.tag &&
+               eq_(key.text, owner_->name(slot.id));
+    }
+
+    /// @brief Points the functor at a new owner after it has been moved.
+    void rebind(const Owner* owner) noexcept {
+        owner_ = owner;
+    }
+
+    HMM_NODISCARD const Eq& key_eq() const noexcept {
+        return eq_;
+    }
+
+  private:
+    const Owner* owner_ = nullptr;
+    Eq eq_;
+};
+
+} // namespace internal
+
+/// @brief Maps strings to dense 32-bit symbols and back.
+///
+/// Each distinct string is copied once into a chunked arena, where it never
+/// moves, and gets the next symbol in sequence. A SwissTable of
+/// `(symbol, hash tag)` pairs finds the symbol of a string: a candidate slot
+/// is only compared byte by byte once 32 more bits of its hash have matched.
+/// A per-symbol array of `(pointer, length, hash)` answers reverse lookups in
+/// O(1) and lets the table grow without rereading the strings.
+///
+/// Interning a string that is already present never allocates.
+///
+/// @tparam TArgs Variadic template arguments specifying optionally:
+///               1. Hash functor (Defaults to
+///               `hmm::CityHash<std::string_view>`)
+///               2. Equality functor (Defaults to
+///               `std::equal_to<std::string_view>`)
+///               3. Allocator (Defaults to `std::allocator<char>`)
+template <class... TArgs> class string_interner {
+  public:
+    using hasher_type = typename internal::detail::TypeAtIndexOrDefault<
+        0, CityHash<std::string_view>, TArgs...>::type;
+    using key_equal = typename internal::detail::TypeAtIndexOrDefault<
+        1, std::equal_to<std::string_view>, TArgs...>::type;
+    using allocator_type = typename internal::detail::TypeAtIndexOrDefault<
+        2, std::allocator<char>, TArgs...>::type;
+    using symbol_type = std::uint32_t;
+    using size_type = std::size_t;
+
+    /// @brief Returned by `find` for strings that were never interned.
+    static constexpr symbol_type npos =
+        std::numeric_limits<symbol_type>::max();
+
+  private:
+    template <class T>
+    using rebind_alloc = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<T>;
+    using CharTraits = std::allocator_traits<rebind_alloc<char>>;
+
+    using Hasher = internal::InternHasher<string_interner>;
+    using Eq = internal::InternEq<string_interner, key_equal>;
+    using Table =
+        internal::raw_hash_set<internal::IndexPolicy<allocator_type,
+                                                     internal::InternSlot>,
+                               Hasher, Eq,
+                               rebind_alloc<internal::InternSlot>>;
+
+    template <class> friend class internal::InternHasher;
+    template <class, class> friend class internal::InternEq;
+
+    /// @brief Where a symbol's string lives, and its full hash.
+    struct Symbol {
+        const char* data;
+        std::size_t size;
+        std::size_t hash;
+    };
+
+    /// @brief One arena allocation.
+    struct Chunk {
+        char* data;
+        std::size_t size;
+    };
+
+    /// @brief Arena chunks are this large, unless a string needs more.
+    static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  public:
+    explicit string_interner(const hasher_type& hash = hasher_type(),
+                             const key_equal& eq = key_equal(),
+                             const allocator_type& alloc = allocator_type())
+        : hash_(hash), alloc_(alloc), symbols_(rebind_alloc<Symbol>(alloc)),
+          chunks_(rebind_alloc<Chunk>(alloc)),
+          table_(Hasher(this), Eq(this, eq),
+                 rebind_alloc<internal::InternSlot>(alloc)) {}
+
+    /// @brief Copies every string, keeping the symbols.
+    string_interner(const string_interner& other)
+        : string_interner(other.hash_, other.table_.equal().key_eq(),
+                          CharTraits::select_on_container_copy_construction(
+                              other.alloc_)) {
+        reserve(other.size());
+        for (const auto& symbol : other.symbols_) {
+            intern(std::string_view(symbol.data, symbol.size));
+        }
+    }
+
+    /// @brief Takes over the arena; strings keep their addresses and the
+    /// source is left empty.
+    string_interner(string_interner&& other) noexcept
+        : hash_(std::move(other.hash_)), alloc_(std::move(other.alloc_)),
+          symbols_(std::move(other.symbols_)),
+          chunks_(std::move(other.chunks_)), table_(std::move(other.table_)),
+          cursor_(other.cursor_), remaining_(other.remaining_) {
+        rebind();
+        other.reset_after_move();
+    }
+
+    string_interner& operator=(const string_interner& other) {
+        if (this != &other) {
+            string_interner tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    string_interner& operator=(string_interner&& other) noexcept {
+        if (this != &other) {
+            release_chunks();
+            hash_ = std::move(other.hash_);
+            alloc_ = std::move(other.alloc_);
+            symbols_ = std::move(other.symbols_);
+            chunks_ = std::move(other.chunks_);
+            table_ = std::move(other.table_);
+            cursor_ = other.cursor_;
+            remaining_ = other.remaining_;
+            rebind();
+            other.reset_after_move();
+        }
+        return *this;
+    }
+
+    ~string_interner() {
+        release_chunks();
+    }
+
+    /// @brief Returns the symbol of `text`, interning it first if needed.
+    /// @throws std::length_error If 2^32 - 1 symbols already exist.
+    symbol_type intern(std::string_view text) {
+        const internal::InternKey key{text, hash_(text)};
+        auto info = table_.find_or_prepare_insert_hashed(key, key.hash);
+        if (info.found) {
+            return table_.slots_ptr()[info.index].id;
+        }
+
+        if (symbols_.size() >= npos) {
+            throw std::length_error("string_interner exceeds 2^32 - 1 symbols");
+        }
+        if (table_.needs_resize()) {
+            table_.rehash_and_grow();
+            info = table_.find_or_prepare_insert_hashed(key, key.hash);
+        }
+        const auto id = static_cast<symbol_type>(symbols_.size());
+        symbols_.push_back(Symbol{copy_to_arena(text), text.size(), key.hash});
+        table_.insert_at_index(info.index, key.hash,
+                               internal::InternSlot{id, internal::InternTag(
+                                                            key.hash)});
+        return id;
+    }
+
+    /// @brief Returns the symbol of `text`, or `npos` if it was never
+    /// interned.
+    HMM_NODISCARD symbol_type find(std::string_view text) const {
+        const internal::InternKey key{text, hash_(text)};
+        const auto it = table_.find_hashed(key, key.hash);
+        return it == table_.end() ? npos : it->id;
+    }
+
+    HMM_NODISCARD bool contains(std::string_view text) const {
+        return find(text) != npos;
+    }
+
+    /// @brief Returns the string of a symbol. The view stays valid until the
+    /// interner is cleared or destroyed.
+    HMM_NODISCARD std::string_view name(symbol_type id) const {
+        HMM_ASSERT(id < symbols_.size());
+        return std::string_view(symbols_[id].data, symbols_[id].size);
+    }
+
+    /// @brief The number of distinct strings, which is also the next symbol.
+    HMM_NODISCARD size_type size() const noexcept {
+        return symbols_.size();
+    }
+
+    HMM_NODISCARD bool empty() const noexcept {
+        return symbols_.empty();
+    }
+
+    /// @brief Makes room for `count` symbols without rehashing.
+    void reserve(size_type count) {
+        symbols_.reserve(count);
+        table_.reserve(count);
+    }
+
+    /// @brief Forgets every string and frees the arena.
+    void clear() {
+        table_.clear();
+        symbols_.clear();
+        release_chunks();
+        chunks_.clear();
+        cursor_ = nullptr;
+        remaining_ = 0;
+    }
+
+    /// @brief The bytes held by the arena, including unused chunk tails.
+    HMM_NODISCARD size_type arena_bytes() const noexcept {
+        size_type total = 0;
+        for (const auto& chunk : chunks_) {
+            total += chunk.size;
+        }
+        return total;
+    }
+
+    HMM_NODISCARD const hasher_type& hash_function() const noexcept {
+        return hash_;
+    }
+
+    HMM_NODISCARD const key_equal& key_eq() const noexcept {
+        return table_.equal().key_eq();
+    }
+
+    HMM_NODISCARD allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+  private:
+    /// @brief The stored hash of a symbol, for rehashing.
+    HMM_NODISCARD std::size_t hash_at(symbol_type id) const noexcept {
+        return symbols_[id].hash;
+    }
+
+    /// @brief Re-points the table's functors at this instance.
+    void rebind() noexcept {
+        table_.hasher().rebind(this);
+        table_.equal().rebind(this);
+    }
+
+    /// @brief Copies `text` into the arena. Strings too large to share a
+    /// chunk get one of their own, leaving the current chunk in use.
+    HMM_NODISCARD const char* copy_to_arena(std::string_view text) {
+        if (text.empty()) {
+            return nullptr;
+        }
+        char* dst = nullptr;
+        if (text.size() > kChunkSize / 4) {
+            dst = new_chunk(text.size());
+        } else {
+            if (text.size() > remaining_) {
+                cursor_ = new_chunk(kChunkSize);
+                remaining_ = kChunkSize;
+            }
+            dst = cursor_;
+            cursor_ += text.size();
+            remaining_ -= text.size();
+        }
+        std::memcpy(dst, text.data(), text.size());
+        return dst;
+    }
+
+    HMM_NODISCARD char* new_chunk(std::size_t size) {
+        chunks_.reserve(chunks_.size() + 1);
+        rebind_alloc<char> alloc(alloc_);
+        char* data = std::addressof(*CharTraits::allocate(alloc, size));
+        chunks_.push_back(Chunk{data, size});
+        return data;
+    }
+
+    void release_chunks() noexcept {
+        rebind_alloc<char> alloc(alloc_);
+        for (const auto& chunk : chunks_) {
+            CharTraits::deallocate(alloc, chunk.data, chunk.size);
+        }
+    }
+
+    void reset_after_move() noexcept {
+        symbols_.clear();
+        chunks_.clear();
+        table_.clear();
+        cursor_ = nullptr;
+        remaining_ = 0;
+    }
+
+    hasher_type hash_;
+    allocator_type alloc_;
+    std::vector<Symbol, rebind_alloc<Symbol>> symbols_;
+    std::vector<Chunk, rebind_alloc<Chunk>> chunks_;
+    Table table_;
+    char* cursor_ = nullptr;
+    std::size_t remaining_ = 0;
+};
+
+template <class... TArgs>
+constexpr typename string_interner<TArgs...>::symbol_type
+    string_interner<TArgs...>::npos;
+
+template <class... TArgs>
+constexpr std::size_t string_interner<TArgs...>::kChunkSize;
+
+} // namespace hmm
+
+#endif // HMM_HMM_STRING_INTERNER_HPP
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <hmm/algorithm.hpp>
+#include <hmm/flat-hash-map.hpp>
+#include <hmm/flat-hash-set.hpp>
+#include <hmm/node-hash-map.hpp>
+#include <hmm/node-hash-set.hpp>
+
+// Std
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::flat_hash_map;
+using hmm::flat_hash_set;
+using hmm::node_hash_map;
+using hmm::node_hash_set;
+using hmm::thread_executor;
+using namespace hmm::testing;
+
+namespace execution = hmm::execution;
+
+// =========================================================================
+// 1. for_each
+// =========================================================================
+
+TEST(TableAlgorithmTest, ForEachVisitsEveryElement) {
+    flat_hash_map<int, int> map;
+    for (int i = 0; i < 100000; ++i) {
+        map.emplace(i, i);
+    }
+
+    std::atomic<long long> sum{0};
+    hmm::for_each(execution::par, map,
+                  [&](const std::pair<const int, int>& kv) {
+                      sum += kv.second;
+                  });
+    EXPECT_EQ(sum.load(), 100000LL * 99999 / 2);
+}
+
+TEST(TableAlgorithmTest, ForEachUpdatesMappedValues) {
+    node_hash_map<int, std::string> map;
+    for (int i = 0; i < 5000; ++i) {
+        map.emplace(i, "v");
+    }
+
+    thread_executor exec(4);
+    hmm::for_each(exec, map, [](std::pair<const int, std::string>& kv) {
+        kv.second += std::to_string(kv.first);
+    });
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(map.at(i), "v" + std::to_string(i));
+    }
+}
+
+TEST(TableAlgorithmTest, ForEachOnEmptyAndConstTables) {
+    const flat_hash_set<int> empty;
+    int calls = 0;
+    hmm::for_each(execution::seq, empty, [&](const int&) { ++calls; });
+    EXPECT_EQ(calls, 0);
+
+    const flat_hash_set<int> set{1, 2, 3};
+    hmm::for_each(execution::seq, set, [&](const int& v) { calls += v; });
+    EXPECT_EQ(calls, 6);
+}
+
+// =========================================================================
+// 2. count_if and reduce
+// =========================================================================
+
+TEST(TableAlgorithmTest, CountIfMatchesSerialCount) {
+    flat_hash_set<int> set;
+    for (int i = 0; i < 100000; ++i) {
+        set.insert(i * 3);
+    }
+
+    const auto even = [](int v) { return v % 2 == 0; };
+    std::size_t expected = 0;
+    for (int v : set) {
+        expected += even(v);
+    }
+    EXPECT_EQ(hmm::count_if(execution::par, set, even), expected);
+    EXPECT_EQ(hmm::count_if(execution::seq, set, even), expected);
+}
+
+TEST(TableAlgorithmTest, ReduceOverMappedValues) {
+    flat_hash_map<int, long long> map;
+    for (int i = 1; i <= 100000; ++i) {
+        map.emplace(i, i);
+    }
+
+    thread_executor exec(4);
+    const auto sum = hmm::reduce(
+        exec, map, 10LL, [](long long a, long long b) { return a + b; });
+    EXPECT_EQ(sum, 10 + 100000LL * 100001 / 2);
+}
+
+TEST(TableAlgorithmTest, ReduceOverSetElements) {
+    node_hash_set<std::string> set{"a", "bb", "ccc"};
+    const auto longest = hmm::reduce(
+        execution::par, set, std::string(),
+        [](const std::string& a, const std::string& b) {
+            return a.size() >= b.size() ? a : b;
+        });
+    EXPECT_EQ(longest, "ccc");
+
+    const flat_hash_set<int> empty;
+    EXPECT_EQ(hmm::reduce(execution::par, empty, 42,
+                          [](int a, int b) { return a + b; }),
+              42);
+}
+
+// =========================================================================
+// 3. erase_if
+// =========================================================================
+
+TEST(TableAlgorithmTest, EraseIfRemovesMatches) {
+    flat_hash_map<int, std::string> map;
+    for (int i = 0; i < 100000; ++i) {
+        map.emplace(i, std::to_string(i));
+    }
+
+    const auto erased =
+        hmm::erase_if(execution::par, map,
+                      [](const std::pair<const int, std::string>& kv) {
+                          return kv.first % 3 == 0;
+                      });
+    EXPECT_EQ(erased, 33334);
+    EXPECT_EQ(map.size(), 100000 - 33334);
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(map.contains(i), i % 3 != 0);
+    }
+
+    // The tombstones are reused as the table fills up again.
+    for (int i = 0; i < 100000; i += 3) {
+        map.emplace(i, "again");
+    }
+    EXPECT_EQ(map.size(), 100000);
+}
+
+TEST(TableAlgorithmTest, EraseIfDestroysElements) {
+    LifecycleTracker::reset();
+    {
+        flat_hash_set<LifecycleTracker, LifecycleHasher> set;
+        for (int i = 0; i < 1000; ++i) {
+            set.emplace(i);
+        }
+        // The tracker counts are not atomic, so stay on one thread.
+        const auto erased =
+            hmm::erase_if(execution::seq, set, [](const LifecycleTracker& t) {
+                return t.val < 250;
+            });
+        EXPECT_EQ(erased, 250);
+        EXPECT_EQ(set.size(), 750);
+        EXPECT_EQ(LifecycleTracker::constructions -
+                      LifecycleTracker::destructions,
+                  750);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
+
+TEST(TableAlgorithmTest, EraseIfThrowingPredicateKeepsCounts) {
+    flat_hash_set<int> set;
+    for (int i = 0; i < 10000; ++i) {
+        set.insert(i);
+    }
+
+    EXPECT_THROW(hmm::erase_if(execution::par, set,
+                               [](int v) {
+                                   if (v == 5000) {
+                                       throw std::runtime_error("pred");
+                                   }
+                                   return v % 2 == 0;
+                               }),
+                 std::runtime_error);
+
+    std::size_t n = 0;
+    for (auto it = set.begin(); it != set.end(); ++it) {
+        ++n;
+    }
+    EXPECT_EQ(n, set.size());
+    EXPECT_TRUE(set.contains(5000));
+}
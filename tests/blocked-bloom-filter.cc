@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <hmm/blocked-bloom-filter.hpp>
+
+// Std
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "test-shared.hpp"
+
+using hmm::blocked_bloom_filter;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Counts the false positives among `probes` keys that were never
+/// inserted, starting at `first`.
+template <class Filter>
+std::size_t FalsePositives(const Filter& filter, int first, int probes) {
+    std::size_t hits = 0;
+    for (int i = first; i < first + probes; ++i) {
+        hits += filter.contains(i) ? 1 : 0;
+    }
+    return hits;
+}
+
+} // namespace
+
+// =========================================================================
+// 1. Membership
+// =========================================================================
+
+TEST(BlockedBloomFilterTest, EmptyFilterRejectsEverything) {
+    const blocked_bloom_filter<int> filter(1000);
+    EXPECT_EQ(FalsePositives(filter, 0, 10000), 0);
+}
+
+TEST(BlockedBloomFilterTest, NoFalseNegatives) {
+    blocked_bloom_filter<int> filter(100000);
+    for (int i = 0; i < 100000; ++i) {
+        filter.insert(i * 7);
+    }
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_TRUE(filter.contains(i * 7));
+    }
+}
+
+TEST(BlockedBloomFilterTest, Strings) {
+    blocked_bloom_filter<std::string> filter(1000);
+    for (int i = 0; i < 1000; ++i) {
+        filter.insert("key-" + std::to_string(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(filter.contains("key-" + std::to_string(i)));
+    }
+    EXPECT_LT(filter.contains("absent") + filter.contains("missing"), 2);
+}
+
+TEST(BlockedBloomFilterTest, HashedEntryPointsMatchKeyed) {
+    blocked_bloom_filter<int> filter(1000);
+    const hmm::CityHash<int> hash;
+    filter.insert_hash(hash(42));
+    EXPECT_TRUE(filter.contains(42));
+    filter.insert(43);
+    EXPECT_TRUE(filter.contains_hash(hash(43)));
+}
+
+// =========================================================================
+// 2. False Positive Rate
+// =========================================================================
+
+TEST(BlockedBloomFilterTest, RateNearTarget) {
+    for (double fpp : {0.05, 0.01, 0.001}) {
+        blocked_bloom_filter<int> filter(100000, fpp);
+        for (int i = 0; i < 100000; ++i) {
+            filter.insert(i);
+        }
+        const double rate =
+            static_cast<double>(FalsePositives(filter, 1 << 24, 200000)) /
+            200000;
+        EXPECT_LT(rate, fpp * 2) << "target " << fpp;
+    }
+}
+
+TEST(BlockedBloomFilterTest, LowerRateUsesMoreBlocks) {
+    const blocked_bloom_filter<int> loose(10000, 0.05);
+    const blocked_bloom_filter<int> tight(10000, 0.001);
+    EXPECT_LT(loose.block_count(), tight.block_count());
+    EXPECT_GE(tight.memory_usage(), tight.block_count() * 64);
+}
+
+TEST(BlockedBloomFilterTest, OverfullFilterDegradesGracefully) {
+    blocked_bloom_filter<int> filter(100);
+    for (int i = 0; i < 10000; ++i) {
+        filter.insert(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(filter.contains(i));
+    }
+}
+
+TEST(BlockedBloomFilterTest, InvalidRateThrows) {
+    using Filter = blocked_bloom_filter<int>;
+    EXPECT_THROW(Filter(10, 0.0), std::invalid_argument);
+    EXPECT_THROW(Filter(10, 1.0), std::invalid_argument);
+}
+
+// =========================================================================
+// 3. Clear, Reset and Copies
+// =========================================================================
+
+TEST(BlockedBloomFilterTest, ClearAndReset) {
+    blocked_bloom_filter<int> filter(1000);
+    for (int i = 0; i < 1000; ++i) {
+        filter.insert(i);
+    }
+    filter.clear();
+    EXPECT_EQ(FalsePositives(filter, 0, 1000), 0);
+
+    filter.reset(50000);
+    EXPECT_EQ(filter.capacity(), 50000);
+    EXPECT_EQ(FalsePositives(filter, 0, 1000), 0);
+}
+
+TEST(BlockedBloomFilterTest, CopiesAndMoves) {
+    blocked_bloom_filter<int> filter(5000);
+    for (int i = 0; i < 5000; ++i) {
+        filter.insert(i);
+    }
+
+    blocked_bloom_filter<int> copy(filter);
+    blocked_bloom_filter<int> assigned;
+    assigned = copy;
+    blocked_bloom_filter<int> moved(std::move(filter));
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(copy.contains(i));
+        ASSERT_TRUE(assigned.contains(i));
+        ASSERT_TRUE(moved.contains(i));
+    }
+    EXPECT_EQ(FalsePositives(copy, 1 << 24, 10000),
+              FalsePositives(moved, 1 << 24, 10000));
+}
+
+TEST(BlockedBloomFilterTest, CollidingHashStillCorrect) {
+    blocked_bloom_filter<int, BadHash> filter(100);
+    filter.insert(1);
+    EXPECT_TRUE(filter.contains(1));
+    EXPECT_TRUE(filter.contains(2));
+}
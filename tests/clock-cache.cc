@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <hmm/clock-cache.hpp>
+
+// Std
+#include <string>
+#include <utility>
+
+#include "test-shared.hpp"
+
+using hmm::clock_cache;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(ClockCacheTest, PutAndGet) {
+    clock_cache<std::string, int> cache(4);
+
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.capacity(), 4);
+    EXPECT_TRUE(cache.put("one", 1));
+    EXPECT_TRUE(cache.put("two", 2));
+    EXPECT_FALSE(cache.put("one", 10));
+
+    ASSERT_NE(cache.get("one"), nullptr);
+    EXPECT_EQ(*cache.get("one"), 10);
+    EXPECT_EQ(cache.get("three"), nullptr);
+    EXPECT_EQ(cache.size(), 2);
+
+    *cache.get("two") = 20;
+    EXPECT_EQ(*cache.peek("two"), 20);
+}
+
+TEST(ClockCacheTest, ReferencedEntriesGetSecondChance) {
+    clock_cache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+
+    // 1 is referenced, so the hand clears its bit and evicts 2 instead.
+    EXPECT_NE(cache.get(1), nullptr);
+    cache.put(4, 4);
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+
+    // Peeking sets no bit; 3 is next under the hand.
+    EXPECT_NE(cache.peek(3), nullptr);
+    cache.put(5, 5);
+    EXPECT_FALSE(cache.contains(3));
+
+    // 1 has used up its second chance.
+    cache.put(6, 6);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(4));
+    EXPECT_TRUE(cache.contains(5));
+    EXPECT_TRUE(cache.contains(6));
+}
+
+TEST(ClockCacheTest, AllReferencedEvictsUnderHand) {
+    clock_cache<int, int> cache(3);
+    for (int i = 0; i < 3; ++i) {
+        cache.put(i, i);
+        (void)cache.get(i);
+    }
+
+    // A full sweep clears every bit and comes back to the first entry.
+    cache.put(3, 3);
+    EXPECT_FALSE(cache.contains(0));
+    EXPECT_EQ(cache.size(), 3);
+}
+
+TEST(ClockCacheTest, EraseAndClear) {
+    clock_cache<int, std::string> cache(3);
+    cache.put(1, "a");
+    cache.put(2, "b");
+    cache.put(3, "c");
+
+    EXPECT_TRUE(cache.erase(2));
+    EXPECT_FALSE(cache.erase(2));
+
+    // The freed entry is reused without evicting.
+    cache.put(4, "d");
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    cache.put(5, "e");
+    EXPECT_EQ(*cache.get(5), "e");
+}
+
+TEST(ClockCacheTest, ZeroCapacity) {
+    clock_cache<int, int> cache(0);
+    EXPECT_FALSE(cache.put(1, 1));
+    EXPECT_EQ(cache.get(1), nullptr);
+    EXPECT_TRUE(cache.empty());
+}
+
+// =========================================================================
+// 2. Copy and Move
+// =========================================================================
+
+TEST(ClockCacheTest, CopyKeepsReferenceBits) {
+    clock_cache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    (void)cache.get(1);
+
+    clock_cache<int, int> copy(cache);
+    copy.put(4, 4);
+    EXPECT_TRUE(copy.contains(1));
+    EXPECT_FALSE(copy.contains(2));
+    EXPECT_TRUE(cache.contains(2));
+
+    clock_cache<int, int> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(copy.capacity(), 0);
+    EXPECT_FALSE(copy.put(9, 9));
+}
+
+// =========================================================================
+// 3. Stress
+// =========================================================================
+
+TEST(ClockCacheTest, ChurnKeepsEntriesConsistent) {
+    clock_cache<int, int> cache(100);
+
+    unsigned state = 12345;
+    for (int step = 0; step < 100000; ++step) {
+        state = state * 1103515245u + 12345u;
+        const int key = static_cast<int>((state >> 8) % 1000);
+        if (step % 2 == 0) {
+            if (const int* value = cache.get(key)) {
+                ASSERT_EQ(*value, key * 3);
+            }
+        } else {
+            cache.put(key, key * 3);
+            ASSERT_TRUE(cache.contains(key));
+        }
+        ASSERT_LE(cache.size(), 100);
+    }
+
+    int count = 0;
+    cache.for_each([&](const auto& v) {
+        EXPECT_EQ(v.second, v.first * 3);
+        ++count;
+    });
+    EXPECT_EQ(count, 100);
+}
+
+// =========================================================================
+// 4. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(ClockCacheTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+    {
+        clock_cache<LifecycleTracker, int, LifecycleHasher> cache(16);
+        for (int i = 0; i < 1000; ++i) {
+            cache.put(LifecycleTracker(i), i);
+            if (i % 7 == 0) {
+                cache.erase(LifecycleTracker(i - 3));
+            }
+        }
+        clock_cache<LifecycleTracker, int, LifecycleHasher> copy(cache);
+        EXPECT_EQ(*copy.get(LifecycleTracker(999)), 999);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <hmm/concurrent-insert-map.hpp>
+
+// Std
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hmm::concurrent_insert_map;
+
+// =========================================================================
+// 1. Single-Threaded Behaviour
+// =========================================================================
+
+TEST(ConcurrentInsertMapTest, TryEmplaceAndFind) {
+    concurrent_insert_map<std::string, int> map(32);
+
+    auto first = map.try_emplace("a", 1);
+    EXPECT_TRUE(first.second);
+    auto again = map.try_emplace("a", 2);
+    EXPECT_FALSE(again.second);
+    EXPECT_EQ(first.first, again.first);
+    EXPECT_EQ(*again.first, 1);
+
+    EXPECT_TRUE(map.insert({"b", 2}));
+    ASSERT_NE(map.find("b"), nullptr);
+    EXPECT_EQ(*map.find("b"), 2);
+    EXPECT_EQ(map.find("c"), nullptr);
+}
+
+// =========================================================================
+// 2. Concurrency Stress
+// =========================================================================
+
+TEST(ConcurrentInsertMapTest, ConcurrentCountersOnStablePointers) {
+    const int threads = 8;
+    const int keys = 5000;
+    concurrent_insert_map<int, std::atomic<int>> map(keys);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < keys; ++i) {
+                map.try_emplace(i, 0).first->fetch_add(1);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(map.size(), keys);
+    for (int i = 0; i < keys; ++i) {
+        ASSERT_EQ(map.find(i)->load(), threads);
+    }
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <hmm/concurrent-insert-set.hpp>
+
+// Std
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::concurrent_insert_set;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Single-Threaded Behaviour
+// =========================================================================
+
+TEST(ConcurrentInsertSetTest, InsertAndContains) {
+    concurrent_insert_set<std::string> set(16);
+
+    EXPECT_TRUE(set.insert("a"));
+    EXPECT_FALSE(set.insert("a"));
+    EXPECT_TRUE(set.emplace(3, 'b'));
+    EXPECT_TRUE(set.contains("bbb"));
+    EXPECT_FALSE(set.contains("c"));
+    EXPECT_EQ(set.size(), 2);
+}
+
+TEST(ConcurrentInsertSetTest, FullSetThrows) {
+    concurrent_insert_set<int> set(14);
+    EXPECT_EQ(set.capacity(), 16);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_TRUE(set.insert(i));
+    }
+    EXPECT_FALSE(set.insert(3));
+    EXPECT_THROW(set.insert(16), std::length_error);
+}
+
+TEST(ConcurrentInsertSetTest, ReserveKeepsElements) {
+    concurrent_insert_set<int, BadHash> set(8);
+    for (int i = 0; i < 16; ++i) {
+        set.insert(i);
+    }
+    set.reserve(1000);
+    EXPECT_GE(set.capacity(), 1000);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_TRUE(set.contains(i));
+    }
+    EXPECT_TRUE(set.insert(16));
+    EXPECT_EQ(set.size(), 17);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(1));
+}
+
+// =========================================================================
+// 2. Concurrency Stress
+// =========================================================================
+
+TEST(ConcurrentInsertSetTest, NoDuplicatesUnderContention) {
+    const int threads = 16;
+    const std::uint64_t keys = 20000;
+    concurrent_insert_set<std::uint64_t> set(keys);
+
+    // Every thread inserts every key, in a thread-specific order, so each
+    // key is contended by all threads at once.
+    std::atomic<std::uint64_t> inserted{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::uint64_t mine = 0;
+            for (std::uint64_t i = 0; i < keys; ++i) {
+                mine += set.insert((i * 7919 + t) % keys) ? 1 : 0;
+            }
+            inserted += mine;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(inserted.load(), keys);
+    EXPECT_EQ(set.size(), keys);
+
+    std::vector<int> seen(keys, 0);
+    set.for_each([&](std::uint64_t key) { ++seen[key]; });
+    for (std::uint64_t i = 0; i < keys; ++i) {
+        ASSERT_EQ(seen[i], 1) << "key " << i;
+    }
+}
+
+TEST(ConcurrentInsertSetTest, NoDuplicatesUnderCollisions) {
+    // All keys share one probe sequence, maximizing races on the same bytes
+    const int threads = 8;
+    concurrent_insert_set<int, BadHash> set(256);
+
+    std::atomic<int> inserted{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 200; ++i) {
+                inserted += set.insert(i) ? 1 : 0;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(inserted.load(), 200);
+    EXPECT_EQ(set.size(), 200);
+}
+
+// =========================================================================
+// 3. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(ConcurrentInsertSetTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+
+    {
+        concurrent_insert_set<LifecycleTracker, LifecycleHasher> set(8);
+        for (int i = 0; i < 8; ++i) {
+            set.emplace(i);
+            set.emplace(i); // Duplicate
+        }
+        set.reserve(100);
+        EXPECT_EQ(set.size(), 8);
+    }
+
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <hmm/cuckoo-filter.hpp>
+
+// Std
+#include <cstddef>
+#include <string>
+
+#include "test-shared.hpp"
+
+using hmm::cuckoo_filter;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Membership
+// =========================================================================
+
+TEST(CuckooFilterTest, EmptyFilterRejectsEverything) {
+    const cuckoo_filter<int> filter(1000);
+    EXPECT_TRUE(filter.empty());
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_FALSE(filter.contains(i));
+    }
+}
+
+TEST(CuckooFilterTest, NoFalseNegativesAtCapacity) {
+    cuckoo_filter<int> filter(100000);
+    const auto n = static_cast<int>(filter.capacity());
+    int stored = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!filter.insert(i)) {
+            break;
+        }
+        ++stored;
+    }
+    // Cuckoo filters with buckets of four reliably fill past 95%.
+    EXPECT_EQ(stored, n);
+    EXPECT_EQ(filter.size(), static_cast<std::size_t>(n));
+    for (int i = 0; i < stored; ++i) {
+        ASSERT_TRUE(filter.contains(i));
+    }
+}
+
+TEST(CuckooFilterTest, LowFalsePositiveRate) {
+    cuckoo_filter<int> filter(100000);
+    for (int i = 0; i < 90000; ++i) {
+        ASSERT_TRUE(filter.insert(i));
+    }
+    std::size_t hits = 0;
+    for (int i = 1 << 24; i < (1 << 24) + 200000; ++i) {
+        hits += filter.contains(i) ? 1 : 0;
+    }
+    // About 8 lanes checked per lookup, at 2^-16 each.
+    EXPECT_LT(hits, 200000 / 1000);
+}
+
+TEST(CuckooFilterTest, Strings) {
+    cuckoo_filter<std::string> filter(100);
+    EXPECT_TRUE(filter.insert("alpha"));
+    EXPECT_TRUE(filter.insert("beta"));
+    EXPECT_TRUE(filter.contains("alpha"));
+    EXPECT_TRUE(filter.contains("beta"));
+    EXPECT_FALSE(filter.contains("gamma"));
+}
+
+// =========================================================================
+// 2. Deletion
+// =========================================================================
+
+TEST(CuckooFilterTest, EraseRemovesKeys) {
+    cuckoo_filter<int> filter(10000);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(filter.insert(i));
+    }
+    for (int i = 0; i < 10000; i += 2) {
+        ASSERT_TRUE(filter.erase(i));
+    }
+    EXPECT_EQ(filter.size(), 5000);
+    std::size_t lingering = 0;
+    for (int i = 0; i < 10000; ++i) {
+        if (i % 2 == 1) {
+            ASSERT_TRUE(filter.contains(i));
+        } else {
+            lingering += filter.contains(i) ? 1 : 0;
+        }
+    }
+    EXPECT_LT(lingering, 10);
+}
+
+TEST(CuckooFilterTest, DuplicatesNeedOneEraseEach) {
+    cuckoo_filter<int> filter(100);
+    filter.insert(7);
+    filter.insert(7);
+    EXPECT_EQ(filter.size(), 2);
+    EXPECT_TRUE(filter.erase(7));
+    EXPECT_TRUE(filter.contains(7));
+    EXPECT_TRUE(filter.erase(7));
+    EXPECT_FALSE(filter.contains(7));
+    EXPECT_FALSE(filter.erase(7));
+}
+
+// =========================================================================
+// 3. Overflow
+// =========================================================================
+
+TEST(CuckooFilterTest, FullFilterRefusesAndKeepsKeys) {
+    // Every key has the same two buckets, so eight lanes plus the victim.
+    cuckoo_filter<int, BadHash> filter(1000);
+    int stored = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (!filter.insert(i)) {
+            break;
+        }
+        ++stored;
+    }
+    EXPECT_LE(stored, 9);
+    EXPECT_EQ(filter.size(), static_cast<std::size_t>(stored));
+    EXPECT_TRUE(filter.contains(0));
+
+    // Erasing frees a lane and gives the victim a home again.
+    EXPECT_TRUE(filter.erase(0));
+    EXPECT_TRUE(filter.insert(0));
+    EXPECT_TRUE(filter.contains(0));
+}
+
+TEST(CuckooFilterTest, ClearAndReset) {
+    cuckoo_filter<int> filter(100);
+    for (int i = 0; i < 50; ++i) {
+        filter.insert(i);
+    }
+    filter.clear();
+    EXPECT_TRUE(filter.empty());
+    EXPECT_FALSE(filter.contains(1));
+
+    filter.reset(100000);
+    EXPECT_GE(filter.capacity(), 100000);
+    EXPECT_EQ(filter.memory_usage(), filter.bucket_count() * 8);
+}
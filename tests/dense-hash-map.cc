@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+
+#include <hmm/dense-hash-map.hpp>
+
+// Std
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::dense_hash_map;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Construction and Assignment
+// =========================================================================
+
+TEST(DenseHashMapTest, DefaultConstruction) {
+    dense_hash_map<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(DenseHashMapTest, CopyConstruction) {
+    dense_hash_map<int, std::string> original{{1, "One"}, {2, "Two"}};
+    dense_hash_map<int, std::string> copy = original;
+
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy.at(1), "One");
+
+    // The copy must resolve lookups through its own entries
+    copy[1] = "Uno";
+    EXPECT_EQ(original.at(1), "One");
+    EXPECT_EQ(copy.at(1), "Uno");
+}
+
+TEST(DenseHashMapTest, MoveConstruction) {
+    dense_hash_map<std::string, int> source{{"key", 1}};
+    dense_hash_map<std::string, int> dest = std::move(source);
+
+    EXPECT_EQ(dest.size(), 1);
+    EXPECT_EQ(dest.at("key"), 1);
+    EXPECT_TRUE(source.empty());
+
+    // Grow the moved-to map, which rehashes through the rebound index
+    for (int i = 0; i < 100; ++i) {
+        dest[std::to_string(i)] = i;
+    }
+    EXPECT_EQ(dest.at("42"), 42);
+}
+
+// =========================================================================
+// 2. Insertion Order
+// =========================================================================
+
+TEST(DenseHashMapTest, IteratesInInsertionOrder) {
+    dense_hash_map<int, int> map;
+    const std::vector<int> keys = {42, 7, 1000, -3, 19, 64, 5};
+    for (int key : keys) {
+        map[key] = key * 2;
+    }
+
+    std::vector<int> seen;
+    for (const auto& pair : map) {
+        EXPECT_EQ(pair.second, pair.first * 2);
+        seen.push_back(pair.first);
+    }
+    EXPECT_EQ(seen, keys);
+}
+
+TEST(DenseHashMapTest, DuplicateInsertKeepsFirst) {
+    dense_hash_map<int, std::string> map;
+    EXPECT_TRUE(map.insert({1, "first"}).second);
+    EXPECT_FALSE(map.insert({1, "second"}).second);
+    EXPECT_FALSE(map.emplace(1, "third").second);
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at(1), "first");
+}
+
+// =========================================================================
+// 3. Erasure
+// =========================================================================
+
+TEST(DenseHashMapTest, EraseMovesLastEntryIntoHole) {
+    dense_hash_map<int, int> map{{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_EQ(map.erase(2), 0);
+    EXPECT_EQ(map.size(), 3);
+
+    std::vector<int> seen;
+    for (const auto& pair : map) {
+        seen.push_back(pair.first);
+    }
+    EXPECT_EQ(seen, (std::vector<int>{1, 4, 3}));
+
+    // The moved entry must still be reachable by key
+    EXPECT_EQ(map.at(4), 40);
+    EXPECT_EQ(map.at(3), 30);
+}
+
+TEST(DenseHashMapTest, EraseByIterator) {
+    dense_hash_map<int, int> map{{1, 10}, {2, 20}, {3, 30}};
+
+    auto it = map.erase(map.find(1));
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, 3);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST(DenseHashMapTest, InsertEraseChurn) {
+    dense_hash_map<int, int> map;
+
+    // Every erase tombstones an index slot; the table must keep purging them
+    for (int i = 0; i < 10000; ++i) {
+        map[i] = i;
+        if (i >= 8) {
+            EXPECT_EQ(map.erase(i - 8), 1);
+        }
+    }
+
+    EXPECT_EQ(map.size(), 8);
+    for (int i = 9992; i < 10000; ++i) {
+        EXPECT_EQ(map.at(i), i);
+    }
+}
+
+// =========================================================================
+// 4. Stress and Collision Resolution
+// =========================================================================
+
+TEST(DenseHashMapTest, AutomaticResizing) {
+    dense_hash_map<int, int> map;
+    const int limit = 1000;
+
+    for (int i = 0; i < limit; ++i) {
+        map[i] = i;
+    }
+
+    EXPECT_EQ(map.size(), limit);
+    for (int i = 0; i < limit; ++i) {
+        EXPECT_EQ(map.at(i), i);
+    }
+    EXPECT_THROW((void)map.at(limit), std::out_of_range);
+}
+
+TEST(DenseHashMapTest, MassiveCollisions) {
+    dense_hash_map<int, int, BadHash> map;
+    for (int i = 0; i < 50; ++i) {
+        map[i] = i;
+    }
+
+    EXPECT_EQ(map.erase(25), 1);
+    EXPECT_FALSE(map.contains(25));
+    for (int i = 0; i < 50; ++i) {
+        if (i != 25) {
+            EXPECT_EQ(map.at(i), i);
+        }
+    }
+}
+
+// =========================================================================
+// 5. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(DenseHashMapTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+
+    {
+        dense_hash_map<int, LifecycleTracker> map;
+        map.try_emplace(1, 10);
+        map.try_emplace(2, 20);
+        map.try_emplace(1, 30); // Duplicate
+        map.erase(1);
+
+        EXPECT_EQ(map.size(), 1);
+    }
+
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
+
+// =========================================================================
+// 6. Exception Safety
+// =========================================================================
+
+namespace {
+
+/// @brief Counts live instances; moves throw while armed.
+struct ThrowingAssign {
+    static inline int live = 0;
+    static inline bool armed = false;
+
+    int val;
+
+    explicit ThrowingAssign(int v) : val(v) {
+        ++live;
+    }
+    ThrowingAssign(const ThrowingAssign& other) : val(other.val) {
+        ++live;
+    }
+    ThrowingAssign(ThrowingAssign&& other) : val(other.val) {
+        if (armed) {
+            throw std::runtime_error("move");
+        }
+        ++live;
+    }
+    ThrowingAssign& operator=(ThrowingAssign&& other) {
+        if (armed) {
+            throw std::runtime_error("assign");
+        }
+        val = other.val;
+        return *this;
+    }
+    ~ThrowingAssign() {
+        --live;
+    }
+};
+
+/// @brief Throws when asked to hash one chosen key.
+struct ThrowingHash {
+    std::size_t operator()(int key) const {
+        if (key == 13) {
+            throw std::runtime_error("hash");
+        }
+        return std::hash<int>{}(key) * 0x9E3779B97F4A7C15ULL;
+    }
+};
+
+} // namespace
+
+TEST(DenseHashMapTest, ThrowingMoveOnEraseKeepsEntriesAlive) {
+    ThrowingAssign::live = 0;
+    {
+        dense_hash_map<int, ThrowingAssign> map;
+        for (int i = 0; i < 4; ++i) {
+            map.try_emplace(i, i * 10);
+        }
+
+        ThrowingAssign::armed = true;
+        EXPECT_THROW(map.erase(1), std::runtime_error);
+        ThrowingAssign::armed = false;
+
+        // The last entry was not moved and is still reachable.
+        EXPECT_EQ(map.at(3).val, 30);
+        EXPECT_EQ(map.at(0).val, 0);
+        EXPECT_FALSE(map.contains(1));
+    }
+    EXPECT_EQ(ThrowingAssign::live, 0);
+}
+
+TEST(DenseHashMapTest, ThrowingHashOnEmplaceLeavesNoEntry) {
+    dense_hash_map<int, int, ThrowingHash> map;
+    // Cross several index growths, which must happen before the append.
+    for (int i = 0; i < 100; ++i) {
+        if (i != 13) {
+            map.emplace(i, i);
+        }
+        EXPECT_THROW(map.emplace(13, 0), std::runtime_error);
+    }
+
+    EXPECT_EQ(map.size(), 99);
+    std::size_t n = 0;
+    for (const auto& pair : map) {
+        EXPECT_EQ(map.at(pair.first), pair.second);
+        ++n;
+    }
+    EXPECT_EQ(n, 99);
+}
@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+
+#include <hmm/expiring-hash-map.hpp>
+
+// Std
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::expiring_hash_map;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(ExpiringHashMapTest, ExpiresAtDeadline) {
+    expiring_hash_map<std::string, int> map;
+
+    EXPECT_TRUE(map.insert_or_assign("a", 1, 10));
+    EXPECT_TRUE(map.insert_or_assign("b", 2, 20));
+    EXPECT_FALSE(map.insert_or_assign("a", 3, 15));
+    EXPECT_EQ(*map.find("a"), 3);
+    EXPECT_EQ(map.deadline("a", 0), 15);
+
+    EXPECT_EQ(map.advance(14), 0);
+    EXPECT_EQ(map.now(), 14);
+    EXPECT_TRUE(map.contains("a"));
+
+    EXPECT_EQ(map.advance(15), 1);
+    EXPECT_FALSE(map.contains("a"));
+    EXPECT_TRUE(map.contains("b"));
+
+    EXPECT_EQ(map.advance(1000), 1);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.now(), 1000);
+}
+
+TEST(ExpiringHashMapTest, RescheduleAndErase) {
+    expiring_hash_map<int, int> map;
+    map.insert_or_assign(1, 10, 100);
+    map.insert_or_assign(2, 20, 100);
+    map.insert_or_assign(3, 30, 100);
+
+    EXPECT_TRUE(map.expire_at(1, 5000));
+    EXPECT_FALSE(map.expire_at(4, 5000));
+    EXPECT_TRUE(map.erase(2));
+    EXPECT_FALSE(map.erase(2));
+
+    EXPECT_EQ(map.advance(100), 1);
+    EXPECT_TRUE(map.contains(1));
+    EXPECT_FALSE(map.contains(3));
+
+    EXPECT_EQ(map.advance(4999), 0);
+    EXPECT_EQ(map.advance(5000), 1);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ExpiringHashMapTest, PastDeadlinesExpireOnNextAdvance) {
+    expiring_hash_map<int, int> map(50);
+    map.insert_or_assign(1, 1, 10);
+    map.insert_or_assign(2, 2, 50);
+
+    EXPECT_TRUE(map.contains(1));
+    EXPECT_EQ(map.advance(50), 2);
+    EXPECT_TRUE(map.empty());
+
+    // Time never moves backwards.
+    map.insert_or_assign(3, 3, 60);
+    EXPECT_EQ(map.advance(40), 0);
+    EXPECT_EQ(map.now(), 50);
+}
+
+TEST(ExpiringHashMapTest, CallbackSeesEntriesInDeadlineOrder) {
+    expiring_hash_map<int, std::string> map;
+    const std::vector<std::uint64_t> deadlines = {
+        70000, 3, 64, 4096, 63, 262144, 65, 1u << 30, 4095, 1};
+    for (std::size_t i = 0; i < deadlines.size(); ++i) {
+        map.insert_or_assign(static_cast<int>(i), std::to_string(i),
+                             deadlines[i]);
+    }
+
+    std::vector<std::uint64_t> seen;
+    EXPECT_EQ(map.advance(std::uint64_t(1) << 31,
+                          [&](std::pair<int, std::string>& v) {
+                              seen.push_back(deadlines[v.first]);
+                              EXPECT_EQ(v.second, std::to_string(v.first));
+                          }),
+              deadlines.size());
+
+    std::vector<std::uint64_t> sorted = deadlines;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(seen, sorted);
+}
+
+TEST(ExpiringHashMapTest, ThrowingCallbackKeepsEntries) {
+    expiring_hash_map<int, int> map;
+    for (int i = 0; i < 4; ++i) {
+        map.insert_or_assign(i, i, 10);
+    }
+
+    int calls = 0;
+    EXPECT_THROW(map.advance(20,
+                             [&](std::pair<int, int>&) {
+                                 if (++calls == 2) {
+                                     throw std::runtime_error("boom");
+                                 }
+                             }),
+                 std::runtime_error);
+    EXPECT_EQ(map.size(), 3);
+
+    EXPECT_EQ(map.advance(20), 3);
+    EXPECT_TRUE(map.empty());
+}
+
+// =========================================================================
+// 2. Matches a Reference Model
+// =========================================================================
+
+TEST(ExpiringHashMapTest, MatchesReferenceModel) {
+    // Start far from zero, so that deadlines cross high level boundaries.
+    const std::uint64_t start = (std::uint64_t(1) << 40) - 1000;
+    expiring_hash_map<int, int> map(start);
+    std::map<int, std::uint64_t> model;
+
+    std::uint64_t state = 42;
+    auto next = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    };
+
+    std::uint64_t now = start;
+    for (int round = 0; round < 2000; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            const int key = static_cast<int>(next() % 2000);
+            // Mix short, long and overflowing time-to-lives.
+            const std::uint64_t ttl = next() % 4 == 0
+                                          ? next() % (std::uint64_t(1) << 28)
+                                          : next() % 5000;
+            switch (next() % 4) {
+            case 0:
+                ASSERT_EQ(map.erase(key), model.erase(key) == 1);
+                break;
+            case 1:
+                ASSERT_EQ(map.expire_at(key, now + ttl), model.count(key) == 1);
+                if (model.count(key)) {
+                    model[key] = now + ttl;
+                }
+                break;
+            default:
+                ASSERT_EQ(map.insert_or_assign(key, key, now + ttl),
+                          model.count(key) == 0);
+                model[key] = now + ttl;
+            }
+        }
+
+        now += next() % 3 == 0 ? next() % (std::uint64_t(1) << 26)
+                               : next() % 300;
+        std::vector<int> expired;
+        map.advance(now, [&](std::pair<int, int>& v) {
+            expired.push_back(v.first);
+        });
+        std::vector<int> expected;
+        for (auto it = model.begin(); it != model.end();) {
+            if (it->second <= now) {
+                expected.push_back(it->first);
+                it = model.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::sort(expired.begin(), expired.end());
+        ASSERT_EQ(expired, expected) << "round " << round;
+        ASSERT_EQ(map.size(), model.size());
+    }
+
+    for (const auto& kv : model) {
+        ASSERT_EQ(map.deadline(kv.first, 0), kv.second);
+    }
+}
+
+TEST(ExpiringHashMapTest, LargestDeadline) {
+    const auto max = std::numeric_limits<std::uint64_t>::max();
+    expiring_hash_map<int, int> map(max - 10);
+    map.insert_or_assign(1, 1, max);
+    map.insert_or_assign(2, 2, max - 5);
+
+    EXPECT_EQ(map.advance(max - 5), 1);
+    EXPECT_EQ(map.advance(max), 1);
+    EXPECT_EQ(map.advance(max), 0);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ExpiringHashMapTest, EmptiedOverflowKeepsExpiring) {
+    // R is one rotation of the top level.
+    const std::uint64_t R = std::uint64_t(1) << 24;
+    expiring_hash_map<int, int> map;
+
+    // The only overflow entry leaves before its rotation is reached.
+    map.insert_or_assign(1, 1, 2 * R + 5);
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_EQ(map.advance(3 * R + 100), 0);
+
+    map.insert_or_assign(2, 2, 8 * R);
+    map.insert_or_assign(3, 3, 3 * R + 110);
+    EXPECT_EQ(map.advance(3 * R + 200), 1);
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.advance(8 * R), 1);
+    EXPECT_TRUE(map.empty());
+}
+
+// =========================================================================
+// 3. Copy, Move and Clear
+// =========================================================================
+
+TEST(ExpiringHashMapTest, CopyMoveAndClear) {
+    expiring_hash_map<int, std::string> map;
+    for (int i = 0; i < 100; ++i) {
+        map.insert_or_assign(i, std::to_string(i), 10 + i);
+    }
+
+    expiring_hash_map<int, std::string> copy(map);
+    EXPECT_EQ(copy.advance(59), 50);
+    EXPECT_EQ(map.size(), 100);
+
+    expiring_hash_map<int, std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 50);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(copy.advance(1000), 0);
+    EXPECT_EQ(moved.advance(1000), 50);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.advance(1000), 0);
+    map.insert_or_assign(1, "one", 1001);
+    EXPECT_EQ(map.advance(1001), 1);
+}
+
+// =========================================================================
+// 4. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(ExpiringHashMapTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+    {
+        expiring_hash_map<LifecycleTracker, int, LifecycleHasher> map;
+        for (int i = 0; i < 1000; ++i) {
+            map.insert_or_assign(LifecycleTracker(i), i, i % 50 + 1);
+            if (i % 100 == 0) {
+                map.advance(i / 100);
+            }
+        }
+        map.erase(LifecycleTracker(999));
+        EXPECT_GT(map.advance(25), 0);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
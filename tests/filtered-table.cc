@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <hmm/cuckoo-filter.hpp>
+#include <hmm/filtered-table.hpp>
+#include <hmm/flat-hash-map.hpp>
+#include <hmm/flat-hash-set.hpp>
+#include <hmm/node-hash-map.hpp>
+
+// Std
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "test-shared.hpp"
+
+using hmm::cuckoo_filter;
+using hmm::filtered_table;
+using hmm::flat_hash_map;
+using hmm::flat_hash_set;
+using hmm::node_hash_map;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Counts the calls made to the hasher.
+struct CountingHash {
+    static inline int calls = 0;
+
+    std::size_t operator()(int key) const {
+        ++calls;
+        return hmm::CityHash<int>{}(key);
+    }
+};
+
+} // namespace
+
+// =========================================================================
+// 1. Bloom Filter in Front of a Set
+// =========================================================================
+
+TEST(FilteredTableTest, SetInsertFindErase) {
+    filtered_table<flat_hash_set<int>> set(1000);
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(set.insert(i).second);
+    }
+    EXPECT_FALSE(set.insert(10).second);
+    EXPECT_EQ(set.size(), 5000);
+
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(set.contains(i));
+        ASSERT_EQ(*set.find(i), i);
+    }
+    for (int i = 5000; i < 10000; ++i) {
+        ASSERT_FALSE(set.contains(i));
+    }
+
+    EXPECT_EQ(set.erase(3), 1);
+    EXPECT_EQ(set.erase(3), 0);
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_EQ(set.size(), 4999);
+}
+
+TEST(FilteredTableTest, FilterGrowsWithTable) {
+    filtered_table<flat_hash_set<int>> set;
+    for (int i = 0; i < 100000; ++i) {
+        set.insert(i);
+    }
+    EXPECT_GE(set.filter().capacity(), set.size());
+
+    std::size_t passed = 0;
+    for (int i = 1 << 24; i < (1 << 24) + 100000; ++i) {
+        passed += set.filter().contains_hash(hmm::CityHash<int>{}(i)) ? 1 : 0;
+    }
+    EXPECT_LT(passed, 100000 / 50);
+}
+
+TEST(FilteredTableTest, HashesEachKeyOnce) {
+    filtered_table<flat_hash_set<int, CountingHash>> set(100);
+    for (int i = 0; i < 50; ++i) {
+        set.insert(i);
+    }
+
+    CountingHash::calls = 0;
+    EXPECT_TRUE(set.contains(7));
+    EXPECT_FALSE(set.contains(1000));
+    EXPECT_EQ(CountingHash::calls, 2);
+
+    CountingHash::calls = 0;
+    set.insert(51);
+    EXPECT_EQ(CountingHash::calls, 1);
+}
+
+TEST(FilteredTableTest, DuplicatesNeverGrowTheTable) {
+    filtered_table<flat_hash_set<int>> set;
+    set.insert(0);
+    for (int i = 1; i < 1000; ++i) {
+        // At every fill level, including a full table, a duplicate only
+        // finds the key.
+        const auto capacity = set.table().capacity();
+        ASSERT_FALSE(set.insert(0).second);
+        ASSERT_EQ(set.table().capacity(), capacity) << i;
+        set.insert(i);
+    }
+}
+
+TEST(FilteredTableTest, StaleKeysTriggerRebuild) {
+    filtered_table<flat_hash_set<int>> set(1000);
+    for (int i = 0; i < 1000; ++i) {
+        set.insert(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(set.erase(i), 1);
+    }
+    EXPECT_TRUE(set.empty());
+    // The filter was rebuilt from the empty table, so nothing gets through.
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(set.filter().contains_hash(hmm::CityHash<int>{}(i)));
+    }
+}
+
+// =========================================================================
+// 2. Other Tables and Filters
+// =========================================================================
+
+TEST(FilteredTableTest, MapWithCuckooFilter) {
+    using Map = flat_hash_map<int, std::string>;
+    filtered_table<Map, cuckoo_filter<int>> map(100);
+    for (int i = 0; i < 2000; ++i) {
+        map.emplace(i, std::to_string(i));
+    }
+    EXPECT_EQ(map.find(1234)->second, "1234");
+    map.find(1234)->second = "x";
+    EXPECT_EQ(map.table().find(1234)->second, "x");
+
+    for (int i = 0; i < 2000; i += 2) {
+        ASSERT_EQ(map.erase(i), 1);
+    }
+    EXPECT_EQ(map.filter().size(), 1000);
+    for (int i = 1; i < 2000; i += 2) {
+        ASSERT_TRUE(map.contains(i));
+    }
+    EXPECT_EQ(map.count(2), 0);
+}
+
+TEST(FilteredTableTest, CollidingHashesBypassCuckooFilter) {
+    // A cuckoo filter holds at most nine copies of one hash, however large
+    // it grows, so the adapter stops consulting it.
+    filtered_table<flat_hash_set<int, BadHash>, cuckoo_filter<int, BadHash>>
+        set(16);
+    for (int i = 0; i < 9; ++i) {
+        set.insert(i);
+    }
+    EXPECT_FALSE(set.bypassed());
+    for (int i = 9; i < 40; ++i) {
+        set.insert(i);
+    }
+    EXPECT_TRUE(set.bypassed());
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_TRUE(set.contains(i));
+    }
+    EXPECT_FALSE(set.contains(40));
+
+    set.clear();
+    EXPECT_FALSE(set.bypassed());
+    set.insert(1);
+    EXPECT_TRUE(set.contains(1));
+}
+
+TEST(FilteredTableTest, AdoptsExistingTable) {
+    node_hash_map<int, int> source;
+    for (int i = 0; i < 3000; ++i) {
+        source.emplace(i, -i);
+    }
+    filtered_table<node_hash_map<int, int>> map(std::move(source));
+    EXPECT_EQ(map.size(), 3000);
+    EXPECT_EQ(map.find(2999)->second, -2999);
+    EXPECT_FALSE(map.contains(3000));
+}
+
+TEST(FilteredTableTest, TracksLifecycles) {
+    LifecycleTracker::reset();
+    {
+        filtered_table<flat_hash_set<LifecycleTracker, LifecycleHasher>> set;
+        for (int i = 0; i < 500; ++i) {
+            set.emplace(i);
+        }
+        set.emplace(3);
+        EXPECT_EQ(set.size(), 500);
+        EXPECT_TRUE(set.contains(LifecycleTracker(10)));
+        set.erase(LifecycleTracker(10));
+        set.clear();
+        EXPECT_FALSE(set.contains(LifecycleTracker(11)));
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <hmm/fixed-flat-hash-map.hpp>
+
+// Std
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::fixed_flat_hash_map;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Sizing From the Buffer
+// =========================================================================
+
+TEST(FixedFlatHashMapTest, CapacityFitsBuffer) {
+    using Map = fixed_flat_hash_map<int, int>;
+    std::vector<unsigned char> buffer(Map::buffer_size(1000));
+    Map map(buffer.data(), buffer.size());
+    EXPECT_EQ(map.capacity(), 2048);
+    EXPECT_EQ(map.max_size(), 1792);
+    EXPECT_GE(map.max_size(), 1000);
+
+    // The size includes slack for aligning the slots; without it the
+    // capacity rounds down.
+    Map smaller(buffer.data(), buffer.size() - alignof(int));
+    EXPECT_EQ(smaller.capacity(), 1024);
+}
+
+TEST(FixedFlatHashMapTest, TinyBufferIsAlwaysFull) {
+    unsigned char buffer[8];
+    fixed_flat_hash_map<int, int> map(buffer, sizeof(buffer));
+    EXPECT_EQ(map.capacity(), 0);
+    EXPECT_TRUE(map.full());
+    EXPECT_EQ(map.try_emplace(1, 1).first, map.end());
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(FixedFlatHashMapTest, ElementsLiveInTheBuffer) {
+    using Map = fixed_flat_hash_map<std::uint64_t, double>;
+    std::vector<unsigned char> buffer(Map::buffer_size(100) + 3);
+    // Misalign the start on purpose.
+    Map map(buffer.data() + 3, buffer.size() - 3);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        map.try_emplace(i, 0.5);
+    }
+    for (const auto& kv : map) {
+        const auto* p = reinterpret_cast<const unsigned char*>(&kv);
+        ASSERT_GE(p, buffer.data());
+        ASSERT_LT(p, buffer.data() + buffer.size());
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(double), 0);
+    }
+}
+
+// =========================================================================
+// 2. Inserting Past the Limit
+// =========================================================================
+
+TEST(FixedFlatHashMapTest, ReportsFullInsteadOfGrowing) {
+    using Map = fixed_flat_hash_map<int, std::string>;
+    std::vector<unsigned char> buffer(Map::buffer_size(14));
+    Map map(buffer.data(), buffer.size());
+    ASSERT_EQ(map.max_size(), 14);
+
+    for (int i = 0; i < 14; ++i) {
+        ASSERT_TRUE(map.try_emplace(i, std::to_string(i)).second);
+    }
+    EXPECT_TRUE(map.full());
+
+    auto result = map.try_emplace(100, "x");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first, map.end());
+    EXPECT_EQ(map.emplace(101, "y").first, map.end());
+    EXPECT_EQ(map.insert({102, "z"}).first, map.end());
+    EXPECT_EQ(map.insert_or_assign(103, "w").first, map.end());
+    EXPECT_EQ(map.size(), 14);
+
+    // Existing keys are still found and updated.
+    result = map.try_emplace(3, "ignored");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first->second, "3");
+    map.insert_or_assign(3, "three");
+    EXPECT_EQ(map.at(3), "three");
+
+    // Erasing makes room again.
+    EXPECT_EQ(map.erase_element(0), 1);
+    EXPECT_TRUE(map.try_emplace(100, "x").second);
+}
+
+TEST(FixedFlatHashMapTest, MatchesReferenceUnderChurn) {
+    using Map = fixed_flat_hash_map<int, int>;
+    std::vector<unsigned char> buffer(Map::buffer_size(200));
+    Map map(buffer.data(), buffer.size());
+    std::map<int, int> reference;
+    std::mt19937 rng(5);
+    for (int step = 0; step < 200000; ++step) {
+        const int key = static_cast<int>(rng() % 600);
+        if (rng() % 2 == 0) {
+            const bool fits =
+                map.insert_or_assign(key, step).first != map.end();
+            ASSERT_EQ(fits, reference.count(key) == 1 ||
+                                reference.size() < map.max_size());
+            if (fits) {
+                reference[key] = step;
+            }
+        } else {
+            ASSERT_EQ(map.erase_element(key), reference.erase(key));
+        }
+    }
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& kv : reference) {
+        ASSERT_EQ(map.at(kv.first), kv.second);
+    }
+}
+
+// =========================================================================
+// 3. Ownership
+// =========================================================================
+
+TEST(FixedFlatHashMapTest, MoveHandsOverTheBuffer) {
+    using Map = fixed_flat_hash_map<int, std::string>;
+    std::vector<unsigned char> buffer(Map::buffer_size(50));
+    Map map(buffer.data(), buffer.size());
+    map.try_emplace(1, "one");
+
+    Map moved(std::move(map));
+    EXPECT_EQ(moved.at(1), "one");
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), 0);
+    EXPECT_EQ(map.try_emplace(2, "two").first, map.end());
+
+    std::vector<unsigned char> other(Map::buffer_size(10));
+    Map target(other.data(), other.size());
+    target.try_emplace(9, "nine");
+    target = std::move(moved);
+    EXPECT_EQ(target.at(1), "one");
+    EXPECT_FALSE(target.contains(9));
+}
+
+TEST(FixedFlatHashMapTest, TracksLifecycles) {
+    LifecycleTracker::reset();
+    {
+        using Map = fixed_flat_hash_map<int, LifecycleTracker>;
+        std::vector<unsigned char> buffer(Map::buffer_size(64));
+        Map map(buffer.data(), buffer.size());
+        for (int i = 0; i < 100; ++i) {
+            map.try_emplace(i, i);
+        }
+        for (int i = 0; i < 50; i += 4) {
+            map.erase(map.find(i));
+        }
+        map.clear();
+        for (int i = 0; i < 10; ++i) {
+            map.try_emplace(i, i);
+        }
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
+
+#if HMM_HAS_CXX_20
+TEST(FixedFlatHashMapTest, SpanConstructor) {
+    using Map = fixed_flat_hash_map<int, int>;
+    std::vector<std::byte> buffer(Map::buffer_size(10));
+    Map map{std::span<std::byte>(buffer)};
+    EXPECT_TRUE(map.try_emplace(1, 2).second);
+    EXPECT_EQ(map.at(1), 2);
+}
+#endif
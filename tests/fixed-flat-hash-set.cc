@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <hmm/fixed-flat-hash-set.hpp>
+
+// Std
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::fixed_flat_hash_set;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Homes every key at its own value's slot.
+struct IdentityHash {
+    std::size_t operator()(int key) const {
+        return static_cast<std::size_t>(key);
+    }
+};
+
+/// @brief Sends every key to one run, throwing while armed.
+struct ArmedHash {
+    static inline bool armed = false;
+
+    std::size_t operator()(const std::string&) const {
+        if (armed) {
+            throw std::runtime_error("hash");
+        }
+        return 3;
+    }
+};
+
+} // namespace
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(FixedFlatHashSetTest, InsertFindErase) {
+    using Set = fixed_flat_hash_set<std::string>;
+    std::vector<unsigned char> buffer(Set::buffer_size(100));
+    Set set(buffer.data(), buffer.size());
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(set.insert(std::to_string(i)).second);
+    }
+    EXPECT_FALSE(set.insert("7").second);
+    EXPECT_TRUE(set.contains("42"));
+    EXPECT_EQ(*set.find("42"), "42");
+    EXPECT_EQ(set.erase_element("42"), 1);
+    EXPECT_FALSE(set.contains("42"));
+
+    std::set<std::string> seen(set.begin(), set.end());
+    EXPECT_EQ(seen.size(), 99);
+}
+
+TEST(FixedFlatHashSetTest, FullSetRejectsNewElements) {
+    using Set = fixed_flat_hash_set<int>;
+    std::vector<unsigned char> buffer(Set::buffer_size(14));
+    Set set(buffer.data(), buffer.size());
+    for (int i = 0; set.insert(i).second; ++i) {
+    }
+    EXPECT_TRUE(set.full());
+    EXPECT_EQ(set.size(), set.max_size());
+    EXPECT_EQ(set.emplace(1000).first, set.end());
+    EXPECT_NE(set.insert(0).first, set.end());
+}
+
+TEST(FixedFlatHashSetTest, CollidingKeys) {
+    using Set = fixed_flat_hash_set<int, BadHash>;
+    std::vector<unsigned char> buffer(Set::buffer_size(100));
+    Set set(buffer.data(), buffer.size());
+    for (int i = 0; i < 100; ++i) {
+        set.insert(i);
+    }
+    for (auto it = set.begin(); it != set.end();) {
+        it = *it % 2 == 0 ? set.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(set.size(), 50);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(set.contains(i), i % 2 == 1);
+    }
+}
+
+TEST(FixedFlatHashSetTest, EraseWhileIteratingAcrossTheWrap) {
+    using Set = fixed_flat_hash_set<int, IdentityHash>;
+    std::vector<unsigned char> buffer(Set::buffer_size(14));
+    Set set(buffer.data(), buffer.size());
+    const int cap = static_cast<int>(set.capacity());
+
+    // Both keys are homed at the last slot; the second wraps to slot 0.
+    const int last = cap - 1;
+    const int wrapped = 2 * cap - 1;
+    set.insert(last);
+    set.insert(wrapped);
+
+    // Erasing the last slot shifts the wrapped key, already visited from
+    // slot 0, into it: the loop sees that key twice, as documented.
+    std::vector<int> visited;
+    for (auto it = set.begin(); it != set.end();) {
+        visited.push_back(*it);
+        it = *it == last ? set.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(visited, (std::vector<int>{wrapped, last, wrapped}));
+    EXPECT_EQ(set.size(), 1);
+    EXPECT_TRUE(set.contains(wrapped));
+    EXPECT_FALSE(set.contains(last));
+}
+
+TEST(FixedFlatHashSetTest, ThrowingHashDuringEraseKeepsSlotsConsistent) {
+    using Set = fixed_flat_hash_set<std::string, ArmedHash>;
+    std::vector<unsigned char> buffer(Set::buffer_size(14));
+    Set set(buffer.data(), buffer.size());
+    for (int i = 0; i < 4; ++i) {
+        // Long enough to live on the heap, so leaks and double frees show.
+        set.insert(std::string(32, static_cast<char>('a' + i)));
+    }
+
+    const auto first = set.find(std::string(32, 'a'));
+    ArmedHash::armed = true;
+    EXPECT_THROW(set.erase(first), std::runtime_error);
+    ArmedHash::armed = false;
+
+    // The erased element is gone and every other one is still iterated.
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(set.begin(), set.end())),
+              3);
+}
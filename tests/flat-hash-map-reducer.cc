@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <hmm/flat-hash-map-reducer.hpp>
+
+// Std
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::flat_hash_map;
+using hmm::flat_hash_map_reducer;
+using hmm::thread_executor;
+using namespace hmm::testing;
+
+namespace {
+
+struct Max {
+    int operator()(int a, int b) const {
+        return std::max(a, b);
+    }
+};
+
+} // namespace
+
+// =========================================================================
+// 1. Accumulation
+// =========================================================================
+
+TEST(FlatHashMapReducerTest, MergeWithNoThreads) {
+    flat_hash_map_reducer<int, int> reducer;
+    EXPECT_TRUE(reducer.merge().empty());
+}
+
+TEST(FlatHashMapReducerTest, SingleThreadKeepsItsTable) {
+    flat_hash_map_reducer<std::string, std::uint64_t> reducer;
+    reducer.add("a", 1);
+    reducer.add("b", 2);
+    reducer.add(std::string("a"), 3);
+    EXPECT_EQ(reducer.local().size(), 2);
+
+    auto merged = reducer.merge();
+    EXPECT_EQ(merged.size(), 2);
+    EXPECT_EQ(merged.at("a"), 4);
+    EXPECT_EQ(merged.at("b"), 2);
+
+    // The reducer starts over after a merge.
+    EXPECT_TRUE(reducer.local().empty());
+    EXPECT_TRUE(reducer.merge().empty());
+}
+
+TEST(FlatHashMapReducerTest, CountsAcrossThreads) {
+    constexpr int kThreads = 8;
+    constexpr int kKeys = 5000;
+    flat_hash_map_reducer<std::string, std::uint64_t> reducer;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            // Every thread sees every key, some of them more than once.
+            for (int i = 0; i < kKeys; ++i) {
+                reducer.add(std::to_string(i), 1);
+                if (i % (t + 2) == 0) {
+                    reducer.add(std::to_string(i), 1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    thread_executor exec(4);
+    auto merged = reducer.merge(exec);
+    ASSERT_EQ(merged.size(), kKeys);
+    for (int i = 0; i < kKeys; ++i) {
+        std::uint64_t expected = kThreads;
+        for (int t = 0; t < kThreads; ++t) {
+            expected += i % (t + 2) == 0;
+        }
+        ASSERT_EQ(merged.at(std::to_string(i)), expected);
+    }
+}
+
+TEST(FlatHashMapReducerTest, DisjointKeysAndCustomCombine) {
+    constexpr int kThreads = 4;
+    flat_hash_map_reducer<int, int, Max> reducer;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 20000; ++i) {
+                // Keys are disjoint between threads, apart from key 0.
+                const int key = i == 0 ? 0 : i * kThreads + t;
+                reducer.add(key, t * 100 + i % 7);
+                reducer.add(key, t * 100);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto merged = reducer.merge();
+    EXPECT_EQ(merged.size(), 1 + (20000 - 1) * kThreads);
+    EXPECT_EQ(merged.at(0), (kThreads - 1) * 100);
+    EXPECT_EQ(merged.at(1 * kThreads + 2), 200 + 1);
+}
+
+TEST(FlatHashMapReducerTest, CollidingHashes) {
+    flat_hash_map_reducer<int, int, std::plus<int>, BadHash> reducer;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 300; ++i) {
+                reducer.add(i, 1);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto merged = reducer.merge();
+    ASSERT_EQ(merged.size(), 300);
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_EQ(merged.at(i), 3);
+    }
+}
+
+TEST(FlatHashMapReducerTest, ReducersDoNotShareTables) {
+    flat_hash_map_reducer<int, int> a;
+    flat_hash_map_reducer<int, int> b;
+    a.add(1, 1);
+    b.add(1, 10);
+    a.add(1, 1);
+
+    EXPECT_EQ(a.merge().at(1), 2);
+    EXPECT_EQ(b.merge().at(1), 10);
+}
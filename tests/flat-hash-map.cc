@@ -3,10 +3,14 @@
 #include <hmm/flat-hash-map.hpp>
 
 // Std
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "test-shared.hpp"
 
@@ -48,6 +52,33 @@ TEST(FlatHashMapTest, CopyConstruction) {
     EXPECT_EQ(copy.at(1), 999);
 }
 
+TEST(FlatHashMapTest, CopyConstructionClonesLayout) {
+    flat_hash_map<int, std::string> original;
+    for (int i = 0; i < 1000; ++i) {
+        original.emplace(i, std::to_string(i));
+    }
+    for (int i = 0; i < 1000; i += 3) {
+        original.erase_element(i);
+    }
+
+    flat_hash_map<int, std::string> copy = original;
+    EXPECT_EQ(copy.size(), original.size());
+    EXPECT_EQ(copy.capacity(), original.capacity());
+
+    auto a = original.begin();
+    auto b = copy.begin();
+    for (; a != original.end() && b != copy.end(); ++a, ++b) {
+        ASSERT_EQ(a->first, b->first);
+        ASSERT_EQ(a->second, b->second);
+    }
+    EXPECT_TRUE(a == original.end() && b == copy.end());
+
+    // The copied tombstones keep probing intact.
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(copy.contains(i), i % 3 != 0);
+    }
+}
+
 TEST(FlatHashMapTest, MoveConstruction) {
     flat_hash_map<std::string, std::string> source;
     source.insert({"key", "value"});
@@ -120,6 +151,47 @@ TEST(FlatHashMapTest, Clear) {
     EXPECT_TRUE(map.empty());
 }
 
+TEST(FlatHashMapTest, ChurnPurgesTombstonesInPlace) {
+    flat_hash_map<int, std::string> map;
+    map.reserve(1000);
+    const auto cap = map.capacity();
+
+    // A sliding window of keys leaves a trail of tombstones, which must be
+    // purged without growing the table.
+    for (int i = 0; i < 100000; ++i) {
+        map.emplace(i, std::to_string(i));
+        if (i >= 500) {
+            ASSERT_EQ(map.erase(i - 500), 1);
+        }
+    }
+
+    EXPECT_EQ(map.capacity(), cap);
+    EXPECT_EQ(map.size(), 500);
+    for (int i = 100000 - 500; i < 100000; ++i) {
+        ASSERT_EQ(map.at(i), std::to_string(i));
+    }
+    EXPECT_FALSE(map.contains(100000 - 501));
+}
+
+TEST(FlatHashMapTest, ChurnWithCollisions) {
+    LifecycleTracker::reset();
+    {
+        flat_hash_map<int, LifecycleTracker, BadHash> map;
+        for (int i = 0; i < 5000; ++i) {
+            map.emplace(i, i);
+            if (i >= 40) {
+                ASSERT_EQ(map.erase(i - 40), 1);
+            }
+        }
+        EXPECT_EQ(map.size(), 40);
+        for (int i = 5000 - 40; i < 5000; ++i) {
+            ASSERT_EQ(map.at(i).val, i);
+        }
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
+
 // =========================================================================
 // 4. Advanced: Move-Only Types
 // =========================================================================
@@ -255,3 +327,177 @@ TEST(FlatHashMapTest, ObjectLifetimeAndLeaks) {
     // Assert that every construction has a matching destruction
     EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
 }
+
+// =========================================================================
+// 9. Partitioned Iteration
+// =========================================================================
+
+TEST(FlatHashMapTest, PartitionsCoverEveryElementOnce) {
+    flat_hash_map<int, int> map;
+    for (int i = 0; i < 10000; ++i) {
+        map.emplace(i, i);
+    }
+
+    for (std::size_t n : {1, 3, 8, 1000, 5000}) {
+        auto parts = map.partitions(n);
+        ASSERT_EQ(parts.size(), n);
+
+        std::vector<int> seen;
+        for (const auto& part : parts) {
+            for (const auto& kv : part) {
+                seen.push_back(kv.first);
+            }
+        }
+
+        // Partitions concatenate to the normal iteration order.
+        std::vector<int> expected;
+        for (const auto& kv : map) {
+            expected.push_back(kv.first);
+        }
+        EXPECT_EQ(seen, expected);
+    }
+}
+
+TEST(FlatHashMapTest, ConstPartitionsSplitTheTable) {
+    flat_hash_map<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.emplace(i, i);
+    }
+
+    const auto& cmap = map;
+    auto parts = cmap.partitions(7);
+    std::size_t nonempty = 0;
+    for (const auto& part : parts) {
+        nonempty += !part.empty();
+    }
+    EXPECT_GT(nonempty, 1);
+    EXPECT_EQ(parts.back().end(), cmap.end());
+}
+
+TEST(FlatHashMapTest, PartitionsOfEmptyAndSmallTables) {
+    flat_hash_map<int, int> empty;
+    auto parts = empty.partitions(4);
+    ASSERT_EQ(parts.size(), 4);
+    for (const auto& part : parts) {
+        EXPECT_TRUE(part.empty());
+    }
+    EXPECT_TRUE(empty.partitions(0).empty());
+
+    flat_hash_map<int, int> small{{1, 1}, {2, 2}};
+    std::size_t count = 0;
+    for (const auto& part : small.partitions(64)) {
+        for (auto it = part.begin(); it != part.end(); ++it) {
+            ++count;
+        }
+    }
+    EXPECT_EQ(count, 2);
+}
+
+TEST(FlatHashMapTest, PartitionsIterateConcurrently) {
+    flat_hash_map<int, int> map;
+    for (int i = 0; i < 50000; ++i) {
+        map.emplace(i, 0);
+    }
+
+    auto parts = map.partitions(4);
+    std::vector<std::thread> threads;
+    for (auto& part : parts) {
+        threads.emplace_back([&part] {
+            for (auto& kv : part) {
+                kv.second = kv.first + 1;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (int i = 0; i < 50000; ++i) {
+        ASSERT_EQ(map.at(i), i + 1);
+    }
+}
+
+// =========================================================================
+// 10. Weak Hashes on Small Keys
+// =========================================================================
+
+namespace {
+
+/// @brief Keeps every element on one control byte; see the set tests.
+struct IdentityHash {
+    std::size_t operator()(std::int32_t key) const {
+        return static_cast<std::uint32_t>(key);
+    }
+};
+
+/// @brief A four byte value that is not trivially copyable.
+struct Boxed {
+    std::int32_t val;
+
+    Boxed(std::int32_t v = 0) : val(v) {}
+    Boxed(const Boxed& other) : val(other.val) {}
+    Boxed& operator=(const Boxed& other) {
+        val = other.val;
+        return *this;
+    }
+};
+
+} // namespace
+
+TEST(FlatHashMapTest, SharedControlBytesCompareOnlyKeys) {
+    // Values equal to other keys must never match a lookup.
+    flat_hash_map<std::int32_t, std::int32_t, IdentityHash> map;
+    for (std::int32_t i = -2000; i < 2000; ++i) {
+        map.emplace(i, i + 1);
+    }
+    for (std::int32_t i = -2000; i < 2000; i += 3) {
+        map.erase_element(i);
+    }
+    for (std::int32_t i = -2500; i < 2500; ++i) {
+        const auto it = map.find(i);
+        if (i < -2000 || i >= 2000 || (i + 2000) % 3 == 0) {
+            ASSERT_EQ(it, map.end()) << i;
+        } else {
+            ASSERT_NE(it, map.end()) << i;
+            ASSERT_EQ(it->second, i + 1);
+        }
+    }
+}
+
+TEST(FlatHashMapTest, SharedControlBytesInSmallTable) {
+    // A single group that also wraps around the end of the table.
+    flat_hash_map<std::int32_t, float, IdentityHash> map;
+    for (std::int32_t i = 0; i < 14; ++i) {
+        map[i * 16 + 15] = static_cast<float>(i);
+    }
+    ASSERT_EQ(map.capacity(), 16);
+    for (std::int32_t i = 0; i < 14; ++i) {
+        ASSERT_EQ(map.at(i * 16 + 15), static_cast<float>(i));
+    }
+    EXPECT_FALSE(map.contains(15 + 14 * 16));
+}
+
+TEST(FlatHashMapTest, SharedControlBytesWithNonTrivialValues) {
+    // Group compares read free slots, so they need trivial slot types.
+    using Trivial = flat_hash_map<std::int32_t, float, IdentityHash>;
+    using NonTrivial = flat_hash_map<std::int32_t, Boxed, IdentityHash>;
+    static_assert(hmm::internal::DirectKeyMatch<
+                      Trivial::policy_type, Trivial::key_equal,
+                      std::int32_t>::value,
+                  "");
+    static_assert(!hmm::internal::DirectKeyMatch<
+                      NonTrivial::policy_type, NonTrivial::key_equal,
+                      std::int32_t>::value,
+                  "");
+
+    NonTrivial map;
+    for (std::int32_t i = 0; i < 3000; ++i) {
+        map.emplace(i, Boxed(-i));
+    }
+    for (std::int32_t i = 0; i < 3500; ++i) {
+        const auto it = map.find(i);
+        ASSERT_EQ(it != map.end(), i < 3000) << i;
+        if (i < 3000) {
+            ASSERT_EQ(it->second.val, -i);
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <hmm/flat-hash-multimap.hpp>
+
+// Std
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::flat_hash_multimap;
+using namespace hmm::testing;
+
+namespace {
+
+template <class Map, class K> std::vector<int> sorted_values(Map& map, K key) {
+    std::vector<int> values;
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        values.push_back(it->second);
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+} // namespace
+
+// =========================================================================
+// 1. Construction and Basic Insertion
+// =========================================================================
+
+TEST(FlatHashMultimapTest, DefaultConstruction) {
+    flat_hash_multimap<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.count(1), 0);
+
+    auto range = map.equal_range(1);
+    EXPECT_EQ(range.first, range.second);
+}
+
+TEST(FlatHashMultimapTest, DuplicateKeysAreKept) {
+    flat_hash_multimap<std::string, int> map{
+        {"a", 1}, {"b", 2}, {"a", 3}, {"a", 4}};
+
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.count("a"), 3);
+    EXPECT_EQ(map.count("b"), 1);
+    EXPECT_EQ(map.count("c"), 0);
+    EXPECT_EQ(sorted_values(map, "a"), (std::vector<int>{1, 3, 4}));
+}
+
+TEST(FlatHashMultimapTest, CopyKeepsDuplicates) {
+    flat_hash_multimap<int, int> original{{1, 10}, {1, 11}, {2, 20}};
+    flat_hash_multimap<int, int> copy = original;
+
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(sorted_values(copy, 1), (std::vector<int>{10, 11}));
+}
+
+// =========================================================================
+// 2. Range Insertion Under One Key
+// =========================================================================
+
+TEST(FlatHashMultimapTest, BulkInsertUnderOneKey) {
+    flat_hash_multimap<int, int> map;
+    std::vector<int> values(100);
+    for (int i = 0; i < 100; ++i) {
+        values[i] = i;
+    }
+
+    map.insert(7, values.begin(), values.end());
+    map.insert({8, -1});
+
+    EXPECT_EQ(map.size(), 101);
+    EXPECT_EQ(map.count(7), 100);
+    EXPECT_EQ(sorted_values(map, 7), values);
+    EXPECT_EQ(sorted_values(map, 8), (std::vector<int>{-1}));
+}
+
+TEST(FlatHashMultimapTest, ValuesAreMutableThroughRange) {
+    flat_hash_multimap<int, int> map{{1, 1}, {1, 2}, {2, 3}};
+
+    auto range = map.equal_range(1);
+    for (auto it = range.first; it != range.second; ++it) {
+        it->second *= 10;
+    }
+    EXPECT_EQ(sorted_values(map, 1), (std::vector<int>{10, 20}));
+    EXPECT_EQ(sorted_values(map, 2), (std::vector<int>{3}));
+}
+
+// =========================================================================
+// 3. Erasure
+// =========================================================================
+
+TEST(FlatHashMultimapTest, EraseKeyRemovesAllMatches) {
+    flat_hash_multimap<int, int> map;
+    for (int i = 0; i < 200; ++i) {
+        map.emplace(i % 10, i);
+    }
+
+    EXPECT_EQ(map.erase(3), 20);
+    EXPECT_EQ(map.erase(3), 0);
+    EXPECT_EQ(map.size(), 180);
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_EQ(map.count(4), 20);
+}
+
+TEST(FlatHashMultimapTest, EraseSingleThroughKeyIterator) {
+    flat_hash_multimap<int, int> map{{1, 10}, {1, 11}, {1, 12}};
+
+    auto range = map.equal_range(1);
+    map.erase(range.first.base());
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.count(1), 2);
+}
+
+// =========================================================================
+// 4. Stress and Collision Resolution
+// =========================================================================
+
+TEST(FlatHashMultimapTest, RangesSpanProbeWindows) {
+    // Every key collides, so ranges interleave across many groups
+    flat_hash_multimap<int, int, BadHash> map;
+    for (int i = 0; i < 300; ++i) {
+        map.emplace(i % 3, i);
+    }
+
+    EXPECT_EQ(map.count(0), 100);
+    EXPECT_EQ(map.count(1), 100);
+    EXPECT_EQ(map.count(2), 100);
+
+    EXPECT_EQ(map.erase(1), 100);
+    EXPECT_EQ(map.count(0), 100);
+    EXPECT_EQ(map.count(1), 0);
+    EXPECT_EQ(map.count(2), 100);
+}
+
+TEST(FlatHashMultimapTest, InsertEraseChurn) {
+    flat_hash_multimap<int, int> map;
+    for (int i = 0; i < 5000; ++i) {
+        map.emplace(i, i);
+        map.emplace(i, -i);
+        if (i >= 4) {
+            EXPECT_EQ(map.erase(i - 4), 2);
+        }
+    }
+
+    EXPECT_EQ(map.size(), 8);
+    EXPECT_EQ(sorted_values(map, 4999), (std::vector<int>{-4999, 4999}));
+}
+
+// =========================================================================
+// 5. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(FlatHashMultimapTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+
+    {
+        flat_hash_multimap<int, LifecycleTracker> map;
+        for (int i = 0; i < 100; ++i) {
+            map.emplace(i % 5, i);
+        }
+        map.erase(2);
+        EXPECT_EQ(map.size(), 80);
+    }
+
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <hmm/flat-hash-multiset.hpp>
+
+// Std
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::flat_hash_multiset;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Construction and Basic Insertion
+// =========================================================================
+
+TEST(FlatHashMultisetTest, DefaultConstruction) {
+    flat_hash_multiset<int> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.count(0), 0);
+    EXPECT_EQ(set.find(0), set.end());
+}
+
+TEST(FlatHashMultisetTest, DuplicatesAreKept) {
+    flat_hash_multiset<std::string> set{"x", "y", "x", "x"};
+
+    EXPECT_EQ(set.size(), 4);
+    EXPECT_EQ(set.count("x"), 3);
+    EXPECT_EQ(set.count("y"), 1);
+    EXPECT_TRUE(set.contains("y"));
+    EXPECT_FALSE(set.contains("z"));
+
+    std::size_t n = 0;
+    auto range = set.equal_range("x");
+    for (auto it = range.first; it != range.second; ++it) {
+        EXPECT_EQ(*it, "x");
+        ++n;
+    }
+    EXPECT_EQ(n, 3);
+}
+
+TEST(FlatHashMultisetTest, IterationVisitsEveryCopy) {
+    flat_hash_multiset<int> set;
+    for (int i = 0; i < 50; ++i) {
+        set.insert(i % 5);
+    }
+
+    std::vector<int> seen(5, 0);
+    for (int v : set) {
+        ++seen[v];
+    }
+    EXPECT_EQ(seen, (std::vector<int>(5, 10)));
+}
+
+// =========================================================================
+// 2. Erasure
+// =========================================================================
+
+TEST(FlatHashMultisetTest, EraseKeyAndIterator) {
+    flat_hash_multiset<int> set{1, 1, 1, 2, 2};
+
+    set.erase(set.find(1));
+    EXPECT_EQ(set.count(1), 2);
+
+    EXPECT_EQ(set.erase(2), 2);
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_FALSE(set.contains(2));
+}
+
+// =========================================================================
+// 3. Stress and Collision Resolution
+// =========================================================================
+
+TEST(FlatHashMultisetTest, MassiveCollisions) {
+    flat_hash_multiset<int, BadHash> set;
+    for (int i = 0; i < 400; ++i) {
+        set.insert(i % 4);
+    }
+
+    for (int k = 0; k < 4; ++k) {
+        EXPECT_EQ(set.count(k), 100);
+    }
+    EXPECT_EQ(set.erase(0), 100);
+    EXPECT_EQ(set.erase(3), 100);
+    EXPECT_EQ(set.count(1), 100);
+    EXPECT_EQ(set.count(2), 100);
+    EXPECT_EQ(set.size(), 200);
+}
+
+// =========================================================================
+// 4. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(FlatHashMultisetTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+
+    {
+        flat_hash_multiset<LifecycleTracker, LifecycleHasher> set;
+        for (int i = 0; i < 64; ++i) {
+            set.emplace(i % 8);
+        }
+        EXPECT_EQ(set.erase(LifecycleTracker(3)), 8);
+    }
+
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
@@ -3,6 +3,7 @@
 #include <hmm/flat-hash-set.hpp>
 
 // Std
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -285,3 +286,57 @@ TEST(FlatHashSetTest, ObjectLifetimeAndLeaks) {
     // Everything constructed must be destroyed
     EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
 }
+
+// =========================================================================
+// 10. Weak Hashes on Small Keys
+// =========================================================================
+
+namespace {
+
+/// @brief Leaves the top bits of the hash zero, so every element shares the
+/// same control byte and lookups compare many candidate keys.
+struct IdentityHash {
+    std::size_t operator()(std::uint32_t key) const {
+        return key;
+    }
+};
+
+enum class Color : std::int32_t { kRed = -1, kGreen = 7 };
+
+struct ColorHash {
+    std::size_t operator()(Color c) const {
+        return static_cast<std::size_t>(static_cast<std::int32_t>(c)) & 0xFF;
+    }
+};
+
+} // namespace
+
+TEST(FlatHashSetTest, SharedControlBytesWithErasure) {
+    flat_hash_set<std::uint32_t, IdentityHash> set;
+    for (std::uint32_t i = 0; i < 5000; ++i) {
+        set.insert(i * 3);
+    }
+    // Erased slots keep their old bytes; they must not be found.
+    for (std::uint32_t i = 0; i < 5000; i += 2) {
+        set.erase_element(i * 3);
+    }
+    for (std::uint32_t i = 0; i < 15000; ++i) {
+        const bool expected = i % 3 == 0 && (i / 3) % 2 == 1;
+        ASSERT_EQ(set.contains(i), expected) << i;
+    }
+
+    for (std::uint32_t i = 0; i < 5000; i += 2) {
+        EXPECT_TRUE(set.insert(i * 3).second);
+    }
+    EXPECT_EQ(set.size(), 5000);
+    EXPECT_EQ(*set.find(2997), 2997);
+}
+
+TEST(FlatHashSetTest, SharedControlBytesWithEnumKeys) {
+    flat_hash_set<Color, ColorHash> set;
+    set.insert(Color::kRed);
+    EXPECT_TRUE(set.contains(Color::kRed));
+    EXPECT_FALSE(set.contains(Color::kGreen));
+    set.insert(Color::kGreen);
+    EXPECT_EQ(set.size(), 2);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <hmm/frozen-hash-map.hpp>
+
+// Std
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::frozen_hash_map;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Hashes by the length of a string, so keys of equal length collide.
+struct LengthHash {
+    std::size_t operator()(const std::string& s) const {
+        return s.size();
+    }
+};
+
+} // namespace
+
+// =========================================================================
+// 1. Construction
+// =========================================================================
+
+TEST(FrozenHashMapTest, EmptyMap) {
+    frozen_hash_map<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.find(1), map.end());
+}
+
+TEST(FrozenHashMapTest, InitializerList) {
+    const frozen_hash_map<std::string, int> map = {
+        {"one", 1}, {"two", 2}, {"three", 3}};
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at("one"), 1);
+    EXPECT_EQ(map.at("two"), 2);
+    EXPECT_EQ(map.at("three"), 3);
+    EXPECT_FALSE(map.contains("four"));
+    EXPECT_THROW((void)map.at("four"), std::out_of_range);
+}
+
+TEST(FrozenHashMapTest, SingleElement) {
+    const frozen_hash_map<int, int> map = {{42, 7}};
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at(42), 7);
+    EXPECT_EQ(map.count(41), 0);
+}
+
+TEST(FrozenHashMapTest, FirstDuplicateWins) {
+    std::vector<std::pair<int, int>> input;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            input.emplace_back(i, round);
+        }
+    }
+    const frozen_hash_map<int, int> map(input.begin(), input.end());
+    EXPECT_EQ(map.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(map.at(i), 0);
+    }
+}
+
+TEST(FrozenHashMapTest, CollidingHashesThrow) {
+    const std::vector<std::pair<std::string, int>> input = {
+        {"ab", 1}, {"cd", 2}};
+    using Map = frozen_hash_map<std::string, int, LengthHash>;
+    EXPECT_THROW(Map(input.begin(), input.end()), std::invalid_argument);
+
+    // Equal keys sharing a hash are plain duplicates.
+    const std::vector<std::pair<std::string, int>> dups = {
+        {"ab", 1}, {"xyz", 2}, {"ab", 3}};
+    const Map map(dups.begin(), dups.end());
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at("ab"), 1);
+}
+
+// =========================================================================
+// 2. Lookup
+// =========================================================================
+
+TEST(FrozenHashMapTest, LargeTable) {
+    std::vector<std::pair<std::uint64_t, std::string>> input;
+    for (std::uint64_t i = 0; i < 200000; ++i) {
+        input.emplace_back(i * 0x9E3779B97F4A7C15ULL, std::to_string(i));
+    }
+    const frozen_hash_map<std::uint64_t, std::string> map(input.begin(),
+                                                          input.end());
+    ASSERT_EQ(map.size(), input.size());
+    for (const auto& kv : input) {
+        ASSERT_EQ(map.at(kv.first), kv.second);
+    }
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(map.contains(i * 0x9E3779B97F4A7C15ULL + 1));
+    }
+}
+
+TEST(FrozenHashMapTest, ManySizes) {
+    for (int n = 0; n < 300; ++n) {
+        std::vector<std::pair<int, int>> input;
+        for (int i = 0; i < n; ++i) {
+            input.emplace_back(i * 3, i);
+        }
+        const frozen_hash_map<int, int> map(input.begin(), input.end());
+        ASSERT_EQ(map.size(), static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            ASSERT_EQ(map.at(i * 3), i);
+            ASSERT_FALSE(map.contains(i * 3 + 1));
+        }
+    }
+}
+
+TEST(FrozenHashMapTest, IterationVisitsEveryElementOnce) {
+    std::vector<std::pair<int, int>> input;
+    for (int i = 0; i < 5000; ++i) {
+        input.emplace_back(i, -i);
+    }
+    const frozen_hash_map<int, int> map(input.begin(), input.end());
+
+    std::vector<int> seen(5000, 0);
+    for (const auto& kv : map) {
+        ASSERT_EQ(kv.second, -kv.first);
+        ++seen[kv.first];
+    }
+    for (int s : seen) {
+        ASSERT_EQ(s, 1);
+    }
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(map.begin(), map.end())),
+              map.size());
+}
+
+TEST(FrozenHashMapTest, FindReturnsIteratorIntoStorage) {
+    const frozen_hash_map<int, std::string> map = {{1, "a"}, {2, "b"}};
+    const auto it = map.find(2);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, "b");
+
+    bool reached = false;
+    for (auto cur = map.begin(); cur != map.end(); ++cur) {
+        reached = reached || cur == it;
+    }
+    EXPECT_TRUE(reached);
+}
+
+// =========================================================================
+// 3. Copy, Move and Lifecycles
+// =========================================================================
+
+TEST(FrozenHashMapTest, CopyAndMove) {
+    std::vector<std::pair<int, int>> input;
+    for (int i = 0; i < 1000; ++i) {
+        input.emplace_back(i, i * i);
+    }
+    const frozen_hash_map<int, int> original(input.begin(), input.end());
+
+    const frozen_hash_map<int, int> copy = original;
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy.at(30), 900);
+
+    frozen_hash_map<int, int> moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 1000);
+    EXPECT_EQ(moved.at(31), 961);
+
+    moved = original;
+    EXPECT_EQ(moved.at(999), 998001);
+}
+
+TEST(FrozenHashMapTest, TracksLifecycles) {
+    LifecycleTracker::reset();
+    {
+        std::vector<std::pair<LifecycleTracker, int>> input;
+        for (int i = 0; i < 500; ++i) {
+            input.emplace_back(LifecycleTracker(i % 400), i);
+        }
+        const frozen_hash_map<LifecycleTracker, int, LifecycleHasher> map(
+            input.begin(), input.end());
+        EXPECT_EQ(map.size(), 400);
+        EXPECT_EQ(map.at(LifecycleTracker(399)), 399);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
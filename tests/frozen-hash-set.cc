@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <hmm/frozen-hash-set.hpp>
+
+// Std
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::frozen_hash_set;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Construction and Lookup
+// =========================================================================
+
+TEST(FrozenHashSetTest, EmptySet) {
+    const frozen_hash_set<std::string> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains("x"));
+}
+
+TEST(FrozenHashSetTest, Keywords) {
+    const frozen_hash_set<std::string> set = {
+        "auto",   "break",    "case",     "char",   "const",   "continue",
+        "do",     "double",   "else",     "enum",   "extern",  "float",
+        "for",    "goto",     "if",       "int",    "long",    "register",
+        "return", "short",    "signed",   "sizeof", "static",  "struct",
+        "switch", "typedef",  "union",    "unsigned", "void",   "volatile",
+        "while"};
+    EXPECT_EQ(set.size(), 31);
+    EXPECT_TRUE(set.contains("typedef"));
+    EXPECT_TRUE(set.contains("while"));
+    EXPECT_FALSE(set.contains("class"));
+    EXPECT_FALSE(set.contains(""));
+}
+
+TEST(FrozenHashSetTest, DropsDuplicates) {
+    std::vector<int> input;
+    for (int i = 0; i < 20000; ++i) {
+        input.push_back(i % 7000);
+    }
+    const frozen_hash_set<int> set(input.begin(), input.end());
+    EXPECT_EQ(set.size(), 7000);
+    for (int i = 0; i < 7000; ++i) {
+        ASSERT_EQ(set.count(i), 1);
+    }
+    EXPECT_EQ(set.count(7000), 0);
+}
+
+TEST(FrozenHashSetTest, StoresEveryElementContiguously) {
+    std::vector<int> input;
+    for (int i = 0; i < 3000; ++i) {
+        input.push_back(i * 17);
+    }
+    const frozen_hash_set<int> set(input.begin(), input.end());
+
+    std::vector<bool> seen(3000, false);
+    for (int v : set) {
+        ASSERT_EQ(v % 17, 0);
+        ASSERT_FALSE(seen[v / 17]);
+        seen[v / 17] = true;
+    }
+    for (int i = 0; i < 3000; ++i) {
+        ASSERT_EQ(*set.find(i * 17), i * 17);
+    }
+}
+
+TEST(FrozenHashSetTest, CollidingHashesThrow) {
+    const std::vector<int> input = {1, 2, 3};
+    using Set = frozen_hash_set<int, BadHash>;
+    EXPECT_THROW(Set(input.begin(), input.end()), std::invalid_argument);
+}
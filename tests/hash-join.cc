@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <hmm/hash-join.hpp>
+
+// Std
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using hmm::hash_anti_join;
+using hmm::hash_join;
+using hmm::hash_semi_join;
+using hmm::join_options;
+
+namespace {
+
+struct Row {
+    int key;
+    int id;
+};
+
+struct KeyOf {
+    int operator()(const Row& row) const {
+        return row.key;
+    }
+};
+
+/// @brief Builds `n` rows with random keys in `[0, range)` and ids from
+/// `first_id`.
+std::vector<Row> MakeRows(std::size_t n, int range, int first_id,
+                          unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<Row> rows(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        rows[i].key = static_cast<int>(rng() % range);
+        rows[i].id = first_id + static_cast<int>(i);
+    }
+    return rows;
+}
+
+using IdPairs = std::vector<std::pair<int, int>>;
+
+IdPairs NestedLoopJoin(const std::vector<Row>& build,
+                       const std::vector<Row>& probe) {
+    IdPairs out;
+    for (const auto& p : probe) {
+        for (const auto& b : build) {
+            if (b.key == p.key) {
+                out.emplace_back(b.id, p.id);
+            }
+        }
+    }
+    return out;
+}
+
+IdPairs InnerJoin(const std::vector<Row>& build,
+                  const std::vector<Row>& probe,
+                  const join_options& options = join_options()) {
+    IdPairs out;
+    hash_join(
+        build, probe, KeyOf(),
+        [&](const Row& b, const Row& p) { out.emplace_back(b.id, p.id); },
+        options);
+    return out;
+}
+
+template <class Join>
+std::vector<int> ProbeIds(Join join, const std::vector<Row>& build,
+                          const std::vector<Row>& probe,
+                          const join_options& options = join_options()) {
+    std::vector<int> out;
+    join(
+        build, probe, KeyOf(), [&](const Row& p) { out.push_back(p.id); },
+        options);
+    return out;
+}
+
+const auto kSemi = [](const auto&... args) { hash_semi_join(args...); };
+const auto kAnti = [](const auto&... args) { hash_anti_join(args...); };
+
+join_options Partitions(int bits) {
+    join_options options;
+    options.partition_bits = bits;
+    return options;
+}
+
+} // namespace
+
+// =========================================================================
+// 1. Inner Join
+// =========================================================================
+
+TEST(HashJoinTest, MatchesNestedLoopInProbeOrder) {
+    const auto build = MakeRows(500, 300, 0, 1);
+    const auto probe = MakeRows(800, 600, 10000, 2);
+
+    // Probe order, then build order within a probe row.
+    EXPECT_EQ(InnerJoin(build, probe), NestedLoopJoin(build, probe));
+}
+
+TEST(HashJoinTest, DuplicateKeysOnBothSides) {
+    // Every key repeats ~50 times on each side.
+    const auto build = MakeRows(1000, 20, 0, 3);
+    const auto probe = MakeRows(1000, 20, 10000, 4);
+
+    const auto expected = NestedLoopJoin(build, probe);
+    EXPECT_GT(expected.size(), 40000u);
+    EXPECT_EQ(InnerJoin(build, probe), expected);
+}
+
+TEST(HashJoinTest, SingleKey) {
+    const std::vector<Row> build = {{7, 0}, {7, 1}, {7, 2}};
+    const std::vector<Row> probe = {{7, 10}, {8, 11}, {7, 12}};
+    const IdPairs expected = {{0, 10}, {1, 10}, {2, 10},
+                              {0, 12}, {1, 12}, {2, 12}};
+    EXPECT_EQ(InnerJoin(build, probe), expected);
+}
+
+TEST(HashJoinTest, StringKeys) {
+    using Named = std::pair<std::string, int>;
+    const std::vector<Named> build = {{"a", 1}, {"b", 2}, {"a", 3}};
+    const std::vector<Named> probe = {{"a", 10}, {"c", 11}, {"b", 12}};
+
+    std::vector<std::pair<int, int>> out;
+    hash_join(
+        build, probe, [](const Named& n) { return n.first; },
+        [&](const Named& b, const Named& p) {
+            out.emplace_back(b.second, p.second);
+        });
+    const IdPairs expected = {{1, 10}, {3, 10}, {2, 12}};
+    EXPECT_EQ(out, expected);
+}
+
+TEST(HashJoinTest, BatchSizesAgree) {
+    const auto build = MakeRows(300, 200, 0, 5);
+    const auto probe = MakeRows(301, 400, 10000, 6);
+    const auto expected = NestedLoopJoin(build, probe);
+
+    for (std::size_t batch : {0, 1, 3, 16, 64, 1000}) {
+        join_options options;
+        options.batch_size = batch;
+        EXPECT_EQ(InnerJoin(build, probe, options), expected) << batch;
+    }
+}
+
+// =========================================================================
+// 2. Semi and Anti Joins
+// =========================================================================
+
+TEST(HashJoinTest, SemiAndAntiSplitProbeRows) {
+    const auto build = MakeRows(400, 500, 0, 7);
+    const auto probe = MakeRows(1000, 1000, 10000, 8);
+
+    std::vector<int> in_build;
+    std::vector<int> not_in_build;
+    for (const auto& p : probe) {
+        const bool found =
+            std::any_of(build.begin(), build.end(),
+                        [&](const Row& b) { return b.key == p.key; });
+        (found ? in_build : not_in_build).push_back(p.id);
+    }
+    ASSERT_FALSE(in_build.empty());
+    ASSERT_FALSE(not_in_build.empty());
+
+    // Once per probe row, however many build rows match.
+    EXPECT_EQ(ProbeIds(kSemi, build, probe), in_build);
+    EXPECT_EQ(ProbeIds(kAnti, build, probe), not_in_build);
+}
+
+// =========================================================================
+// 3. Partitioning
+// =========================================================================
+
+TEST(HashJoinTest, PartitionedMatchesUnpartitioned) {
+    const auto build = MakeRows(5000, 3000, 0, 9);
+    const auto probe = MakeRows(8000, 6000, 100000, 10);
+
+    auto expected = NestedLoopJoin(build, probe);
+    std::sort(expected.begin(), expected.end());
+    auto semi = ProbeIds(kSemi, build, probe);
+    auto anti = ProbeIds(kAnti, build, probe);
+    std::sort(semi.begin(), semi.end());
+    std::sort(anti.begin(), anti.end());
+
+    for (int bits : {1, 4, 10, 20, join_options::kAutoPartitions}) {
+        // Results come grouped by partition, so compare as multisets.
+        auto inner = InnerJoin(build, probe, Partitions(bits));
+        std::sort(inner.begin(), inner.end());
+        EXPECT_EQ(inner, expected) << bits;
+
+        auto s = ProbeIds(kSemi, build, probe, Partitions(bits));
+        auto a = ProbeIds(kAnti, build, probe, Partitions(bits));
+        std::sort(s.begin(), s.end());
+        std::sort(a.begin(), a.end());
+        EXPECT_EQ(s, semi) << bits;
+        EXPECT_EQ(a, anti) << bits;
+    }
+}
+
+TEST(HashJoinTest, PartitionedKeepsBuildOrderPerProbeRow) {
+    const auto build = MakeRows(2000, 50, 0, 11);
+    const auto probe = MakeRows(500, 100, 10000, 12);
+
+    // Group by probe row; build ids of a probe row must stay ascending.
+    auto by_probe = [](IdPairs pairs) {
+        std::stable_sort(pairs.begin(), pairs.end(),
+                         [](const std::pair<int, int>& a,
+                            const std::pair<int, int>& b) {
+                             return a.second < b.second;
+                         });
+        return pairs;
+    };
+    EXPECT_EQ(by_probe(InnerJoin(build, probe, Partitions(6))),
+              by_probe(NestedLoopJoin(build, probe)));
+}
+
+// =========================================================================
+// 4. Edge Cases
+// =========================================================================
+
+TEST(HashJoinTest, EmptySides) {
+    const std::vector<Row> empty;
+    const auto rows = MakeRows(100, 10, 0, 13);
+
+    for (int bits : {0, 3}) {
+        EXPECT_TRUE(InnerJoin(empty, rows, Partitions(bits)).empty());
+        EXPECT_TRUE(InnerJoin(rows, empty, Partitions(bits)).empty());
+        EXPECT_TRUE(ProbeIds(kSemi, empty, rows, Partitions(bits)).empty());
+        EXPECT_EQ(ProbeIds(kAnti, empty, rows, Partitions(bits)).size(),
+                  rows.size());
+        EXPECT_TRUE(ProbeIds(kAnti, rows, empty, Partitions(bits)).empty());
+    }
+}
+
+TEST(HashJoinTest, RawArrays) {
+    const Row build[] = {{1, 0}, {2, 1}};
+    const Row probe[] = {{2, 10}, {3, 11}, {1, 12}};
+
+    IdPairs out;
+    hash_join(build, probe, KeyOf(), [&](const Row& b, const Row& p) {
+        out.emplace_back(b.id, p.id);
+    });
+    const IdPairs expected = {{1, 10}, {0, 12}};
+    EXPECT_EQ(out, expected);
+}
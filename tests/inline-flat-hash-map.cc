@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <hmm/inline-flat-hash-map.hpp>
+
+// Std
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::inline_flat_hash_map;
+using namespace hmm::testing;
+
+static_assert(
+    std::is_trivially_copyable<inline_flat_hash_map<int, double, 8>>::value,
+    "maps of trivial keys and values are trivially copyable");
+static_assert(!std::is_trivially_copyable<
+                  inline_flat_hash_map<int, std::string, 8>>::value,
+              "maps of strings copy element by element");
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(InlineFlatHashMapTest, InsertFindAt) {
+    inline_flat_hash_map<int, std::string, 32> map = {{1, "one"},
+                                                      {2, "two"}};
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at(1), "one");
+    EXPECT_THROW((void)map.at(3), std::out_of_range);
+
+    map[3] = "three";
+    EXPECT_EQ(map.find(3)->second, "three");
+    EXPECT_FALSE(map.try_emplace(3, "again").second);
+    EXPECT_EQ(map.at(3), "three");
+
+    EXPECT_FALSE(map.insert_or_assign(3, "drei").second);
+    EXPECT_EQ(map.at(3), "drei");
+    EXPECT_TRUE(map.insert({4, "four"}).second);
+    EXPECT_TRUE(map.emplace(5, "five").second);
+    EXPECT_EQ(map.size(), 5);
+}
+
+TEST(InlineFlatHashMapTest, ValuesAreMutableThroughIterators) {
+    inline_flat_hash_map<int, int, 16> map;
+    for (int i = 0; i < 16; ++i) {
+        map[i] = i;
+    }
+    for (auto& kv : map) {
+        kv.second *= 2;
+    }
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_EQ(map.at(i), i * 2);
+    }
+}
+
+TEST(InlineFlatHashMapTest, OperatorBracketThrowsWhenFull) {
+    inline_flat_hash_map<int, int, 2> map;
+    map[1] = 1;
+    map[2] = 2;
+    EXPECT_THROW(map[3] = 3, std::length_error);
+    EXPECT_EQ(map[2], 2);
+}
+
+// =========================================================================
+// 2. Churn
+// =========================================================================
+
+TEST(InlineFlatHashMapTest, MatchesReferenceUnderChurn) {
+    inline_flat_hash_map<int, int, 100> map;
+    std::map<int, int> reference;
+    std::mt19937 rng(11);
+    for (int step = 0; step < 100000; ++step) {
+        const int key = static_cast<int>(rng() % 300);
+        if (rng() % 2 == 0 && reference.size() < 100) {
+            map[key] = step;
+            reference[key] = step;
+        } else {
+            ASSERT_EQ(map.erase_element(key), reference.erase(key));
+        }
+    }
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& kv : reference) {
+        ASSERT_EQ(map.at(kv.first), kv.second);
+    }
+}
+
+TEST(InlineFlatHashMapTest, StoredInVectors) {
+    using Map = inline_flat_hash_map<int, std::string, 4>;
+    std::vector<Map> maps;
+    for (int i = 0; i < 200; ++i) {
+        maps.emplace_back();
+        maps.back()[i] = std::to_string(i);
+    }
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_EQ(maps[i].at(i), std::to_string(i));
+    }
+}
+
+TEST(InlineFlatHashMapTest, TracksLifecycles) {
+    LifecycleTracker::reset();
+    {
+        inline_flat_hash_map<int, LifecycleTracker, 20> map;
+        for (int i = 0; i < 20; ++i) {
+            map.try_emplace(i, i);
+        }
+        for (int i = 0; i < 20; i += 3) {
+            map.erase(map.find(i));
+        }
+        auto copy = map;
+        copy.clear();
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
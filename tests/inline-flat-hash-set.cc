@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include <hmm/inline-flat-hash-set.hpp>
+
+// Std
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::inline_flat_hash_set;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Counts live instances; copies throw once `copies_left` runs out.
+struct Fragile {
+    static int live;
+    static int copies_left;
+    int val;
+
+    explicit Fragile(int v) : val(v) {
+        ++live;
+    }
+    Fragile(const Fragile& other) : val(other.val) {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+    Fragile(Fragile&& other) noexcept : val(other.val) {
+        ++live;
+    }
+    ~Fragile() {
+        --live;
+    }
+    bool operator==(const Fragile& other) const {
+        return val == other.val;
+    }
+};
+
+int Fragile::live = 0;
+int Fragile::copies_left = 0;
+
+struct FragileHash {
+    std::size_t operator()(const Fragile& f) const {
+        return std::hash<int>{}(f.val);
+    }
+};
+
+} // namespace
+
+static_assert(std::is_trivially_copyable<inline_flat_hash_set<int, 8>>::value,
+              "sets of trivial elements are trivially copyable");
+static_assert(
+    !std::is_trivially_copyable<inline_flat_hash_set<std::string, 8>>::value,
+    "sets of strings copy element by element");
+static_assert(inline_flat_hash_set<int, 8>::capacity() == 16, "");
+static_assert(inline_flat_hash_set<int, 14>::capacity() == 16, "");
+static_assert(inline_flat_hash_set<int, 15>::capacity() == 32, "");
+static_assert(inline_flat_hash_set<int, 64>::capacity() == 128, "");
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(InlineFlatHashSetTest, InsertFindErase) {
+    inline_flat_hash_set<int, 64> set;
+    EXPECT_TRUE(set.empty());
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_TRUE(set.insert(i * 3).second);
+    }
+    EXPECT_FALSE(set.insert(3).second);
+    EXPECT_EQ(set.size(), 64);
+    EXPECT_TRUE(set.full());
+
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_TRUE(set.contains(i * 3));
+        ASSERT_EQ(*set.find(i * 3), i * 3);
+        ASSERT_FALSE(set.contains(i * 3 + 1));
+    }
+
+    EXPECT_EQ(set.erase_element(9), 1);
+    EXPECT_EQ(set.erase_element(9), 0);
+    EXPECT_FALSE(set.contains(9));
+    EXPECT_FALSE(set.full());
+    EXPECT_TRUE(set.insert(1000).second);
+}
+
+TEST(InlineFlatHashSetTest, InsertingPastCapacityThrows) {
+    inline_flat_hash_set<int, 4> set = {1, 2, 3, 4};
+    EXPECT_THROW(set.insert(5), std::length_error);
+    EXPECT_EQ(set.size(), 4);
+    // Present keys are still found without throwing.
+    EXPECT_FALSE(set.insert(4).second);
+
+    using Set = inline_flat_hash_set<int, 2>;
+    const std::vector<int> input = {1, 2, 3};
+    EXPECT_THROW(Set(input.begin(), input.end()), std::length_error);
+}
+
+TEST(InlineFlatHashSetTest, IteratesEveryElement) {
+    inline_flat_hash_set<std::string, 10> set = {"a", "b", "c", "a"};
+    std::set<std::string> seen(set.begin(), set.end());
+    EXPECT_EQ(seen, (std::set<std::string>{"a", "b", "c"}));
+
+    for (auto it = set.begin(); it != set.end();) {
+        it = *it == "b" ? set.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_FALSE(set.contains("b"));
+}
+
+// =========================================================================
+// 2. Erasure Keeps Probe Runs Intact
+// =========================================================================
+
+TEST(InlineFlatHashSetTest, CollidingKeys) {
+    inline_flat_hash_set<int, 40, BadHash> set;
+    for (int i = 0; i < 40; ++i) {
+        set.insert(i);
+    }
+    for (int i = 0; i < 40; i += 3) {
+        ASSERT_EQ(set.erase_element(i), 1);
+    }
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_EQ(set.contains(i), i % 3 != 0) << i;
+    }
+}
+
+TEST(InlineFlatHashSetTest, MatchesReferenceUnderChurn) {
+    inline_flat_hash_set<int, 56> set;
+    std::set<int> reference;
+    std::mt19937 rng(7);
+    for (int step = 0; step < 200000; ++step) {
+        const int key = static_cast<int>(rng() % 200);
+        if (rng() % 2 == 0 && reference.size() < 56) {
+            ASSERT_EQ(set.insert(key).second, reference.insert(key).second);
+        } else {
+            ASSERT_EQ(set.erase_element(key), reference.erase(key));
+        }
+        ASSERT_EQ(set.size(), reference.size());
+    }
+    for (int key = 0; key < 200; ++key) {
+        ASSERT_EQ(set.contains(key), reference.count(key) == 1);
+    }
+}
+
+// =========================================================================
+// 3. Copies, Moves and Relocation
+// =========================================================================
+
+TEST(InlineFlatHashSetTest, CopyAndMoveStrings) {
+    inline_flat_hash_set<std::string, 8> a = {"x", "y", "z"};
+    inline_flat_hash_set<std::string, 8> b(a);
+    inline_flat_hash_set<std::string, 8> c(std::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.size(), 3);
+    EXPECT_EQ(c.size(), 3);
+
+    b.erase_element("x");
+    c = b;
+    EXPECT_FALSE(c.contains("x"));
+    EXPECT_TRUE(c.contains("y"));
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 2);
+}
+
+TEST(InlineFlatHashSetTest, RelocatesAsBytes) {
+    inline_flat_hash_set<int, 16> set = {5, 6, 7};
+    alignas(inline_flat_hash_set<int, 16>) unsigned char
+        buffer[sizeof(inline_flat_hash_set<int, 16>)];
+    std::memcpy(buffer, &set, sizeof(set));
+    const auto* copy =
+        reinterpret_cast<const inline_flat_hash_set<int, 16>*>(buffer);
+    EXPECT_EQ(copy->size(), 3);
+    EXPECT_TRUE(copy->contains(6));
+
+    std::vector<inline_flat_hash_set<int, 16>> sets(100);
+    for (int i = 0; i < 100; ++i) {
+        sets[i].insert(i);
+    }
+    sets.resize(1000);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(sets[i].contains(i));
+    }
+}
+
+TEST(InlineFlatHashSetTest, TracksLifecycles) {
+    LifecycleTracker::reset();
+    {
+        inline_flat_hash_set<LifecycleTracker, 32, LifecycleHasher> set;
+        for (int i = 0; i < 32; ++i) {
+            set.emplace(i);
+        }
+        EXPECT_THROW(set.emplace(100), std::length_error);
+        for (int i = 0; i < 32; i += 2) {
+            set.erase_element(LifecycleTracker(i));
+        }
+        auto copy = set;
+        auto moved = std::move(copy);
+        EXPECT_EQ(moved.size(), 16);
+        set.clear();
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
+
+TEST(InlineFlatHashSetTest, ThrowingCopyConstructionDestroysCopies) {
+    Fragile::live = 0;
+    {
+        inline_flat_hash_set<Fragile, 8, FragileHash> set;
+        for (int i = 0; i < 5; ++i) {
+            set.emplace(i);
+        }
+        EXPECT_EQ(Fragile::live, 5);
+
+        // The third copy throws.
+        Fragile::copies_left = 2;
+        EXPECT_THROW(
+            {
+                const auto copy = set;
+                (void)copy;
+            },
+            std::runtime_error);
+        EXPECT_EQ(Fragile::live, 5);
+    }
+    EXPECT_EQ(Fragile::live, 0);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <hmm/lru-cache.hpp>
+
+// Std
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::lru_cache;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Lists the keys of a cache from the most to the least recently used.
+template <class Cache> std::vector<int> Order(const Cache& cache) {
+    std::vector<int> out;
+    cache.for_each([&](const auto& v) { out.push_back(v.first); });
+    return out;
+}
+
+} // namespace
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(LruCacheTest, PutAndGet) {
+    lru_cache<std::string, int> cache(4);
+
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.capacity(), 4);
+    EXPECT_TRUE(cache.put("one", 1));
+    EXPECT_TRUE(cache.put("two", 2));
+    EXPECT_FALSE(cache.put("one", 10));
+
+    ASSERT_NE(cache.get("one"), nullptr);
+    EXPECT_EQ(*cache.get("one"), 10);
+    EXPECT_EQ(cache.get("three"), nullptr);
+    EXPECT_EQ(cache.size(), 2);
+
+    *cache.get("two") = 20;
+    EXPECT_EQ(*cache.peek("two"), 20);
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+    lru_cache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    EXPECT_EQ(Order(cache), (std::vector<int>{3, 2, 1}));
+
+    // Touching 1 makes 2 the eviction victim.
+    EXPECT_NE(cache.get(1), nullptr);
+    cache.put(4, 4);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(Order(cache), (std::vector<int>{4, 1, 3}));
+
+    // Peeking does not refresh recency.
+    EXPECT_NE(cache.peek(3), nullptr);
+    cache.put(5, 5);
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_EQ(Order(cache), (std::vector<int>{5, 4, 1}));
+}
+
+TEST(LruCacheTest, EraseAndClear) {
+    lru_cache<int, std::string> cache(3);
+    cache.put(1, "a");
+    cache.put(2, "b");
+    cache.put(3, "c");
+
+    EXPECT_TRUE(cache.erase(2));
+    EXPECT_FALSE(cache.erase(2));
+    EXPECT_EQ(Order(cache), (std::vector<int>{3, 1}));
+
+    // The freed entry is reused without evicting.
+    cache.put(4, "d");
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_TRUE(cache.contains(1));
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    cache.put(5, "e");
+    EXPECT_EQ(Order(cache), (std::vector<int>{5}));
+}
+
+TEST(LruCacheTest, ZeroCapacity) {
+    lru_cache<int, int> cache(0);
+    EXPECT_FALSE(cache.put(1, 1));
+    EXPECT_EQ(cache.get(1), nullptr);
+    EXPECT_TRUE(cache.empty());
+}
+
+// =========================================================================
+// 2. Copy and Move
+// =========================================================================
+
+TEST(LruCacheTest, CopyKeepsRecency) {
+    lru_cache<int, std::string> cache(3);
+    cache.put(1, "a");
+    cache.put(2, "b");
+    cache.put(3, "c");
+    (void)cache.get(1);
+
+    lru_cache<int, std::string> copy(cache);
+    EXPECT_EQ(Order(copy), Order(cache));
+    copy.put(4, "d");
+    EXPECT_FALSE(copy.contains(2));
+    EXPECT_TRUE(cache.contains(2));
+
+    lru_cache<int, std::string> moved(std::move(copy));
+    EXPECT_EQ(Order(moved), (std::vector<int>{4, 1, 3}));
+    EXPECT_EQ(copy.capacity(), 0);
+    EXPECT_TRUE(Order(copy).empty());
+
+    copy = cache;
+    EXPECT_EQ(Order(copy), Order(cache));
+}
+
+// =========================================================================
+// 3. Stress
+// =========================================================================
+
+TEST(LruCacheTest, MatchesReferenceModel) {
+    const int capacity = 100;
+    lru_cache<int, int> cache(capacity);
+    std::vector<int> model; // Most recent first
+
+    unsigned state = 12345;
+    for (int step = 0; step < 50000; ++step) {
+        state = state * 1103515245u + 12345u;
+        const int key = static_cast<int>((state >> 8) % 300);
+
+        auto pos = std::find(model.begin(), model.end(), key);
+        if (step % 3 == 0) {
+            const bool hit = cache.get(key) != nullptr;
+            ASSERT_EQ(hit, pos != model.end());
+            if (hit) {
+                model.erase(pos);
+                model.insert(model.begin(), key);
+            }
+        } else {
+            cache.put(key, step);
+            if (pos != model.end()) {
+                model.erase(pos);
+            } else if (static_cast<int>(model.size()) == capacity) {
+                model.pop_back();
+            }
+            model.insert(model.begin(), key);
+        }
+    }
+    EXPECT_EQ(Order(cache), model);
+}
+
+TEST(LruCacheTest, NoAllocationAfterConstruction) {
+    lru_cache<int, int, hmm::CityHash<int>, std::equal_to<int>,
+              CountingAllocator<std::pair<int, int>>>
+        cache(1000);
+    const int before = AllocationCounter::allocations.load();
+
+    // Steady eviction leaves tombstones in the index, which must be purged
+    // within its allocation.
+    for (int i = 0; i < 200000; ++i) {
+        cache.put(i, i);
+        if (i % 3 == 0) {
+            (void)cache.get(i / 2);
+            cache.erase(i - 500);
+        }
+    }
+
+    EXPECT_EQ(AllocationCounter::allocations.load(), before);
+    EXPECT_EQ(*cache.get(199999), 199999);
+}
+
+// =========================================================================
+// 4. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(LruCacheTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+    {
+        lru_cache<LifecycleTracker, int, LifecycleHasher> cache(16);
+        for (int i = 0; i < 1000; ++i) {
+            cache.put(LifecycleTracker(i), i);
+            if (i % 7 == 0) {
+                cache.erase(LifecycleTracker(i - 3));
+            }
+        }
+        lru_cache<LifecycleTracker, int, LifecycleHasher> copy(cache);
+        EXPECT_EQ(*copy.get(LifecycleTracker(999)), 999);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
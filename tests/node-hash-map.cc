@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <hmm/node-hash-map.hpp>
+
+// Std
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::node_hash_map;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Construction and Assignment
+// =========================================================================
+
+TEST(NodeHashMapTest, InitializerListConstruction) {
+    node_hash_map<std::string, int> map{{"One", 1}, {"Two", 2}, {"Three", 3}};
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at("One"), 1);
+    EXPECT_EQ(map.at("Two"), 2);
+    EXPECT_EQ(map.at("Three"), 3);
+}
+
+TEST(NodeHashMapTest, CopyConstruction) {
+    node_hash_map<int, int> original{{1, 100}, {2, 200}};
+    node_hash_map<int, int> copy = original;
+
+    // Copies must own their own nodes
+    copy[1] = 999;
+    EXPECT_EQ(original.at(1), 100);
+    EXPECT_EQ(copy.at(1), 999);
+}
+
+TEST(NodeHashMapTest, MoveConstruction) {
+    node_hash_map<std::string, std::string> source{{"key", "value"}};
+    const std::string* value = &source.at("key");
+
+    node_hash_map<std::string, std::string> dest = std::move(source);
+
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(&dest.at("key"), value);
+}
+
+// =========================================================================
+// 2. Pointer Stability
+// =========================================================================
+
+TEST(NodeHashMapTest, ReferencesSurviveRehash) {
+    node_hash_map<int, std::string> map;
+    std::vector<std::pair<const int, std::string>*> addresses;
+
+    for (int i = 0; i < 1000; ++i) {
+        auto res = map.try_emplace(i, std::to_string(i));
+        ASSERT_TRUE(res.second);
+        addresses.push_back(&*res.first);
+    }
+
+    // Many rehashes have happened since the first insertions
+    for (int i = 0; i < 1000; ++i) {
+        auto it = map.find(i);
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(&*it, addresses[i]);
+        EXPECT_EQ(addresses[i]->second, std::to_string(i));
+    }
+}
+
+// =========================================================================
+// 3. Element Access and Erasure
+// =========================================================================
+
+TEST(NodeHashMapTest, SubscriptAndAt) {
+    node_hash_map<int, std::string> map;
+    map[1] = "One";
+    map[1] = "Uno";
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at(1), "Uno");
+    EXPECT_THROW((void)map.at(2), std::out_of_range);
+}
+
+TEST(NodeHashMapTest, EraseByKey) {
+    node_hash_map<int, int> map{{1, 10}, {2, 20}, {3, 30}};
+    const int* kept = &map.at(3);
+
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_EQ(map.erase(2), 0);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(&map.at(3), kept);
+}
+
+TEST(NodeHashMapTest, SupportsMoveOnlyTypes) {
+    node_hash_map<int, std::unique_ptr<int>> map;
+    for (int i = 0; i < 100; ++i) {
+        map.try_emplace(i, std::make_unique<int>(i));
+    }
+    map.reserve(500);
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(*map.at(i), i);
+    }
+}
+
+// =========================================================================
+// 4. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(NodeHashMapTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+
+    {
+        node_hash_map<int, LifecycleTracker> map;
+        map.try_emplace(1, 10);
+        map.try_emplace(2, 20);
+        map.emplace(1, 30); // Duplicate, the freshly built node is released
+        map.reserve(1000);
+        map.erase(2);
+
+        EXPECT_EQ(map.size(), 1);
+    }
+
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
+
+namespace {
+
+/// @brief Throws when asked to hash one chosen key.
+struct ThrowingHash {
+    std::size_t operator()(int key) const {
+        if (key == 13) {
+            throw std::runtime_error("hash");
+        }
+        return std::hash<int>{}(key);
+    }
+};
+
+} // namespace
+
+TEST(NodeHashMapTest, ThrowingHashReleasesTheNewNode) {
+    LifecycleTracker::reset();
+    {
+        node_hash_map<int, LifecycleTracker, ThrowingHash> map;
+        map.emplace(1, 10);
+        EXPECT_THROW(map.emplace(13, 20), std::runtime_error);
+        EXPECT_EQ(map.size(), 1);
+        EXPECT_TRUE(map.contains(1));
+    }
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
+
+TEST(NodeHashMapTest, DuplicateEmplaceNeverGrows) {
+    node_hash_map<int, int> map;
+    map.emplace(0, 0);
+    for (int i = 1; i < 100; ++i) {
+        const auto cap = map.capacity();
+        EXPECT_FALSE(map.emplace(0, i).second);
+        ASSERT_EQ(map.capacity(), cap);
+        map.emplace(i, i);
+    }
+    EXPECT_EQ(map.size(), 100);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <hmm/node-hash-set.hpp>
+
+// Std
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::node_hash_set;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Construction and Insertion
+// =========================================================================
+
+TEST(NodeHashSetTest, InitializerListConstruction) {
+    node_hash_set<std::string> set{"A", "B", "C"};
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_TRUE(set.contains("A"));
+    EXPECT_FALSE(set.contains("D"));
+}
+
+TEST(NodeHashSetTest, InsertReturnValue) {
+    node_hash_set<int> set;
+
+    auto res1 = set.insert(10);
+    EXPECT_TRUE(res1.second);
+    EXPECT_EQ(*res1.first, 10);
+
+    auto res2 = set.insert(10);
+    EXPECT_FALSE(res2.second);
+    EXPECT_EQ(&*res2.first, &*res1.first);
+}
+
+TEST(NodeHashSetTest, CopyConstruction) {
+    node_hash_set<int> original{1, 2, 3};
+    node_hash_set<int> copy = original;
+
+    copy.insert(4);
+    EXPECT_EQ(copy.size(), 4);
+    EXPECT_FALSE(original.contains(4));
+    EXPECT_NE(&*copy.find(1), &*original.find(1));
+}
+
+// =========================================================================
+// 2. Pointer Stability
+// =========================================================================
+
+TEST(NodeHashSetTest, AddressesSurviveRehash) {
+    node_hash_set<std::string> set;
+    std::vector<const std::string*> addresses;
+
+    for (int i = 0; i < 1000; ++i) {
+        addresses.push_back(&*set.insert(std::to_string(i)).first);
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(&*set.find(std::to_string(i)), addresses[i]);
+    }
+}
+
+// =========================================================================
+// 3. Collisions and Lifetime
+// =========================================================================
+
+TEST(NodeHashSetTest, MassiveCollisions) {
+    node_hash_set<int, BadHash> set;
+    for (int i = 0; i < 50; ++i) {
+        set.insert(i);
+    }
+
+    set.erase(set.find(25));
+    EXPECT_FALSE(set.contains(25));
+    EXPECT_TRUE(set.contains(26));
+    EXPECT_EQ(set.size(), 49);
+}
+
+TEST(NodeHashSetTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+
+    {
+        node_hash_set<LifecycleTracker, LifecycleHasher> set;
+        set.emplace(10);
+        set.emplace(20);
+        set.emplace(10); // Duplicate
+
+        EXPECT_EQ(set.size(), 2);
+    }
+
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
@@ -0,0 +1,397 @@
+#include <gtest/gtest.h>
+
+#include <hmm/parallel-flat-hash-map.hpp>
+
+// Std
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::parallel_flat_hash_map;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Sends key `k` to shard `k % 4` of a map with four shards.
+struct ShardOfKeyHash {
+    std::size_t operator()(int key) const {
+        return (std::size_t(key % 4) << (sizeof(std::size_t) * 8 - 9)) |
+               std::size_t(key);
+    }
+};
+
+} // namespace
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(ParallelFlatHashMapTest, InsertAndLookup) {
+    parallel_flat_hash_map<std::string, int> map{{"one", 1}, {"two", 2}};
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_TRUE(map.contains("one"));
+    EXPECT_FALSE(map.contains("three"));
+    EXPECT_FALSE(map.insert({"one", 100}));
+    EXPECT_TRUE(map.emplace("three", 3));
+    EXPECT_FALSE(map.try_emplace("three", 30));
+
+    int seen = 0;
+    EXPECT_TRUE(
+        map.if_contains("three", [&](const auto& v) { seen = v.second; }));
+    EXPECT_EQ(seen, 3);
+}
+
+TEST(ParallelFlatHashMapTest, SpreadsAcrossShards) {
+    parallel_flat_hash_map<int, int> map;
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(map.try_emplace(i, i));
+    }
+    EXPECT_EQ(map.size(), 10000);
+    EXPECT_EQ(map.subcnt(), 16);
+
+    long long sum = 0;
+    map.for_each([&](const auto& v) { sum += v.second; });
+    EXPECT_EQ(sum, 10000LL * 9999 / 2);
+}
+
+// =========================================================================
+// 2. Callback Interfaces
+// =========================================================================
+
+TEST(ParallelFlatHashMapTest, ModifyAndEraseIf) {
+    parallel_flat_hash_map<int, int> map{{1, 10}, {2, 20}};
+
+    EXPECT_TRUE(map.modify_if(1, [](auto& v) { v.second += 5; }));
+    EXPECT_FALSE(map.modify_if(3, [](auto& v) { v.second += 5; }));
+
+    EXPECT_FALSE(map.erase_if(1, [](auto& v) { return v.second != 15; }));
+    EXPECT_TRUE(map.erase_if(1, [](auto& v) { return v.second == 15; }));
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_EQ(map.erase(2), 0);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ParallelFlatHashMapTest, LockFreeAtomicUpdatesWithErases) {
+    // One shard, so that every insert, erase and rehash restructures the
+    // table the hot keys live in.
+    parallel_flat_hash_map<int, std::atomic<long>, hmm::CityHash<int>,
+                           std::equal_to<int>,
+                           std::allocator<std::pair<int, long>>, 0>
+        map;
+    const int updaters = 4;
+    const int rounds = 50000;
+
+    std::atomic<bool> done{false};
+    std::thread churn([&map, &done] {
+        for (int i = 0; !done.load(); ++i) {
+            map.add(100 + i % 3000, 1L);
+            if (i % 2 == 1) {
+                map.erase(100 + (i / 2) % 3000);
+            }
+            if (i % 5000 == 4999) {
+                map.reserve(static_cast<std::size_t>(i % 7) * 1000);
+            }
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int t = 0; t < updaters; ++t) {
+        workers.emplace_back([&map] {
+            for (int i = 0; i < rounds; ++i) {
+                map.add(i % 8, 1L);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    done.store(true);
+    churn.join();
+
+    for (int key = 0; key < 8; ++key) {
+        long value = 0;
+        ASSERT_TRUE(map.if_contains(key, [&](const auto& v) {
+            value = v.second.load();
+        }));
+        EXPECT_EQ(value, long(updaters) * rounds / 8) << key;
+    }
+}
+
+TEST(ParallelFlatHashMapTest, LazyEmplaceRunsOneCallback) {
+    parallel_flat_hash_map<int, std::string> map;
+    int constructed = 0;
+    int existed = 0;
+
+    for (int round = 0; round < 3; ++round) {
+        map.lazy_emplace_l(
+            7, [&](auto&) { ++existed; },
+            [&](const auto& ctor) {
+                ++constructed;
+                ctor(7, "seven");
+            });
+    }
+
+    EXPECT_EQ(constructed, 1);
+    EXPECT_EQ(existed, 2);
+    EXPECT_TRUE(map.insert_or_assign(8, "eight"));
+    EXPECT_FALSE(map.insert_or_assign(8, "VIII"));
+
+    std::string value;
+    map.if_contains(8, [&](const auto& v) { value = v.second; });
+    EXPECT_EQ(value, "VIII");
+}
+
+// =========================================================================
+// 3. Concurrency
+// =========================================================================
+
+TEST(ParallelFlatHashMapTest, ConcurrentCounting) {
+    parallel_flat_hash_map<int, int> map;
+    const int threads = 8;
+    const int keys = 1000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&map] {
+            for (int i = 0; i < keys; ++i) {
+                map.try_emplace_l(i, [](auto& v) { ++v.second; }, 1);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(map.size(), keys);
+    map.for_each([&](const auto& v) { EXPECT_EQ(v.second, threads); });
+}
+
+TEST(ParallelFlatHashMapTest, SharedMutexReaders) {
+    parallel_flat_hash_map<int, int, hmm::CityHash<int>, std::equal_to<int>,
+                           std::allocator<std::pair<int, int>>, 3,
+                           std::shared_mutex>
+        map;
+    for (int i = 0; i < 1000; ++i) {
+        map.try_emplace(i, i * 2);
+    }
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&map] {
+            for (int i = 0; i < 1000; ++i) {
+                int value = -1;
+                EXPECT_TRUE(map.if_contains(
+                    i, [&](const auto& v) { value = v.second; }));
+                EXPECT_EQ(value, i * 2);
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
+
+TEST(ParallelFlatHashMapTest, NullMutex) {
+    parallel_flat_hash_map<int, int, hmm::CityHash<int>, std::equal_to<int>,
+                           std::allocator<std::pair<int, int>>, 2,
+                           hmm::null_mutex>
+        map;
+    for (int i = 0; i < 100; ++i) {
+        map.try_emplace(i, i);
+    }
+    EXPECT_EQ(map.size(), 100);
+    EXPECT_EQ(map.subcnt(), 4);
+}
+
+// =========================================================================
+// 4. Object Lifetime (Leak Check)
+// =========================================================================
+
+TEST(ParallelFlatHashMapTest, ObjectLifetimeAndLeaks) {
+    LifecycleTracker::reset();
+
+    {
+        parallel_flat_hash_map<int, LifecycleTracker> map;
+        for (int i = 0; i < 200; ++i) {
+            map.try_emplace(i, i);
+            map.emplace(i, i); // Duplicate
+        }
+        map.erase(5);
+        EXPECT_EQ(map.size(), 199);
+    }
+
+    EXPECT_EQ(LifecycleTracker::constructions, LifecycleTracker::destructions);
+}
+
+TEST(ParallelFlatHashMapTest, DuplicateEmplaceOfAtomicValues) {
+    AllocationCounter::reset();
+    {
+        // Atomic values live in nodes, built before the key is looked up.
+        parallel_flat_hash_map<int, std::atomic<int>, hmm::CityHash<int>,
+                               std::equal_to<int>,
+                               CountingAllocator<std::pair<int, int>>>
+            map;
+        EXPECT_TRUE(map.emplace(1, 5));
+        EXPECT_FALSE(map.emplace(1, 6));
+        EXPECT_FALSE(map.emplace(1, 7));
+
+        int value = 0;
+        map.if_contains(1, [&](const auto& v) { value = v.second.load(); });
+        EXPECT_EQ(value, 5);
+        EXPECT_EQ(map.size(), 1);
+    }
+    EXPECT_EQ(AllocationCounter::live_blocks.load(), 0);
+}
+
+// =========================================================================
+// 5. In-Place Updates
+// =========================================================================
+
+TEST(ParallelFlatHashMapTest, AddComputeAndUpdateOrInsert) {
+    parallel_flat_hash_map<std::string, int> map;
+
+    EXPECT_TRUE(map.add("a", 5));
+    EXPECT_FALSE(map.add("a", 3));
+
+    EXPECT_TRUE(map.compute("b", [](int& v) { v += 10; }));
+    EXPECT_FALSE(map.compute("b", [](int& v) { v *= 2; }));
+
+    EXPECT_TRUE(map.update_or_insert("c", 1, [](int& v) { v = -1; }));
+    EXPECT_FALSE(map.update_or_insert("c", 1, [](int& v) { v = 42; }));
+
+    int a = 0;
+    int b = 0;
+    int c = 0;
+    map.if_contains("a", [&](const auto& v) { a = v.second; });
+    map.if_contains("b", [&](const auto& v) { b = v.second; });
+    map.if_contains("c", [&](const auto& v) { c = v.second; });
+    EXPECT_EQ(a, 8);
+    EXPECT_EQ(b, 20);
+    EXPECT_EQ(c, 42);
+}
+
+TEST(ParallelFlatHashMapTest, ConcurrentAdd) {
+    parallel_flat_hash_map<int, long> map;
+    const int threads = 8;
+    const int keys = 500;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&map] {
+            for (int i = 0; i < keys * 4; ++i) {
+                map.add(i % keys, 1L);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(map.size(), keys);
+    map.for_each([&](const auto& v) { EXPECT_EQ(v.second, threads * 4); });
+}
+
+TEST(ParallelFlatHashMapTest, AtomicValuesUnderSharedLock) {
+    parallel_flat_hash_map<int, std::atomic<long>, hmm::CityHash<int>,
+                           std::equal_to<int>,
+                           std::allocator<std::pair<int, long>>, 2,
+                           std::shared_mutex>
+        map;
+    const int threads = 8;
+    const int rounds = 20000;
+
+    // A few hot keys take most of the traffic; the rest force rehashes while
+    // other threads update the hot values.
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&map, t] {
+            for (int i = 0; i < rounds; ++i) {
+                map.add(i % 4, 1L);
+                if (i % 8 == 0) {
+                    const int key = 1000 + t * rounds + i;
+                    map.compute(key, [](std::atomic<long>& v) {
+                        v.fetch_add(2, std::memory_order_relaxed);
+                    });
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(map.size(), 4 + threads * rounds / 8);
+    long hot = 0;
+    long cold = 0;
+    map.for_each([&](const auto& v) {
+        (v.first < 4 ? hot : cold) += v.second.load();
+    });
+    EXPECT_EQ(hot, long(threads) * rounds);
+    EXPECT_EQ(cold, 2L * threads * rounds / 8);
+
+    EXPECT_FALSE(map.update_or_insert(2, 0L, [](std::atomic<long>& v) {
+        v.store(-1);
+    }));
+    long two = 0;
+    map.if_contains(2, [&](const auto& v) { two = v.second.load(); });
+    EXPECT_EQ(two, -1);
+    EXPECT_EQ(map.erase(2), 1);
+}
+
+TEST(ParallelFlatHashMapTest, InsertsWaitOnlyForUpdatesToTheirShard) {
+    parallel_flat_hash_map<int, std::atomic<long>, ShardOfKeyHash,
+                           std::equal_to<int>,
+                           std::allocator<std::pair<int, long>>, 2>
+        map;
+    map.add(0, 1L);
+
+    // Park a lock-free update in shard 0.
+    std::atomic<bool> parked{false};
+    std::atomic<bool> released{false};
+    std::thread updater([&] {
+        map.compute(0, [&](std::atomic<long>& v) {
+            parked = true;
+            while (!released.load()) {
+                std::this_thread::yield();
+            }
+            v.fetch_add(1);
+        });
+    });
+    while (!parked.load()) {
+        std::this_thread::yield();
+    }
+
+    // Inserts and erases in shard 1 go ahead meanwhile.
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int key = 1; key < 4000; key += 4) {
+            map.add(key, 1L);
+        }
+        for (int key = 1; key < 4000; key += 8) {
+            map.erase(key);
+        }
+        done = true;
+    });
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(done.load());
+
+    released = true;
+    updater.join();
+    writer.join();
+    EXPECT_EQ(map.size(), 1 + 500);
+    long zero = 0;
+    map.if_contains(0, [&](const auto& v) { zero = v.second.load(); });
+    EXPECT_EQ(zero, 2);
+}
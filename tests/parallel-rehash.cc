@@ -0,0 +1,480 @@
+#include <gtest/gtest.h>
+
+#include <hmm/executor.hpp>
+#include <hmm/flat-hash-map.hpp>
+#include <hmm/flat-hash-multiset.hpp>
+#include <hmm/flat-hash-set.hpp>
+#include <hmm/node-hash-map.hpp>
+
+// Std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::flat_hash_map;
+using hmm::flat_hash_multiset;
+using hmm::flat_hash_set;
+using hmm::node_hash_map;
+using hmm::thread_executor;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Collects the elements of a table in iteration order, which mirrors
+/// the slot layout.
+template <class Table> auto Layout(const Table& table) {
+    std::vector<typename Table::value_type> out;
+    for (const auto& v : table) {
+        out.push_back(v);
+    }
+    return out;
+}
+
+/// @brief Runs everything on the calling thread, in reverse order.
+struct ReverseExecutor {
+    std::size_t concurrency() const {
+        return 3;
+    }
+
+    template <class F> void parallel_for(std::size_t n, F&& f) const {
+        for (std::size_t i = n; i-- > 0;) {
+            f(i);
+        }
+    }
+};
+
+/// @brief Hashes every key into one of a few home slots to force long probes
+/// that cross partitions.
+struct ClusteredHash {
+    std::size_t operator()(int key) const {
+        return static_cast<std::size_t>(key % 7) * 4093;
+    }
+};
+
+/// @brief Throws on the Nth call once armed, counting across copies.
+struct CountdownHash {
+    static std::atomic<int> calls_left;
+
+    std::size_t operator()(int key) const {
+        if (calls_left.fetch_sub(1) == 1) {
+            throw std::runtime_error("hash");
+        }
+        return std::hash<int>{}(key) * 0x9E3779B97F4A7C15ULL;
+    }
+};
+
+std::atomic<int> CountdownHash::calls_left{0};
+
+} // namespace
+
+// =========================================================================
+// 1. Executor
+// =========================================================================
+
+TEST(ThreadExecutorTest, VisitsEveryIndexOnce) {
+    thread_executor exec(4);
+    std::vector<std::atomic<int>> hits(1000);
+    exec.parallel_for(hits.size(), [&](std::size_t i) { ++hits[i]; });
+
+    for (const auto& h : hits) {
+        EXPECT_EQ(h.load(), 1);
+    }
+}
+
+TEST(ThreadExecutorTest, RethrowsWorkerException) {
+    thread_executor exec(4);
+    EXPECT_THROW(exec.parallel_for(100,
+                                   [](std::size_t i) {
+                                       if (i == 42) {
+                                           throw std::runtime_error("boom");
+                                       }
+                                   }),
+                 std::runtime_error);
+}
+
+TEST(ThreadExecutorTest, ZeroTasks) {
+    thread_executor exec(4);
+    int calls = 0;
+    exec.parallel_for(0, [&](std::size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
+
+// =========================================================================
+// 2. Parallel Rehash Matches Serial Rehash
+// =========================================================================
+
+TEST(ParallelRehashTest, MatchesSerialLayout) {
+    flat_hash_map<int, std::string> serial;
+    flat_hash_map<int, std::string> parallel;
+    for (int i = 0; i < 100000; ++i) {
+        serial.emplace(i, std::to_string(i));
+        parallel.emplace(i, std::to_string(i));
+    }
+    ASSERT_EQ(Layout(serial), Layout(parallel));
+
+    thread_executor exec(4);
+    serial.reserve(1000000);
+    parallel.reserve_parallel(1000000, exec);
+
+    EXPECT_EQ(serial.capacity(), parallel.capacity());
+    EXPECT_EQ(parallel.size(), 100000);
+    EXPECT_EQ(Layout(serial), Layout(parallel));
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(parallel.at(i), std::to_string(i));
+    }
+}
+
+TEST(ParallelRehashTest, LayoutIndependentOfExecutor) {
+    flat_hash_set<int> a;
+    flat_hash_set<int> b;
+    for (int i = 0; i < 50000; ++i) {
+        a.insert(i * 31);
+        b.insert(i * 31);
+    }
+
+    thread_executor exec(3);
+    ReverseExecutor reverse;
+    a.reserve_parallel(400000, exec);
+    b.reserve_parallel(400000, reverse);
+    EXPECT_EQ(Layout(a), Layout(b));
+}
+
+TEST(ParallelRehashTest, ClusteredHashesOverflowPartitions) {
+    flat_hash_set<int, ClusteredHash> serial;
+    flat_hash_set<int, ClusteredHash> parallel;
+    for (int i = 0; i < 20000; ++i) {
+        serial.insert(i);
+        parallel.insert(i);
+    }
+
+    thread_executor exec(4);
+    serial.reserve(200000);
+    parallel.reserve_parallel(200000, exec);
+
+    EXPECT_EQ(Layout(serial), Layout(parallel));
+    for (int i = 0; i < 20000; ++i) {
+        ASSERT_TRUE(parallel.contains(i));
+    }
+}
+
+TEST(ParallelRehashTest, AllCollisions) {
+    flat_hash_set<int, BadHash> serial;
+    flat_hash_set<int, BadHash> parallel;
+    for (int i = 0; i < 500; ++i) {
+        serial.insert(i);
+        parallel.insert(i);
+    }
+
+    thread_executor exec(4);
+    serial.reserve(5000);
+    parallel.reserve_parallel(5000, exec);
+
+    EXPECT_EQ(Layout(serial), Layout(parallel));
+    EXPECT_EQ(parallel.size(), 500);
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_TRUE(parallel.contains(i));
+    }
+}
+
+TEST(ParallelRehashTest, ThrowingHasherKeepsElements) {
+    CountdownHash::calls_left = -1;
+    flat_hash_set<int, CountdownHash> set;
+    for (int i = 0; i < 10000; ++i) {
+        set.insert(i);
+    }
+    const auto cap = set.capacity();
+
+    thread_executor exec(4);
+    CountdownHash::calls_left = 5000;
+    EXPECT_THROW(set.reserve_parallel(100000, exec), std::runtime_error);
+
+    CountdownHash::calls_left = -1;
+    EXPECT_EQ(set.capacity(), cap);
+    EXPECT_EQ(set.size(), 10000);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(set.contains(i));
+    }
+}
+
+// =========================================================================
+// 3. Other Tables
+// =========================================================================
+
+TEST(ParallelRehashTest, NodeMapKeepsAddresses) {
+    node_hash_map<int, int> map;
+    for (int i = 0; i < 10000; ++i) {
+        map.emplace(i, i * 2);
+    }
+    const int* addr = &map.at(1234);
+
+    thread_executor exec(4);
+    map.reserve_parallel(100000, exec);
+    EXPECT_EQ(&map.at(1234), addr);
+    EXPECT_EQ(map.size(), 10000);
+}
+
+TEST(ParallelRehashTest, MultisetKeepsDuplicates) {
+    flat_hash_multiset<int> set;
+    for (int i = 0; i < 30000; ++i) {
+        set.insert(i % 1000);
+    }
+
+    thread_executor exec(4);
+    set.reserve_parallel(300000, exec);
+    EXPECT_EQ(set.size(), 30000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(set.count(i), 30);
+    }
+}
+
+TEST(ParallelRehashTest, TracksLifecycles) {
+    LifecycleTracker::reset();
+    {
+        flat_hash_set<LifecycleTracker, LifecycleHasher> set;
+        for (int i = 0; i < 2000; ++i) {
+            set.emplace(i);
+        }
+        // The tracker counts are not atomic, so stay on one thread.
+        ReverseExecutor exec;
+        set.reserve_parallel(40000, exec);
+        EXPECT_EQ(set.size(), 2000);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
+
+TEST(ParallelRehashTest, EmptyAndSmallerRequests) {
+    flat_hash_map<int, int> map;
+    thread_executor exec(2);
+    map.reserve_parallel(1000, exec);
+    EXPECT_GE(map.capacity(), 1000);
+    EXPECT_TRUE(map.empty());
+
+    map.emplace(1, 1);
+    const auto cap = map.capacity();
+    map.reserve_parallel(10, exec);
+    EXPECT_EQ(map.capacity(), cap);
+    EXPECT_EQ(map.at(1), 1);
+}
+
+// =========================================================================
+// 4. Parallel Bulk Insertion
+// =========================================================================
+
+namespace {
+
+/// @brief Places every key at its own value's slot.
+struct IdentityHash {
+    std::size_t operator()(std::uint64_t key) const {
+        return static_cast<std::size_t>(key);
+    }
+};
+
+/// @brief Throws when copied with a chosen value, to interrupt a bulk insert.
+struct ThrowOnCopy {
+    int val;
+
+    explicit ThrowOnCopy(int v) : val(v) {}
+    ThrowOnCopy(const ThrowOnCopy& o) : val(o.val) {
+        if (val == 777) {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    bool operator==(const ThrowOnCopy& other) const {
+        return val == other.val;
+    }
+};
+
+struct ThrowOnCopyHash {
+    std::size_t operator()(const ThrowOnCopy& t) const {
+        return std::hash<int>{}(t.val) * 0x9E3779B97F4A7C15ULL;
+    }
+};
+
+} // namespace
+
+TEST(InsertParallelTest, BuildMapFromRange) {
+    std::vector<std::pair<int, std::string>> input;
+    for (int i = 0; i < 200000; ++i) {
+        input.emplace_back(i, std::to_string(i));
+    }
+
+    auto map = hmm::build_parallel<flat_hash_map<int, std::string>>(
+        input.begin(), input.end(), 4);
+
+    EXPECT_EQ(map.size(), input.size());
+    for (const auto& kv : input) {
+        ASSERT_EQ(map.at(kv.first), kv.second);
+    }
+}
+
+TEST(InsertParallelTest, FirstDuplicateWins) {
+    std::vector<std::pair<int, int>> input;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 50000; ++i) {
+            input.emplace_back(i, round);
+        }
+    }
+
+    flat_hash_map<int, int> map;
+    map.emplace(7, -1);
+    thread_executor exec(4);
+    map.insert_parallel(input.begin(), input.end(), exec);
+
+    EXPECT_EQ(map.size(), 50000);
+    EXPECT_EQ(map.at(7), -1);
+    for (int i = 0; i < 50000; ++i) {
+        if (i != 7) {
+            ASSERT_EQ(map.at(i), 0);
+        }
+    }
+}
+
+TEST(InsertParallelTest, MatchesSerialInsertContents) {
+    std::vector<int> input;
+    for (int i = 0; i < 100000; ++i) {
+        input.push_back((i * 7919) % 60000);
+    }
+
+    flat_hash_set<int> serial(input.begin(), input.end());
+    flat_hash_set<int> parallel;
+    thread_executor exec(4);
+    parallel.insert_parallel(input.begin(), input.end(), exec);
+
+    EXPECT_EQ(parallel.size(), serial.size());
+    for (int v : serial) {
+        ASSERT_TRUE(parallel.contains(v));
+    }
+}
+
+TEST(InsertParallelTest, CollidingKeysAreDeferred) {
+    std::vector<int> input;
+    for (int i = 0; i < 2000; ++i) {
+        input.push_back(i % 1500);
+    }
+
+    flat_hash_set<int, BadHash> bad;
+    flat_hash_set<int, ClusteredHash> clustered;
+    thread_executor exec(4);
+    bad.insert_parallel(input.begin(), input.end(), exec);
+    clustered.insert_parallel(input.begin(), input.end(), exec);
+
+    EXPECT_EQ(bad.size(), 1500);
+    EXPECT_EQ(clustered.size(), 1500);
+    for (int i = 0; i < 1500; ++i) {
+        ASSERT_TRUE(bad.contains(i));
+        ASSERT_TRUE(clustered.contains(i));
+    }
+}
+
+TEST(InsertParallelTest, ReusesTableWithTombstones) {
+    flat_hash_set<int> set;
+    for (int i = 0; i < 20000; ++i) {
+        set.insert(i);
+    }
+    for (int i = 0; i < 20000; i += 2) {
+        set.erase_element(i);
+    }
+
+    std::vector<int> input;
+    for (int i = 0; i < 30000; ++i) {
+        input.push_back(i);
+    }
+    thread_executor exec(4);
+    set.insert_parallel(input.begin(), input.end(), exec);
+
+    EXPECT_EQ(set.size(), 30000);
+    for (int i = 0; i < 30000; ++i) {
+        ASSERT_TRUE(set.contains(i));
+    }
+}
+
+TEST(InsertParallelTest, NodeMap) {
+    std::vector<std::pair<const int, std::string>> input;
+    for (int i = 0; i < 30000; ++i) {
+        input.emplace_back(i, std::to_string(i));
+    }
+
+    node_hash_map<int, std::string> map;
+    thread_executor exec(4);
+    map.insert_parallel(input.begin(), input.end(), exec);
+
+    EXPECT_EQ(map.size(), input.size());
+    EXPECT_EQ(map.at(12345), "12345");
+}
+
+TEST(InsertParallelTest, ThrowingCopyLeavesConsistentTable) {
+    std::vector<ThrowOnCopy> input;
+    input.reserve(5000);
+    for (int i = 0; i < 5000; ++i) {
+        input.emplace_back(i);
+    }
+
+    flat_hash_set<ThrowOnCopy, ThrowOnCopyHash> set;
+    thread_executor exec(4);
+    EXPECT_THROW(set.insert_parallel(input.begin(), input.end(), exec),
+                 std::runtime_error);
+
+    std::size_t n = 0;
+    for (auto it = set.begin(); it != set.end(); ++it) {
+        ++n;
+    }
+    EXPECT_EQ(n, set.size());
+    EXPECT_FALSE(set.contains(ThrowOnCopy(777)));
+}
+
+TEST(InsertParallelTest, FindsKeysPurgedAcrossPartitions) {
+    constexpr std::uint64_t kCap = 32768;
+    constexpr std::uint64_t kHome = 16380; // 4 slots before a partition
+    flat_hash_set<std::uint64_t, IdentityHash> set;
+    set.reserve(20000);
+    ASSERT_EQ(set.capacity(), kCap);
+
+    // Seven keys homed at kHome fill slots kHome to kHome + 6, the last
+    // three in the next partition.
+    std::vector<std::uint64_t> run;
+    for (std::uint64_t m = 0; m < 7; ++m) {
+        run.push_back(kHome + m * kCap);
+        set.insert(run.back());
+    }
+    // Fill the table to its load limit with keys homed elsewhere.
+    std::vector<std::uint64_t> fillers;
+    for (std::uint64_t k = 0; set.size() < kCap / 8 * 7; ++k) {
+        if (k < kHome - 16 || k > kHome + 16) {
+            fillers.push_back(k);
+            set.insert(k);
+        }
+    }
+    ASSERT_EQ(set.capacity(), kCap);
+
+    // Tombstone everything but the run's tail; the next insert then purges
+    // the tombstones in place, emptying slot kHome.
+    for (std::uint64_t k : fillers) {
+        set.erase_element(k);
+    }
+    set.erase_element(run[0]);
+    for (std::uint64_t k = 0; k < 5; ++k) {
+        set.insert(kHome - 1000 + k);
+    }
+    ASSERT_EQ(set.capacity(), kCap);
+    ASSERT_EQ(set.size(), 11);
+
+    thread_executor exec(2);
+    set.insert_parallel(run.begin() + 1, run.end(), exec);
+    EXPECT_EQ(set.size(), 11);
+    std::size_t n = 0;
+    for (auto it = set.begin(); it != set.end(); ++it) {
+        ++n;
+    }
+    EXPECT_EQ(n, 11);
+    for (std::size_t i = 1; i < run.size(); ++i) {
+        EXPECT_TRUE(set.contains(run[i]));
+    }
+}
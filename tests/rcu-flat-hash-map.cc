@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include <hmm/rcu-flat-hash-map.hpp>
+
+// Std
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::flat_hash_map;
+using hmm::rcu_flat_hash_map;
+using namespace hmm::testing;
+
+// =========================================================================
+// 1. Basic Reads and Writes
+// =========================================================================
+
+TEST(RcuFlatHashMapTest, DefaultConstruction) {
+    rcu_flat_hash_map<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(1));
+
+    int out = 0;
+    EXPECT_FALSE(map.find(1, out));
+}
+
+TEST(RcuFlatHashMapTest, SingleWrites) {
+    rcu_flat_hash_map<std::string, int> map;
+    map.insert_or_assign("a", 1);
+    map.insert_or_assign("b", 2);
+    map.insert_or_assign("a", 3);
+
+    int out = 0;
+    EXPECT_TRUE(map.find("a", out));
+    EXPECT_EQ(out, 3);
+    EXPECT_EQ(map.size(), 2);
+
+    EXPECT_TRUE(map.erase("a"));
+    EXPECT_FALSE(map.erase("a"));
+    EXPECT_FALSE(map.contains("a"));
+    EXPECT_TRUE(map.contains("b"));
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(RcuFlatHashMapTest, BatchedUpdate) {
+    rcu_flat_hash_map<int, int> map;
+    map.update([](flat_hash_map<int, int>& table) {
+        for (int i = 0; i < 1000; ++i) {
+            table.emplace(i, i * i);
+        }
+    });
+
+    EXPECT_EQ(map.size(), 1000);
+    auto snap = map.snapshot();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(snap->at(i), i * i);
+    }
+}
+
+TEST(RcuFlatHashMapTest, PublishReplacesEverything) {
+    rcu_flat_hash_map<int, std::string> map;
+    map.insert_or_assign(1, "old");
+
+    flat_hash_map<int, std::string> rebuilt;
+    rebuilt.emplace(2, "new");
+    map.publish(std::move(rebuilt));
+
+    EXPECT_FALSE(map.contains(1));
+    std::string out;
+    EXPECT_TRUE(map.find(2, out));
+    EXPECT_EQ(out, "new");
+}
+
+TEST(RcuFlatHashMapTest, ThrowingUpdatePublishesNothing) {
+    rcu_flat_hash_map<int, int> map;
+    map.insert_or_assign(1, 1);
+
+    EXPECT_THROW(map.update([](flat_hash_map<int, int>& table) {
+        table.emplace(2, 2);
+        throw std::runtime_error("abort");
+    }),
+                 std::runtime_error);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.size(), 1);
+}
+
+// =========================================================================
+// 2. Snapshot Isolation
+// =========================================================================
+
+TEST(RcuFlatHashMapTest, SnapshotIsImmutable) {
+    rcu_flat_hash_map<int, int> map;
+    map.insert_or_assign(1, 10);
+
+    auto before = map.snapshot();
+    map.insert_or_assign(1, 20);
+    map.insert_or_assign(2, 30);
+
+    EXPECT_EQ(before->size(), 1);
+    EXPECT_EQ(before->at(1), 10);
+
+    auto after = map.snapshot();
+    EXPECT_EQ(after->size(), 2);
+    EXPECT_EQ(after->at(1), 20);
+}
+
+TEST(RcuFlatHashMapTest, CopiesKeepTheLayout) {
+    rcu_flat_hash_map<int, int> map;
+    map.update([](flat_hash_map<int, int>& table) {
+        for (int i = 0; i < 500; ++i) {
+            table.emplace(i, i);
+        }
+        for (int i = 0; i < 500; i += 5) {
+            table.erase_element(i);
+        }
+    });
+
+    auto before = map.snapshot();
+    map.update([](flat_hash_map<int, int>&) {});
+    auto after = map.snapshot();
+
+    std::vector<int> a;
+    std::vector<int> b;
+    for (const auto& kv : *before) {
+        a.push_back(kv.first);
+    }
+    for (const auto& kv : *after) {
+        b.push_back(kv.first);
+    }
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(before->capacity(), after->capacity());
+}
+
+TEST(RcuFlatHashMapTest, RetiredVersionsAreDestroyed) {
+    LifecycleTracker::reset();
+    {
+        rcu_flat_hash_map<int, LifecycleTracker> map;
+        for (int i = 0; i < 20; ++i) {
+            map.update([i](flat_hash_map<int, LifecycleTracker>& table) {
+                table.emplace(i, LifecycleTracker(i));
+            });
+        }
+        auto snap = map.snapshot();
+        EXPECT_EQ(snap->size(), 20);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
+
+TEST(RcuFlatHashMapTest, ReleasingTheLastSnapshotDestroysItsVersion) {
+    LifecycleTracker::reset();
+    const auto live = [] {
+        return LifecycleTracker::constructions -
+               LifecycleTracker::destructions;
+    };
+
+    rcu_flat_hash_map<int, LifecycleTracker> map;
+    map.update([](flat_hash_map<int, LifecycleTracker>& table) {
+        table.emplace(1, LifecycleTracker(1));
+    });
+    {
+        auto snap = map.snapshot();
+        map.update([](flat_hash_map<int, LifecycleTracker>&) {});
+        EXPECT_EQ(live(), 2);
+    }
+    // Destroyed by the snapshot on its way out, with no further write.
+    EXPECT_EQ(live(), 1);
+}
+
+TEST(RcuFlatHashMapTest, CollectKeepsHeldVersions) {
+    LifecycleTracker::reset();
+    const auto live = [] {
+        return LifecycleTracker::constructions -
+               LifecycleTracker::destructions;
+    };
+
+    rcu_flat_hash_map<int, LifecycleTracker> map;
+    map.update([](flat_hash_map<int, LifecycleTracker>& table) {
+        table.emplace(1, LifecycleTracker(1));
+    });
+    auto snap = map.snapshot();
+    map.update([](flat_hash_map<int, LifecycleTracker>&) {});
+
+    map.collect();
+    EXPECT_EQ(live(), 2);
+    EXPECT_EQ(snap->at(1).val, 1);
+}
+
+TEST(RcuFlatHashMapTest, SnapshotsAreUnbounded) {
+    rcu_flat_hash_map<int, int> map;
+    map.insert_or_assign(1, 10);
+
+    std::vector<rcu_flat_hash_map<int, int>::Snapshot> snaps;
+    for (int i = 0; i < 500; ++i) {
+        snaps.push_back(map.snapshot());
+    }
+    map.insert_or_assign(1, 20);
+
+    std::thread other([&] { EXPECT_EQ(map.snapshot()->at(1), 20); });
+    other.join();
+    for (const auto& snap : snaps) {
+        EXPECT_EQ(snap->at(1), 10);
+    }
+}
+
+// =========================================================================
+// 3. Concurrency
+// =========================================================================
+
+TEST(RcuFlatHashMapTest, ReadersSeeWholeVersions) {
+    constexpr int kKeys = 256;
+    rcu_flat_hash_map<int, int> map;
+    map.update([](flat_hash_map<int, int>& table) {
+        for (int k = 0; k < kKeys; ++k) {
+            table.emplace(k, 0);
+        }
+    });
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto snap = map.snapshot();
+                const int version = snap->at(0);
+                for (int k = 1; k < kKeys; ++k) {
+                    if (snap->at(k) != version) {
+                        ++torn;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int version = 1; version <= 200; ++version) {
+        map.update([version](flat_hash_map<int, int>& table) {
+            for (auto& kv : table) {
+                kv.second = version;
+            }
+        });
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    int out = 0;
+    EXPECT_TRUE(map.find(kKeys - 1, out));
+    EXPECT_EQ(out, 200);
+}
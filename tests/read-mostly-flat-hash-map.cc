@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <hmm/read-mostly-flat-hash-map.hpp>
+
+// Std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::read_mostly_flat_hash_map;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Parks the first reader that compares keys until released.
+struct ParkingEq {
+    static std::atomic<bool> armed;
+    static std::atomic<bool> parked;
+    static std::atomic<bool> released;
+
+    bool operator()(int a, int b) const {
+        if (armed.exchange(false)) {
+            parked = true;
+            while (!released.load()) {
+                std::this_thread::yield();
+            }
+        }
+        return a == b;
+    }
+};
+
+std::atomic<bool> ParkingEq::armed{false};
+std::atomic<bool> ParkingEq::parked{false};
+std::atomic<bool> ParkingEq::released{false};
+
+} // namespace
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(ReadMostlyFlatHashMapTest, InsertFindErase) {
+    read_mostly_flat_hash_map<int, double> map;
+    double value = 0;
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.find(1, value));
+
+    EXPECT_TRUE(map.insert(1, 1.5));
+    EXPECT_FALSE(map.insert(1, 2.5));
+    EXPECT_TRUE(map.find(1, value));
+    EXPECT_EQ(value, 1.5);
+
+    EXPECT_FALSE(map.insert_or_assign(1, 3.5));
+    EXPECT_TRUE(map.find(1, value));
+    EXPECT_EQ(value, 3.5);
+
+    EXPECT_EQ(map.erase(1), 1);
+    EXPECT_EQ(map.erase(1), 0);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ReadMostlyFlatHashMapTest, GrowsAndClears) {
+    read_mostly_flat_hash_map<std::uint64_t, std::uint64_t> map;
+    for (std::uint64_t i = 0; i < 5000; ++i) {
+        EXPECT_TRUE(map.insert(i, i * i));
+    }
+    EXPECT_EQ(map.size(), 5000);
+
+    std::uint64_t sum = 0;
+    map.for_each([&](std::uint64_t key, std::uint64_t value) {
+        EXPECT_EQ(value, key * key);
+        sum += key;
+    });
+    EXPECT_EQ(sum, 5000ULL * 4999 / 2);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(42));
+}
+
+TEST(ReadMostlyFlatHashMapTest, InsertEraseChurn) {
+    read_mostly_flat_hash_map<int, int> map;
+    for (int i = 0; i < 10000; ++i) {
+        map.insert(i, i);
+        if (i >= 8) {
+            EXPECT_EQ(map.erase(i - 8), 1);
+        }
+    }
+
+    // Tombstones must be purged without growing without bound
+    EXPECT_EQ(map.size(), 8);
+    EXPECT_LE(map.capacity(), 64);
+}
+
+TEST(ReadMostlyFlatHashMapTest, MassiveCollisions) {
+    read_mostly_flat_hash_map<int, int, BadHash> map;
+    for (int i = 0; i < 100; ++i) {
+        map.insert(i, -i);
+    }
+
+    int value = 0;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(map.find(i, value));
+        EXPECT_EQ(value, -i);
+    }
+}
+
+// =========================================================================
+// 2. Concurrency
+// =========================================================================
+
+TEST(ReadMostlyFlatHashMapTest, ReadersDuringUpdatesAndGrowth) {
+    struct Pair {
+        std::uint64_t a;
+        std::uint64_t b;
+    };
+    read_mostly_flat_hash_map<int, Pair> map;
+    for (int i = 0; i < 64; ++i) {
+        map.insert(i, Pair{0, 0});
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            Pair value{};
+            while (!done.load()) {
+                for (int i = 0; i < 64; ++i) {
+                    // The writer always stores a == b; a mismatch means a
+                    // torn read slipped past validation.
+                    if (map.find(i, value) && value.a != value.b) {
+                        ++torn;
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::uint64_t round = 1; round < 2000; ++round) {
+        map.insert_or_assign(static_cast<int>(round % 64), Pair{round, round});
+        map.insert(static_cast<int>(64 + round), Pair{round, round});
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(map.size(), 64 + 1999);
+}
+
+TEST(ReadMostlyFlatHashMapTest, CollectFreesRetiredStorageAfterLastReader) {
+    using Alloc = CountingAllocator<std::pair<const int, int>>;
+    AllocationCounter::reset();
+    {
+        read_mostly_flat_hash_map<int, int, std::hash<int>, ParkingEq, Alloc>
+            map;
+        map.insert(1, 1);
+        // One storage header and one word array.
+        EXPECT_EQ(AllocationCounter::live_blocks.load(), 2);
+
+        ParkingEq::armed = true;
+        std::thread reader([&] { EXPECT_TRUE(map.contains(1)); });
+        while (!ParkingEq::parked.load()) {
+            std::this_thread::yield();
+        }
+
+        // The parked reader may still be in the old storage.
+        map.reserve(1000);
+        EXPECT_EQ(AllocationCounter::live_blocks.load(), 4);
+
+        // Readers never reclaim; collecting after it leaves frees it.
+        ParkingEq::released = true;
+        reader.join();
+        EXPECT_EQ(AllocationCounter::live_blocks.load(), 4);
+        map.collect();
+        EXPECT_EQ(AllocationCounter::live_blocks.load(), 2);
+    }
+    EXPECT_EQ(AllocationCounter::live_blocks.load(), 0);
+}
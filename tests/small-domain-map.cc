@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <hmm/small-domain-map.hpp>
+
+// Std
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::enum_map;
+using hmm::small_domain_map;
+using namespace hmm::testing;
+
+namespace {
+
+enum class Opcode : std::uint8_t { kLoad = 3, kStore = 200 };
+
+enum class Color { kRed, kGreen, kBlue, kCount };
+
+} // namespace
+
+namespace hmm {
+template <> struct key_domain<Color> : enum_domain<Color, Color::kCount> {};
+} // namespace hmm
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(SmallDomainMapTest, InsertFindErase) {
+    small_domain_map<std::uint8_t, std::string> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.max_size(), 256);
+    EXPECT_EQ(map.begin(), map.end());
+
+    EXPECT_TRUE(map.try_emplace(7, "seven").second);
+    EXPECT_FALSE(map.try_emplace(7, "again").second);
+    EXPECT_TRUE(map.insert({255, "max"}).second);
+    EXPECT_TRUE(map.emplace(0, "zero").second);
+    map[42] = "answer";
+    EXPECT_EQ(map.size(), 4);
+
+    EXPECT_EQ(map.at(7), "seven");
+    EXPECT_EQ(map.find(255)->second, "max");
+    EXPECT_EQ(map.find(8), map.end());
+    EXPECT_TRUE(map.contains(0));
+    EXPECT_EQ(map.count(1), 0);
+    EXPECT_THROW(static_cast<void>(map.at(1)), std::out_of_range);
+
+    map.insert_or_assign(7, "SEVEN");
+    EXPECT_EQ(map.at(7), "SEVEN");
+
+    EXPECT_EQ(map.erase_element(42), 1);
+    EXPECT_EQ(map.erase_element(42), 0);
+    EXPECT_EQ(map.size(), 3);
+}
+
+TEST(SmallDomainMapTest, IteratesInKeyOrder) {
+    small_domain_map<std::uint8_t, int> map;
+    for (int k : {200, 3, 64, 63, 128, 0}) {
+        map[static_cast<std::uint8_t>(k)] = k;
+    }
+    std::vector<int> keys;
+    for (const auto& kv : map) {
+        EXPECT_EQ(kv.first, kv.second);
+        keys.push_back(kv.first);
+    }
+    EXPECT_EQ(keys, (std::vector<int>{0, 3, 63, 64, 128, 200}));
+
+    // Erasing through iterators returns the next key.
+    auto it = map.find(63);
+    it = map.erase(it);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, 64);
+    for (it = map.begin(); it != map.end();) {
+        it = map.erase(it);
+    }
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(SmallDomainMapTest, SignedKeys) {
+    small_domain_map<std::int8_t, int> map;
+    for (int k = -128; k < 128; ++k) {
+        map.try_emplace(static_cast<std::int8_t>(k), k);
+    }
+    EXPECT_EQ(map.size(), 256);
+    for (int k = -128; k < 128; ++k) {
+        ASSERT_EQ(map.at(static_cast<std::int8_t>(k)), k);
+    }
+}
+
+// =========================================================================
+// 2. Enum Keys
+// =========================================================================
+
+TEST(SmallDomainMapTest, EnumOverSmallIntegerNeedsNoDomain) {
+    enum_map<Opcode, std::string> map;
+    map[Opcode::kLoad] = "load";
+    map[Opcode::kStore] = "store";
+    EXPECT_EQ(map.max_size(), 256);
+    EXPECT_EQ(map.at(Opcode::kStore), "store");
+    EXPECT_EQ(map.begin()->first, Opcode::kLoad);
+}
+
+TEST(SmallDomainMapTest, EnumWithDeclaredCount) {
+    enum_map<Color, int> map{{Color::kRed, 1}, {Color::kBlue, 3}};
+    EXPECT_EQ(map.max_size(), 3);
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_FALSE(map.contains(Color::kGreen));
+
+    // Values outside the domain are never present and cannot be inserted.
+    EXPECT_FALSE(map.contains(Color::kCount));
+    EXPECT_EQ(map.find(static_cast<Color>(-1)), map.end());
+    EXPECT_THROW(map.try_emplace(Color::kCount, 4), std::out_of_range);
+    EXPECT_EQ(map.size(), 2);
+}
+
+// =========================================================================
+// 3. Stress
+// =========================================================================
+
+TEST(SmallDomainMapTest, MatchesReferenceOverSixteenBitKeys) {
+    small_domain_map<std::uint16_t, std::uint32_t> map;
+    std::map<std::uint16_t, std::uint32_t> reference;
+    std::mt19937 rng(11);
+    for (std::uint32_t step = 0; step < 300000; ++step) {
+        const auto key = static_cast<std::uint16_t>(rng());
+        if (rng() % 3 != 0) {
+            map.insert_or_assign(key, step);
+            reference[key] = step;
+        } else {
+            ASSERT_EQ(map.erase_element(key), reference.erase(key));
+        }
+    }
+    ASSERT_EQ(map.size(), reference.size());
+    auto it = map.begin();
+    for (const auto& kv : reference) {
+        ASSERT_EQ(it->first, kv.first);
+        ASSERT_EQ(it->second, kv.second);
+        ++it;
+    }
+    EXPECT_EQ(it, map.end());
+}
+
+// =========================================================================
+// 4. Copy, Move and Object Lifetime
+// =========================================================================
+
+TEST(SmallDomainMapTest, CopyAndMove) {
+    small_domain_map<std::uint8_t, std::string> map{{1, "a"}, {2, "b"}};
+    auto copy = map;
+    copy[1] = "changed";
+    EXPECT_EQ(map.at(1), "a");
+    EXPECT_EQ(copy.size(), 2);
+
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved.at(1), "changed");
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(copy.contains(1));
+    copy[9] = "reused";
+    EXPECT_EQ(copy.size(), 1);
+
+    map = moved;
+    EXPECT_EQ(map.at(1), "changed");
+    map = std::move(copy);
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at(9), "reused");
+}
+
+TEST(SmallDomainMapTest, TracksLifecycles) {
+    LifecycleTracker::reset();
+    {
+        small_domain_map<std::uint8_t, LifecycleTracker> map;
+        for (int i = 0; i < 100; ++i) {
+            map.try_emplace(static_cast<std::uint8_t>(i), i);
+        }
+        map.emplace(std::uint8_t(5), LifecycleTracker(5));
+        for (int i = 0; i < 100; i += 3) {
+            map.erase_element(static_cast<std::uint8_t>(i));
+        }
+        auto copy = map;
+        map.clear();
+        map.try_emplace(1, 1);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <hmm/small-domain-set.hpp>
+
+// Std
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using hmm::small_domain_set;
+
+namespace {
+
+enum class Flag { kA, kB, kC, kCount };
+
+} // namespace
+
+namespace hmm {
+template <> struct key_domain<Flag> : enum_domain<Flag, Flag::kCount> {};
+} // namespace hmm
+
+// =========================================================================
+// 1. Basic Operations
+// =========================================================================
+
+TEST(SmallDomainSetTest, InsertFindErase) {
+    small_domain_set<std::uint8_t> set{1, 2, 3, 2};
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_FALSE(set.insert(3).second);
+    EXPECT_TRUE(set.emplace(255).second);
+    EXPECT_EQ(*set.find(255), 255);
+    EXPECT_EQ(set.find(4), set.end());
+    EXPECT_EQ(set.erase_element(1), 1);
+    EXPECT_EQ(set.erase_element(1), 0);
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()),
+              (std::vector<int>{2, 3, 255}));
+
+    auto it = set.erase(set.find(2));
+    EXPECT_EQ(*it, 3);
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(SmallDomainSetTest, BoolAndSignedKeys) {
+    small_domain_set<bool> flags;
+    EXPECT_EQ(flags.max_size(), 2);
+    flags.insert(true);
+    EXPECT_TRUE(flags.contains(true));
+    EXPECT_FALSE(flags.contains(false));
+    EXPECT_EQ(*flags.begin(), true);
+
+    small_domain_set<std::int16_t> set{-32768, -1, 0, 32767};
+    EXPECT_EQ(set.size(), 4);
+    EXPECT_TRUE(set.contains(-1));
+    EXPECT_FALSE(set.contains(1));
+}
+
+TEST(SmallDomainSetTest, EnumWithDeclaredCount) {
+    small_domain_set<Flag> set{Flag::kC, Flag::kA};
+    EXPECT_EQ(set.max_size(), 3);
+    EXPECT_EQ(*set.begin(), Flag::kA);
+    EXPECT_FALSE(set.contains(Flag::kCount));
+    EXPECT_THROW(set.insert(Flag::kCount), std::out_of_range);
+}
+
+// =========================================================================
+// 2. Stress
+// =========================================================================
+
+TEST(SmallDomainSetTest, MatchesReferenceOverSixteenBitKeys) {
+    small_domain_set<std::uint16_t> set;
+    std::set<std::uint16_t> reference;
+    std::mt19937 rng(3);
+    for (int step = 0; step < 300000; ++step) {
+        const auto key = static_cast<std::uint16_t>(rng());
+        if (rng() % 2 == 0) {
+            ASSERT_EQ(set.insert(key).second, reference.insert(key).second);
+        } else {
+            ASSERT_EQ(set.erase_element(key), reference.erase(key));
+        }
+    }
+    EXPECT_EQ(set.size(), reference.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(),
+                           reference.end()));
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <hmm/city-hash.hpp>
+#include <hmm/static-flat-hash-map.hpp>
+
+// Std
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::ConstexprCityHash;
+using hmm::static_flat_hash_map;
+using namespace hmm::testing;
+
+namespace {
+
+enum class Opcode : std::uint8_t { kAdd, kSub, kMul, kDiv, kJmp };
+
+constexpr static_flat_hash_map<std::string_view, Opcode, 5> kOpcodes = {
+    {"add", Opcode::kAdd},
+    {"sub", Opcode::kSub},
+    {"mul", Opcode::kMul},
+    {"div", Opcode::kDiv},
+    {"jmp", Opcode::kJmp}};
+
+constexpr static_flat_hash_map<int, int, 64> MakeSquares() {
+    std::pair<int, int> entries[64] = {};
+    for (int i = 0; i < 64; ++i) {
+        // std::pair assignment is only constexpr from C++20.
+        entries[i].first = i;
+        entries[i].second = i * i;
+    }
+    return static_flat_hash_map<int, int, 64>(entries, entries + 64);
+}
+
+constexpr auto kSquares = MakeSquares();
+
+/// @brief A constexpr hasher sending every key to one home slot.
+struct ConstantHash {
+    constexpr std::size_t operator()(int) const {
+        return 0;
+    }
+};
+
+} // namespace
+
+// =========================================================================
+// 1. Compile-Time Construction and Lookup
+// =========================================================================
+
+static_assert(kOpcodes.size() == 5, "");
+static_assert(kOpcodes.at("mul") == Opcode::kMul, "");
+static_assert(kOpcodes.contains("jmp"), "");
+static_assert(!kOpcodes.contains("nop"), "");
+static_assert(kOpcodes.find("nop") == kOpcodes.end(), "");
+static_assert(kOpcodes.find("div")->second == Opcode::kDiv, "");
+
+static_assert(kSquares.size() == 64, "");
+static_assert(kSquares.at(63) == 3969, "");
+static_assert(kSquares.count(64) == 0, "");
+static_assert(decltype(kSquares)::capacity() == 128, "");
+
+static_assert(ConstexprCityHash<int>{}(1) != ConstexprCityHash<int>{}(2), "");
+
+TEST(StaticFlatHashMapTest, RuntimeLookupOfConstexprTable) {
+    // Runtime lookups take the SIMD path over the compile-time layout.
+    const std::string add = "add";
+    EXPECT_EQ(kOpcodes.at(add), Opcode::kAdd);
+    EXPECT_EQ(kOpcodes.count(std::string_view("sub")), 1);
+    EXPECT_FALSE(kOpcodes.contains(std::string_view("ad")));
+    EXPECT_THROW((void)kOpcodes.at("nop"), std::out_of_range);
+
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_EQ(kSquares.at(i), i * i);
+    }
+    EXPECT_FALSE(kSquares.contains(-1));
+}
+
+TEST(StaticFlatHashMapTest, IterationVisitsEveryElementOnce) {
+    std::vector<int> seen(64, 0);
+    for (const auto& kv : kSquares) {
+        ASSERT_EQ(kv.second, kv.first * kv.first);
+        ++seen[kv.first];
+    }
+    for (int s : seen) {
+        ASSERT_EQ(s, 1);
+    }
+}
+
+// =========================================================================
+// 2. Runtime Construction
+// =========================================================================
+
+TEST(StaticFlatHashMapTest, EmptyMap) {
+    const static_flat_hash_map<int, int, 4> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_FALSE(map.contains(0));
+}
+
+TEST(StaticFlatHashMapTest, FirstDuplicateWinsAndOverflowThrows) {
+    const std::vector<std::pair<int, int>> dups = {{1, 1}, {2, 2}, {1, 3}};
+    const static_flat_hash_map<int, int, 2> map(dups.begin(), dups.end());
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at(1), 1);
+
+    const std::vector<std::pair<int, int>> many = {{1, 1}, {2, 2}, {3, 3}};
+    using Map = static_flat_hash_map<int, int, 2>;
+    EXPECT_THROW(Map(many.begin(), many.end()), std::length_error);
+}
+
+TEST(StaticFlatHashMapTest, CollidingKeysWrapAroundTheTable) {
+    // Every key starts probing at slot 0, so the run of probes crosses every
+    // group boundary.
+    std::vector<std::pair<int, int>> input;
+    for (int i = 0; i < 100; ++i) {
+        input.emplace_back(i, -i);
+    }
+    const static_flat_hash_map<int, int, 100, ConstantHash> map(input.begin(),
+                                                               input.end());
+    EXPECT_EQ(map.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(map.at(i), -i);
+    }
+    EXPECT_FALSE(map.contains(100));
+}
+
+TEST(StaticFlatHashMapTest, NonLiteralValues) {
+    const static_flat_hash_map<int, std::string, 3> map = {
+        {1, "one"}, {2, "two"}, {3, "three"}};
+    EXPECT_EQ(map.at(3), "three");
+    EXPECT_EQ(map.find(4), map.end());
+}
+
+// =========================================================================
+// 3. Constexpr Hashing
+// =========================================================================
+
+TEST(ConstexprCityHashTest, MatchesCityHash) {
+    for (int i = -500; i < 500; ++i) {
+        ASSERT_EQ(ConstexprCityHash<int>{}(i), hmm::CityHash<int>{}(i));
+    }
+    for (std::uint64_t i = 0; i < 500; ++i) {
+        const std::uint64_t v = i * 0x9E3779B97F4A7C15ULL;
+        ASSERT_EQ(ConstexprCityHash<std::uint64_t>{}(v),
+                  hmm::CityHash<std::uint64_t>{}(v));
+    }
+
+    std::string s;
+    for (int len = 0; len < 300; ++len) {
+        ASSERT_EQ(ConstexprCityHash<std::string_view>{}(s),
+                  hmm::CityHash<std::string>{}(s));
+        s.push_back(static_cast<char>('a' + len % 26));
+    }
+}
+
+TEST(ConstexprCityHashTest, CompileTimeMatchesRuntime) {
+    constexpr std::string_view text =
+        "a string longer than sixty-four bytes, so that the main CityHash "
+        "loop runs during constant evaluation";
+    constexpr std::size_t at_compile_time =
+        ConstexprCityHash<std::string_view>{}(text);
+    EXPECT_EQ(at_compile_time,
+              hmm::CityHash<std::string>{}(std::string(text)));
+}
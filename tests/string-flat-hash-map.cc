@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <hmm/string-flat-hash-map.hpp>
+
+// Std
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::string_flat_hash_map;
+using hmm::string_key;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Sends every string to the same hash, so lookups rely on equality.
+struct ConstantStringHash {
+    std::size_t operator()(std::string_view) const {
+        return 7;
+    }
+};
+
+std::string LongKey(int i) {
+    // Shares a 12-byte prefix, so equality must read the remaining bytes.
+    return "common_prefix_" + std::to_string(i) + "_with_a_long_tail";
+}
+
+} // namespace
+
+// =========================================================================
+// 1. string_key
+// =========================================================================
+
+TEST(StringKeyTest, InlineAndLongKeys) {
+    static_assert(sizeof(string_key) == 24, "");
+
+    const string_key empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.view(), "");
+
+    const string_key short_key("twenty bytes exactly");
+    EXPECT_EQ(short_key.size(), 20);
+    EXPECT_TRUE(short_key.is_inline());
+    EXPECT_EQ(short_key.view(), "twenty bytes exactly");
+
+    const std::string text = "twenty-one bytes long";
+    const string_key long_key(text);
+    EXPECT_FALSE(long_key.is_inline());
+    EXPECT_EQ(long_key.view(), text);
+    EXPECT_EQ(long_key.data(), text.data());
+}
+
+TEST(StringKeyTest, Equality) {
+    const std::string a = LongKey(1);
+    const std::string b = LongKey(2);
+    EXPECT_EQ(string_key(a), string_key(std::string(a)));
+    EXPECT_NE(string_key(a), string_key(b));
+    EXPECT_NE(string_key("abc"), string_key("abd"));
+    EXPECT_NE(string_key("abc"), string_key("ab"));
+    EXPECT_NE(string_key(std::string_view("a\0", 2)), string_key("a"));
+    EXPECT_EQ(string_key(std::string_view("a\0b", 3)),
+              string_key(std::string("a\0b", 3)));
+}
+
+// =========================================================================
+// 2. Map Operations
+// =========================================================================
+
+TEST(StringFlatHashMapTest, InsertFindErase) {
+    string_flat_hash_map<int> map = {{"one", 1}, {"two", 2}};
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at("one"), 1);
+
+    const std::string long_key = LongKey(3);
+    EXPECT_TRUE(map.try_emplace(long_key, 3).second);
+    EXPECT_FALSE(map.try_emplace(long_key, 30).second);
+    EXPECT_EQ(map.at(std::string_view(long_key)), 3);
+
+    map["four"] = 4;
+    map.insert_or_assign("one", 10);
+    EXPECT_EQ(map.at("one"), 10);
+    EXPECT_EQ(map.count("four"), 1);
+
+    EXPECT_EQ(map.erase(long_key), 1);
+    EXPECT_EQ(map.erase(long_key), 0);
+    EXPECT_FALSE(map.contains(long_key));
+    EXPECT_THROW((void)map.at("five"), std::out_of_range);
+}
+
+TEST(StringFlatHashMapTest, StoredKeysOwnTheirBytes) {
+    string_flat_hash_map<int> map;
+    {
+        std::string temp = LongKey(42);
+        map.try_emplace(temp, 42);
+        temp.assign(temp.size(), 'x');
+    }
+    const auto it = map.find(LongKey(42));
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first.view(), LongKey(42));
+}
+
+TEST(StringFlatHashMapTest, ManyKeysThroughGrowth) {
+    string_flat_hash_map<int> map;
+    for (int i = 0; i < 50000; ++i) {
+        const std::string key = i % 2 == 0 ? std::to_string(i) : LongKey(i);
+        ASSERT_TRUE(map.try_emplace(key, i).second);
+    }
+    EXPECT_EQ(map.size(), 50000);
+    for (int i = 0; i < 50000; ++i) {
+        const std::string key = i % 2 == 0 ? std::to_string(i) : LongKey(i);
+        ASSERT_EQ(map.at(key), i);
+    }
+
+    std::size_t n = 0;
+    for (const auto& kv : map) {
+        const std::string key =
+            kv.second % 2 == 0 ? std::to_string(kv.second) : LongKey(kv.second);
+        ASSERT_EQ(kv.first.view(), key);
+        ++n;
+    }
+    EXPECT_EQ(n, map.size());
+}
+
+TEST(StringFlatHashMapTest, CollidingHashes) {
+    string_flat_hash_map<int, ConstantStringHash> map;
+    for (int i = 0; i < 300; ++i) {
+        map[LongKey(i)] = i;
+    }
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_EQ(map.at(LongKey(i)), i);
+    }
+    EXPECT_FALSE(map.contains(LongKey(300)));
+}
+
+// =========================================================================
+// 3. Ownership and Lifecycles
+// =========================================================================
+
+TEST(StringFlatHashMapTest, CopyAndMove) {
+    string_flat_hash_map<std::string> original;
+    for (int i = 0; i < 1000; ++i) {
+        original.try_emplace(LongKey(i), std::to_string(i));
+    }
+
+    string_flat_hash_map<std::string> copy = original;
+    EXPECT_EQ(copy.at(LongKey(500)), "500");
+    EXPECT_NE(copy.find(LongKey(1))->first.data(),
+              original.find(LongKey(1))->first.data());
+
+    string_flat_hash_map<std::string> assigned;
+    assigned["x"] = "y";
+    assigned = original;
+    EXPECT_EQ(assigned.size(), 1000);
+    EXPECT_FALSE(assigned.contains("x"));
+
+    string_flat_hash_map<std::string> moved = std::move(copy);
+    EXPECT_EQ(moved.at(LongKey(999)), "999");
+}
+
+TEST(StringFlatHashMapTest, ReleasesLongKeys) {
+    using Map = string_flat_hash_map<int, hmm::CityHash<std::string_view>,
+                                     CountingAllocator<int>>;
+    AllocationCounter::reset();
+    {
+        Map map;
+        for (int i = 0; i < 2000; ++i) {
+            map.try_emplace(LongKey(i), i);
+        }
+        for (int i = 0; i < 2000; i += 2) {
+            map.erase(LongKey(i));
+        }
+        Map copy = map;
+        copy = map;
+        map.clear();
+        EXPECT_EQ(copy.size(), 1000);
+    }
+    EXPECT_EQ(AllocationCounter::live_blocks.load(), 0);
+}
+
+TEST(StringFlatHashMapTest, TracksValueLifecycles) {
+    LifecycleTracker::reset();
+    {
+        string_flat_hash_map<LifecycleTracker> map;
+        for (int i = 0; i < 1000; ++i) {
+            map.try_emplace(LongKey(i), i);
+        }
+        for (int i = 0; i < 1000; i += 3) {
+            map.erase(LongKey(i));
+        }
+        EXPECT_EQ(map.at(LongKey(1)).val, 1);
+    }
+    EXPECT_EQ(LifecycleTracker::constructions,
+              LifecycleTracker::destructions);
+}
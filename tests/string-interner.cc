@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <hmm/string-interner.hpp>
+
+// Std
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "test-shared.hpp"
+
+using hmm::string_interner;
+using namespace hmm::testing;
+
+namespace {
+
+/// @brief Sends every string to the same hash, so lookups rely on equality.
+struct ConstantStringHash {
+    std::size_t operator()(std::string_view) const {
+        return 42;
+    }
+};
+
+} // namespace
+
+// =========================================================================
+// 1. Interning and Reverse Lookup
+// =========================================================================
+
+TEST(StringInternerTest, AssignsDenseSymbols) {
+    string_interner<> interner;
+    EXPECT_TRUE(interner.empty());
+
+    EXPECT_EQ(interner.intern("alpha"), 0);
+    EXPECT_EQ(interner.intern("beta"), 1);
+    EXPECT_EQ(interner.intern("alpha"), 0);
+    EXPECT_EQ(interner.intern(""), 2);
+    EXPECT_EQ(interner.intern(std::string("beta")), 1);
+
+    EXPECT_EQ(interner.size(), 3);
+    EXPECT_EQ(interner.name(0), "alpha");
+    EXPECT_EQ(interner.name(1), "beta");
+    EXPECT_EQ(interner.name(2), "");
+}
+
+TEST(StringInternerTest, FindDoesNotIntern) {
+    string_interner<> interner;
+    interner.intern("x");
+    EXPECT_EQ(interner.find("x"), 0);
+    EXPECT_EQ(interner.find("y"), string_interner<>::npos);
+    EXPECT_FALSE(interner.contains("y"));
+    EXPECT_EQ(interner.size(), 1);
+}
+
+TEST(StringInternerTest, ManyStringsKeepStableViews) {
+    string_interner<> interner;
+    std::vector<std::string> strings;
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 100000; ++i) {
+        strings.push_back("identifier_" + std::to_string(i));
+        const auto id = interner.intern(strings.back());
+        ASSERT_EQ(id, static_cast<std::uint32_t>(i));
+        views.push_back(interner.name(id));
+    }
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(interner.intern(strings[i]), static_cast<std::uint32_t>(i));
+        // Growing the table and the arena never moves a string.
+        ASSERT_EQ(interner.name(i).data(), views[i].data());
+        ASSERT_EQ(views[i], strings[i]);
+    }
+}
+
+TEST(StringInternerTest, LongStringsGetTheirOwnChunk) {
+    string_interner<> interner;
+    const std::string big(1 << 20, 'z');
+    const auto small = interner.intern("small");
+    const auto large = interner.intern(big);
+    const auto after = interner.intern("after");
+
+    EXPECT_EQ(interner.name(large), big);
+    EXPECT_EQ(interner.name(small), "small");
+    EXPECT_EQ(interner.name(after), "after");
+    EXPECT_EQ(interner.intern(big), large);
+    EXPECT_GE(interner.arena_bytes(), big.size());
+}
+
+TEST(StringInternerTest, HashCollisionsFallBackToEquality) {
+    string_interner<ConstantStringHash> interner;
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(interner.intern(std::to_string(i)),
+                  static_cast<std::uint32_t>(i));
+    }
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(interner.find(std::to_string(i)),
+                  static_cast<std::uint32_t>(i));
+    }
+    EXPECT_FALSE(interner.contains("500"));
+}
+
+TEST(StringInternerTest, EmbeddedNulBytes) {
+    string_interner<> interner;
+    const std::string_view a("a\0b", 3);
+    const std::string_view b("a\0c", 3);
+    EXPECT_NE(interner.intern(a), interner.intern(b));
+    EXPECT_EQ(interner.name(interner.find(a)), a);
+}
+
+// =========================================================================
+// 2. Allocation Behaviour
+// =========================================================================
+
+TEST(StringInternerTest, InterningExistingStringsDoesNotAllocate) {
+    string_interner<hmm::CityHash<std::string_view>,
+                    std::equal_to<std::string_view>, CountingAllocator<char>>
+        interner;
+    std::vector<std::string> strings;
+    for (int i = 0; i < 10000; ++i) {
+        strings.push_back("a reasonably long identifier #" +
+                          std::to_string(i));
+        interner.intern(strings.back());
+    }
+
+    const int before = AllocationCounter::allocations.load();
+    for (const auto& s : strings) {
+        interner.intern(std::string_view(s));
+        ASSERT_TRUE(interner.contains(s));
+    }
+    EXPECT_EQ(AllocationCounter::allocations.load(), before);
+}
+
+TEST(StringInternerTest, ArenaPacksStrings) {
+    string_interner<> interner;
+    interner.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        interner.intern("s" + std::to_string(i));
+    }
+    // A thousand short strings fit in the first chunk.
+    EXPECT_EQ(interner.arena_bytes(), 64 * 1024);
+}
+
+// =========================================================================
+// 3. Copy, Move and Clear
+// =========================================================================
+
+TEST(StringInternerTest, CopyKeepsSymbols) {
+    string_interner<> original;
+    for (int i = 0; i < 1000; ++i) {
+        original.intern(std::to_string(i * 7));
+    }
+    string_interner<> copy = original;
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy.find("70"), 10);
+    EXPECT_NE(copy.name(10).data(), original.name(10).data());
+
+    copy.intern("new");
+    EXPECT_FALSE(original.contains("new"));
+}
+
+TEST(StringInternerTest, MoveKeepsAddresses) {
+    string_interner<> original;
+    original.intern("one");
+    original.intern("two");
+    const char* two = original.name(1).data();
+
+    string_interner<> moved = std::move(original);
+    EXPECT_EQ(moved.name(1).data(), two);
+    EXPECT_EQ(moved.find("one"), 0);
+    EXPECT_EQ(moved.intern("three"), 2);
+
+    string_interner<> assigned;
+    assigned.intern("other");
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.find("three"), 2);
+    EXPECT_EQ(assigned.find("other"), string_interner<>::npos);
+}
+
+TEST(StringInternerTest, ClearRestartsSymbols) {
+    string_interner<> interner;
+    interner.intern("a");
+    interner.intern("b");
+    interner.clear();
+    EXPECT_TRUE(interner.empty());
+    EXPECT_EQ(interner.arena_bytes(), 0);
+    EXPECT_FALSE(interner.contains("a"));
+    EXPECT_EQ(interner.intern("b"), 0);
+}
@@ -1,7 +1,10 @@
 #ifndef HMM_TESTS_TEST_SHARED_HPP
 #define HMM_TESTS_TEST_SHARED_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <memory>
 
 namespace hmm {
 namespace testing {
@@ -48,6 +51,43 @@ struct LifecycleHasher {
     }
 };
 
+/// @brief Allocations made through `CountingAllocator`, across every rebind.
+struct AllocationCounter {
+    static inline std::atomic<int> allocations{0};
+    static inline std::atomic<int> live_blocks{0};
+
+    static void reset() {
+        allocations = 0;
+        live_blocks = 0;
+    }
+};
+
+/// @brief Counts every allocation made through it or its rebound copies, and
+/// the blocks not yet freed.
+template <class T> struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <class U> CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        ++AllocationCounter::allocations;
+        ++AllocationCounter::live_blocks;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) {
+        --AllocationCounter::live_blocks;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <class U> bool operator==(const CountingAllocator<U>&) const {
+        return true;
+    }
+    template <class U> bool operator!=(const CountingAllocator<U>&) const {
+        return false;
+    }
+};
+
 } // namespace
 } // namespace testing
 } // namespace hmm